@@ -1,5 +1,6 @@
 #include "LimboApp.h"
 #include "Utils/Algorithm.h"
+#include "GLs/GLDebug.h"
 
 // A B C D
 // E F G H
@@ -106,6 +107,10 @@ const Math::fv2 LimboApp::TARGET_POSITIONS[8] = {
 };
 
 LimboApp::LimboApp() : gdevice(Graphics::GraphicsDevice::Initialize({ (int)WIDTH, (int)HEIGHT }, { .decorated = false, /*.floating = true, */.maximized = true, .transparent = true })) {
+    Debug::Logger::GetInternalLog().SetAsync(logger);
+    Graphics::GLLogger().SetAsync(logger);
+    Debug::AsyncLogger::InstallCrashHandlers();
+
     if (ma_engine_init(nullptr, &audioEngine) != MA_SUCCESS) {
         Debug::QError$("Miniaudio Failed to Load!");
     }
@@ -121,6 +126,24 @@ LimboApp::LimboApp() : gdevice(Graphics::GraphicsDevice::Initialize({ (int)WIDTH
             "hands", "light", "icons", "choose" } },
         true
     );
+    keySprites = {
+        .main    = texAtlas.GetHandle("main"),
+        .high    = texAtlas.GetHandle("high"),
+        .shadow  = texAtlas.GetHandle("shadow"),
+        .outline = texAtlas.GetHandle("outline"),
+        .glow    = texAtlas.GetHandle("glow"),
+    };
+    overlaySprites = {
+        .countdown = {
+            texAtlas.GetHandle("ready"), texAtlas.GetHandle("3"), texAtlas.GetHandle("2"),
+            texAtlas.GetHandle("1"),     texAtlas.GetHandle("go"),
+        },
+        .hands  = texAtlas.GetHandle("hands"),
+        .light  = texAtlas.GetHandle("light"),
+        .icons  = texAtlas.GetHandle("icons"),
+        .choose = texAtlas.GetHandle("choose"),
+    };
+    keyInstancer.CreateRender(gdevice, 8 * 5);
 
     for (int i = 0; i < 8; ++i) {
         for (int tone = 0; tone < 3; ++tone) {
@@ -217,6 +240,8 @@ LimboApp::LimboApp() : gdevice(Graphics::GraphicsDevice::Initialize({ (int)WIDTH
 
 LimboApp::~LimboApp() {
     ma_engine_uninit(&audioEngine);
+    Debug::Logger::GetInternalLog().SetAsync(nullptr);
+    Graphics::GLLogger().SetAsync(nullptr);
 }
 
 bool LimboApp::Run() {
@@ -263,16 +288,22 @@ Math::fv2 LimboApp::Project(Math::fv2 position, float z) {
 
 void LimboApp::DrawKey(int index) {
     LimboKey& key = keys[index];
-    const Math::fv2 screenPos = Project(key.position, key.z / globalScale);
+    const Math::fv2 screenPos = Project(key.position, key.z / globalScale) + screenShake.offset;
     const float size = globalScale * key.scale * KEY_SIZE * Z_CENTER / key.z;
     const auto* palette = key.color;
-    canvas.transform = Math::Transform2D(screenPos + screenShake.offset, 1, Math::Radians(globalRotation));
-    canvas.DrawSTextureW(texAtlas["main"],    0, size, true, palette[0]);
-    canvas.DrawSTextureW(texAtlas["high"],    0, size, true, palette[1]);
-    canvas.DrawSTextureW(texAtlas["shadow"],  0, size, true, palette[2]);
-    canvas.DrawSTextureW(texAtlas["outline"], 0, size);
-    canvas.DrawSTextureW(texAtlas["glow"],    0, size * 1.25f, true, palette[0].AddAlpha(key.glowIntensity));
-    canvas.transform.Reset();
+    const Math::Rotor2D rotation = Math::Radians(globalRotation);
+    using Graphics::SpriteInstance;
+    keyInstancer.Push(SpriteInstance::FromWidth(texAtlas[keySprites.main],    screenPos, size,         rotation, palette[0]), key.z);
+    keyInstancer.Push(SpriteInstance::FromWidth(texAtlas[keySprites.high],    screenPos, size,         rotation, palette[1]), key.z);
+    keyInstancer.Push(SpriteInstance::FromWidth(texAtlas[keySprites.shadow],  screenPos, size,         rotation, palette[2]), key.z);
+    keyInstancer.Push(SpriteInstance::FromWidth(texAtlas[keySprites.outline], screenPos, size,         rotation),             key.z);
+    keyInstancer.Push(SpriteInstance::FromWidth(texAtlas[keySprites.glow],    screenPos, size * 1.25f, rotation, palette[0].AddAlpha(key.glowIntensity)), key.z);
+}
+
+void LimboApp::FlushKeys() {
+    // whatever the canvas has so far goes under the keys
+    canvas.ForceDrawCurrentBatch();
+    keyInstancer.Draw(texAtlas.GetTexture());
 }
 
 void LimboApp::DrawFrontKeys() {
@@ -280,6 +311,7 @@ void LimboApp::DrawFrontKeys() {
         if (keys[i].z >= Z_CENTER) continue;
         DrawKey(i);
     }
+    FlushKeys();
 }
 
 void LimboApp::DrawBackKeys() {
@@ -287,19 +319,21 @@ void LimboApp::DrawBackKeys() {
         if (keys[i].z < Z_CENTER) continue;
         DrawKey(i);
     }
+    FlushKeys();
 }
 
 void LimboApp::DrawKeys() {
-    DrawBackKeys();
-    DrawFrontKeys();
+    // the instancer sorts by depth, so back and front keys can share a draw
+    for (int i = 0; i < 8; i++) DrawKey(i);
+    FlushKeys();
 }
 
-void LimboApp::DrawTexW(Str name, const Math::fv2& pos, float w, float alpha) {
-    canvas.DrawSTextureW(texAtlas[name], pos, w, true, { 1, alpha });
+void LimboApp::DrawTexW(Graphics::TextureAtlas::Handle sprite, const Math::fv2& pos, float w, float alpha) {
+    canvas.DrawSTextureW(texAtlas[sprite], pos, w, true, { 1, alpha });
 }
 
-void LimboApp::DrawTexH(Str name, const Math::fv2& pos, float h, float alpha) {
-    canvas.DrawSTextureH(texAtlas[name], pos, h, true, { 1, alpha });
+void LimboApp::DrawTexH(Graphics::TextureAtlas::Handle sprite, const Math::fv2& pos, float h, float alpha) {
+    canvas.DrawSTextureH(texAtlas[sprite], pos, h, true, { 1, alpha });
 }
 
 const Math::fColor& LimboApp::GetColor(int index, int shade) const {
@@ -447,7 +481,6 @@ void LimboApp::ReadyAnim::Anim(LimboApp& app, float dt) {
     app.DrawKeys();
 
     static constexpr float ACC_TIMES[] = { 0.0f, 0.33f, 0.5f, 0.67f, 0.83f, 1.0f };
-    static Str TEXTURES[] = { "ready", "3", "2", "1", "go" };
     const int newIdx = (int)(Span { ACC_TIMES }.FindIf([&] (float x) { return x > time; }).UnwrapOr(5)) - 1;
     if (newIdx != texIndex) {
         app.screenShake.Trigger(30.0f);
@@ -455,7 +488,7 @@ void LimboApp::ReadyAnim::Anim(LimboApp& app, float dt) {
     texIndex = newIdx;
 
     const float t = time - ACC_TIMES[texIndex], dur = ACC_TIMES[texIndex + 1] - ACC_TIMES[texIndex];
-    const Str tex = TEXTURES[texIndex];
+    const Graphics::TextureAtlas::Handle tex = app.overlaySprites.countdown[texIndex];
 
     const Math::fv2& sOff = app.screenShake.offset;
     switch (texIndex) {
@@ -560,13 +593,13 @@ void LimboApp::ChooseKeyAnim::Anim(LimboApp& app, float dt) {
 
     const float handY = HEIGHT * (0.46f - 2 * std::exp(0.4f - time) + 0.04f * std::sin(0.6f * time));
     const float a = std::min(time, 1.0f), w = WIDTH * 0.4f * (1 + std::min(time * 0.6f, 1.0f));
-    app.DrawTexW("hands",  { WIDTH / 2, handY }, w, a);
-    app.DrawTexW("icons",  { WIDTH / 2, HEIGHT * (0.86f + std::exp(3 * (5.0f - time))) }, WIDTH);
+    app.DrawTexW(app.overlaySprites.hands,  { WIDTH / 2, handY }, w, a);
+    app.DrawTexW(app.overlaySprites.icons,  { WIDTH / 2, HEIGHT * (0.86f + std::exp(3 * (5.0f - time))) }, WIDTH);
 
     const float chooseY = HEIGHT * (0.5f + 1.4f * std::exp(0.6f - time) + 0.04f * std::sin(0.6f * time + 0.7f));
     app.DrawBackKeys();
-    app.DrawTexW("choose", { WIDTH / 2, chooseY }, w * 0.45f, a);
-    app.DrawTexH("light", ORIGIN, HEIGHT, 0.2f * std::min(time, 2.0f));
+    app.DrawTexW(app.overlaySprites.choose, { WIDTH / 2, chooseY }, w * 0.45f, a);
+    app.DrawTexH(app.overlaySprites.light,  ORIGIN, HEIGHT, 0.2f * std::min(time, 2.0f));
     app.DrawFrontKeys();
 }
 
@@ -2,7 +2,9 @@
 #include "Timeline.h"
 #include "PostEffect.h"
 #include "GUI/Canvas.h"
+#include "SpriteInstancer.h"
 #include "Quasi/src/Graphics/GraphicsDevice.h"
+#include "Quasi/src/Utils/Debug/AsyncLogger.h"
 #include "miniaudio/miniaudio.h"
 
 using namespace Quasi;
@@ -50,6 +52,8 @@ class LimboApp {
     static constexpr float WIDTH = 1920, HEIGHT = 1080, Z_CENTER = 1.0f, KEY_SIZE = WIDTH * 0.1;
     static const Math::fv2 ORIGIN;
 
+    // first in, last out, so everything logs through it for as long as the app is up
+    Debug::AsyncLogger logger;
     Graphics::GraphicsDevice gdevice;
     Graphics::Canvas canvas { gdevice };
     ma_engine audioEngine;
@@ -70,6 +74,17 @@ class LimboApp {
     static const Math::fv2 TARGET_POSITIONS[8];
 
     Graphics::TextureAtlas texAtlas;
+    // looked up once after loading the atlas, every key draws all of these every frame
+    struct KeySprites {
+        Graphics::TextureAtlas::Handle main, high, shadow, outline, glow;
+    } keySprites;
+    // the same for the overlays the animations draw
+    struct OverlaySprites {
+        Graphics::TextureAtlas::Handle countdown[5]; // ready, 3, 2, 1, go
+        Graphics::TextureAtlas::Handle hands, light, icons, choose;
+    } overlaySprites;
+    // every layer of every key goes through here as one instanced draw, sorted back to front
+    Graphics::SpriteInstancer keyInstancer;
     Math::fColor colorPalette[8][3];
 public:
     LimboApp();
@@ -83,8 +98,9 @@ public:
     void DrawFrontKeys();
     void DrawBackKeys();
     void DrawKeys();
-    void DrawTexW(Str name, const Math::fv2& pos, float w, float alpha = 1);
-    void DrawTexH(Str name, const Math::fv2& pos, float h, float alpha = 1);
+    void FlushKeys();
+    void DrawTexW(Graphics::TextureAtlas::Handle sprite, const Math::fv2& pos, float w, float alpha = 1);
+    void DrawTexH(Graphics::TextureAtlas::Handle sprite, const Math::fv2& pos, float h, float alpha = 1);
 
     const Math::fColor& GetColor(int index, int shade) const;
     const CArray<Math::fColor, 3>& GetColorShades(int index) const;
@@ -24,7 +24,7 @@ namespace Quasi::Graphics {
     void PostEffect::SetToRenderTarget() {
         frameBuf.Bind();
         frameBuf.Attach(screenTex);
-        GL::Viewport(0, 0, screenDim.x, screenDim.y);
+        Render::SetViewport({ 0, screenDim });
     }
 
     void PostEffect::ApplyEffect() {
@@ -0,0 +1,71 @@
+#include "Bench.h"
+
+#include "Utils/Debug/AsyncLogger.h"
+
+#include <thread>
+
+using namespace Quasi;
+using Debug::Severity;
+
+static constexpr u32 LOGS = 200'000;
+static const Str PASS = "main pass";
+
+// what a frame loop would log: a few numbers and a short string
+static void LogFrames(Debug::Logger& log, u32 count) {
+    for (u32 i = 0; i < count; ++i)
+        log.LogFmt(Severity::INFO, "frame {} took {} ms, {} draws in {}", i, 16.6f + (f32)(i % 7), i % 300, PASS);
+}
+
+static void LogFramesStatic(Debug::Logger& log, u32 count) {
+    for (u32 i = 0; i < count; ++i)
+        log.LogFmt(Severity::INFO, "frame {} took {} ms, {} draws in {}"_fmt, i, 16.6f + (f32)(i % 7), i % 300, PASS);
+}
+
+// ns per log on the calling thread, then how long the worker took to get everything written
+static void Async(Str name, Debug::AsyncLogger::OverflowPolicy policy, usize ringSize, u32 threads, void (*logFrames)(Debug::Logger&, u32)) {
+    std::FILE* out = std::tmpfile();
+    Debug::AsyncLogger async { out, policy, ringSize };
+    Debug::Logger log;
+    log.SetAsync(async);
+
+    const u32 perThread = LOGS / threads;
+    double callerNs = 0;
+    const double totalNs = Bench::NsPerOp(1, [&] {
+        Vec<std::thread> workers;
+        std::atomic<u64> elapsed = 0;
+        for (u32 t = 0; t < threads; ++t)
+            workers.Push(std::thread { [&] {
+                // the first log sets up the thread's ring, which isnt what this is timing
+                log.LogFmt(Severity::INFO, "warming up");
+                elapsed.fetch_add((u64)Bench::NsPerOp(1, [&] { logFrames(log, perThread); }));
+            } });
+        for (std::thread& w : workers) w.join();
+        callerNs = (double)elapsed.load() / (perThread * threads);
+        async.Flush();
+    });
+
+    std::printf("  %-28s %6.1f ns per log, %5zu dropped, all written after %.1f ms\n",
+                name.Data(), callerNs, async.DroppedCount(), totalNs / 1e6);
+    log.SetAsync(nullptr);
+    std::fclose(out);
+}
+
+int main() {
+    std::printf("logging %u lines to a temp file\n", LOGS);
+    {
+        std::FILE* out = std::tmpfile();
+        Debug::Logger log { Text::StringWriter::WriteToFile(out) };
+        const double ns = Bench::NsPerOp(LOGS, [&] { LogFrames(log, LOGS); });
+        std::printf("  %-28s %6.1f ns per log\n", "sync", ns);
+        std::fclose(out);
+    }
+
+    using enum Debug::AsyncLogger::OverflowPolicy;
+    constexpr usize BIG = 32 * 1024 * 1024, SMALL = Debug::AsyncLogger::DEFAULT_RING_SIZE;
+    Async("async, runtime format",      DROP,  BIG,   1, LogFrames);
+    Async("async, _fmt",                DROP,  BIG,   1, LogFramesStatic);
+    Async("async, 64kb ring, drop",     DROP,  SMALL, 1, LogFrames);
+    Async("async, 64kb ring, block",    BLOCK, SMALL, 1, LogFrames);
+    Async("async, 4 threads",           DROP,  BIG,   4, LogFrames);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "Bench.h"
+
+#include "TextureAtlas.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+// LimboFools' atlas, the sizes are made up but the names are the same
+static constexpr Str NAMES[] = {
+    "high", "main", "shadow", "outline", "glow", "ready", "1", "2", "3", "go", "hands", "light", "icons", "choose",
+};
+static const Math::iv2 SIZES[] = {
+    { 40, 40 }, { 40, 40 }, { 40, 40 }, { 44, 44 }, { 64, 64 }, { 120, 48 }, { 32, 48 },
+    { 32, 48 }, { 32, 48 }, { 64, 48 }, { 200, 120 }, { 256, 256 }, { 96, 32 }, { 160, 40 },
+};
+// every key draws these every frame
+static constexpr Str LAYERS[] = { "main", "high", "shadow", "outline", "glow" };
+static constexpr usize KEYS = 8, FRAMES = 200'000;
+
+// what the atlas did before it kept handles: a String keyed map, and dividing by the texture size on every fetch
+struct StringAtlas {
+    const TextureAtlas& atlas;
+    HashMap<String, Math::iRect2D> lookup;
+
+    StringAtlas(const TextureAtlas& atlas) : atlas(atlas) {
+        for (const Str name : NAMES) lookup.Insert(String::FromStr(name), atlas.GetPx(name));
+    }
+    Math::fRect2D GetUV(Str name) const { return atlas.GetTexture().Px2UV(*lookup.Get(name)); }
+};
+
+// one sprite fetch per key per layer, as DrawKey does
+template <class F>
+static double NsPerFetch(F&& fetch) {
+    return Bench::BestNsPerOp(FRAMES * KEYS * std::size(LAYERS), 3, [&] {
+        f32 sum = 0;
+        for (usize f = 0; f < FRAMES; ++f)
+            for (usize k = 0; k < KEYS; ++k)
+                for (usize l = 0; l < std::size(LAYERS); ++l)
+                    sum += fetch(l).min.x;
+        Bench::Keep(sum);
+    });
+}
+
+int main() {
+    Vec<Image> images = Vec<Image>::WithCap(std::size(SIZES));
+    Vec<ImageView> views = Vec<ImageView>::WithCap(std::size(SIZES));
+    for (const Math::iv2& size : SIZES) {
+        images.Push(Image::New(size.x, size.y));
+        views.Push(images.Last().AsView());
+    }
+    const TextureAtlas atlas { views, Span<const Str> { NAMES }, true };
+    const StringAtlas stringAtlas { atlas };
+
+    TextureAtlas::Handle handles[std::size(LAYERS)];
+    for (usize l = 0; l < std::size(LAYERS); ++l) handles[l] = atlas.GetHandle(LAYERS[l]);
+
+    const double str    = NsPerFetch([&] (usize l) { return stringAtlas.GetUV(LAYERS[l]); }),
+                 atom   = NsPerFetch([&] (usize l) { return atlas.GetUV(LAYERS[l]); }),
+                 handle = NsPerFetch([&] (usize l) { return atlas.GetUV(handles[l]); });
+
+    const double perFrame = (double)(KEYS * std::size(LAYERS));
+    std::printf("one sprite fetch, %zu sprites, %zu keys x %zu layers\n", std::size(NAMES), KEYS, std::size(LAYERS));
+    std::printf("  %-26s %5.1f ns  (%.0f ns a frame)\n", "String map + Px2UV",       str,    str    * perFrame);
+    std::printf("  %-26s %5.1f ns  (%.0f ns a frame)\n", "Str -> Atom -> atlas map", atom,   atom   * perFrame);
+    std::printf("  %-26s %5.1f ns  (%.0f ns a frame)\n", "Handle",                   handle, handle * perFrame);
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "Bench.h"
+
+#include <cstring>
+
+#include "GLs/VertexElement.h"
+#include "GUI/UIVertex.h"
+#include "Utils/Vec.h"
+#include "Utils/Math/BatchTransform.h"
+#include "Utils/Math/Random.h"
+#include "Utils/Math/Transform2D.h"
+#include "Utils/Math/Transform3D.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+static constexpr usize COUNT = 1 << 20;
+
+static Math::fv2 RandomV2(Math::SplitMix64& rng) {
+    return { (f32)(rng.Next64() % 2001) / 100.0f - 10.0f, (f32)(rng.Next64() % 2001) / 100.0f - 10.0f };
+}
+static Math::fv3 RandomV3(Math::SplitMix64& rng) {
+    const Math::fv2 xy = RandomV2(rng);
+    return { xy.x, xy.y, (f32)(rng.Next64() % 2001) / 100.0f - 10.0f };
+}
+
+static double MVertsPerSecond(double nsPerVertex) { return 1e3 / nsPerVertex; }
+
+// every run transforms a fresh copy of the same vertices, so they dont drift off towards infinity over the runs.
+// the copy is timed too, but its the same for every column
+template <class V, class Tf>
+static void Run(const char* name, const Vec<V>& source, const Tf& transform) {
+    Vec<V> verts = Vec<V>::WithSize(COUNT);
+    const auto time = [&] (auto&& transformAll) {
+        return Bench::BestNsPerOp(COUNT, 5, [&] {
+            std::memcpy((void*)verts.Data(), (const void*)source.Data(), COUNT * sizeof(V));
+            transformAll();
+            Bench::Keep(verts[COUNT / 2]);
+        });
+    };
+
+    const double perVertex = time([&] { for (V& v : verts) v = v.Mul(transform); });
+    Vec<V> reference = verts.Clone();
+
+    std::printf("  %-16s %-10.0f", name, MVertsPerSecond(perVertex));
+    bool same = true;
+    for (u32 level = Math::BatchTransform::SCALAR; level <= Math::BatchTransform::AVX2; ++level) {
+        Math::BatchTransform::UseLevel((Math::BatchTransform::Level)level);
+        if (Math::BatchTransform::CurrentLevel() != level) {
+            std::printf(" %-9s", "-");
+            continue;
+        }
+        const double batch = time([&] { V::MulBatch(verts.AsSpan(), transform); });
+        same &= std::memcmp((const void*)verts.Data(), (const void*)reference.Data(), COUNT * sizeof(V)) == 0;
+        std::printf(" %-9.0f", MVertsPerSecond(batch));
+    }
+    std::printf(" %s\n", same ? "yes" : "NO");
+    Math::BatchTransform::UseLevel(Math::BatchTransform::BestLevel());
+}
+
+int main() {
+    Math::SplitMix64 rng { 0xBA7C };
+    Vec<VertexNormal3D> normal3D = Vec<VertexNormal3D>::WithCap(COUNT);
+    Vec<Vertex3D>       plain3D  = Vec<Vertex3D>::WithCap(COUNT);
+    Vec<VertexColor2D>  color2D  = Vec<VertexColor2D>::WithCap(COUNT);
+    Vec<UIVertex>       ui       = Vec<UIVertex>::WithCap(COUNT);
+    for (usize i = 0; i < COUNT; ++i) {
+        normal3D.Push({ RandomV3(rng), RandomV3(rng).Norm() });
+        plain3D.Push({ RandomV3(rng) });
+        color2D.Push({ RandomV2(rng), Math::fColor { 1, 0.5f, 0.25f, 1 } });
+        ui.Push({ RandomV2(rng), RandomV2(rng), Math::uColor { 255, 128, 64, 255 }, { 0, 0, 1, 1 }, (u32)(i % 4) });
+    }
+
+    const Math::MatrixTransform3D tf3D =
+        Math::Transform3D { { 1, -2, 3 }, { 1.5f, 0.75f, 2 }, Math::Rotor3D { 0.3_rad, -0.7_rad, 1.1_rad } }.TransformMatrix().AsTransform();
+    const Math::MatrixTransform2D tf2D =
+        Math::Transform2D { { 12, -4 }, { 2, 0.5f }, Math::Rotor2D { 0.6_rad } }.TransformMatrix().AsTransform();
+
+    std::printf("%zu vertices transformed in place, million vertices/s, best of 5\n", COUNT);
+    std::printf("  %-16s %-10s %-9s %-9s %-9s %s\n", "", "Mul", "scalar", "sse2", "avx2", "same bits");
+    Run("VertexNormal3D", normal3D, tf3D);
+    Run("Vertex3D", plain3D, tf3D);
+    Run("VertexColor2D", color2D, tf2D);
+    Run("UIVertex", ui, tf2D);
+    return 0;
+}
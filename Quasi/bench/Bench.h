@@ -0,0 +1,30 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+// a tiny harness for the benchmarks: times a loop and prints ns per op. nothing here fails,
+// the numbers are for reading (and for pasting into commit messages)
+namespace Quasi::Bench {
+    using Clock = std::chrono::steady_clock;
+
+    // keeps the optimizer from throwing away a result that nothing reads
+    template <class T> void Keep(const T& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+    // runs f() once and returns how many ns each of its ops took
+    template <class F> double NsPerOp(unsigned long long ops, F&& f) {
+        const Clock::time_point begin = Clock::now();
+        f();
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - begin;
+        return ops ? elapsed.count() / (double)ops : 0.0;
+    }
+
+    // the best of a few runs, the others are mostly noise from the rest of the machine
+    template <class F> double BestNsPerOp(unsigned long long ops, int runs, F&& f) {
+        double best = NsPerOp(ops, f);
+        for (int i = 1; i < runs; ++i) {
+            const double t = NsPerOp(ops, f);
+            if (t < best) best = t;
+        }
+        return best;
+    }
+}
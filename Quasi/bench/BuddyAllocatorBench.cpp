@@ -0,0 +1,84 @@
+#include "Bench.h"
+
+#include "GLs/BufferPool.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+using Block = BuddyAllocator::Block;
+
+// mostly small meshes with the occasional big one
+static u32 RandomCount(Math::SplitMix64& rng) {
+    return (u32)(1 + rng.Next64() % (rng.Next64() % 8 ? 512 : 16384));
+}
+
+static void Allocator() {
+    static constexpr u32 CAPACITY = 1 << 22, MIN_BLOCK = 64, OPS = 2'000'000;
+    BuddyAllocator alloc { CAPACITY, MIN_BLOCK };
+    Vec<Block> live;
+    Math::SplitMix64 rng { 0xF4A9 };
+
+    // held at about 3/4 full, with the fragmentation sampled along the way
+    double fragmentation = 0, worst = 0;
+    u32 failed = 0, samples = 0;
+    const double ns = Bench::NsPerOp(OPS, [&] {
+        for (u32 i = 0; i < OPS; ++i) {
+            if (live.IsEmpty() || alloc.UsedUnits() < CAPACITY / 4 * 3) {
+                if (const Option<Block> b = alloc.Allocate(RandomCount(rng))) live.Push(*b);
+                else ++failed;
+            } else {
+                const usize at = rng.Next64() % live.Length();
+                alloc.Free(live[at]);
+                live[at] = live.Last();
+                live.Pop();
+            }
+            if (i % 1024 == 0) {
+                fragmentation += alloc.Fragmentation();
+                worst = std::max(worst, (double)alloc.Fragmentation());
+                ++samples;
+            }
+        }
+    });
+
+    std::printf("buddy allocator, %u units, %u unit blocks, %u random ops at 3/4 load\n", CAPACITY, MIN_BLOCK, OPS);
+    std::printf("  %.1f ns per op, %u allocations didnt fit\n", ns, failed);
+    std::printf("  fragmentation %.2f on average, %.2f at worst\n", fragmentation / samples, worst);
+
+    Vec<Block> packed;
+    const double repack = Bench::NsPerOp(1, [&] { packed = alloc.Repack(live); });
+    std::printf("  repacking %zu blocks: %.2f ms, fragmentation %.2f after\n", packed.Length(), repack / 1e6, alloc.Fragmentation());
+}
+
+static void Pool() {
+    static constexpr u32 OPS = 200'000;
+    BufferPool pool = BufferPool::New<Vertex2D>(1 << 12, 3 << 12);
+    Vec<SlotKey> live;
+    Math::SplitMix64 rng { 0x9001 };
+
+    // grows until it settles at about 2000 meshes, then churns
+    const double ns = Bench::NsPerOp(OPS, [&] {
+        for (u32 i = 0; i < OPS; ++i) {
+            if (live.Length() < 2000 || rng.Next64() % 2) {
+                live.Push(pool.Allocate(RandomCount(rng), 3 * RandomCount(rng)));
+            } else {
+                const usize at = rng.Next64() % live.Length();
+                pool.Free(live[at]);
+                live[at] = live.Last();
+                live.Pop();
+            }
+        }
+    });
+
+    std::printf("buffer pool, %u random mesh allocs and frees, gl calls stubbed out\n", OPS);
+    std::printf("  %.1f ns per op, ended at %u vertices and %u indices\n", ns, pool.VertexCapacity(), pool.IndexCapacity());
+    const float before = pool.Fragmentation();
+    const double defrag = Bench::NsPerOp(1, [&] { pool.Defragment(); });
+    std::printf("  defragmenting %zu meshes: %.2f ms, fragmentation %.2f -> %.2f\n", pool.RangeCount(), defrag / 1e6, before, pool.Fragmentation());
+}
+
+int main() {
+    Allocator();
+    Pool();
+    return 0;
+}
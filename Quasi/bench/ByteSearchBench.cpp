@@ -0,0 +1,102 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "Utils/String.h"
+#include "Utils/Text/ByteSearch.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using Text::ByteSearch;
+
+static constexpr usize SIZE = 64 << 20;
+
+// lowercase words and spaces, a newline every 60 or so bytes. the searches look for things that arent in it,
+// so every one goes through the whole text
+static String MakeText() {
+    Math::SplitMix64 rng { 0xB17E };
+    String text = String::WithCap(SIZE);
+    usize line = 0;
+    while (text.Length() < SIZE) {
+        for (usize n = 1 + rng.Next64() % 10; n; --n) text += (char)('a' + rng.Next64() % 26);
+        line += 1;
+        text += line % 10 == 0 ? '\n' : ' ';
+    }
+    return text;
+}
+
+static double GBPerSecond(double ns) { return (double)SIZE / ns; }
+
+template <class F>
+static double Time(F&& search) { return GBPerSecond(Bench::BestNsPerOp(1, 5, [&] { Bench::Keep(search()); })); }
+
+// byte at a time, the way Str searched before ByteSearch
+struct Naive {
+    static usize FindChar(Str text, char c) {
+        for (usize i = 0; i < text.Length(); ++i) if (text[i] == c) return i;
+        return text.Length();
+    }
+    static usize CountChar(Str text, char c) {
+        usize n = 0;
+        for (usize i = 0; i < text.Length(); ++i) n += text[i] == c;
+        return n;
+    }
+    static usize FindOneOf(Str text, Str set) {
+        for (usize i = 0; i < text.Length(); ++i)
+            for (const char c : set) if (text[i] == c) return i;
+        return text.Length();
+    }
+    static usize FindStr(Str text, Str pat) {
+        for (usize i = 0; i + pat.Length() <= text.Length(); ++i)
+            if (std::memcmp(text.Data() + i, pat.Data(), pat.Length()) == 0) return i;
+        return text.Length();
+    }
+};
+
+int main() {
+    const String owned = MakeText();
+    const Str text = owned.AsStr().First(SIZE);
+    const std::string_view view { text.Data(), text.Length() };
+    static constexpr Str SET = "#@!", PATTERN = "needle!";
+
+    std::printf("%zu MB of words, GB/s, best of 5\n", SIZE >> 20);
+    std::printf("  %-11s %-8s %-8s %-8s %-8s %-12s %s\n", "", "naive", "swar", "sse2", "avx2", "libc/std", "same");
+
+    const auto row = [&] (const char* name, auto&& naive, auto&& search, auto&& library) {
+        const usize expected = naive();
+        std::printf("  %-11s %-8.2f", name, Time(naive));
+        bool same = true;
+        for (u32 level = ByteSearch::SCALAR; level <= ByteSearch::AVX2; ++level) {
+            ByteSearch::UseLevel((ByteSearch::Level)level);
+            if (ByteSearch::CurrentLevel() != level) {
+                std::printf(" %-8s", "-");
+                continue;
+            }
+            same &= search() == expected;
+            std::printf(" %-8.2f", Time(search));
+        }
+        ByteSearch::UseLevel(ByteSearch::BestLevel());
+        std::printf(" %-12.2f %s\n", Time(library), same ? "yes" : "NO");
+    };
+
+    row("FindChar",
+        [&] { return Naive::FindChar(text, '#'); },
+        [&] { return ByteSearch::FindChar(text, '#'); },
+        [&] { const void* p = std::memchr(text.Data(), '#', text.Length()); return p ? (usize)((const char*)p - text.Data()) : text.Length(); });
+    row("CountChar",
+        [&] { return Naive::CountChar(text, '\n'); },
+        [&] { return ByteSearch::CountChar(text, '\n'); },
+        [&] { return (usize)std::count(view.begin(), view.end(), '\n'); });
+    row("FindOneOf",
+        [&] { return Naive::FindOneOf(text, SET); },
+        [&] { return ByteSearch::FindOneOf(text, SET); },
+        [&] { return std::min(view.find_first_of(std::string_view { SET.Data(), SET.Length() }), view.size()); });
+    row("FindStr",
+        [&] { return Naive::FindStr(text, PATTERN); },
+        [&] { return ByteSearch::FindStr(text, PATTERN); },
+        [&] { return std::min(view.find(std::string_view { PATTERN.Data(), PATTERN.Length() }), view.size()); });
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "Bench.h"
+
+#include <charconv>
+
+#include "Utils/Text.h"
+#include "Utils/Text/Num.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+static constexpr usize COUNT = 1'000'000;
+
+template <class F>
+static Vec<F> RandomFloats(Math::SplitMix64& rng, bool anyBits) {
+    using Fs = NumInfo<F>;
+    Vec<F> floats = Vec<F>::WithCap(COUNT);
+    while (floats.Length() < COUNT) {
+        // either any finite bit pattern, or what a level or trace file is mostly full of
+        const F f = anyBits ? Fs::FromBits((decltype(Fs::BitsOf(F {})))rng.Next64())
+                            : (F)((f64)(rng.Next64() % 2000000) / 1000.0 - 1000.0);
+        if (Fs::IsFinite(f)) floats.Push(f);
+    }
+    return floats;
+}
+
+template <class F>
+static void Run(const char* name, Span<const F> floats) {
+    char buffer[64];
+    usize bytes = 0;
+    const double ours = Bench::BestNsPerOp(COUNT, 3, [&] {
+        bytes = 0;
+        for (const F f : floats) {
+            Span<char> rest = Span<char>::Slice(buffer, sizeof(buffer));
+            Text::FormatObjectTo(Text::StringWriter::WriteToBuffer(rest), f, Str::Empty());
+            bytes += sizeof(buffer) - rest.Length();
+            Bench::Keep(buffer[0]);
+        }
+    });
+    const usize ourBytes = bytes;
+    const double std = Bench::BestNsPerOp(COUNT, 3, [&] {
+        bytes = 0;
+        for (const F f : floats) {
+            const std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), f);
+            bytes += (usize)(r.ptr - buffer);
+            Bench::Keep(buffer[0]);
+        }
+    });
+    std::printf("  %-18s %-10.1f %-10.1f %.1f / %.1f\n", name, ours, std, (f64)ourBytes / COUNT, (f64)bytes / COUNT);
+}
+
+int main() {
+    Math::SplitMix64 rng { 0xF10A7 };
+    std::printf("shortest round trip formatting, %zu numbers, ns per number\n", COUNT);
+    std::printf("  %-18s %-10s %-10s %s\n", "", "quasi", "to_chars", "chars (quasi / to_chars)");
+    Run<f32>("f32, any bits",  RandomFloats<f32>(rng, true));
+    Run<f32>("f32, 3 decimals", RandomFloats<f32>(rng, false));
+    Run<f64>("f64, any bits",  RandomFloats<f64>(rng, true));
+    Run<f64>("f64, 3 decimals", RandomFloats<f64>(rng, false));
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "Bench.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+#include "Utils/CStr.h"
+#include "Utils/Text.h"
+#include "Utils/Text/Num.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+static constexpr usize COUNT = 2'000'000;
+
+// whitespace separated numbers like an obj file's v lines, or doubles anywhere from 1e-37 to 1e35 with all their digits
+static String Generate(Math::SplitMix64& rng, const char* fmt, bool wide) {
+    String text;
+    char buf[64];
+    for (usize i = 0; i < COUNT; ++i) {
+        const f64 f = wide ? f64s::FromBits((rng.Next64() & ~(0x7FFull << 52)) | (u64)(900 + rng.Next64() % 240) << 52)
+                              : (f64)(rng.Next64() % 2000000) / 1000.0 - 1000.0;
+        const int n = std::snprintf(buf, sizeof(buf), fmt, f);
+        text += Str::Slice(buf, (usize)n);
+        text += i % 3 == 2 ? '\n' : ' ';
+    }
+    return text;
+}
+
+static double MBPerSecond(usize bytes, double ns) { return (double)bytes / (1 << 20) / (ns / 1e9); }
+
+static bool IsSpace(char c) { return c == ' ' || c == '\n'; }
+
+template <class F>
+static void Run(const char* name, String& text) {
+    Vec<F> out = Vec<F>::WithSize(COUNT);
+    const CStr cstr = text.IntoCStr();
+    const char* const begin = cstr.Data(), *const end = begin + cstr.Length();
+
+    const double many = Bench::BestNsPerOp(1, 3, [&] {
+        Str rest = cstr;
+        Bench::Keep(Text::Parser<F>::ParseMany(rest, out.AsSpan()));
+    });
+    const double until = Bench::BestNsPerOp(1, 3, [&] {
+        Str rest = cstr;
+        for (F& f : out) {
+            while (rest && IsSpace(rest[0])) rest.Advance(1);
+            rest.Advance(Text::Parser<F>::ParseUntil(rest, f, {}).UnwrapOr(1));
+        }
+        Bench::Keep(out[COUNT - 1]);
+    });
+    const double strto = Bench::BestNsPerOp(1, 3, [&] {
+        char* p = const_cast<char*>(begin);
+        for (F& f : out) f = sizeof(F) == 4 ? std::strtof(p, &p) : std::strtod(p, &p);
+        Bench::Keep(out[COUNT - 1]);
+    });
+    const double fromChars = Bench::BestNsPerOp(1, 3, [&] {
+        const char* p = begin;
+        for (F& f : out) {
+            while (p != end && IsSpace(*p)) ++p;
+            p = std::from_chars(p, end, f).ptr;
+        }
+        Bench::Keep(out[COUNT - 1]);
+    });
+    std::printf("  %-22s %-11.0f %-11.0f %-11.0f %.0f\n", name, MBPerSecond(text.Length(), many), MBPerSecond(text.Length(), until),
+                MBPerSecond(text.Length(), strto), MBPerSecond(text.Length(), fromChars));
+    text.TruncNullTerm();
+}
+
+int main() {
+    Math::SplitMix64 rng { 0xF1A75 };
+    String fixed = Generate(rng, "%.3f", false), obj = Generate(rng, "%.6f", false), any = Generate(rng, "%.17g", true);
+    std::printf("%zu whitespace separated numbers, MB/s, best of 3\n", COUNT);
+    std::printf("  %-22s %-11s %-11s %-11s %s\n", "", "ParseMany", "ParseUntil", "strtod", "from_chars");
+    Run<f32>("f32, %.3f", fixed);
+    Run<f32>("f32, %.6f (obj)", obj);
+    Run<f64>("f64, %.6f (obj)", obj);
+    Run<f64>("f64, %.17g", any);
+    return 0;
+}
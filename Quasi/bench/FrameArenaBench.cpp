@@ -0,0 +1,72 @@
+#include "Bench.h"
+
+#include "GraphicsDevice.h"
+#include "SpriteInstancer.h"
+#include "GLs/Texture.h"
+#include "Utils/Math/Random.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+// every heap allocation in the program goes through here, so a frame's share can be read off the difference
+static usize HeapAllocations = 0;
+
+void* operator new(std::size_t size) {
+    ++HeapAllocations;
+    if (void* mem = std::malloc(size ? size : 1)) return mem;
+    throw std::bad_alloc {};
+}
+void operator delete(void* mem) noexcept { std::free(mem); }
+void operator delete(void* mem, std::size_t) noexcept { std::free(mem); }
+
+static constexpr u32 FRAMES = 200, SPRITES = 3000, SCRATCH_VECS = 64;
+
+struct FrameCounts { double heap, arena, ns; };
+
+// a headless frame: enough sprites for three instanced draws, and a pile of short lived scratch lists
+// the way gameplay code would make them, with or without the frame arena underneath
+static FrameCounts RunFrames(GraphicsDevice& device, SpriteInstancer& sprites, const Texture2D& texture, bool scratchInArena) {
+    Math::SplitMix64 rng { 0xA4E7A };
+    usize heap = 0, arena = 0;
+    const double ns = Bench::NsPerOp(FRAMES, [&] {
+        for (u32 f = 0; f < FRAMES; ++f) {
+            const usize before = HeapAllocations;
+            for (u32 i = 0; i < SPRITES; ++i) sprites.Push(SpriteInstance {}, (f32)(rng.Next64() % 64), (u8)(i % 3));
+            sprites.Draw(texture);
+            {
+                Memory::ArenaScope scope { scratchInArena ? &device.GetFrameArena() : nullptr };
+                for (u32 v = 0; v < SCRATCH_VECS; ++v) {
+                    Vec<u32> picked;
+                    for (u64 n = rng.Next64() % 256; n --> 0; ) picked.Push((u32)n);
+                    Bench::Keep(picked.Length());
+                }
+            }
+            heap += HeapAllocations - before;
+            arena += device.GetFrameArena().AllocationCount();
+            device.End();
+        }
+    });
+    return { (double)heap / FRAMES, (double)arena / FRAMES, ns };
+}
+
+int main() {
+    // no window, and every gl call lands in the stub
+    GraphicsDevice device { nullptr, { 640, 480 } };
+    SpriteInstancer sprites;
+    sprites.CreateRender(device, 1024);
+    const Texture2D texture = Texture2D::New(nullptr, { 64, 64 });
+
+    // the first frames fill the shader's uniform cache and grow the sprite buffers, which isnt what this counts
+    RunFrames(device, sprites, texture, false);
+
+    std::printf("%u headless frames, %u sprites and %u scratch Vecs each\n", FRAMES, SPRITES, SCRATCH_VECS);
+    std::printf("  %-18s %-14s %-14s %s\n", "scratch from", "heap / frame", "arena / frame", "us / frame");
+    for (const bool inArena : { false, true }) {
+        const FrameCounts c = RunFrames(device, sprites, texture, inArena);
+        std::printf("  %-18s %-14.1f %-14.1f %.1f\n", inArena ? "frame arena" : "heap", c.heap, c.arena, c.ns / 1e3);
+    }
+    return 0;
+}
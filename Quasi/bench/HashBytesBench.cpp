@@ -0,0 +1,43 @@
+#include "Bench.h"
+
+#include "Utils/Hash.h"
+#include "Utils/Vec.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+static constexpr usize BUFFER_SIZE = 4 << 20, BYTES_PER_SIZE = 256 << 20;
+
+// hashes keys of one size from all over the buffer, and sums the hashes so none are thrown away.
+// every key starts somewhere else, so short keys arent all the same few bytes
+template <class F>
+static double NsPerHash(Span<const byte> buffer, usize size, F&& hash) {
+    const usize count = std::max<usize>(BYTES_PER_SIZE / size / 16, 1 << 16), span = buffer.Length() - size;
+    return Bench::BestNsPerOp(count, 3, [&] {
+        u64 sum = 0;
+        for (usize i = 0, offset = 0; i < count; ++i) {
+            offset = (offset + size * 7 + 13) % span;
+            sum += (u64)hash(buffer.Subspan(offset, size));
+        }
+        Bench::Keep(sum);
+    });
+}
+
+int main() {
+    Vec<byte> buffer = Vec<byte>::WithSize(BUFFER_SIZE);
+    Math::SplitMix64 rng { 0x4A54 };
+    for (byte& b : buffer) b = (byte)rng.Next64();
+
+    std::printf("HashBytes throughput, keys from a %zu MB buffer, best of 3\n", BUFFER_SIZE >> 20);
+    std::printf("  %-8s %-12s %-12s %-12s %-12s %s\n", "bytes", "murmur ns", "rapid ns", "murmur GB/s", "rapid GB/s", "rapid / murmur");
+    for (usize size = 4; size <= 64 << 10; size *= 2) {
+        const double murmur = NsPerHash(buffer, size, [] (Span<const byte> b) { return Hashing::HashBytesMurmur(b); });
+        const double rapid  = NsPerHash(buffer, size, [] (Span<const byte> b) { return Hashing::HashBytesRapid(b); });
+        char label[16];
+        if (size < 1024) std::snprintf(label, sizeof(label), "%zu", size);
+        else std::snprintf(label, sizeof(label), "%zuK", size >> 10);
+        std::printf("  %-8s %-12.2f %-12.2f %-12.2f %-12.2f %.2fx\n", label, murmur, rapid,
+                    (double)size / murmur, (double)size / rapid, murmur / rapid);
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "Bench.h"
+
+#include "Utils/HashMap.h"
+#include "Utils/String.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+// HashMap without Q_HASHMAP_SWISS, named here so the comparison doesnt depend on how this is built
+template <class K, class V>
+using RobinMap = HashTable<sizeof(KeyValuePair<K, V>) <= sizeof(usize) * 6, K, V, Hashing::DefaultHasher>;
+
+struct MapTimes { double load, insert, hit, miss, erase; };
+
+template <class Map>
+static MapTimes RunU64(Span<const u64> keys, Span<const u64> missing) {
+    const usize n = keys.Length();
+    MapTimes t {};
+    Map map;
+    t.insert = Bench::NsPerOp(n, [&] {
+        for (usize i = 0; i < n; ++i) map.Insert(keys[i], (u32)i);
+    });
+    t.load = map.LoadFactor();
+    t.hit = Bench::BestNsPerOp(n, 3, [&] {
+        u64 sum = 0;
+        for (usize i = n; i --> 0; ) sum += *map.Get(keys[i]);
+        Bench::Keep(sum);
+    });
+    t.miss = Bench::BestNsPerOp(n, 3, [&] {
+        usize found = 0;
+        for (usize i = 0; i < n; ++i) found += map.Get(missing[i]).HasValue();
+        Bench::Keep(found);
+    });
+    t.erase = Bench::NsPerOp(n, [&] {
+        usize removed = 0;
+        for (usize i = 0; i < n; ++i) removed += map.Remove(keys[i]);
+        Bench::Keep(removed);
+    });
+    return t;
+}
+
+template <class Map>
+static Tuple<double, double> RunStrings(Span<const String> keys, Span<const String> missing) {
+    const usize n = keys.Length();
+    Map map;
+    for (usize i = 0; i < n; ++i) map.Insert(keys[i], (u32)i);
+    const double hit = Bench::BestNsPerOp(n, 3, [&] {
+        u64 sum = 0;
+        for (usize i = 0; i < n; ++i) sum += *map.Get(keys[i].AsStr());
+        Bench::Keep(sum);
+    });
+    const double miss = Bench::BestNsPerOp(n, 3, [&] {
+        usize found = 0;
+        for (usize i = 0; i < n; ++i) found += map.Get(missing[i].AsStr()).HasValue();
+        Bench::Keep(found);
+    });
+    return { hit, miss };
+}
+
+int main() {
+    Math::SplitMix64 rng { 0xB0BA };
+
+    // the sizes sit just under and just over the points where each table grows
+    static constexpr usize SIZES[] = { 1'000, 100'000, 450'000, 700'000, 900'000, 4'000'000 };
+    std::printf("random u64 keys, ns per op, robin / swiss\n");
+    std::printf("  %-8s %-12s %-14s %-14s %-14s %s\n", "n", "load", "insert", "hit", "miss", "erase");
+    for (const usize n : SIZES) {
+        Vec<u64> keys = Vec<u64>::WithCap(n), missing = Vec<u64>::WithCap(n);
+        for (usize i = 0; i < n; ++i) keys.Push(rng.Next64());
+        for (usize i = 0; i < n; ++i) missing.Push(rng.Next64());
+
+        const MapTimes r = RunU64<RobinMap<u64, u32>>(keys, missing),
+                       s = RunU64<SwissMap<u64, u32>>(keys, missing);
+        std::printf("  %-8zu %.2f/%.2f    %6.1f/%-6.1f  %6.1f/%-6.1f  %6.1f/%-6.1f  %6.1f/%.1f\n",
+            n, r.load, s.load, r.insert, s.insert, r.hit, s.hit, r.miss, s.miss, r.erase, s.erase);
+    }
+
+    // string keys, looked up by Str so nothing gets allocated for the lookup
+    static constexpr usize STRING_COUNT = 50'000;
+    Vec<String> keys, missing;
+    for (usize i = 0; i < STRING_COUNT; ++i) {
+        char buf[32];
+        const int len = std::snprintf(buf, sizeof(buf), "key_%016llx", (unsigned long long)rng.Next64());
+        keys.Push(String::FromStr(Str::Slice(buf, len)));
+        buf[0] = 'K';
+        missing.Push(String::FromStr(Str::Slice(buf, len)));
+    }
+    const auto [rhit, rmiss] = RunStrings<RobinMap<String, u32>>(keys, missing);
+    const auto [shit, smiss] = RunStrings<SwissMap<String, u32>>(keys, missing);
+    std::printf("string keys, %zu: Str hit %.1f/%.1f, Str miss %.1f/%.1f\n", STRING_COUNT, rhit, shit, rmiss, smiss);
+    return 0;
+}
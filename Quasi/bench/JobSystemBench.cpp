@@ -0,0 +1,96 @@
+#include "Bench.h"
+
+#include "Utils/JobSystem.h"
+#include "Utils/Vec.h"
+
+using namespace Quasi;
+using namespace Quasi::Jobs;
+
+static constexpr u32 JOBS = 1 << 16, FORK_DEPTH = 14;
+
+// about a microsecond of arithmetic the optimizer cant skip
+static u64 Work(u64 x, u32 rounds) {
+    for (u32 i = 0; i < rounds; ++i) {
+        x += 0x9E3779B97F4A7C15;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+        x ^= x >> 31;
+    }
+    return x;
+}
+
+// a binary tree of jobs, every node forks both halves and waits on them, the leaves do the work
+struct ForkJoin {
+    JobSystem* system;
+    std::atomic<u64>* sum;
+    u32 depth, rounds;
+    u64 seed;
+
+    void operator()() const {
+        if (depth == 0) {
+            sum->fetch_add(Work(seed, rounds), std::memory_order_relaxed);
+            return;
+        }
+        JobCounter children;
+        system->Schedule(ForkJoin { system, sum, depth - 1, rounds, seed * 2 }, &children);
+        system->Schedule(ForkJoin { system, sum, depth - 1, rounds, seed * 2 + 1 }, &children);
+        system->Wait(children);
+    }
+};
+
+struct Result { double scheduleNs, forNs, forkEmptyNs, forkWorkMs, forWorkMs; };
+
+static Result Measure(u32 workers) {
+    JobSystem system { workers };
+    Result r {};
+    std::atomic<u64> sum = 0;
+
+    // empty jobs, so this is what scheduling, running and finishing one costs
+    r.scheduleNs = Bench::BestNsPerOp(JOBS, 5, [&] {
+        JobCounter done;
+        for (u32 i = 0; i < JOBS; ++i) system.Schedule([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &done);
+        system.Wait(done);
+    });
+    r.forNs = Bench::BestNsPerOp(JOBS, 5, [&] {
+        system.ParallelFor(0, JOBS, 1, [&] (usize i) { sum.fetch_add(i, std::memory_order_relaxed); });
+    });
+    r.forkEmptyNs = Bench::BestNsPerOp((2ull << FORK_DEPTH) - 1, 5, [&] {
+        JobCounter root;
+        system.Schedule(ForkJoin { &system, &sum, FORK_DEPTH, 0, 1 }, &root);
+        system.Wait(root);
+    });
+
+    // the same shapes with real work in them, for how it scales
+    r.forkWorkMs = Bench::BestNsPerOp(1, 3, [&] {
+        JobCounter root;
+        system.Schedule(ForkJoin { &system, &sum, FORK_DEPTH, 256, 1 }, &root);
+        system.Wait(root);
+    }) / 1e6;
+    r.forWorkMs = Bench::BestNsPerOp(1, 3, [&] {
+        system.ParallelFor(0, 1 << FORK_DEPTH, 64, [&] (usize i) { sum.fetch_add(Work(i, 256), std::memory_order_relaxed); });
+    }) / 1e6;
+
+    Bench::Keep(sum.load());
+    return r;
+}
+
+int main() {
+    const u32 hardware = std::thread::hardware_concurrency(), most = std::max(JobSystem::DefaultWorkerCount(), 1u);
+    std::printf("JobSystem, %u hardware threads, best of 5 (3 for the ms columns)\n", hardware);
+    std::printf("  %-8s %-12s %-12s %-12s %-16s %-16s\n", "workers", "job ns", "for ns/item", "fork ns/job", "fork+work ms", "for+work ms");
+
+    // 0, then doubling, always ending on every worker
+    Vec<u32> counts;
+    counts.Push(0);
+    for (u32 w = 1; w < most; w *= 2) counts.Push(w);
+    counts.Push(most);
+
+    Result serial {};
+    for (const u32 workers : counts) {
+        const Result r = Measure(workers);
+        if (workers == 0) serial = r;
+        std::printf("  %-8u %-12.1f %-12.1f %-12.1f %-6.2f (%.2fx)    %-6.2f (%.2fx)\n", workers, r.scheduleNs, r.forNs, r.forkEmptyNs,
+                    r.forkWorkMs, serial.forkWorkMs / r.forkWorkMs, r.forWorkMs, serial.forWorkMs / r.forWorkMs);
+    }
+    if (hardware <= 1) std::printf("  only one hardware thread, the workers take turns on it so nothing here scales\n");
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "Bench.h"
+
+#include <filesystem>
+
+#include "ModelLoading/LevelLoader.h"
+#include "Utils/CStr.h"
+#include "Utils/Text/Json.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using Text::JsonIndexer;
+
+static constexpr usize TARGET_SIZE = 100 << 20;
+
+// a level shaped like the ones in res/levels, just a lot bigger
+static String GenerateLevel() {
+    String json = "{\n  \"LevelName\": \"bench\",\n  \"Description\": \"generated \\\"big\\\" level\",\n  \"Tiles\": [\n";
+    Math::SplitMix64 rng { 0xB16 };
+    for (u32 i = 0; json.Length() < TARGET_SIZE; ++i) {
+        const int x = (int)(rng.Next64() % 20001) - 10000, y = (int)(rng.Next64() % 64) - 32, z = (int)(rng.Next64() % 20001) - 10000;
+        Text::FormatTo(Text::StringWriter::WriteTo(json), "{}    {{ \"Position\": [{}, {}, {}], \"Type\": {} }}"_fmt,
+                       i ? Str { ",\n" } : Str {}, x, y, z, rng.Next64() % 12);
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+static double MBPerSecond(usize bytes, double ns) { return (double)bytes / (1 << 20) / (ns / 1e9); }
+
+int main() {
+    const String json = GenerateLevel();
+    const f64 mb = (f64)json.Length() / (1 << 20);
+    std::printf("a %.1f MB level, best of 3\n", mb);
+
+    std::printf("  %-10s %-16s %s\n", "kernel", "stage 1 MB/s", "full parse MB/s");
+    for (const JsonIndexer::Level level : { JsonIndexer::SCALAR, JsonIndexer::SSE2, JsonIndexer::AVX2 }) {
+        if (level > JsonIndexer::BestLevel()) continue;
+        JsonIndexer::UseLevel(level);
+        Vec<u32> structurals = Vec<u32>::WithCap(json.Length() / 4);
+        const double index = Bench::BestNsPerOp(1, 3, [&] {
+            structurals.Clear();
+            Bench::Keep(JsonIndexer::Index(json, structurals));
+        });
+        Text::JsonParser parser;
+        const double parse = Bench::BestNsPerOp(1, 3, [&] {
+            const Option<Text::JsonDocument> doc = parser.Parse(json);
+            Bench::Keep(doc->TapeLength());
+        });
+        std::printf("  %-10s %-16.0f %.0f\n", JsonIndexer::LevelName(level).Data(), MBPerSecond(json.Length(), index), MBPerSecond(json.Length(), parse));
+    }
+    JsonIndexer::UseLevel(JsonIndexer::BestLevel());
+
+    Graphics::LevelLoader loader;
+    loader.UseCache(false);
+    const double load = Bench::BestNsPerOp(1, 3, [&] { Bench::Keep(loader.Load(json)); });
+    const Graphics::LevelData& level = loader.GetLevel();
+    std::printf("  json -> LevelData: %.0f ms (%.0f MB/s), %zu tiles\n", load / 1e6, MBPerSecond(json.Length(), load), level.tiles.Length());
+
+    // the .qlevel for the same level, against a made up source so nothing has to hit the json file
+    const std::string path = (std::filesystem::temp_directory_path() / "QuasiJsonBench.qlevel").string();
+    const CStr cachePath = CStr::FromUnchecked(Str::Slice(path.data(), path.size()));
+    const Text::FileInfo source { .size = json.Length(), .lastModified = 1 };
+    const double write = Bench::BestNsPerOp(1, 3, [&] { Bench::Keep(Graphics::LevelCache::Write(cachePath, level, source)); });
+    Graphics::LevelData fromCache;
+    const double read = Bench::BestNsPerOp(1, 3, [&] {
+        const Graphics::LevelCache cache = Graphics::LevelCache::Open(cachePath, source);
+        cache.LoadInto(fromCache);
+    });
+    std::printf("  .qlevel: write %.0f ms, open and copy out %.0f ms, %zu tiles\n", write / 1e6, read / 1e6, fromCache.tiles.Length());
+    std::filesystem::remove(path);
+    return 0;
+}
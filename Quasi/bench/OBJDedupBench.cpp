@@ -0,0 +1,92 @@
+#include "Bench.h"
+
+#include "ModelLoading/OBJModelLoader.h"
+#include "Utils/Algorithm.h"
+#include "Utils/Comparison.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+using Loader = OBJModelLoader;
+
+static constexpr int SIZE = 1024;
+
+// a SIZE x SIZE grid, already parsed, as one object. smooth meshes share one v/t/n triple
+// between every face around a vertex, hard edged ones give each quad its own normal
+static Loader::ParsedChunk HighPoly(bool hardEdges) {
+    Loader::ParsedChunk chunk;
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x) {
+            chunk.vertex.Push({ (f32)x, (f32)y, (f32)((x ^ y) & 7) });
+            chunk.vertexTexture.Push({ (f32)x / SIZE, (f32)y / SIZE });
+            chunk.vertexNormal.Push({ 0, 0, 1 });
+        }
+
+    Loader::OBJProperty object = { Empty {} };
+    object.Set(Loader::Object { "grid" });
+    chunk.properties.Push({ 0, std::move(object) });
+
+    for (int y = 0; y < SIZE - 1; ++y)
+        for (int x = 0; x < SIZE - 1; ++x) {
+            const int quad[4] = { y * SIZE + x + 1, y * SIZE + x + 2, (y + 1) * SIZE + x + 2, (y + 1) * SIZE + x + 1 };
+            const int n = hardEdges ? quad[0] : 0;
+            for (const auto& tri : { Math::iv3 { 0, 1, 2 }, Math::iv3 { 0, 2, 3 } }) {
+                Loader::Face f;
+                for (u32 c = 0; c < 3; ++c) {
+                    const int v = quad[tri[c]];
+                    f.indices[c][0] = v; f.indices[c][1] = v; f.indices[c][2] = n ? n : v;
+                }
+                chunk.faces.Push(f);
+            }
+        }
+    return chunk;
+}
+
+// the dedup ResolveObjectIndices used to do: sort every triple, drop duplicates, binary search each corner back
+static Mesh<OBJVertex> SortedDedup(const Loader::ParsedChunk& chunk) {
+    struct Cmp3 {
+        Comparison operator()(const Math::iv3& a, const Math::iv3& b) const {
+            return a.x != b.x ? Cmp::Between(a.x, b.x) : a.y != b.y ? Cmp::Between(a.y, b.y) : Cmp::Between(a.z, b.z);
+        }
+    };
+    Vec<Math::iv3> indices;
+    for (const Loader::Face& f : chunk.faces)
+        for (const auto& [v, t, n] : f.indices) indices.Push({ v, t, n });
+    indices.SortBy(Cmp3 {});
+    indices.RemoveDups();
+
+    Mesh<OBJVertex> mesh;
+    mesh.vertices = indices.MapEach([&] (const Math::iv3& triple) {
+        return OBJVertex { chunk.vertex[triple.x - 1], chunk.vertexTexture[triple.y - 1], chunk.vertexNormal[triple.z - 1] };
+    });
+    mesh.indices.Reserve(chunk.faces.Length());
+    for (const Loader::Face& f : chunk.faces) {
+        u32 tri[3];
+        for (u32 c = 0; c < 3; ++c) {
+            const Math::iv3 corner { f.indices[c][0], f.indices[c][1], f.indices[c][2] };
+            tri[c] = (u32)indices.BinarySearchWith([&] (const Math::iv3& x) { return Cmp3 {}(x, corner); }).Get<1>();
+        }
+        mesh.indices.Push({ tri[0], tri[1], tri[2] });
+    }
+    return mesh;
+}
+
+int main() {
+    std::printf("deduplicating a %dx%d grid (%d triangles), ms per mesh\n", SIZE, SIZE, 2 * (SIZE - 1) * (SIZE - 1));
+    std::printf("  %-12s %-10s %-10s %s\n", "", "hash map", "sorted", "vertices (hash / sorted)");
+    for (const bool hardEdges : { false, true }) {
+        const Loader::ParsedChunk chunk = HighPoly(hardEdges);
+        usize hashVertices = 0, sortedVertices = 0;
+        // CreateModelFromChunks also copies the chunk's arrays into the loader, which is a small part of this
+        const double hash = Bench::BestNsPerOp(1, 3, [&] {
+            Loader loader;
+            loader.CreateModelFromChunks(Span<const Loader::ParsedChunk>::Only(chunk));
+            hashVertices = loader.GetModel().objects[0].mesh.vertices.Length();
+        });
+        const double sorted = Bench::BestNsPerOp(1, 3, [&] {
+            const Mesh<OBJVertex> mesh = SortedDedup(chunk);
+            sortedVertices = mesh.vertices.Length();
+        });
+        std::printf("  %-12s %-10.1f %-10.1f %zu / %zu\n", hardEdges ? "hard edges" : "smooth", hash / 1e6, sorted / 1e6, hashVertices, sortedVertices);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "Bench.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+#include "ModelLoading/OBJModelLoader.h"
+#include "Utils/CStr.h"
+#include "Utils/Text.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+using Loader = OBJModelLoader;
+
+static constexpr int SIZE = 1024;
+
+// a SIZE x SIZE grid with texture coordinates and a few normals, split into 8 objects. about 140 MB
+static String Generate() {
+    // the first object comes before any geometry, like exporters write it
+    String s = "o part0\n";
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x) {
+            Text::FormatTo(Text::StringWriter::WriteTo(s), "v {} {} {}\n"_fmt, (f32)x / 8, (f32)y / 8, (f32)((x * 7 + y * 3) % 16) / 4);
+            Text::FormatTo(Text::StringWriter::WriteTo(s), "vt {} {}\n"_fmt, (f32)(x + 1) / 256, (f32)(y + 1) / 256);
+        }
+    s += "vn 1 0 0\nvn 0 1 0\nvn 0 0 1\nvn 0 0 -1\n";
+    for (int y = 0; y < SIZE - 1; ++y) {
+        if (y % (SIZE / 8) == 0 && y != 0) Text::FormatTo(Text::StringWriter::WriteTo(s), "o part{}\n"_fmt, y / (SIZE / 8));
+        for (int x = 0; x < SIZE - 1; ++x) {
+            const int a = y * SIZE + x + 1, b = a + 1, c = a + SIZE + 1, d = a + SIZE, n = (x + y) % 4 + 1;
+            Text::FormatTo(Text::StringWriter::WriteTo(s), "f {}/{}/{} {}/{}/{} {}/{}/{}\n"_fmt, a, a, n, b, b, n, c, c, n);
+            Text::FormatTo(Text::StringWriter::WriteTo(s), "f {}/{}/{} {}/{}/{} {}/{}/{}\n"_fmt, a, a, n, c, c, n, d, d, n);
+        }
+    }
+    return s;
+}
+
+struct Counts {
+    usize objects = 0, vertices = 0, indices = 0;
+    bool operator==(const Counts&) const = default;
+};
+
+static Counts CountsOf(const OBJModel& model) {
+    Counts c { .objects = model.objects.Length() };
+    for (const OBJObject& o : model.objects) {
+        c.vertices += o.mesh.vertices.Length();
+        c.indices  += o.mesh.indices.Length();
+    }
+    return c;
+}
+
+// ms for the best of 3 loads, and what the last one made
+template <class F>
+static double LoadMs(Counts& counts, F&& load) {
+    return Bench::BestNsPerOp(1, 3, [&] {
+        Loader loader;
+        load(loader);
+        counts = CountsOf(loader.GetModel());
+    }) / 1e6;
+}
+
+int main() {
+    const std::string path = (std::filesystem::temp_directory_path() / "QuasiOBJLoadBench.obj").string();
+    const CStr file = path.c_str();
+    const String source = Generate();
+    if (!Text::WriteFile(file, source)) {
+        std::printf("couldn't write %s\n", path.c_str());
+        return 1;
+    }
+    String cachePath = OBJModelCache::CachePathOf(file);
+    const double mb = (double)source.Length() / (1 << 20);
+    const u32 hardware = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::printf("loading a %.0f MB obj (%dx%d grid), best of 3, %u hardware threads\n", mb, SIZE, SIZE, hardware);
+    std::printf("  %-40s %-10s %-10s %s\n", "", "ms", "MB/s", "same model");
+
+    Counts expected, counts;
+    const auto print = [&] (const char* name, double ms) {
+        std::printf("  %-40s %-10.1f %-10.1f %s\n", name, ms, mb / (ms / 1e3), counts == expected ? "yes" : "NO");
+    };
+
+    // what LoadFile did before: read the whole file into a String, then parse it line by line on one thread
+    const double serial = LoadMs(expected, [&] (Loader& l) { l.Load(Text::ReadFile(file).Assert()); });
+    counts = expected;
+    print("ReadFile + Load (the old LoadFile)", serial);
+
+    const double parseOnly = Bench::BestNsPerOp(1, 3, [&] {
+        Loader::ParsedChunk chunk;
+        Loader::ParseChunk(source, chunk);
+        Bench::Keep(chunk.faces.Length());
+    }) / 1e6;
+    std::printf("  %-40s %-10.1f %-10.1f\n", "ParseChunk alone, one thread", parseOnly, mb / (parseOnly / 1e3));
+
+    for (u32 threads = 1;; threads = std::min(threads * 2, hardware)) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "mapped LoadFile, %u thread%s", threads, threads == 1 ? "" : "s");
+        print(name, LoadMs(counts, [&] (Loader& l) { l.UseCache(false); l.LoadFile(file, threads); }));
+        if (threads == hardware) break;
+    }
+
+    // the first load writes the binary cache next to the file, every one after reads it back
+    std::remove(cachePath.IntoCStr().Data());
+    counts = {};
+    Loader writer;
+    const double write = Bench::NsPerOp(1, [&] { writer.LoadFile(file); }) / 1e6;
+    counts = CountsOf(writer.GetModel());
+    print("LoadFile, writing the cache", write);
+    print("LoadFile, from the cache", LoadMs(counts, [&] (Loader& l) { l.LoadFile(file); }));
+
+    std::remove(cachePath.IntoCStr().Data());
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "Bench.h"
+
+#include <random>
+
+#include "Utils/Vec.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using Math::RandomGenerator;
+
+static constexpr usize SAMPLES = 1 << 24, FILL_SIZE = 1 << 14;
+
+struct Row { double raw, f32s, ints, fillF32, fillU32; };
+
+// ns per sample. each loop sums what it draws so nothing gets thrown away
+template <class Raw, class Float, class Int, class FillF, class FillU>
+static Row Measure(Raw&& raw, Float&& f, Int&& i, FillF&& fillF32, FillU&& fillU32) {
+    Row r {};
+    r.raw  = Bench::BestNsPerOp(SAMPLES, 3, [&] { u64 sum = 0; for (usize n = 0; n < SAMPLES; ++n) sum += raw(); Bench::Keep(sum); });
+    r.f32s = Bench::BestNsPerOp(SAMPLES, 3, [&] { f32 sum = 0; for (usize n = 0; n < SAMPLES; ++n) sum += f(); Bench::Keep(sum); });
+    r.ints = Bench::BestNsPerOp(SAMPLES, 3, [&] { u64 sum = 0; for (usize n = 0; n < SAMPLES; ++n) sum += i(); Bench::Keep(sum); });
+
+    Vec<f32> floats = Vec<f32>::WithSize(FILL_SIZE);
+    Vec<u32> ints   = Vec<u32>::WithSize(FILL_SIZE);
+    r.fillF32 = Bench::BestNsPerOp(SAMPLES, 3, [&] {
+        for (usize n = 0; n < SAMPLES; n += FILL_SIZE) { fillF32(floats.AsSpan()); Bench::Keep(floats[n % FILL_SIZE]); }
+    });
+    r.fillU32 = Bench::BestNsPerOp(SAMPLES, 3, [&] {
+        for (usize n = 0; n < SAMPLES; n += FILL_SIZE) { fillU32(ints.AsSpan()); Bench::Keep(ints[n % FILL_SIZE]); }
+    });
+    return r;
+}
+
+static void Print(const char* name, const Row& r) {
+    std::printf("  %-22s %-8.2f %-8.2f %-9.2f %-10.2f %.2f\n", name, r.raw, r.f32s, r.ints, r.fillF32, r.fillU32);
+}
+
+static Row MeasureEngine(RandomGenerator::Engine engine) {
+    RandomGenerator rg { engine, 0x5EED };
+    return Measure([&] { return rg.GetRaw(); },
+                   [&] { return rg.Get<f32>(); },
+                   [&] { return rg.Get<int>(0, 100); },
+                   [&] (Span<f32> out) { rg.Fill(out); },
+                   [&] (Span<u32> out) { rg.Fill(out); });
+}
+
+int main() {
+    std::printf("ns per sample, %zu samples, best of 3\n", SAMPLES);
+    std::printf("  %-22s %-8s %-8s %-9s %-10s %s\n", "", "raw u32", "f32", "[0,100)", "Fill f32", "Fill u32");
+
+    // what RandomGenerator used to be: an mt19937 and a std distribution made on every call
+    std::mt19937 mt { 0x5EED };
+    Print("mt19937 (old)", Measure(
+        [&] { return mt(); },
+        [&] { return std::uniform_real_distribution<f32> { 0, 1 } (mt); },
+        [&] { return std::uniform_int_distribution<int> { 0, 99 } (mt); },
+        [&] (Span<f32> out) { for (f32& x : out) x = std::uniform_real_distribution<f32> { 0, 1 } (mt); },
+        [&] (Span<u32> out) { for (u32& x : out) x = (u32)mt(); }));
+
+    Print("xoshiro256++", MeasureEngine(RandomGenerator::XOSHIRO256PP));
+    Print("pcg32",        MeasureEngine(RandomGenerator::PCG32));
+    Print("wyrand",       MeasureEngine(RandomGenerator::WYRAND));
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "Bench.h"
+
+#include "GraphicsDevice.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+static constexpr usize COUNT = 100'000;
+
+using Renders = Vec<RenderObject<Vertex2D>>;
+
+static double CreateAll(GraphicsDevice& device, Renders& renders) {
+    return Bench::NsPerOp(COUNT, [&] {
+        // small buffers, so the time is the device's bookkeeping and not allocating vertex data
+        for (usize i = 0; i < COUNT; ++i) renders.Push(device.CreateNewRender<Vertex2D>(4, 2));
+    });
+}
+
+static double DestroyAll(Renders& renders) {
+    const double t = Bench::NsPerOp(COUNT, [&] {
+        for (RenderObject<Vertex2D>& r : renders) r.Destroy();
+    });
+    renders.Clear();
+    return t;
+}
+
+int main() {
+    // no window, and every gl call lands in the stub
+    GraphicsDevice device { nullptr, { 640, 480 } };
+    Math::SplitMix64 rng { 0x4E4D };
+    Renders renders = Renders::WithCap(COUNT);
+
+    std::printf("%zu render objects, ns per op\n", COUNT);
+    std::printf("  %-14s %-8s %s\n", "destroyed", "create", "destroy");
+
+    // the old Vec of renders shifted and reindexed everything after a deleted render, so oldest first was its worst case
+    double create = CreateAll(device, renders);
+    std::printf("  %-14s %-8.1f %.1f\n", "oldest first", create, DestroyAll(renders));
+
+    // the slots are all free now, so this creates into reused slots
+    create = CreateAll(device, renders);
+    for (usize i = 0, j = renders.Length() - 1; i < j; ++i, --j) std::swap(renders[i], renders[j]);
+    std::printf("  %-14s %-8.1f %.1f\n", "newest first", create, DestroyAll(renders));
+
+    create = CreateAll(device, renders);
+    for (usize i = renders.Length() - 1; i > 0; --i) std::swap(renders[i], renders[rng.Next64() % (i + 1)]);
+    std::printf("  %-14s %-8.1f %.1f\n", "random", create, DestroyAll(renders));
+
+    return 0;
+}
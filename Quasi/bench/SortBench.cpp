@@ -0,0 +1,82 @@
+#include "Bench.h"
+
+#include <algorithm>
+
+#include "Utils/Algorithm.h"
+#include "Utils/ParallelSort.h"
+#include "Utils/Vec.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+// bigger than a key, smaller than a cache line, sorted by one float in it. what a broadphase or particle sort moves around
+struct Particle {
+    f32 x, y, z, depth;
+    u32 id, flags;
+    u64 extra;
+};
+
+// the sort runs on a fresh copy each time, and only the sort is timed
+template <class T, class F>
+static double BestNsPerElement(const Vec<T>& source, Vec<T>& out, int runs, F&& sort) {
+    double best = 0;
+    for (int r = 0; r < runs; ++r) {
+        out = source.Clone();
+        const double ns = Bench::NsPerOp(source.Length(), [&] { sort(out.AsSpan()); });
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+// std::sort, Span::SortBy, RadixSortByKey and ParallelSortBy on the same input.
+// every result has to have its keys in the same order as std::sort's
+template <class T>
+static void Run(const char* name, Jobs::JobSystem& jobs, const Vec<T>& source, auto&& key) {
+    const auto less = [&] (const T& a, const T& b) { return key(a) < key(b); };
+    const auto cmp  = [&] (const T& a, const T& b) { return Cmp::Compare {}(key(a), key(b)); };
+    const int runs = source.Length() >= 1'000'000 ? 3 : 7;
+
+    Vec<T> expected, out;
+    bool same = true;
+    const auto check = [&] { for (usize i = 0; i < out.Length(); ++i) same &= key(out[i]) == key(expected[i]); };
+
+    const double stdSort = BestNsPerElement(source, expected, runs, [&] (Span<T> s) { std::sort(s.Data(), s.Data() + s.Length(), less); });
+    const double sortBy  = BestNsPerElement(source, out, runs, [&] (Span<T> s) { s.SortBy(cmp); });
+    check();
+    const double radix   = BestNsPerElement(source, out, runs, [&] (Span<T> s) { s.RadixSortByKey(key); });
+    check();
+    const double parallel = BestNsPerElement(source, out, runs, [&] (Span<T> s) { Algorithm::ParallelSortBy(jobs, s, cmp); });
+    check();
+
+    char label[16];
+    if (source.Length() >= 1'000'000) std::snprintf(label, sizeof(label), "%zuM", source.Length() / 1'000'000);
+    else std::snprintf(label, sizeof(label), "%zuk", source.Length() / 1000);
+    std::printf("  %-10s %-6s %-10.1f %-10.1f %-10.1f %-10.1f %-13.2f %s\n", name, label, stdSort, sortBy, radix, parallel,
+                stdSort / radix, same ? "yes" : "NO");
+}
+
+int main() {
+    Jobs::JobSystem jobs;
+    Math::SplitMix64 rng { 0x5027 };
+    const auto randomF32 = [&] { return (f32)(i64)(rng.Next64() >> 40) / 4096.0f - 2048.0f; };
+
+    std::printf("sorting random data, ns per element, best of 7 (3 from 1M up), %u job system threads\n", jobs.WorkerCount());
+    std::printf("  %-10s %-6s %-10s %-10s %-10s %-10s %-13s %s\n", "", "n", "std::sort", "SortBy", "Radix", "Parallel",
+                "std / radix", "same order");
+    for (const usize n : { 1'000, 10'000, 100'000, 1'000'000, 10'000'000 }) {
+        Vec<f32> floats = Vec<f32>::WithCap(n);
+        for (usize i = 0; i < n; ++i) floats.Push(randomF32());
+        Run("f32", jobs, floats, [] (const f32& f) { return f; });
+    }
+    for (const usize n : { 1'000, 100'000, 10'000'000 }) {
+        Vec<u64> ints = Vec<u64>::WithCap(n);
+        for (usize i = 0; i < n; ++i) ints.Push(rng.Next64());
+        Run("u64", jobs, ints, [] (const u64& x) { return x; });
+    }
+    for (const usize n : { 1'000, 100'000, 1'000'000 }) {
+        Vec<Particle> particles = Vec<Particle>::WithCap(n);
+        for (usize i = 0; i < n; ++i) particles.Push({ randomF32(), randomF32(), randomF32(), randomF32(), (u32)i, 0, rng.Next64() });
+        Run("Particle", jobs, particles, [] (const Particle& p) { return p.depth; });
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "Bench.h"
+
+#include "Utils/Text.h"
+#include "Utils/Text/Formatting.h"
+#include "Utils/Text/Num.h"
+
+using namespace Quasi;
+
+static constexpr usize COUNT = 2'000'000;
+
+// the same format through the runtime Str overloads and through _fmt, each into a String and into a buffer, and through snprintf.
+// makeArgs(i) gives the arguments for iteration i as a tuple, so every call formats something a little different
+template <class Fmt, class MakeArgs, class Snprintf>
+static void Run(const char* name, Str runtime, Fmt compiled, MakeArgs&& makeArgs, Snprintf&& snprintfTo) {
+    char buffer[256];
+    const double runtimeString = Bench::BestNsPerOp(COUNT, 3, [&] {
+        for (usize i = 0; i < COUNT; ++i)
+            std::apply([&] (const auto&... args) { Bench::Keep(Text::Format(runtime, args...).Length()); }, makeArgs(i));
+    });
+    const double runtimeBuffer = Bench::BestNsPerOp(COUNT, 3, [&] {
+        for (usize i = 0; i < COUNT; ++i)
+            std::apply([&] (const auto&... args) {
+                Span<char> rest = Span<char>::Slice(buffer, sizeof(buffer));
+                Bench::Keep(Text::FormatTo(Text::StringWriter::WriteToBuffer(rest), runtime, args...));
+            }, makeArgs(i));
+    });
+    const double staticString = Bench::BestNsPerOp(COUNT, 3, [&] {
+        for (usize i = 0; i < COUNT; ++i)
+            std::apply([&] (const auto&... args) { Bench::Keep(Text::Format(compiled, args...).Length()); }, makeArgs(i));
+    });
+    const double staticBuffer = Bench::BestNsPerOp(COUNT, 3, [&] {
+        for (usize i = 0; i < COUNT; ++i)
+            std::apply([&] (const auto&... args) {
+                Bench::Keep(Text::FormatToBuffer(Span<char>::Slice(buffer, sizeof(buffer)), compiled, args...));
+            }, makeArgs(i));
+    });
+    const double libc = Bench::BestNsPerOp(COUNT, 3, [&] {
+        for (usize i = 0; i < COUNT; ++i) Bench::Keep(snprintfTo(buffer, sizeof(buffer), i));
+    });
+    std::printf("  %-24s %-12.1f %-12.1f %-12.1f %-12.1f %.1f\n", name, runtimeString, runtimeBuffer, staticString, staticBuffer, libc);
+}
+
+int main() {
+    std::printf("ns per format, %zu formats, best of 3\n", COUNT);
+    std::printf("  %-24s %-12s %-12s %-12s %-12s %s\n", "", "Str String", "Str buffer", "_fmt String", "_fmt buffer", "snprintf");
+
+    // the logger's source location prefix
+    static constexpr Str FILE = "Quasi/src/Graphics/GraphicsDevice.cpp", FUNC = "void Quasi::Graphics::GraphicsDevice::Render()";
+    Run("\"{}:{}:{} in {}: \"", "{}:{}:{} in {}: ", "{}:{}:{} in {}: "_fmt,
+        [] (usize i) { return std::tuple { FILE, (u32)(i % 500), (u32)(i % 80), FUNC }; },
+        [] (char* out, usize size, usize i) {
+            return std::snprintf(out, size, "%.*s:%u:%u in %.*s: ", (int)FILE.Length(), FILE.Data(), (u32)(i % 500), (u32)(i % 80),
+                                 (int)FUNC.Length(), FUNC.Data());
+        });
+
+    // the logger's timestamp fields, zero padded
+    Run("\"{:02}:{:02}:{:02}\"", "{:02}:{:02}:{:02}", "{:02}:{:02}:{:02}"_fmt,
+        [] (usize i) { return std::tuple { (u32)(i / 3600 % 24), (u32)(i / 60 % 60), (u32)(i % 60) }; },
+        [] (char* out, usize size, usize i) {
+            return std::snprintf(out, size, "%02u:%02u:%02u", (u32)(i / 3600 % 24), (u32)(i / 60 % 60), (u32)(i % 60));
+        });
+
+    // an obj vertex line. snprintf gets %g, which isnt shortest round trip like {} is, so it does less work
+    Run("\"v {} {} {}\\n\"", "v {} {} {}\n", "v {} {} {}\n"_fmt,
+        [] (usize i) { return std::tuple { (f32)(i % 1000) / 8, (f32)(i % 777) / 16, -(f32)(i % 333) / 4 }; },
+        [] (char* out, usize size, usize i) {
+            return std::snprintf(out, size, "v %g %g %g\n", (f64)((f32)(i % 1000) / 8), (f64)((f32)(i % 777) / 16), (f64)(-(f32)(i % 333) / 4));
+        });
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "Bench.h"
+
+#include "CameraController2D.h"
+#include "GraphicsDevice.h"
+#include "TileMap.h"
+#include "GLs/Texture.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+static constexpr u32 SIZE = 4096, FRAMES = 20;
+
+// big patches of a few types with holes, and a sprinkle of single odd tiles, roughly what a level looks like
+static TileMap MakeMap() {
+    TileMap map { { SIZE, SIZE } };
+    Math::SplitMix64 rng { 0x7115 };
+    for (u32 y = 0; y < SIZE; ++y)
+        for (u32 x = 0; x < SIZE; ++x) {
+            const u32 patch = (x / 37 * 7 + y / 23 * 13) % 5;
+            map.Set(x, y, rng.Next64() % 50 == 0 ? 5 + (u32)(rng.Next64() % 3) : patch);
+        }
+    return map;
+}
+
+struct FrameResult { double ms; usize triangles, unmerged; u32 rebuilt, drawCalls; };
+
+// runs FRAMES frames, calling step(frame) before each draw
+template <class F>
+static FrameResult Run(GraphicsDevice& device, TileMap& map, CameraController2D& camera, const Texture2D& tileset, F&& step) {
+    FrameResult r {};
+    const double ns = Bench::NsPerOp(FRAMES, [&] {
+        for (u32 f = 0; f < FRAMES; ++f) {
+            step(f);
+            map.Draw(camera, tileset, { 4, 2 });
+            r.rebuilt += map.GetStats().rebuiltChunks;
+            r.drawCalls += map.GetStats().drawCalls;
+            device.End();
+        }
+    });
+    r.ms = ns / 1e6;
+    r.triangles = map.GetStats().triangles;
+    // what one quad per tile would have drawn on the last frame
+    for (const u32 c : map.VisibleChunks()) {
+        const u32 cx = c % map.ChunkCount().x * TileMap::CHUNK_SIZE, cy = c / map.ChunkCount().x * TileMap::CHUNK_SIZE;
+        for (u32 y = cy; y < std::min(cy + TileMap::CHUNK_SIZE, SIZE); ++y)
+            for (u32 x = cx; x < std::min(cx + TileMap::CHUNK_SIZE, SIZE); ++x)
+                r.unmerged += map.Get(x, y) != TileMap::EMPTY ? 2 : 0;
+    }
+    return r;
+}
+
+static void Print(const char* name, const FrameResult& r) {
+    std::printf("  %-26s %-10.2f %-12zu %-12zu %-10.1f %.1f\n", name, r.ms, r.triangles, r.unmerged,
+                (double)r.rebuilt / FRAMES, (double)r.drawCalls / FRAMES);
+}
+
+int main() {
+    // no window, and every gl call lands in the stub
+    GraphicsDevice device { nullptr, { 640, 480 } };
+    TileMap map = MakeMap();
+    map.CreateRender(device);
+    const Texture2D tileset = Texture2D::New(nullptr, { 64, 32 });
+
+    CameraController2D camera;
+    const Math::fv2 window = (Math::fv2)device.GetWindowSize();
+    const auto wholeMap = [&] { camera.position = Math::fv2 { SIZE / 2.0f }; camera.displayScale = window.y / SIZE; };
+    const auto closeUp = [&] (u32 f) { camera.position = Math::fv2 { 100.0f + (f32)f * 150, 2048 }; camera.displayScale = 16; };
+
+    std::printf("%ux%u headless tile map, %u frames each, per frame\n", SIZE, SIZE, FRAMES);
+    std::printf("  %-26s %-10s %-12s %-12s %-10s %s\n", "", "cpu ms", "triangles", "unmerged", "rebuilt", "draw calls");
+
+    map.MarkAllDirty();
+    wholeMap();
+    Print("whole map, all rebuilt", Run(device, map, camera, tileset, [&] (u32 f) { if (f) map.MarkAllDirty(); }));
+    Print("whole map, unchanged", Run(device, map, camera, tileset, [] (u32) {}));
+
+    Math::SplitMix64 rng { 0xED17 };
+    Print("whole map, 64 edits", Run(device, map, camera, tileset, [&] (u32) {
+        for (u32 i = 0; i < 64; ++i) map.Set(rng.Next64() % SIZE, rng.Next64() % SIZE, (u32)(rng.Next64() % 8));
+    }));
+
+    map.MarkAllDirty();
+    Print("close up, panning", Run(device, map, camera, tileset, closeUp));
+    Print("close up, unchanged", Run(device, map, camera, tileset, [&] (u32) { closeUp(FRAMES); }));
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "Bench.h"
+
+#include "Utils/Box.h"
+#include "Utils/String.h"
+#include "Utils/Vec.h"
+
+using namespace Quasi;
+
+// the same layout with the same moves, but not marked trivially relocatable, so Vec moves and destroys it
+// one element at a time. the difference to the bare type is what the memcpy path buys
+template <class T> struct Wrapped {
+    T value;
+};
+
+static constexpr usize PUSHES = 1 << 20, SHIFTS = 8192;
+
+static String MakeString(usize i) { String s = "a string that doesnt fit inline, number "; s += (char)('0' + i % 10); return s; }
+static Vec<u32> MakeVec(usize i) { Vec<u32> v; v.Push((u32)i); return v; }
+static Box<u64> MakeBox(usize i) { return Box<u64>::New(i); }
+
+// pushes without reserving, so the time is mostly the regrowth moves plus making the elements
+template <class T, class Make>
+static double PushNs(Make&& make) {
+    return Bench::BestNsPerOp(PUSHES, 3, [&] {
+        Vec<T> v;
+        for (usize i = 0; i < PUSHES; ++i) v.Push(T { make(i) });
+        Bench::Keep(v.Length());
+    });
+}
+
+// inserting at the front and popping it again shifts everything behind it each time
+template <class T, class Make>
+static double ShiftNs(Make&& make) {
+    return Bench::BestNsPerOp(SHIFTS * 2, 3, [&] {
+        Vec<T> v;
+        for (usize i = 0; i < SHIFTS; ++i) v.Insert(T { make(i) }, 0);
+        for (usize i = 0; i < SHIFTS; ++i) v.Pop(0);
+        Bench::Keep(v.Length());
+    });
+}
+
+template <class T, class Make>
+static void Run(const char* name, Make&& make) {
+    static_assert(Memory::TrivialRelocate<T> && !Memory::TrivialRelocate<Wrapped<T>>);
+    const double push = PushNs<T>(make), pushWrapped = PushNs<Wrapped<T>>(make);
+    const double shift = ShiftNs<T>(make), shiftWrapped = ShiftNs<Wrapped<T>>(make);
+    std::printf("  %-10s %-10.1f %-10.1f %-8.2f %-10.0f %-10.0f %.2f\n", name,
+                push, pushWrapped, pushWrapped / push, shift, shiftWrapped, shiftWrapped / shift);
+}
+
+int main() {
+    std::printf("Vec relocation, memcpy vs moving each element, ns per op, best of 3\n");
+    std::printf("  %zu pushes without reserve; %zu inserts at the front, then as many Pop(0)\n", PUSHES, SHIFTS);
+    std::printf("  %-10s %-10s %-10s %-8s %-10s %-10s %s\n", "", "push", "push/move", "x", "shift", "shift/move", "x");
+    Run<String>("String", MakeString);
+    Run<Vec<u32>>("Vec<u32>", MakeVec);
+    Run<Box<u64>>("Box<u64>", MakeBox);
+    return 0;
+}
@@ -69,7 +69,10 @@ namespace Quasi::Graphics {
     }
 
     Math::Matrix3D CameraController3D::GetProjMat() const {
-        const float aspect = GraphicsDevice::GetDeviceInstance().GetWindowSize().AspectRatio();
+        return GetProjMat(GraphicsDevice::GetDeviceInstance().GetWindowSize().AspectRatio());
+    }
+
+    Math::Matrix3D CameraController3D::GetProjMat(float aspect) const {
         return Math::Matrix3D::PerspectiveFov(Math::Degrees(viewFov), aspect, 0.01f, 100.0f);
     }
 }
@@ -28,6 +28,7 @@ namespace Quasi::Graphics {
         Math::Matrix3D GetViewMat() const;
         Math::Transform3D GetViewTransform() const;
         Math::Matrix3D GetProjMat() const;
+        Math::Matrix3D GetProjMat(float aspect) const;
 
         bool UsesSmoothZoom() const { return !std::signbit(smoothZoom); }
     };
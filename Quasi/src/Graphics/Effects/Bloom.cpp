@@ -160,7 +160,7 @@ namespace Quasi::Graphics {
 
     void Bloom::SetToRenderTarget() {
         screenTex.BindDrawDest();
-        GL::Viewport(0, 0, screenDim.x, screenDim.y);
+        Render::SetViewport({ 0, screenDim });
     }
 
     void Bloom::ApplyEffect() {
@@ -214,6 +214,6 @@ namespace Quasi::Graphics {
         screenTex.BlitToScreen({ 0, (screenDim).As<int>() }, { 0, actualScreenDim });
         screenTex.Unbind();
 
-        GL::Viewport(0, 0, actualScreenDim.x, actualScreenDim.y);
+        Render::SetViewport({ 0, actualScreenDim });
     }
 }
@@ -0,0 +1,110 @@
+#include "BuddyAllocator.h"
+
+#include "Utils/Algorithm.h"
+#include "Utils/Numeric.h"
+#include "Utils/Debug/Logger.h"
+
+#include <bit>
+
+namespace Quasi::Graphics {
+    BuddyAllocator::BuddyAllocator(u32 capacity, u32 minBlock) : minBlock(std::max(minBlock, 1u)) {
+        Reset(capacity);
+    }
+
+    u32 BuddyAllocator::LargestFreeBlock() const {
+        for (u32 o = maxOrder + 1; o --> 0;)
+            if (!freeLists[o].IsEmpty()) return minBlock << o;
+        return 0;
+    }
+
+    float BuddyAllocator::Fragmentation() const {
+        // packed free space splits into one block per set bit, so the biggest block it could have is the top bit
+        const u32 freeBlocks = FreeUnits() / minBlock;
+        return freeBlocks ? 1.0f - (float)LargestFreeBlock() / (float)(std::bit_floor(freeBlocks) * minBlock) : 0.0f;
+    }
+
+    u32 BuddyAllocator::OrderFor(u32 count) const {
+        const u32 blocks = (u32)(((u64)std::max(count, 1u) + minBlock - 1) / minBlock);
+        return u32s::BitWidth(blocks - 1);
+    }
+
+    Option<BuddyAllocator::Block> BuddyAllocator::AllocateOrder(u32 order) {
+        if (order > maxOrder) return nullptr;
+
+        u32 o = order;
+        while (freeLists[o].IsEmpty())
+            if (++o > maxOrder) return nullptr;
+
+        u32 node = freeLists[o].Last();
+        RemoveFree(node, o);
+        // split down to the size we need, keeping the left half each time
+        for (; o > order; --o) {
+            states[node] = NodeState::SPLIT;
+            node *= 2;
+            PushFree(node + 1, o - 1);
+        }
+        states[node] = NodeState::USED;
+        usedUnits += minBlock << order;
+        return Block { OffsetOf(node, order), order };
+    }
+
+    void BuddyAllocator::Free(const Block& block) {
+        u32 node = NodeOf(block), order = block.order;
+        Debug::QAssert$(states[node] == NodeState::USED, "freeing a block that isnt allocated");
+        usedUnits -= minBlock << order;
+
+        // merge upwards for as long as the buddy is free too
+        for (; node > 1 && states[node ^ 1] == NodeState::FREE; node /= 2, ++order) {
+            RemoveFree(node ^ 1, order);
+            states[node] = states[node ^ 1] = NodeState::UNREACHED;
+        }
+        PushFree(node, order);
+    }
+
+    void BuddyAllocator::Reset(u32 capacity) {
+        if (capacity) {
+            const u32 blocks = (u32)(((u64)capacity + minBlock - 1) / minBlock);
+            maxOrder = u32s::BitWidth(blocks - 1);
+            Debug::QAssert$(((u64)minBlock << maxOrder) <= u32s::MAX, "{} units dont fit in a u32 once rounded up to a power of 2", capacity);
+        }
+        states.Clear();
+        states.Resize(2 << maxOrder, NodeState::UNREACHED);
+        freeIndices.Clear();
+        freeIndices.Resize(2 << maxOrder, 0);
+        freeLists.Clear();
+        freeLists.ResizeDefault(maxOrder + 1);
+        usedUnits = 0;
+        PushFree(1, maxOrder);
+    }
+
+    Vec<BuddyAllocator::Block> BuddyAllocator::Repack(Span<const Block> blocks, u32 capacity) {
+        // biggest first, and same sized blocks keep their old order so ones that are already packed dont move
+        Vec<u32> order = Vec<u32>::WithCap(blocks.Length());
+        for (u32 i = 0; i < blocks.Length(); ++i) order.Push(i);
+        order.SortByKey([&] (u32 i) { return (u64)(31 - blocks[i].order) << 32 | blocks[i].offset; });
+
+        Reset(capacity);
+        Vec<Block> packed;
+        packed.Resize(blocks.Length());
+        for (const u32 i : order) {
+            const Option<Block> b = AllocateOrder(blocks[i].order);
+            Debug::QAssert$(b.HasValue(), "repacked blocks dont fit in {} units", Capacity());
+            packed[i] = *b;
+        }
+        return packed;
+    }
+
+    void BuddyAllocator::PushFree(u32 node, u32 order) {
+        states[node] = NodeState::FREE;
+        freeIndices[node] = (u32)freeLists[order].Length();
+        freeLists[order].Push(node);
+    }
+
+    void BuddyAllocator::RemoveFree(u32 node, u32 order) {
+        Vec<u32>& list = freeLists[order];
+        const u32 i = freeIndices[node];
+        list[i] = list.Last();
+        freeIndices[list[i]] = i;
+        list.Pop();
+    }
+}
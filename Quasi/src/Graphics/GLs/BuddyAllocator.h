@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Utils/Vec.h"
+#include "Utils/Option.h"
+
+namespace Quasi::Graphics {
+    // hands out ranges of a fixed size buffer as power of 2 blocks (of at least minBlock units).
+    // freeing merges a block back with its buddy whenever both halves are free, so the free space
+    // coalesces by itself. it doesnt touch any gl state, it only does the bookkeeping for offsets
+    class BuddyAllocator {
+    public:
+        struct Block {
+            u32 offset = 0, order = 0; // the block is (minBlock << order) units long
+
+            bool operator==(const Block&) const = default;
+        };
+    private:
+        enum class NodeState : byte { UNREACHED, SPLIT, FREE, USED };
+
+        // the blocks form an implicit binary tree, node 1 is the whole buffer and node i splits into 2i and 2i + 1
+        Vec<NodeState> states;
+        Vec<u32> freeIndices; // where a free node sits in its free list
+        Vec<Vec<u32>> freeLists; // free nodes per order
+        u32 minBlock = 1, maxOrder = 0;
+        u32 usedUnits = 0;
+    public:
+        BuddyAllocator() = default;
+        explicit BuddyAllocator(u32 capacity, u32 minBlock = 1);
+
+        u32 Capacity() const { return minBlock << maxOrder; }
+        u32 MinBlock() const { return minBlock; }
+        u32 UsedUnits() const { return usedUnits; }
+        u32 FreeUnits() const { return Capacity() - usedUnits; }
+        u32 LargestFreeBlock() const;
+        // 0 when the biggest free block is as big as it could be with this much free space, towards 1 the more its scattered around
+        float Fragmentation() const;
+
+        u32 BlockSize(const Block& block) const { return minBlock << block.order; }
+        u32 OrderFor(u32 count) const;
+
+        Option<Block> Allocate(u32 count) { return AllocateOrder(OrderFor(count)); }
+        Option<Block> AllocateOrder(u32 order);
+        void Free(const Block& block);
+        // frees everything, and resizes the buffer if capacity is given
+        void Reset(u32 capacity = 0);
+        // frees everything and allocates the same blocks again biggest first, which leaves them packed at the start
+        // of the buffer without holes. returns where each block ended up, in the same order they were given.
+        // the blocks have to fit in the new capacity (always true if its the same or bigger)
+        Vec<Block> Repack(Span<const Block> blocks, u32 capacity = 0);
+    private:
+        u32 NodeOf(const Block& block) const { return (1 << (maxOrder - block.order)) + block.offset / BlockSize(block); }
+        u32 OffsetOf(u32 node, u32 order) const { return (node - (1 << (maxOrder - order))) * (minBlock << order); }
+
+        void PushFree(u32 node, u32 order);
+        void RemoveFree(u32 node, u32 order);
+    };
+}
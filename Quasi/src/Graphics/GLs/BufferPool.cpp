@@ -0,0 +1,132 @@
+#include "BufferPool.h"
+
+#include "Render.h"
+#include "GLDebug.h"
+
+namespace Quasi::Graphics {
+    BufferPool::BufferPool(const VertexBufferLayout& layout, u32 vertexCapacity, u32 indexCapacity) :
+        layout(layout), varray(VertexArray::New()),
+        vertexAlloc(vertexCapacity, MIN_VERTEX_BLOCK), indexAlloc(indexCapacity, MIN_INDEX_BLOCK) {
+        vbo = VertexBuffer::New(vertexAlloc.Capacity() * layout.GetStride());
+        ibo = IndexBuffer::New(indexAlloc.Capacity());
+        AttachBuffers();
+    }
+
+    BufferPool BufferPool::New(const VertexBufferLayout& layout, u32 vertexCapacity, u32 indexCapacity) {
+        return BufferPool { layout, vertexCapacity, indexCapacity };
+    }
+
+    // buffer sizes are u32 bytes, so past that the buffer cant double anymore
+    static bool CanDouble(u32 capacity, u32 unitSize) {
+        return (u64)capacity * 2 * unitSize <= u32s::MAX;
+    }
+
+    SlotKey BufferPool::Allocate(u32 vertexCount, u32 indexCount) {
+        Option<BuddyAllocator::Block> vblock = vertexAlloc.Allocate(vertexCount);
+        while (!vblock) {
+            if (!CanDouble(vertexAlloc.Capacity(), layout.GetStride())) {
+                GLLogger().QError$("buffer pool cant grow to fit {} vertices", vertexCount);
+                return {};
+            }
+            RelocateVertices(vertexAlloc.Capacity() * 2);
+            vblock = vertexAlloc.Allocate(vertexCount);
+        }
+        Option<BuddyAllocator::Block> iblock = indexAlloc.Allocate(indexCount);
+        while (!iblock) {
+            if (!CanDouble(indexAlloc.Capacity(), sizeof(u32))) {
+                GLLogger().QError$("buffer pool cant grow to fit {} indices", indexCount);
+                vertexAlloc.Free(*vblock);
+                return {};
+            }
+            RelocateIndices(indexAlloc.Capacity() * 2);
+            iblock = indexAlloc.Allocate(indexCount);
+        }
+        return ranges.Insert({ *vblock, *iblock, vertexCount, indexCount });
+    }
+
+    void BufferPool::Free(SlotKey key) {
+        const Option<PoolRange> range = ranges.Take(key);
+        if (!range) return;
+        vertexAlloc.Free(range->vertexBlock);
+        indexAlloc.Free(range->indexBlock);
+    }
+
+    void BufferPool::SetVertexBytes(SlotKey key, Span<const byte> vertices) {
+        const PoolRange& range = ranges[key];
+        const u32 stride = layout.GetStride();
+        Debug::QAssert$(vertices.ByteSize() <= range.vertexCount * stride, "too many vertices for the range");
+        vbo.SetDataBytes(vertices, range.vertexBlock.offset * stride);
+    }
+
+    void BufferPool::SetIndices(SlotKey key, Span<const u32> indices) {
+        const PoolRange& range = ranges[key];
+        Debug::QAssert$(indices.Length() <= range.indexCount, "too many indices for the range");
+        ibo.SetData(indices, range.indexBlock.offset * sizeof(u32));
+    }
+
+    void BufferPool::Draw(SlotKey key, const Shader& shader) const {
+        const PoolRange& range = ranges[key];
+        Render::DrawRange(varray, ibo, shader, range.indexBlock.offset, range.indexCount, range.vertexBlock.offset);
+    }
+
+    void BufferPool::DrawInstanced(SlotKey key, const Shader& shader, int instances) const {
+        const PoolRange& range = ranges[key];
+        Render::DrawRangeInstanced(varray, ibo, shader, range.indexBlock.offset, range.indexCount, range.vertexBlock.offset, instances);
+    }
+
+    void BufferPool::Defragment() {
+        RelocateVertices(vertexAlloc.Capacity());
+        RelocateIndices(indexAlloc.Capacity());
+    }
+
+    void BufferPool::RelocateVertices(u32 capacity) {
+        Vec<BuddyAllocator::Block> blocks = Vec<BuddyAllocator::Block>::WithCap(ranges.Length());
+        for (const PoolRange& r : ranges) blocks.Push(r.vertexBlock);
+        const Vec<BuddyAllocator::Block> packed = vertexAlloc.Repack(blocks, capacity);
+
+        const u32 stride = layout.GetStride();
+        VertexBuffer moved = VertexBuffer::New(vertexAlloc.Capacity() * stride);
+        for (usize i = 0; i < ranges.Length(); ++i) {
+            PoolRange& r = ranges.Values()[i];
+            if (r.vertexCount)
+                Render::CopyBufferData(vbo.rendererID, moved.rendererID, blocks[i].offset * stride, packed[i].offset * stride, r.vertexCount * stride);
+            r.vertexBlock = packed[i];
+        }
+        vbo = std::move(moved);
+        AttachBuffers();
+    }
+
+    void BufferPool::RelocateIndices(u32 capacity) {
+        Vec<BuddyAllocator::Block> blocks = Vec<BuddyAllocator::Block>::WithCap(ranges.Length());
+        for (const PoolRange& r : ranges) blocks.Push(r.indexBlock);
+        const Vec<BuddyAllocator::Block> packed = indexAlloc.Repack(blocks, capacity);
+
+        IndexBuffer moved = IndexBuffer::New(indexAlloc.Capacity());
+        for (usize i = 0; i < ranges.Length(); ++i) {
+            PoolRange& r = ranges.Values()[i];
+            if (r.indexCount)
+                Render::CopyBufferData(ibo.rendererID, moved.rendererID, blocks[i].offset * sizeof(u32), packed[i].offset * sizeof(u32), r.indexCount * sizeof(u32));
+            r.indexBlock = packed[i];
+        }
+        ibo = std::move(moved);
+        AttachBuffers();
+    }
+
+    void BufferPool::AttachBuffers() {
+        // the attribute pointers remember which vertex buffer was bound, so they're redone whenever it changes
+        varray.AddBuffer(vbo, layout);
+        ibo.Bind();
+    }
+
+    BufferPool& BufferArena::PoolFor(const VertexBufferLayout& layout) {
+        for (Pool& p : pools)
+            if (p.layout == &layout) return *p.pool;
+        pools.Push({ &layout, Box<BufferPool>::Build(BufferPool::New(layout, initialVertexCapacity, initialIndexCapacity)) });
+        return *pools.Last().pool;
+    }
+
+    void BufferArena::DefragmentAbove(float fragmentation) {
+        for (Pool& p : pools)
+            if (p.pool->Fragmentation() > fragmentation) p.pool->Defragment();
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "BuddyAllocator.h"
+#include "IndexBuffer.h"
+#include "VertexArray.h"
+#include "VertexElement.h"
+#include "Utils/Box.h"
+#include "Utils/SlotMap.h"
+
+namespace Quasi::Graphics {
+    class Shader;
+
+    // where one mesh lives inside a pool's buffers, in vertices and indices (not bytes or triangles)
+    struct PoolRange {
+        BuddyAllocator::Block vertexBlock, indexBlock;
+        u32 vertexCount = 0, indexCount = 0;
+    };
+
+    // one vertex array over a big vertex buffer and a big index buffer, that meshes with the same layout get
+    // sub-allocated from, so drawing a bunch of them doesnt rebind anything in between.
+    // each mesh's indices start from 0, the draw offsets them by its base vertex.
+    // when a buffer runs out it doubles and everything gets packed into the new one, which is fine since
+    // meshes are referred to by key and not by offset
+    class BufferPool {
+        VertexBufferLayout layout;
+        VertexArray varray;
+        VertexBuffer vbo;
+        IndexBuffer ibo;
+        BuddyAllocator vertexAlloc, indexAlloc;
+        SlotMap<PoolRange> ranges;
+
+        explicit BufferPool(const VertexBufferLayout& layout, u32 vertexCapacity, u32 indexCapacity);
+    public:
+        static constexpr u32 MIN_VERTEX_BLOCK = 64, MIN_INDEX_BLOCK = 3 * 64;
+
+        BufferPool() = default;
+        static BufferPool New(const VertexBufferLayout& layout, u32 vertexCapacity, u32 indexCapacity);
+        template <IVertex T> static BufferPool New(u32 vertexCapacity, u32 indexCapacity) {
+            return New(VertexLayoutOf<T>(), vertexCapacity, indexCapacity);
+        }
+
+        // a null key if the buffers would have to grow past what a u32 byte size can hold
+        SlotKey Allocate(u32 vertexCount, u32 indexCount);
+        void Free(SlotKey key);
+        bool Contains(SlotKey key) const { return ranges.Contains(key); }
+        const PoolRange& GetRange(SlotKey key) const { return ranges[key]; }
+        usize RangeCount() const { return ranges.Length(); }
+
+        void SetVertexBytes(SlotKey key, Span<const byte> vertices);
+        template <IVertex T> void SetVertices(SlotKey key, Span<const T> vertices) { SetVertexBytes(key, vertices.AsBytes()); }
+        void SetIndices(SlotKey key, Span<const u32> indices);
+        void SetIndices(SlotKey key, Span<const TriIndices> indices) { SetIndices(key, indices.Transmute<u32>()); }
+
+        void Draw(SlotKey key, const Shader& shader) const;
+        void DrawInstanced(SlotKey key, const Shader& shader, int instances) const;
+
+        u32 VertexCapacity() const { return vertexAlloc.Capacity(); }
+        u32 IndexCapacity() const { return indexAlloc.Capacity(); }
+        float Fragmentation() const { return std::max(vertexAlloc.Fragmentation(), indexAlloc.Fragmentation()); }
+        // packs every mesh to the start of the buffers again
+        void Defragment();
+    private:
+        // repacks into a new buffer of the given capacity, overlapping copies in the same buffer arent allowed
+        void RelocateVertices(u32 capacity);
+        void RelocateIndices(u32 capacity);
+        void AttachBuffers();
+    };
+
+    // a pool per vertex type
+    class BufferArena {
+        struct Pool {
+            const VertexBufferLayout* layout;
+            Box<BufferPool> pool;
+        };
+        Vec<Pool> pools;
+    public:
+        u32 initialVertexCapacity = 1 << 14, initialIndexCapacity = 3 << 14;
+
+        BufferArena() = default;
+
+        template <IVertex T> BufferPool& PoolFor() { return PoolFor(VertexLayoutOf<T>()); }
+        // pools are found by the address of the layout, so this should be a vertex type's VERTEX_LAYOUT
+        BufferPool& PoolFor(const VertexBufferLayout& layout);
+
+        void DefragmentAbove(float fragmentation);
+        void Clear() { pools.Clear(); }
+    };
+}
@@ -16,15 +16,16 @@ namespace Quasi::Graphics {
     }
 
     void FrameBuffer::DestroyObject(GraphicsID id) {
+        Render::ForgetFrameBuffer(id);
         QGLCall$(GL::DeleteFramebuffers(1, &id));
     }
 
     void FrameBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindFramebuffer(GL::FRAMEBUFFER, id));
+        Render::BindFrameBuffer(id);
     }
 
     void FrameBuffer::UnbindObject() {
-        QGLCall$(GL::BindFramebuffer(GL::FRAMEBUFFER, 0));
+        Render::BindFrameBuffer(0);
     }
 
     void FrameBuffer::Attach(const TextureBase& tbase, int target, int mipmapLvl, AttachmentType type) const {
@@ -43,15 +44,15 @@ namespace Quasi::Graphics {
     }
 
     void FrameBuffer::BindReadSrc() const {
-        QGLCall$(GL::BindFramebuffer(GL::READ_FRAMEBUFFER, rendererID));
+        Render::BindReadFrameBuffer(rendererID);
     }
 
     void FrameBuffer::BindDrawDest() const {
-        QGLCall$(GL::BindFramebuffer(GL::DRAW_FRAMEBUFFER, rendererID));
+        Render::BindDrawFrameBuffer(rendererID);
     }
 
     void FrameBuffer::UnbindDrawDest() {
-        QGLCall$(GL::BindFramebuffer(GL::DRAW_FRAMEBUFFER, 0));
+        Render::BindDrawFrameBuffer(0);
     }
 
     void FrameBuffer::BlitFramebuffers(const Math::iRect2D& srcRect, const Math::iRect2D& destRect, bool linear) {
@@ -81,6 +81,6 @@ namespace Quasi::Graphics {
 template <>
 struct Quasi::Text::Formatter<Quasi::Graphics::GLErrorCode> {
     static usize FormatTo(StringWriter output, Graphics::GLErrorCode err, Str) {
-        return Text::FormatTo(output, "0x{:X04} ({})", (u32)err, GetErrName(err));
+        return Text::FormatTo(output, "0x{:04X} ({})"_fmt, (u32)err, GetErrName(err));
     }
 };
@@ -5,6 +5,7 @@
 #include <glp.h>
 
 #include "GLDebug.h"
+#include "Render.h"
 
 namespace Quasi::Graphics {
     IndexBuffer::IndexBuffer(GraphicsID id, u32 size) : GLObject(id), bufferSize(size) {}
@@ -18,15 +19,16 @@ namespace Quasi::Graphics {
     }
 
     void IndexBuffer::DestroyObject(GraphicsID id) {
+        Render::ForgetBuffer(id);
         QGLCall$(GL::DeleteBuffers(1, &id));
     }
 
     void IndexBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, id));
+        Render::BindIndexBuffer(id);
     }
 
     void IndexBuffer::UnbindObject() {
-        QGLCall$(GL::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, 0));
+        Render::BindIndexBuffer(0);
     }
 
     void IndexBuffer::SetData(Span<const u32> data, u32 dOffset) {
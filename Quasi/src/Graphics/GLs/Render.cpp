@@ -4,7 +4,85 @@
 #include "VertexArray.h"
 #include "../RenderData.h"
 
+namespace Quasi::Graphics::RenderDetails {
+    constexpr int MAX_CACHED_SLOTS = 32;
+    constexpr Capability CACHED_CAPABILITIES[] = {
+        Capability::BLEND, Capability::DEPTH, Capability::STENCIL,
+        Capability::CULL_FACE, Capability::MULTISAMPLE, Capability::SCISSOR,
+    };
+
+    struct BlendFunc {
+        BlendFactor src, dest, srcAlpha, destAlpha;
+        bool operator==(const BlendFunc&) const = default;
+    };
+
+    struct StencilTest {
+        CmpOperation op; int ref, mask;
+        bool operator==(const StencilTest&) const = default;
+    };
+
+    struct StencilWriteOp {
+        StencilOperation stencilFail, depthFail, pass;
+        bool operator==(const StencilWriteOp&) const = default;
+    };
+
+    struct BoundTexture {
+        TextureTarget target; GraphicsID id;
+        bool operator==(const BoundTexture&) const = default;
+    };
+
+    // none means we dont know, the next set always goes through
+    struct StateCache {
+        Option<GraphicsID> vertexArray, vertexBuffer, indexBuffer, program, renderBuffer, readFrameBuffer, drawFrameBuffer;
+        Option<int> textureSlot;
+        Option<BoundTexture> textures[MAX_CACHED_SLOTS];
+
+        Option<bool> capabilities[std::size(CACHED_CAPABILITIES)];
+        Option<BlendFunc> blendFunc;
+        Option<Math::fColor> blendColor, clearColor;
+        Option<CmpOperation> depthFunc;
+        Option<StencilTest> stencilTest;
+        Option<int> stencilWriteMask;
+        Option<StencilWriteOp> stencilWriteOp;
+        Option<RenderMode> renderMode;
+        Option<FacingMode> cullFace;
+        Option<OrientationMode> frontFace;
+        Option<Math::iRect2D> viewport;
+
+        Render::StateCacheStats stats;
+    };
+
+    StateCache& Cache() {
+        static StateCache cache;
+        return cache;
+    }
+
+    template <class T>
+    bool Changed(Option<T>& cached, const std::type_identity_t<T>& value) {
+        StateCache& cache = Cache();
+        if (cached == value) {
+            ++cache.stats.skipped;
+            return false;
+        }
+        cached = value;
+        ++cache.stats.issued;
+        return true;
+    }
+
+    Option<bool>* CachedCapability(Capability cap) {
+        for (usize i = 0; i < std::size(CACHED_CAPABILITIES); ++i)
+            if (CACHED_CAPABILITIES[i] == cap) return &Cache().capabilities[i];
+        return nullptr;
+    }
+
+    void Forget(Option<GraphicsID>& cached, GraphicsID id) {
+        if (id != GraphicsNoID && cached == id) cached = nullptr;
+    }
+}
+
 namespace Quasi::Graphics::Render {
+    using RenderDetails::Cache;
+
     void Draw(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader) {
         vertexArr.Bind();
         indexBuff.Bind();
@@ -35,11 +113,26 @@ namespace Quasi::Graphics::Render {
         DrawInstanced(dat, dat.shader, instances);
     }
 
+    void DrawRange(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 firstIndex, u32 indexCount, u32 baseVertex) {
+        vertexArr.Bind();
+        indexBuff.Bind();
+        shader.Bind();
+        QGLCall$(GL::DrawElementsBaseVertex(GL::TRIANGLES, (int)indexCount, GL::UNSIGNED_INT, (void*)(firstIndex * sizeof(u32)), (int)baseVertex));
+    }
+
+    void DrawRangeInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 firstIndex, u32 indexCount, u32 baseVertex, int instances) {
+        vertexArr.Bind();
+        indexBuff.Bind();
+        shader.Bind();
+        QGLCall$(GL::DrawElementsInstancedBaseVertex(GL::TRIANGLES, (int)indexCount, GL::UNSIGNED_INT, (const void*)(firstIndex * sizeof(u32)), instances, (int)baseVertex));
+    }
+
     void Clear(const BufferBit bit) {
         QGLCall$(GL::Clear((int)bit));
     }
 
     void SetRenderMode(const RenderMode mode) {
+        if (!RenderDetails::Changed(Cache().renderMode, mode)) return;
         QGLCall$(GL::PolygonMode(GL::FRONT_AND_BACK, (uint)mode));
     }
 
@@ -48,30 +141,39 @@ namespace Quasi::Graphics::Render {
     }
 
     void SetClearColor(const Math::fColor& color) {
+        if (!RenderDetails::Changed(Cache().clearColor, color)) return;
         QGLCall$(GL::ClearColor(color.r, color.g, color.b, color.a));
     }
 
     void Enable(const Capability cap) {
+        if (Option<bool>* enabled = RenderDetails::CachedCapability(cap))
+            if (!RenderDetails::Changed(*enabled, true)) return;
         QGLCall$(GL::Enable((int)cap));
     }
 
     void Disable(const Capability cap) {
+        if (Option<bool>* enabled = RenderDetails::CachedCapability(cap))
+            if (!RenderDetails::Changed(*enabled, false)) return;
         QGLCall$(GL::Disable((int)cap));
     }
 
     void UseDepthFunc(const CmpOperation op) {
+        if (!RenderDetails::Changed(Cache().depthFunc, op)) return;
         QGLCall$(GL::DepthFunc((int)op));
     }
 
     void UseStencilTest(const CmpOperation op, const int ref, const int mask) {
+        if (!RenderDetails::Changed(Cache().stencilTest, { op, ref, mask })) return;
         QGLCall$(GL::StencilFunc((int)op, ref, mask));
     }
 
     void UseStencilWriteMask(const int mask) {
+        if (!RenderDetails::Changed(Cache().stencilWriteMask, mask)) return;
         QGLCall$(GL::StencilMask(mask));
     }
 
     void UseStencilWriteOp(StencilOperation stencilFail, StencilOperation depthFail, StencilOperation pass) {
+        if (!RenderDetails::Changed(Cache().stencilWriteOp, { stencilFail, depthFail, pass })) return;
         QGLCall$(GL::StencilOp((int)stencilFail, (int)depthFail, (int)pass));
     }
 
@@ -80,22 +182,27 @@ namespace Quasi::Graphics::Render {
     }
 
     void UseBlendConstColor(const Math::fColor& ref) {
+        if (!RenderDetails::Changed(Cache().blendColor, ref)) return;
         QGLCall$(GL::BlendColor(ref.r, ref.g, ref.b, ref.a));
     }
 
     void UseBlendFunc(const BlendFactor src, const BlendFactor dest) {
+        if (!RenderDetails::Changed(Cache().blendFunc, { src, dest, src, dest })) return;
         QGLCall$(GL::BlendFunc((int)src, (int)dest));
     }
 
     void UseBlendFuncSeparate(BlendFactor src, BlendFactor dest, BlendFactor srcAlpha, BlendFactor destAlpha) {
+        if (!RenderDetails::Changed(Cache().blendFunc, { src, dest, srcAlpha, destAlpha })) return;
         QGLCall$(GL::BlendFuncSeparate((int)src, (int)dest, (int)srcAlpha, (int)destAlpha));
     }
 
     void SetCullFace(FacingMode facing) {
+        if (!RenderDetails::Changed(Cache().cullFace, facing)) return;
         QGLCall$(GL::CullFace((int)facing));
     }
 
     void SetFrontFacing(OrientationMode   orientation) {
+        if (!RenderDetails::Changed(Cache().frontFace, orientation)) return;
         QGLCall$(GL::FrontFace((int)orientation));
     }
 
@@ -103,7 +210,128 @@ namespace Quasi::Graphics::Render {
         QGLCall$(GL::DrawBuffer((int)mode));
     }
 
+    void SetViewport(const Math::iRect2D& viewport) {
+        if (!RenderDetails::Changed(Cache().viewport, viewport)) return;
+        const Math::iv2 size = viewport.Size();
+        QGLCall$(GL::Viewport(viewport.min.x, viewport.min.y, size.x, size.y));
+    }
+
     void MemoryBarrier(int barrierBits) {
         QGLCall$(GL::MemoryBarrier(barrierBits));
     }
+
+    void CopyBufferData(GraphicsID from, GraphicsID to, usize fromOffset, usize toOffset, usize size) {
+        QGLCall$(GL::BindBuffer(GL::COPY_READ_BUFFER, from));
+        QGLCall$(GL::BindBuffer(GL::COPY_WRITE_BUFFER, to));
+        QGLCall$(GL::CopyBufferSubData(GL::COPY_READ_BUFFER, GL::COPY_WRITE_BUFFER, (isize)fromOffset, (isize)toOffset, (isize)size));
+    }
+
+    void InvalidateState() {
+        RenderDetails::StateCache& cache = Cache();
+        const StateCacheStats stats = cache.stats;
+        cache = {};
+        cache.stats = stats;
+    }
+
+    const StateCacheStats& GetStateCacheStats() { return Cache().stats; }
+    void ResetStateCacheStats() { Cache().stats = {}; }
+
+    void BindVertexArray(GraphicsID id) {
+        RenderDetails::StateCache& cache = Cache();
+        if (!RenderDetails::Changed(cache.vertexArray, id)) return;
+        // the element buffer binding belongs to the vertex array
+        cache.indexBuffer = nullptr;
+        QGLCall$(GL::BindVertexArray(id));
+    }
+
+    void BindVertexBuffer(GraphicsID id) {
+        if (!RenderDetails::Changed(Cache().vertexBuffer, id)) return;
+        QGLCall$(GL::BindBuffer(GL::ARRAY_BUFFER, id));
+    }
+
+    void BindIndexBuffer(GraphicsID id) {
+        if (!RenderDetails::Changed(Cache().indexBuffer, id)) return;
+        QGLCall$(GL::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, id));
+    }
+
+    void BindProgram(GraphicsID id) {
+        if (!RenderDetails::Changed(Cache().program, id)) return;
+        QGLCall$(GL::UseProgram(id));
+    }
+
+    void BindRenderBuffer(GraphicsID id) {
+        if (!RenderDetails::Changed(Cache().renderBuffer, id)) return;
+        QGLCall$(GL::BindRenderbuffer(GL::RENDERBUFFER, id));
+    }
+
+    void BindFrameBuffer(GraphicsID id) {
+        RenderDetails::StateCache& cache = Cache();
+        if (cache.readFrameBuffer == id && cache.drawFrameBuffer == id) {
+            ++cache.stats.skipped;
+            return;
+        }
+        ++cache.stats.issued;
+        cache.readFrameBuffer = cache.drawFrameBuffer = id;
+        QGLCall$(GL::BindFramebuffer(GL::FRAMEBUFFER, id));
+    }
+
+    void BindReadFrameBuffer(GraphicsID id) {
+        if (!RenderDetails::Changed(Cache().readFrameBuffer, id)) return;
+        QGLCall$(GL::BindFramebuffer(GL::READ_FRAMEBUFFER, id));
+    }
+
+    void BindDrawFrameBuffer(GraphicsID id) {
+        if (!RenderDetails::Changed(Cache().drawFrameBuffer, id)) return;
+        QGLCall$(GL::BindFramebuffer(GL::DRAW_FRAMEBUFFER, id));
+    }
+
+    void UseTextureSlot(int slot) {
+        if (!RenderDetails::Changed(Cache().textureSlot, slot)) return;
+        QGLCall$(GL::ActiveTexture(GL::TEXTURE0 + slot));
+    }
+
+    void BindTexture(TextureTarget target, GraphicsID id) {
+        RenderDetails::StateCache& cache = Cache();
+        // past the slots we keep track of, or we dont know which slot is active
+        if (!cache.textureSlot.HasValueAnd([] (int s) { return s < RenderDetails::MAX_CACHED_SLOTS; })) {
+            ++cache.stats.issued;
+            QGLCall$(GL::BindTexture((int)target, id));
+            return;
+        }
+        if (!RenderDetails::Changed(cache.textures[*cache.textureSlot], { target, id })) return;
+        QGLCall$(GL::BindTexture((int)target, id));
+    }
+
+    void BindTextureToSlot(TextureTarget target, GraphicsID id, int slot) {
+        UseTextureSlot(slot);
+        BindTexture(target, id);
+    }
+
+    void ForgetVertexArray(GraphicsID id) {
+        RenderDetails::Forget(Cache().vertexArray, id);
+    }
+
+    void ForgetBuffer(GraphicsID id) {
+        RenderDetails::Forget(Cache().vertexBuffer, id);
+        RenderDetails::Forget(Cache().indexBuffer,  id);
+    }
+
+    void ForgetProgram(GraphicsID id) {
+        RenderDetails::Forget(Cache().program, id);
+    }
+
+    void ForgetRenderBuffer(GraphicsID id) {
+        RenderDetails::Forget(Cache().renderBuffer, id);
+    }
+
+    void ForgetFrameBuffer(GraphicsID id) {
+        RenderDetails::Forget(Cache().readFrameBuffer, id);
+        RenderDetails::Forget(Cache().drawFrameBuffer, id);
+    }
+
+    void ForgetTexture(GraphicsID id) {
+        for (auto& bound : Cache().textures)
+            if (bound.HasValueAnd([&] (const RenderDetails::BoundTexture& t) { return t.id == id; }))
+                bound = nullptr;
+    }
 }
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "IndexBuffer.h"
 #include "Shader.h"
+#include "TextureConstants.h"
 
 namespace Quasi::Graphics {
     class RenderData;
@@ -155,6 +156,9 @@ namespace Quasi::Graphics::Render {
     void Draw(const RenderData& dat);
     void DrawInstanced(const RenderData& dat, const Shader& s, int instances);
     void DrawInstanced(const RenderData& dat, int instances);
+    // draws part of the index buffer, with the indices counted from baseVertex instead of the buffer's start
+    void DrawRange(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 firstIndex, u32 indexCount, u32 baseVertex);
+    void DrawRangeInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 firstIndex, u32 indexCount, u32 baseVertex, int instances);
 
 #pragma region GL Functions
 #define GL_SWITCH(F, NAME, E) inline void F##NAME() { F(E); }
@@ -207,4 +211,40 @@ namespace Quasi::Graphics::Render {
 #pragma endregion
 
     void MemoryBarrier(int barrierBits);
+    // gpu side copy between buffers, offsets and size are in bytes. goes through the copy targets so it doesnt disturb any binding
+    void CopyBufferData(GraphicsID from, GraphicsID to, usize fromOffset, usize toOffset, usize size);
+
+#pragma region State Cache
+    // everything above that sets state, and every GLObject bind, goes through a shadow copy of the gl state,
+    // so setting what's already current never reaches the driver.
+    // if something else touches gl (like imgui's backend), call InvalidateState after it's done
+    struct StateCacheStats {
+        u32 issued = 0, skipped = 0;
+    };
+
+    void InvalidateState();
+    const StateCacheStats& GetStateCacheStats();
+    void ResetStateCacheStats();
+
+    void BindVertexArray(GraphicsID id);
+    void BindVertexBuffer(GraphicsID id);
+    void BindIndexBuffer(GraphicsID id);
+    void BindProgram(GraphicsID id);
+    void BindRenderBuffer(GraphicsID id);
+    void BindFrameBuffer(GraphicsID id);
+    void BindReadFrameBuffer(GraphicsID id);
+    void BindDrawFrameBuffer(GraphicsID id);
+    void UseTextureSlot(int slot);
+    // binds to whatever slot is active
+    void BindTexture(TextureTarget target, GraphicsID id);
+    void BindTextureToSlot(TextureTarget target, GraphicsID id, int slot);
+
+    // called right before an object is deleted, so that a new object with the same id doesnt look bound already
+    void ForgetVertexArray(GraphicsID id);
+    void ForgetBuffer(GraphicsID id);
+    void ForgetProgram(GraphicsID id);
+    void ForgetRenderBuffer(GraphicsID id);
+    void ForgetFrameBuffer(GraphicsID id);
+    void ForgetTexture(GraphicsID id);
+#pragma endregion
 }
\ No newline at end of file
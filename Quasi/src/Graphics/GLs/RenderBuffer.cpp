@@ -1,6 +1,7 @@
 #include "RenderBuffer.h"
 #include <glp.h>
 #include "GLDebug.h"
+#include "Render.h"
 #include "TextureConstants.h"
 
 namespace Quasi::Graphics {
@@ -16,14 +17,15 @@ namespace Quasi::Graphics {
     }
 
     void RenderBuffer::DestroyObject(GraphicsID id) {
+        Render::ForgetRenderBuffer(id);
         QGLCall$(GL::DeleteRenderbuffers(1, &id));
     }
 
     void RenderBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindRenderbuffer(GL::RENDERBUFFER, id));
+        Render::BindRenderBuffer(id);
     }
 
     void RenderBuffer::UnbindObject() {
-        QGLCall$(GL::BindRenderbuffer(GL::RENDERBUFFER, 0));
+        Render::BindRenderBuffer(0);
     }
 }
@@ -28,15 +28,16 @@ namespace Quasi::Graphics {
     }
 
     void ShaderProgram::DestroyObject(GraphicsID id) {
+        Render::ForgetProgram(id);
         QGLCall$(GL::DeleteProgram(id));
     }
 
     void ShaderProgram::BindObject(GraphicsID id) {
-        QGLCall$(GL::UseProgram(id));
+        Render::BindProgram(id);
     }
 
     void ShaderProgram::UnbindObject() {
-        QGLCall$(GL::UseProgram(0));
+        Render::BindProgram(0);
     }
 
     int ShaderProgram::GetUniformLocation(CStr name) const {
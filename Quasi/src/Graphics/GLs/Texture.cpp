@@ -14,15 +14,16 @@ namespace Quasi::Graphics {
     }
 
     void TextureBase::DestroyObject(GraphicsID id) {
+        Render::ForgetTexture(id);
         QGLCall$(GL::DeleteTextures(1, &id));
     }
 
     void TextureBase::BindObject(TextureTarget target, GraphicsID id) {
-        QGLCall$(GL::BindTexture((int)target, id));
+        Render::BindTexture(target, id);
     }
 
     void TextureBase::UnbindObject(TextureTarget target) {
-        QGLCall$(GL::BindTexture((int)target, 0));
+        Render::BindTexture(target, 0);
     }
 
     void TextureBase::SetSample(TextureTarget target, TextureSample sample) {
@@ -66,8 +67,7 @@ namespace Quasi::Graphics {
     }
 
     void TextureBase::Activate(TextureTarget target, int slot) const {
-        QGLCall$(GL::ActiveTexture(GL::TEXTURE0 + slot));
-        BindObject(target, rendererID);
+        Render::BindTextureToSlot(target, rendererID, slot);
     }
 
     TextureBase::TextureBase(GraphicsID id) : GLObject(id) {}
@@ -144,8 +144,7 @@ namespace Quasi::Graphics {
 
     template <TextureTarget Target>
     void TextureObject<Target>::Activate(int slot) {
-        QGLCall$(GL::ActiveTexture(GL::TEXTURE0 + slot));
-        Bind();
+        Render::BindTextureToSlot(Target, rendererID, slot);
     }
 
     template <TextureTarget Target>
@@ -2,6 +2,7 @@
 
 #include <glp.h>
 #include "GLDebug.h"
+#include "Render.h"
 
 namespace Quasi::Graphics {
     VertexArray::VertexArray(GraphicsID id) : GLObject(id) {}
@@ -13,34 +14,47 @@ namespace Quasi::Graphics {
     }
 
     void VertexArray::DestroyObject(const GraphicsID id) {
+        Render::ForgetVertexArray(id);
         QGLCall$(GL::DeleteVertexArrays(1, &id));
     }
 
     void VertexArray::BindObject(const GraphicsID id) {
-        QGLCall$(GL::BindVertexArray(id));
+        Render::BindVertexArray(id);
     }
 
     void VertexArray::UnbindObject() {
-        QGLCall$(GL::BindVertexArray(0));
+        Render::BindVertexArray(0);
     }
 
     void VertexArray::AddBuffer(const VertexBufferLayout& layout) {
+        AddAttributes(layout, 0, 0);
+    }
+
+    void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout) {
+        Bind();
+        vb.Bind();
+        AddBuffer(layout);
+    }
+
+    void VertexArray::AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, u32 firstAttribute) {
+        Bind();
+        vb.Bind();
+        AddAttributes(layout, firstAttribute, 1);
+    }
+
+    void VertexArray::AddAttributes(const VertexBufferLayout& layout, u32 firstAttribute, u32 divisor) {
         const Vec<VertexBufferComponent>& elements = layout.GetComponents();
         usize offset = 0;
         for (u32 i = 0; i < elements.Length(); i++) {
             const auto& elem = elements[i];
-            QGLCall$(GL::EnableVertexAttribArray(i));
+            const u32 attrib = firstAttribute + i;
+            QGLCall$(GL::EnableVertexAttribArray(attrib));
             if (elem.integer)
-                QGLCall$(GL::VertexAttribIPointer(i, elem.count, elem.type->glID, layout.GetStride(), (const void*)offset));
+                QGLCall$(GL::VertexAttribIPointer(attrib, elem.count, elem.type->glID, layout.GetStride(), (const void*)offset));
             else
-                QGLCall$(GL::VertexAttribPointer(i, elem.count, elem.type->glID, elem.norm, layout.GetStride(), (const void*)offset));
+                QGLCall$(GL::VertexAttribPointer(attrib, elem.count, elem.type->glID, elem.norm, layout.GetStride(), (const void*)offset));
+            if (divisor) QGLCall$(GL::VertexAttribDivisor(attrib, divisor));
             offset += elem.width;
         }
     }
-
-    void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout) {
-        Bind();
-        vb.Bind();
-        AddBuffer(layout);
-    }
 }
@@ -14,6 +14,12 @@ namespace Quasi::Graphics {
 
         void AddBuffer(const VertexBufferLayout& layout);
         void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+        // attributes that advance once per instance instead of once per vertex,
+        // numbered from firstAttribute so they go after the vertex buffer's
+        void AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, u32 firstAttribute);
+    private:
+        static void AddAttributes(const VertexBufferLayout& layout, u32 firstAttribute, u32 divisor);
+    public:
 
         friend class GraphicsDevice;
     };
@@ -3,6 +3,7 @@
 #include <glp.h>
 
 #include "GLDebug.h"
+#include "Render.h"
 
 namespace Quasi::Graphics {
     VertexBuffer::VertexBuffer(GraphicsID id, u32 size) : GLObject(id), bufferSize(size) {}
@@ -16,20 +17,21 @@ namespace Quasi::Graphics {
     }
 
     void VertexBuffer::DestroyObject(GraphicsID id) {
+        Render::ForgetBuffer(id);
         QGLCall$(GL::DeleteBuffers(1, &id));
     }
 
     void VertexBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindBuffer(GL::ARRAY_BUFFER, id));
+        Render::BindVertexBuffer(id);
     }
 
     void VertexBuffer::UnbindObject() {
-        QGLCall$(GL::BindBuffer(GL::ARRAY_BUFFER, 0));
+        Render::BindVertexBuffer(0);
     }
 
-    void VertexBuffer::SetDataBytes(Span<const byte> data) {
+    void VertexBuffer::SetDataBytes(Span<const byte> data, u32 byteOffset) {
         Bind();
-        QGLCall$(GL::BufferSubData(GL::ARRAY_BUFFER, 0, (int)data.ByteSize(), data.Data()));
+        QGLCall$(GL::BufferSubData(GL::ARRAY_BUFFER, (int)byteOffset, (int)data.ByteSize(), data.Data()));
     }
 
     void VertexBuffer::ClearData() {
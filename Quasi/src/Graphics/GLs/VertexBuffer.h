@@ -18,7 +18,7 @@ namespace Quasi::Graphics {
 
         u32 GetLength() const { return bufferSize; }
 
-        void SetDataBytes(Span<const byte> data);
+        void SetDataBytes(Span<const byte> data, u32 byteOffset = 0);
         template <class T> void SetData(Span<const T> data) { SetDataBytes(data.AsBytes()); }
         template <ContinuousCollectionAny T> void SetData(const T& data) { SetData(data.AsSpan()); }
 
@@ -1,4 +1,7 @@
 ﻿#pragma once
+#include <cstddef>
+
+#include "Utils/Math/BatchTransform.h"
 #include "Utils/Math/Transform2D.h"
 #include "Utils/Math/Transform3D.h"
 #include "VertexBufferLayout.h"
@@ -16,10 +19,18 @@
         Q_IF_ARGS_ELSE((__VA_ARGS__), (return __VA_ARGS__(_tr);), ( \
             return T { Q_INVOKE(Q_ARGS_SKIP, Q_ITERATE_SEQUENCE(Q_GL_VERTTRANS_IT, MEMBS)) }; \
         ))\
+    } \
+    static void MulBatch(Span<T> _vs, const Math::ITransformation##DIM auto& _tr) { \
+        Q_IF_ARGS_ELSE((__VA_ARGS__), (for (T& _v : _vs) _v = _v.Mul(_tr);), ( \
+            Q_ITERATE_SEQUENCE(Q_GL_VERTBATCH_IT, MEMBS) \
+        ))\
     }
 
 #define Q_GL_VERTTRANS_IT(MX) , .Q_ARGS_FIRST MX = Q_GL_VERTTRANS_WHEN_T MX
 #define Q_GL_VERTTRANS_WHEN_T(M, ...) __VA_OPT__(Quasi::Graphics::Transform##__VA_ARGS__ Q_LPAREN() ) M __VA_OPT__(, _tr Q_RPAREN())
+#define Q_GL_VERTBATCH_IT(MX) Q_GL_VERTBATCH_WHEN_T MX
+#define Q_GL_VERTBATCH_WHEN_T(M, ...) __VA_OPT__(Quasi::Graphics::Transform##__VA_ARGS__##Batch<decltype(Self::M)> Q_LPAREN() \
+    Quasi::Memory::TransmutePtr<byte>(_vs.Data()) + offsetof(Self, M), sizeof(Self), _vs.Length(), _tr Q_RPAREN();)
 #define Q_GL_VERTLAYOUT_IT(X_) , decltype(Self:: Q_ARGS_FIRST X_)
 
 #define QuasiDefineVertex$(...) Q_GL_DEFINE_VERTEX(__VA_ARGS__)
@@ -33,6 +44,32 @@ namespace Quasi::Graphics {
     T TransformNormal(const T& n, const auto& transform) { return transform.TransformNormal(n); }
     template <class T> T&& TransfromCustom(T&& custom) { return (T&&)custom; }
 
+    // the same over every vertex of a span at once, matrix transforms get the simd kernels
+    template <class T>
+    void TransformPositionBatch(byte* data, usize stride, usize count, const auto& transform) {
+        using Tf = RemQual<decltype(transform)>;
+        if constexpr (SameAs<Tf, Math::MatrixTransform2D> && SameAs<T, Math::fv2>)
+            Math::BatchTransform::Points2D(data, stride, count, transform.transform);
+        else if constexpr (SameAs<Tf, Math::MatrixTransform3D> && SameAs<T, Math::fv3>)
+            Math::BatchTransform::Points3D(data, stride, count, transform.transform);
+        else for (usize i = 0; i < count; ++i) {
+            T& p = *Memory::TransmutePtr<T>(data + i * stride);
+            p = transform.Transform(p);
+        }
+    }
+    template <class T>
+    void TransformNormalBatch(byte* data, usize stride, usize count, const auto& transform) {
+        using Tf = RemQual<decltype(transform)>;
+        if constexpr (SameAs<Tf, Math::MatrixTransform2D> && SameAs<T, Math::fv2>)
+            Math::BatchTransform::Normals2D(data, stride, count, transform.normalMatrix);
+        else if constexpr (SameAs<Tf, Math::MatrixTransform3D> && SameAs<T, Math::fv3>)
+            Math::BatchTransform::Normals3D(data, stride, count, transform.normalMatrix);
+        else for (usize i = 0; i < count; ++i) {
+            T& n = *Memory::TransmutePtr<T>(data + i * stride);
+            n = transform.TransformNormal(n);
+        }
+    }
+
     struct Vertex2D {
         Math::fv2 Position;
 
@@ -499,6 +499,12 @@ namespace Quasi::Graphics {
         v.Position = canvas.TransformToWorldSpace(v.Position);
         canvas.renderCanvas->PushVertex(v);
     }
+    void Canvas::Batch::PushVs(Span<const UIVertex> vs) {
+        if (vs.IsEmpty()) return;
+        const usize begin = mesh.vertices.Length();
+        mesh.vertices.Extend(vs);
+        Math::BatchTransform::Points2D(Memory::TransmutePtr<byte>(&mesh.vertices[begin].Position), sizeof(UIVertex), vs.Length(), canvas.WorldSpaceMatrix());
+    }
     UIVertex& Canvas::Batch::VertAt(u32 i)             { return mesh.vertices[i]; }
     const UIVertex& Canvas::Batch::VertAt(u32 i) const { return mesh.vertices[i]; }
     u32 Canvas::Batch::VertCount() const { return mesh.vertices.Length(); }
@@ -533,8 +539,7 @@ namespace Quasi::Graphics {
         canvas.textures[canvas.usedTextures] = textureID;
         storedPoint.RenderPrim |= UIRender::TEXTURE_ID * (canvas.usedTextures + 1);
 
-        GL::ActiveTexture(GL::TEXTURE0 + canvas.usedTextures);
-        GL::BindTexture(GL::TEXTURE_2D, textureID);
+        Render::BindTextureToSlot(TextureTarget::_2D, textureID, (int)canvas.usedTextures);
 
         ++canvas.usedTextures;
     }
@@ -702,14 +707,12 @@ namespace Quasi::Graphics {
                         dim   = rsize * scaling;
 
         SetPrim(UIRender::SDF);
-        SetTextureCoord(uv.min.x, uv.min.y);
-        Push({ start.x,         start.y });
-        SetTextureCoord(uv.max.x, uv.min.y);
-        Push({ start.x + dim.x, start.y });
-        SetTextureCoord(uv.max.x, uv.max.y);
-        Push({ start.x + dim.x, start.y - dim.y });
-        SetTextureCoord(uv.min.x, uv.max.y);
-        Push({ start.x,         start.y - dim.y });
+        UIVertex quad[4] = { storedPoint, storedPoint, storedPoint, storedPoint };
+        quad[0].Position = { start.x,         start.y };         quad[0].TexCoord = { uv.min.x, uv.min.y };
+        quad[1].Position = { start.x + dim.x, start.y };         quad[1].TexCoord = { uv.max.x, uv.min.y };
+        quad[2].Position = { start.x + dim.x, start.y - dim.y }; quad[2].TexCoord = { uv.max.x, uv.max.y };
+        quad[3].Position = { start.x,         start.y - dim.y }; quad[3].TexCoord = { uv.min.x, uv.max.y };
+        PushVs(Spans::Vals(quad));
         Quad(0, 1, 2, 3);
 
         Refresh();
@@ -1533,6 +1536,13 @@ namespace Quasi::Graphics {
         return transform * point;
     }
 
+    Math::Matrix2D Canvas::WorldSpaceMatrix() const {
+        // not Transform2D::TransformMatrix, that one scales after rotating
+        return Math::Matrix2D::FromColumns({ transform.rotation.Rotate({ transform.scale.x, 0 }).AddZ(0),
+                                             transform.rotation.Rotate({ 0, transform.scale.y }).AddZ(0),
+                                             transform.position.AddZ(1) });
+    }
+
     void Canvas::Update(float dt) {
         (void)dt;
 
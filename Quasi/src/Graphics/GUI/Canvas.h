@@ -117,6 +117,8 @@ namespace Quasi::Graphics {
             UIVertex storedPoint;
 
             void PushV(UIVertex v);
+            // like PushV for every vertex, but the positions are all transformed in one go
+            void PushVs(Span<const UIVertex> vs);
             void ResizeV(u32) const {}
             void ReserveV(u32) const {}
             UIVertex& VertAt(u32 i);
@@ -262,6 +264,8 @@ namespace Quasi::Graphics {
         PushStylesScope PushStyles();
 
         Math::fv2 TransformToWorldSpace(const Math::fv2& point) const;
+        // the same transform as a matrix, for moving a lot of points at once
+        Math::Matrix2D WorldSpaceMatrix() const;
 
         void Update(float dt);
         void AddInteractable(Ref<Interactable> inter);
@@ -40,7 +40,12 @@ namespace Quasi::Graphics {
     }
 
     GraphicsDevice::~GraphicsDevice() {
-        if (IsClosed()) return;
+        // a headless device never opened a window, but its renders still have to go
+        // before the slot map does, since deleting one reaches back into it
+        if (IsClosed()) {
+            DeleteAllRenders();
+            return;
+        }
         Quit();
         Terminate();
     }
@@ -60,6 +65,8 @@ namespace Quasi::Graphics {
         dest.fontDevice = std::move(from.fontDevice);
         dest.ioDevice = std::move(from.ioDevice);
         dest.randDevice = from.randDevice;
+        dest.frameArena = std::move(from.frameArena);
+        dest.jobSystem = std::move(from.jobSystem);
 
         Instance = dest;
     }
@@ -78,12 +85,13 @@ namespace Quasi::Graphics {
         RenderInMode(renderOptions.renderMode);
 
         ioDevice.Update();
+        if (jobSystem) jobSystem->RunMainThreadJobs();
 
         renderOptions.drawCalls = 0;
     }
 
     void GraphicsDevice::End() {
-        if (IsClosed()) return;
+        if (IsClosed()) return NextFrame();
 
         const auto end = Debug::Timer::Now();
         frameDurationTime = end - frameBeginTime;
@@ -94,20 +102,27 @@ namespace Quasi::Graphics {
         glfwPollEvents();
             
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        // imgui's backend sets its own state, so nothing we remember can be trusted anymore
+        Render::InvalidateState();
             
         glfwSwapBuffers(mainWindow);
+
+        NextFrame();
+    }
+
+    void GraphicsDevice::NextFrame() {
+        if (frameArena) frameArena->NextFrame();
+        if (jobSystem) jobSystem->NextFrame();
     }
     
-    void GraphicsDevice::BindRender(RenderData& render) {
+    void GraphicsDevice::BindRender(RenderData& render, SlotKey key) {
         render.device = *this;
-        render.deviceIndex = (u32)(renders.Length() - 1);
+        render.deviceKey = key;
     }
 
-    void GraphicsDevice::DeleteRender(u32 index) {
-        renders[index]->device = nullptr;
-        renders.Pop(index);
-        for (u32 i = index; i < renders.Length(); ++i)
-            renders[i]->deviceIndex = i;
+    void GraphicsDevice::DeleteRender(SlotKey key) {
+        renders[key]->device = nullptr;
+        renders.Remove(key);
     }
 
     void GraphicsDevice::DeleteAllRenders() {
@@ -116,8 +131,12 @@ namespace Quasi::Graphics {
         renders.Clear();
     }
 
-    RenderData& GraphicsDevice::GetRender(u32 index) {
-        return *renders[index];
+    RenderData& GraphicsDevice::GetRender(SlotKey key) {
+        return *renders[key];
+    }
+
+    bool RenderIsAlive(SlotKey key) {
+        return GraphicsDevice::Instance && GraphicsDevice::Instance->HasRender(key);
     }
 
     void GraphicsDevice::Render(RenderData& r, Shader& s, const ShaderArgs& args, bool setDefaultShaderArgs) {
@@ -265,7 +284,7 @@ namespace Quasi::Graphics {
         if (ImGui::BeginTabItem("Data")) {
             u32 vCount = 0, tCount = 0;
             for (u32 i = 0; i < renders.Length(); ++i) {
-                const RenderHandle& data = renders[i];
+                const RenderHandle& data = renders.Values()[i];
                 vCount += data->vbo.dataOffset;
                 tCount += data->ibo.dataOffset / 3;
                 if (ImGui::TreeNode((const void*)(intptr_t)i, "Render #%d", i)) {
@@ -277,6 +296,35 @@ namespace Quasi::Graphics {
             }
             ImGui::Text("Total: %d Vertices (bytes), %d Triangles", vCount, tCount);
             ImGui::Text("Draw Calls: %d", renderOptions.drawCalls);
+
+            ImGui::BulletText("Frame Arena");
+            ImGui::Indent();
+            if (frameArena) {
+                const Memory::LinearArena& lastFrame = frameArena->Previous();
+                ImGui::Text("Last Frame: %zu / %zu KiB, %zu Allocations", lastFrame.Used() / 1024, lastFrame.Capacity() / 1024, lastFrame.AllocationCount());
+                ImGui::Text("High Water: %zu KiB", std::max(lastFrame.HighWater(), frameArena->Current().HighWater()) / 1024);
+                if (lastFrame.OverflowCount())
+                    ImGui::TextColored({ 1, 0.4f, 0.4f, 1 }, "%zu Allocations Spilled to the Heap", lastFrame.OverflowCount());
+            } else ImGui::Text("Unused");
+            ImGui::Unindent();
+            ImGui::EndTabItem();
+        }
+
+        if (ImGui::BeginTabItem("Jobs")) {
+            if (!jobSystem) ImGui::Text("Not Started");
+            else {
+                const Jobs::JobSystem& jobs = *jobSystem;
+                ImGui::Text("%u Workers (Main Thread Included)", jobs.WorkerCount());
+                ImGui::Text("Main Thread Only Jobs: %llu", (unsigned long long)jobs.LastFrameMainJobs());
+                for (u32 i = 0; i < jobs.WorkerCount(); ++i) {
+                    const Jobs::JobStats& stats = jobs.LastFrameStats(i);
+                    ImGui::BulletText(i ? "Worker #%u" : "Main Thread", i);
+                    ImGui::Indent();
+                    ImGui::Text("%llu Executed, %llu Stolen, %llu Sleeps",
+                        (unsigned long long)stats.executed, (unsigned long long)stats.stolen, (unsigned long long)stats.sleeps);
+                    ImGui::Unindent();
+                }
+            }
             ImGui::EndTabItem();
         }
 
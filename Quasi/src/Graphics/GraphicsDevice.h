@@ -6,6 +6,8 @@
 #include "IO/IO.h"
 #include "Utils/Math/Random.h"
 #include "Utils/Box.h"
+#include "Utils/Arena.h"
+#include "Utils/JobSystem.h"
 #include "Fonts/FontDevice.h"
 
 namespace Quasi::Graphics {
@@ -31,7 +33,7 @@ namespace Quasi::Graphics {
 
         using RenderHandle = Box<RenderData>;
     private:
-        Vec<RenderHandle> renders;
+        SlotMap<RenderHandle> renders;
 
         Math::iv2 windowSize;
         GLFWwindow* mainWindow;
@@ -46,8 +48,11 @@ namespace Quasi::Graphics {
         FontDevice fontDevice = {};
         IO::IO ioDevice { *this };
         Math::RandomGenerator randDevice {};
+        Box<Memory::FrameArena> frameArena;
+        Box<Jobs::JobSystem> jobSystem;
 
         friend IO::IO;
+        friend bool RenderIsAlive(SlotKey key);
 
         Debug::DateTime frameBeginTime;
         Debug::TimeDuration frameDurationTime;
@@ -55,6 +60,7 @@ namespace Quasi::Graphics {
         inline static OptRef<GraphicsDevice> Instance;
         inline static bool ShowDebugMenu = false;
     public:
+        // a null window makes a headless device, with no input and nothing to draw to. only for tests and benchmarks
         explicit GraphicsDevice(GLFWwindow* window, Math::iv2 winSize);
 
         void Quit();
@@ -68,23 +74,25 @@ namespace Quasi::Graphics {
         GraphicsDevice& operator=(GraphicsDevice&& gd) noexcept { Transfer(*this, std::move(gd)); return *this; }
 
         void Begin();
+        // a headless device has nothing to present, but still moves on to the next frame
         void End();
 
         template <class T> RenderObject<T> CreateNewRender(usize vsize = MAX_VERTEX_COUNT, usize isize = MAX_INDEX_COUNT);
-        void BindRender(RenderData& render);
-        void DeleteRender(u32 index);
+        void BindRender(RenderData& render, SlotKey key);
+        void DeleteRender(SlotKey key);
         void DeleteAllRenders();
-        RenderData& GetRender(u32 index);
+        bool HasRender(SlotKey key) const { return renders.Contains(key); }
+        RenderData& GetRender(SlotKey key);
 
         void Render(RenderData& r, Shader& s, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true);
         void Render(RenderData& r, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) { Render(r, r.shader, args, setDefaultShaderArgs); }
-        void Render(u32 index, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) { Render(GetRender(index), args, setDefaultShaderArgs); }
+        void Render(SlotKey key, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) { Render(GetRender(key), args, setDefaultShaderArgs); }
         void RenderInstanced(RenderData& r, int instances, Shader& s, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true);
         void RenderInstanced(RenderData& r, int instances, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) {
             RenderInstanced(r, instances, r.shader, args, setDefaultShaderArgs);
         }
-        void RenderInstanced(u32 index, int instances, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) {
-            RenderInstanced(GetRender(index), instances, args, setDefaultShaderArgs);
+        void RenderInstanced(SlotKey key, int instances, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) {
+            RenderInstanced(GetRender(key), instances, args, setDefaultShaderArgs);
         }
 
         void ClearColor(const Math::fColor& color);
@@ -108,6 +116,7 @@ namespace Quasi::Graphics {
         void DebugMenu();
     private:
         void ShowDebugWindow();
+        void NextFrame();
     public:
 
         static GraphicsDevice& GetDeviceInstance() { return *Instance; }
@@ -117,14 +126,27 @@ namespace Quasi::Graphics {
         const IO::IO& GetIO() const { return ioDevice; }
         Math::RandomGenerator& GetRand() { return randDevice; }
         const Math::RandomGenerator& GetRand() const { return randDevice; }
+        // for transient data, whatever's allocated here lives until the end of the next frame.
+        // use with Memory::ArenaScope scope { gd.GetFrameArena() };
+        // the arena only gets allocated the first time this is called
+        Memory::LinearArena& GetFrameArena() {
+            if (!frameArena) frameArena = Box<Memory::FrameArena>::Build();
+            return frameArena->Current();
+        }
+        // jobs scheduled on main run at the start of every frame.
+        // the workers only get started the first time this is called, which has to be from the main thread
+        Jobs::JobSystem& GetJobs() {
+            if (!jobSystem) jobSystem = Box<Jobs::JobSystem>::Build();
+            return *jobSystem;
+        }
 
         static GraphicsDevice Initialize(Math::iv2 winSize = { 640, 480 }, const WindowArgs& windowArgs = {});
     };
 
     template <class T>
     RenderObject<T> GraphicsDevice::CreateNewRender(usize vsize, usize isize) {
-        renders.Push(Box<RenderData>::Build(*this, vsize, 3 * isize, sizeof(T), VertexLayoutOf<T>()));
-        BindRender(*renders.LastMut());
-        return *renders.LastMut();
+        const SlotKey key = renders.Insert(Box<RenderData>::Build(*this, vsize, 3 * isize, sizeof(T), VertexLayoutOf<T>()));
+        BindRender(*renders[key], key);
+        return *renders[key];
     }
 }
@@ -53,7 +53,7 @@ namespace Quasi::Graphics {
             PushVertices(vs);
             for (u32 i = begin + 1; i < vertices.Length() - 1; ++i) PushIndex({ begin, i, i + 1 });
         }
-        void PushPolygon(IList<Vtx> vs) { PushPolygon(Span { vs }); }
+        void PushPolygon(IList<Vtx> vs) { PushPolygon(Spans::FromIList(vs)); }
 
         template <FnArgs<const Vtx&> F>
         Mesh<FuncResult<F, const Vtx&>> GeometryConvert(F&& geometryPass) && {
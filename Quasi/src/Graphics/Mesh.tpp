@@ -3,10 +3,7 @@
 
 namespace Quasi::Graphics {
     template <IVertex Vtx> Mesh<Vtx>& Mesh<Vtx>::EmbedTransform() {
-        const auto transform = modelTransform.TransformMatrix().AsTransform();
-        for (auto& v : vertices) {
-            v = v.Mul(transform);
-        }
+        Vtx::MulBatch(vertices.AsSpan(), modelTransform.TransformMatrix().AsTransform());
         modelTransform = {};
         return *this;
     }
@@ -16,10 +13,11 @@ namespace Quasi::Graphics {
     void Mesh<Vtx>::AddTo(RenderData& rd) const {
         rd.PushIndicesOffseted(indices, sizeof(Vtx));
 
-        const auto transform = modelTransform.TransformMatrix().AsTransform();
-        for (const Vtx& v : vertices) {
-            rd.PushVertex(v.Mul(transform));
-        }
+        // copied over as is, then transformed in place all at once
+        Vtx* out = Memory::TransmutePtr<Vtx>(rd.vertexData.Data() + rd.vertexOffset);
+        Memory::MemCopyNoOverlap(out, vertices.Data(), vertices.ByteSize());
+        rd.vertexOffset += vertices.ByteSize();
+        Vtx::MulBatch(Span<Vtx>::Slice(out, vertices.Length()), modelTransform.TransformMatrix().AsTransform());
     }
 
     template <IVertex Vtx>
@@ -0,0 +1,259 @@
+#include "MeshOptimizer.h"
+
+#include "Utils/Algorithm.h"
+
+namespace Quasi::Graphics::MeshOptimizer {
+    CacheStats AnalyzeVertexCache(Span<const TriIndices> indices, usize vertexCount, u32 cacheSize) {
+        // a vertex is still cached if less than cacheSize vertices were transformed since it was
+        Vec<u32> timestamps = Vec<u32>::WithSize(vertexCount);
+        Memory::MemSet(timestamps.Data(), 0, timestamps.ByteSize());
+
+        u32 time = cacheSize + 1;
+        for (const TriIndices& tri : indices) {
+            for (const u32 v : { tri.i, tri.j, tri.k }) {
+                if (time - timestamps[v] > cacheSize)
+                    timestamps[v] = time++;
+            }
+        }
+
+        const u32 transformed = time - (cacheSize + 1);
+        usize unique = 0;
+        for (const u32 t : timestamps) unique += t != 0;
+
+        return {
+            .transformedVertices = transformed,
+            .acmr = indices.IsEmpty() ? 0 : (float)transformed / (float)indices.Length(),
+            .atvr = unique == 0 ? 0 : (float)transformed / (float)unique,
+        };
+    }
+
+    void OptimizeVertexCache(Span<TriIndices> indices, usize vertexCount) {
+        static constexpr u32 CACHE_SIZE = 32, MAX_VALENCE = 32, NONE = -1;
+        static constexpr float LAST_TRI_SCORE = 0.75f, VALENCE_BOOST_SCALE = 2.0f;
+
+        const usize triCount = indices.Length();
+        if (triCount == 0) return;
+
+        // scores from the paper, tabled so the inner loop doesnt call pow/sqrt
+        static const Array<float, CACHE_SIZE> CACHE_SCORES = [] {
+            Array<float, CACHE_SIZE> scores;
+            for (u32 i = 0; i < CACHE_SIZE; ++i)
+                scores[i] = i < 3 ? LAST_TRI_SCORE : std::pow(1.0f - (float)(i - 3) / (float)(CACHE_SIZE - 3), 1.5f);
+            return scores;
+        } ();
+        static const Array<float, MAX_VALENCE + 1> VALENCE_SCORES = [] {
+            Array<float, MAX_VALENCE + 1> scores;
+            scores[0] = 0;
+            for (u32 i = 1; i <= MAX_VALENCE; ++i)
+                scores[i] = VALENCE_BOOST_SCALE / std::sqrt((float)i);
+            return scores;
+        } ();
+        const auto vertexScore = [&] (u32 cachePos, u32 liveTris) {
+            if (liveTris == 0) return -1.0f; // no triangles left to draw
+            return (cachePos < CACHE_SIZE ? CACHE_SCORES[cachePos] : 0.0f) +
+                   VALENCE_SCORES[std::min(liveTris, MAX_VALENCE)];
+        };
+
+        // every triangle that still uses each vertex, packed per vertex.
+        // emitted triangles get swapped past the live count of each of their vertices
+        Vec<u32> liveCount = Vec<u32>::WithSize(vertexCount);
+        Memory::MemSet(liveCount.Data(), 0, liveCount.ByteSize());
+        for (const TriIndices& tri : indices) {
+            ++liveCount[tri.i]; ++liveCount[tri.j]; ++liveCount[tri.k];
+        }
+
+        Vec<u32> adjOffset = Vec<u32>::WithSize(vertexCount + 1);
+        adjOffset[0] = 0;
+        for (usize v = 0; v < vertexCount; ++v) adjOffset[v + 1] = adjOffset[v] + liveCount[v];
+
+        Vec<u32> adjacency = Vec<u32>::WithSize(triCount * 3);
+        {
+            Vec<u32> fill = Vec<u32>::New(adjOffset.AsSpan());
+            for (u32 t = 0; t < triCount; ++t) {
+                adjacency[fill[indices[t].i]++] = t;
+                adjacency[fill[indices[t].j]++] = t;
+                adjacency[fill[indices[t].k]++] = t;
+            }
+        }
+
+        Vec<u32> cachePos = Vec<u32>::WithSize(vertexCount);
+        Vec<float> vertScore = Vec<float>::WithSize(vertexCount);
+        for (usize v = 0; v < vertexCount; ++v) {
+            cachePos[v] = NONE;
+            vertScore[v] = vertexScore(NONE, liveCount[v]);
+        }
+
+        Vec<float> triScore = Vec<float>::WithSize(triCount);
+        Vec<bool> emitted = Vec<bool>::WithSize(triCount);
+        u32 bestTri = 0;
+        for (u32 t = 0; t < triCount; ++t) {
+            const TriIndices& tri = indices[t];
+            triScore[t] = vertScore[tri.i] + vertScore[tri.j] + vertScore[tri.k];
+            emitted[t] = false;
+            if (triScore[t] > triScore[bestTri]) bestTri = t;
+        }
+
+        Vec<TriIndices> output = Vec<TriIndices>::WithCap(triCount);
+        u32 cache[CACHE_SIZE + 3];
+        u32 cacheCount = 0;
+        u32 scanCursor = 0;
+
+        while (output.Length() < triCount) {
+            if (bestTri == NONE) {
+                // dead end, none of the cached vertices have triangles left.
+                // everything before the cursor was emitted, so this stays linear overall
+                while (emitted[scanCursor]) ++scanCursor;
+                bestTri = scanCursor;
+            }
+
+            const TriIndices tri = indices[bestTri];
+            output.Push(tri);
+            emitted[bestTri] = true;
+
+            for (const u32 v : { tri.i, tri.j, tri.k }) {
+                u32* const adj = &adjacency[adjOffset[v]];
+                const u32 live = liveCount[v]--;
+                for (u32 i = 0; i < live; ++i) {
+                    if (adj[i] != bestTri) continue;
+                    std::swap(adj[i], adj[live - 1]);
+                    break;
+                }
+            }
+
+            // the new triangle goes to the front, everything else shifts back
+            u32 newCache[CACHE_SIZE + 3];
+            u32 newCount = 0;
+            newCache[newCount++] = tri.i;
+            if (tri.j != tri.i)                   newCache[newCount++] = tri.j;
+            if (tri.k != tri.i && tri.k != tri.j) newCache[newCount++] = tri.k;
+            for (u32 i = 0; i < cacheCount; ++i) {
+                const u32 v = cache[i];
+                if (v != tri.i && v != tri.j && v != tri.k) newCache[newCount++] = v;
+            }
+
+            // rescore everything that moved, including vertices that just got pushed out
+            for (u32 i = 0; i < newCount; ++i) {
+                const u32 v = newCache[i];
+                cachePos[v] = i < CACHE_SIZE ? i : NONE;
+                const float score = vertexScore(cachePos[v], liveCount[v]), delta = score - vertScore[v];
+                vertScore[v] = score;
+                for (u32 a = adjOffset[v]; a < adjOffset[v] + liveCount[v]; ++a)
+                    triScore[adjacency[a]] += delta;
+            }
+
+            cacheCount = std::min(newCount, CACHE_SIZE);
+            Memory::MemCopyNoOverlap(cache, newCache, cacheCount * sizeof(u32));
+
+            bestTri = NONE;
+            float bestScore = -1;
+            for (u32 i = 0; i < cacheCount; ++i) {
+                const u32 v = cache[i];
+                for (u32 a = adjOffset[v]; a < adjOffset[v] + liveCount[v]; ++a) {
+                    const u32 t = adjacency[a];
+                    if (triScore[t] > bestScore) { bestScore = triScore[t]; bestTri = t; }
+                }
+            }
+        }
+
+        indices.CloneFrom(output);
+    }
+
+    void OptimizeOverdraw(Span<TriIndices> indices, Span<const Math::fv3> positions, float threshold) {
+        static constexpr u32 CACHE_SIZE = 16;
+        const usize triCount = indices.Length();
+        if (triCount == 0) return;
+
+        Vec<u32> timestamps = Vec<u32>::WithSize(positions.Length());
+        Memory::MemSet(timestamps.Data(), 0, timestamps.ByteSize());
+        u32 time = CACHE_SIZE + 1;
+        const auto simulate = [&] (const TriIndices& tri) {
+            u32 misses = 0;
+            for (const u32 v : { tri.i, tri.j, tri.k }) {
+                if (time - timestamps[v] > CACHE_SIZE) { timestamps[v] = time++; ++misses; }
+            }
+            return misses;
+        };
+        const auto flush = [&] { time += CACHE_SIZE + 1; };
+
+        // hard boundaries are where the cache got fully missed, so reordering there is free
+        Vec<u32> hardClusters;
+        for (u32 t = 0; t < triCount; ++t) {
+            if (simulate(indices[t]) == 3) hardClusters.Push(t);
+        }
+        hardClusters.Push(triCount);
+
+        // soft boundaries split hard clusters further, wherever the cache efficiency so far is close enough
+        Vec<u32> clusters;
+        for (u32 c = 0; c + 1 < hardClusters.Length(); ++c) {
+            const u32 begin = hardClusters[c], end = hardClusters[c + 1];
+
+            flush();
+            u32 clusterMisses = 0;
+            for (u32 t = begin; t < end; ++t) clusterMisses += simulate(indices[t]);
+            const float clusterAcmr = (float)clusterMisses / (float)(end - begin);
+
+            flush();
+            clusters.Push(begin);
+            u32 runningMisses = 0, runningTris = 0;
+            for (u32 t = begin; t < end; ++t) {
+                runningMisses += simulate(indices[t]);
+                ++runningTris;
+                if (t + 1 < end && (float)runningMisses / (float)runningTris <= clusterAcmr * threshold) {
+                    clusters.Push(t + 1);
+                    flush();
+                    runningMisses = runningTris = 0;
+                }
+            }
+        }
+        clusters.Push(triCount);
+
+        // clusters facing away from the mesh center are likely to be in front of the rest
+        Math::fv3 meshCenter;
+        for (const Math::fv3& p : positions) meshCenter += p;
+        meshCenter /= (float)std::max<usize>(positions.Length(), 1);
+
+        const usize clusterCount = clusters.Length() - 1;
+        Vec<float> sortKeys = Vec<float>::WithCap(clusterCount);
+        for (u32 c = 0; c < clusterCount; ++c) {
+            Math::fv3 center, normal;
+            float area = 0;
+            for (u32 t = clusters[c]; t < clusters[c + 1]; ++t) {
+                const Math::fv3 &a = positions[indices[t].i], &b = positions[indices[t].j], &k = positions[indices[t].k];
+                const Math::fv3 n = (b - a).Cross(k - a);
+                const float triArea = n.Len();
+                center += (a + b + k) * (triArea / 3.0f);
+                normal += n;
+                area += triArea;
+            }
+            center = area > 0 ? center / area : positions[indices[clusters[c]].i];
+            sortKeys.Push(normal.NearZero() ? 0.0f : (center - meshCenter).Dot(normal.Norm()));
+        }
+
+        Vec<u32> order = Vec<u32>::WithCap(clusterCount);
+        for (u32 c = 0; c < clusterCount; ++c) order.Push(c);
+        order.SortByKey([&] (u32 c) { return -sortKeys[c]; });
+
+        Vec<TriIndices> output = Vec<TriIndices>::WithCap(triCount);
+        for (const u32 c : order)
+            output.Extend(indices.Subspan(clusters[c], clusters[c + 1] - clusters[c]));
+        indices.CloneFrom(output);
+    }
+
+    Vec<u32> OptimizeVertexFetch(Span<TriIndices> indices, usize vertexCount) {
+        static constexpr u32 UNUSED = -1;
+        Vec<u32> remap = Vec<u32>::WithSize(vertexCount);
+        for (u32& r : remap) r = UNUSED;
+
+        Vec<u32> order = Vec<u32>::WithCap(vertexCount);
+        for (TriIndices& tri : indices) {
+            for (u32* v : { &tri.i, &tri.j, &tri.k }) {
+                if (remap[*v] == UNUSED) {
+                    remap[*v] = (u32)order.Length();
+                    order.Push(*v);
+                }
+                *v = remap[*v];
+            }
+        }
+        return order;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Mesh.h"
+
+namespace Quasi::Graphics::MeshOptimizer {
+    struct CacheStats {
+        u32 transformedVertices = 0;
+        float acmr = 0; // average cache miss ratio, transforms per triangle. 0.5 is ideal for large grids, 3 is the worst
+        float atvr = 0; // average transform to vertex ratio, 1 is ideal
+    };
+
+    // simulates a fifo post-transform cache, like most hardware has
+    CacheStats AnalyzeVertexCache(Span<const TriIndices> indices, usize vertexCount, u32 cacheSize = 16);
+
+    // tom forsyth's linear-speed vertex cache optimisation
+    // https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+    void OptimizeVertexCache(Span<TriIndices> indices, usize vertexCount);
+
+    // reorders clusters of triangles so that ones facing outward from the mesh draw first,
+    // which hides more of the mesh behind itself. cache efficiency may only drop by the threshold.
+    // expects indices to already be cache optimized, as in Sander et al. 'Fast Triangle Reordering'
+    void OptimizeOverdraw(Span<TriIndices> indices, Span<const Math::fv3> positions, float threshold = 1.05f);
+
+    // renumbers vertices in the order the indices first use them, so vertex fetches are mostly sequential.
+    // returns the old index of every new vertex, unused vertices are dropped
+    Vec<u32> OptimizeVertexFetch(Span<TriIndices> indices, usize vertexCount);
+
+    struct OptimizeOptions {
+        bool vertexCache = true;
+        bool overdraw = false; // only for 3d meshes
+        bool vertexFetch = true;
+        float overdrawThreshold = 1.05f;
+    };
+
+    struct OptimizeReport {
+        CacheStats before, after;
+    };
+
+    template <IVertex Vtx>
+    OptimizeReport Optimize(Mesh<Vtx>& mesh, const OptimizeOptions& options = {}) {
+        OptimizeReport report;
+        report.before = AnalyzeVertexCache(mesh.indices, mesh.vertices.Length());
+
+        if (options.vertexCache)
+            OptimizeVertexCache(mesh.indices, mesh.vertices.Length());
+
+        if constexpr (Vtx::DIMENSION == 3) {
+            if (options.overdraw) {
+                const Vec<Math::fv3> positions = mesh.vertices.MapEach([] (const Vtx& v) { return v.Position; });
+                OptimizeOverdraw(mesh.indices, positions, options.overdrawThreshold);
+            }
+        }
+
+        if (options.vertexFetch) {
+            Vec<u32> order = OptimizeVertexFetch(mesh.indices, mesh.vertices.Length());
+            mesh.vertices = order.MapEach([&] (u32 i) { return mesh.vertices[i]; });
+        }
+
+        report.after = AnalyzeVertexCache(mesh.indices, mesh.vertices.Length());
+        return report;
+    }
+}
@@ -0,0 +1,140 @@
+#include "Meshlets.h"
+
+#include "CameraController3D.h"
+
+namespace Quasi::Graphics::Meshlets {
+    MeshletSet Build(Span<const TriIndices> indices, Span<const Math::fv3> positions, u32 maxVertices, u32 maxTriangles) {
+        static constexpr u8 NONE = 0xFF;
+        // local indices are bytes, and NONE is taken
+        maxVertices  = std::clamp(maxVertices, 3u, 255u);
+        maxTriangles = std::max(maxTriangles, 1u);
+
+        MeshletSet set;
+        set.meshlets.Reserve(indices.Length() / maxTriangles + 1);
+        set.triangles.Reserve(indices.Length() * 3);
+
+        // where each global vertex is in the current meshlet
+        Vec<u8> localIndex = Vec<u8>::WithSize(positions.Length());
+        Memory::MemSet(localIndex.Data(), NONE, localIndex.ByteSize());
+
+        const auto computeBounds = [&] (Meshlet& m) {
+            const Span<const u32> verts = set.vertices.Subspan(m.vertexOffset, m.vertexCount);
+            Math::fv3 min = positions[verts[0]], max = min;
+            for (const u32 v : verts) {
+                const Math::fv3& p = positions[v];
+                min = { std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z) };
+                max = { std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z) };
+            }
+            m.center = (min + max) * 0.5f;
+            float radiusSq = 0;
+            for (const u32 v : verts) radiusSq = std::max(radiusSq, (positions[v] - m.center).LenSq());
+            m.radius = std::sqrt(radiusSq);
+
+            // the cone has to contain every triangle normal, degenerate triangles dont face anywhere
+            Math::fv3 axis;
+            const u8* tris = &set.triangles[m.triangleOffset * 3];
+            for (u32 t = 0; t < m.triangleCount; ++t, tris += 3) {
+                const Math::fv3 &a = positions[verts[tris[0]]], &b = positions[verts[tris[1]]], &c = positions[verts[tris[2]]];
+                const Math::fv3 n = (b - a).Cross(c - a);
+                if (!n.NearZero()) axis += n.Norm();
+            }
+            m.coneCutoff = 1;
+            if (axis.NearZero()) return;
+            m.coneAxis = axis.Norm();
+
+            float minDot = 1;
+            tris = &set.triangles[m.triangleOffset * 3];
+            for (u32 t = 0; t < m.triangleCount; ++t, tris += 3) {
+                const Math::fv3 &a = positions[verts[tris[0]]], &b = positions[verts[tris[1]]], &c = positions[verts[tris[2]]];
+                const Math::fv3 n = (b - a).Cross(c - a);
+                if (!n.NearZero()) minDot = std::min(minDot, n.Norm().Dot(m.coneAxis));
+            }
+            // anything spreading past 90 degrees is always partly facing the camera
+            if (minDot > 0) m.coneCutoff = std::sqrt(1 - minDot * minDot);
+        };
+
+        Meshlet current;
+        const auto finish = [&] {
+            if (current.triangleCount == 0) return;
+            for (const u32 v : set.vertices.Skip(current.vertexOffset)) localIndex[v] = NONE;
+            computeBounds(current);
+            set.meshlets.Push(current);
+            current = {};
+            current.vertexOffset   = (u32)set.vertices.Length();
+            current.triangleOffset = (u32)set.TriangleCount();
+        };
+
+        for (const TriIndices& tri : indices) {
+            const u32 newVerts = (localIndex[tri.i] == NONE) +
+                                 (localIndex[tri.j] == NONE && tri.j != tri.i) +
+                                 (localIndex[tri.k] == NONE && tri.k != tri.i && tri.k != tri.j);
+            if (current.vertexCount + newVerts > maxVertices || current.triangleCount + 1 > maxTriangles)
+                finish();
+
+            for (const u32 v : { tri.i, tri.j, tri.k }) {
+                if (localIndex[v] == NONE) {
+                    localIndex[v] = (u8)current.vertexCount++;
+                    set.vertices.Push(v);
+                }
+                set.triangles.Push(localIndex[v]);
+            }
+            ++current.triangleCount;
+        }
+        finish();
+        return set;
+    }
+
+    Frustum Frustum::FromMatrix(const Math::Matrix3D& viewProjection) {
+        const Math::fv4 x = viewProjection.GetRow(0), y = viewProjection.GetRow(1),
+                        z = viewProjection.GetRow(2), w = viewProjection.GetRow(3);
+        Frustum frustum { { w + x, w - x, w + y, w - y, w + z, w - z } };
+        for (Math::fv4& p : frustum.planes) {
+            const float len = Math::fv3 { p.x, p.y, p.z }.Len();
+            if (len > 0) p /= len;
+        }
+        return frustum;
+    }
+
+    Frustum Frustum::FromCamera(const CameraController3D& camera, float aspect) {
+        return FromMatrix(camera.GetProjMat(aspect) * camera.GetViewMat());
+    }
+
+    bool Frustum::IntersectsSphere(const Math::fv3& center, float radius) const {
+        for (const Math::fv4& p : planes) {
+            if (p.x * center.x + p.y * center.y + p.z * center.z + p.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    CullStats Cull(const MeshletSet& set, const Frustum& frustum, const Math::fv3& cameraPosition,
+                   Vec<TriIndices>& out, bool backfaceCulling) {
+        CullStats stats;
+        out.Clear();
+        out.Reserve(set.TriangleCount());
+
+        for (const Meshlet& m : set.meshlets) {
+            if (!frustum.IntersectsSphere(m.center, m.radius)) {
+                ++stats.frustumCulled;
+                continue;
+            }
+            if (backfaceCulling && m.coneCutoff < 1) {
+                // every triangle faces away if the whole sphere is outside the cone, as seen from the camera
+                const Math::fv3 toCenter = m.center - cameraPosition;
+                if (toCenter.Dot(m.coneAxis) >= m.coneCutoff * toCenter.Len() + m.radius) {
+                    ++stats.backfaceCulled;
+                    continue;
+                }
+            }
+
+            const u32* verts = &set.vertices[m.vertexOffset];
+            const u8* tris = &set.triangles[m.triangleOffset * 3];
+            for (u32 t = 0; t < m.triangleCount; ++t, tris += 3)
+                out.Push({ verts[tris[0]], verts[tris[1]], verts[tris[2]] });
+
+            ++stats.visibleMeshlets;
+            stats.visibleTriangles += m.triangleCount;
+        }
+        return stats;
+    }
+}
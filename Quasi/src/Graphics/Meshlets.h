@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Mesh.h"
+
+namespace Quasi::Graphics {
+    class CameraController3D;
+}
+
+namespace Quasi::Graphics::Meshlets {
+    // a small cluster of triangles, sized so a whole cluster can be culled at once.
+    // vertices are indices into the original mesh, triangles index into the cluster's own vertices
+    struct Meshlet {
+        u32 vertexOffset = 0, vertexCount = 0;
+        u32 triangleOffset = 0, triangleCount = 0;
+
+        Math::fv3 center; // bounding sphere
+        float radius = 0;
+        Math::fv3 coneAxis; // average facing of the triangles
+        float coneCutoff = 1; // sin of the cone's spread, 1 means it can never be backface culled
+    };
+
+    struct MeshletSet {
+        static constexpr u32 MAX_VERTICES = 64, MAX_TRIANGLES = 124;
+
+        Vec<Meshlet> meshlets;
+        Vec<u32> vertices;  // global vertex index for every meshlet vertex
+        Vec<u8> triangles;  // 3 local vertex indices per triangle
+
+        usize TriangleCount() const { return triangles.Length() / 3; }
+    };
+
+    // fills meshlets greedily in index order, so run OptimizeVertexCache before this for tighter clusters
+    MeshletSet Build(Span<const TriIndices> indices, Span<const Math::fv3> positions,
+                     u32 maxVertices = MeshletSet::MAX_VERTICES, u32 maxTriangles = MeshletSet::MAX_TRIANGLES);
+
+    struct Frustum {
+        // left, right, bottom, top, near, far. xyz is the inward normal, w the offset
+        Array<Math::fv4, 6> planes;
+
+        // gribb & hartmann plane extraction, the frustum ends up in whatever space the matrix maps from
+        static Frustum FromMatrix(const Math::Matrix3D& viewProjection);
+        static Frustum FromCamera(const CameraController3D& camera, float aspect);
+
+        bool IntersectsSphere(const Math::fv3& center, float radius) const;
+    };
+
+    struct CullStats {
+        u32 visibleMeshlets = 0, visibleTriangles = 0;
+        u32 frustumCulled = 0, backfaceCulled = 0;
+    };
+
+    // writes every triangle of every surviving meshlet into out (in global vertex indices), replacing its contents.
+    // the frustum and camera position have to be in the same space as the positions the set was built with
+    CullStats Cull(const MeshletSet& set, const Frustum& frustum, const Math::fv3& cameraPosition,
+                   Vec<TriIndices>& out, bool backfaceCulling = true);
+
+    template <IVertex Vtx>
+    MeshletSet BuildMeshlets(const Mesh<Vtx>& mesh,
+                             u32 maxVertices = MeshletSet::MAX_VERTICES, u32 maxTriangles = MeshletSet::MAX_TRIANGLES) {
+        static_assert(Vtx::DIMENSION == 3, "meshlets are only built for 3d meshes");
+        Vec<Math::fv3> positions = Vec<Math::fv3>::WithCap(mesh.vertices.Length());
+        for (const Vtx& v : mesh.vertices) positions.Push(v.Position);
+        return Build(mesh.indices, positions, maxVertices, maxTriangles);
+    }
+}
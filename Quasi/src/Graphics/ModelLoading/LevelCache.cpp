@@ -0,0 +1,110 @@
+#include "LevelCache.h"
+
+#include <bit>
+
+#include "Utils/CStr.h"
+
+namespace Quasi::Graphics {
+    // layout, all little-endian:
+    // header (80 bytes)
+    //    0 u64 magic, 8 u32 version, 12 u32 tile count,
+    //   16 u64 source size, 24 i64 source modification time, 32 u64 total file size,
+    //   40 i32[3] bound min, 52 i32[3] bound max, 64 u32 name length, 68 u32 description length, 72 u64 (reserved)
+    // tiles (16 bytes each), right after the header so they stay aligned
+    //    0 i32[3] position, 12 u32 type
+    // then the name and the description
+
+    static_assert(sizeof(LevelTile) == 16 && alignof(LevelTile) == 4, "level tiles are mapped as-is");
+    static_assert(std::endian::native == std::endian::little, "level tiles are mapped as-is");
+
+    String LevelCache::CachePathOf(Str sourcePath) {
+        String path = sourcePath;
+        path += EXTENSION;
+        path.AddNullTerm();
+        return path;
+    }
+
+    bool LevelCache::Write(CStr cachePath, const LevelData& level, const Text::FileInfo& source) {
+        const usize tilesSize = level.tiles.ByteSize();
+        const usize size = HEADER_SIZE + tilesSize + level.name.Length() + level.description.Length();
+
+        Vec<byte> out = Vec<byte>::WithSize(size);
+        Memory::MemSet(out.Data(), 0, HEADER_SIZE);
+        byte* const base = out.Data();
+
+        Memory::WriteU64(MAGIC,                         base + 0);
+        Memory::WriteU32(VERSION,                       base + 8);
+        Memory::WriteU32((u32)level.tiles.Length(),     base + 12);
+        Memory::WriteU64(source.size,                   base + 16);
+        Memory::WriteI64(source.lastModified,           base + 24);
+        Memory::WriteU64(size,                          base + 32);
+        for (u32 i = 0; i < 3; ++i) {
+            Memory::WriteI32(level.boundMin[i],         base + 40 + i * 4);
+            Memory::WriteI32(level.boundMax[i],         base + 52 + i * 4);
+        }
+        Memory::WriteU32((u32)level.name.Length(),        base + 64);
+        Memory::WriteU32((u32)level.description.Length(), base + 68);
+
+        Memory::MemCopyNoOverlap(base + HEADER_SIZE, level.tiles.Data(), tilesSize);
+        Memory::MemCopyNoOverlap(base + HEADER_SIZE + tilesSize, level.name.Data(), level.name.Length());
+        Memory::MemCopyNoOverlap(base + HEADER_SIZE + tilesSize + level.name.Length(),
+                                 level.description.Data(), level.description.Length());
+
+        return Text::WriteFileBinary(cachePath, out);
+    }
+
+    LevelCache LevelCache::Open(CStr cachePath, const Text::FileInfo& source) {
+        LevelCache cache { Text::MappedFile::Open(cachePath) };
+        if (cache.IsNull() || !cache.IsValid(source)) return {};
+        return cache;
+    }
+
+    bool LevelCache::IsValid(const Text::FileInfo& source) const {
+        const byte* const base = file.Data();
+        const usize size = file.Length();
+        if (size < HEADER_SIZE) return false;
+        if (Memory::ReadU64(base + 0)  != MAGIC ||
+            Memory::ReadU32(base + 8)  != VERSION ||
+            Memory::ReadU64(base + 16) != source.size ||
+            Memory::ReadI64(base + 24) != source.lastModified ||
+            Memory::ReadU64(base + 32) != size)
+            return false;
+        // the tile count and the string lengths have to add up to the whole file
+        return HEADER_SIZE + (u64)Memory::ReadU32(base + 12) * sizeof(LevelTile) +
+               Memory::ReadU32(base + 64) + Memory::ReadU32(base + 68) == size;
+    }
+
+    Str LevelCache::Name() const {
+        const byte* const base = file.Data();
+        return Str::Slice((const char*)base + HEADER_SIZE + Tiles().ByteSize(), Memory::ReadU32(base + 64));
+    }
+
+    Str LevelCache::Description() const {
+        const byte* const base = file.Data();
+        return Str::Slice((const char*)base + HEADER_SIZE + Tiles().ByteSize() + Memory::ReadU32(base + 64),
+                          Memory::ReadU32(base + 68));
+    }
+
+    Math::iv3 LevelCache::BoundMin() const {
+        const byte* const base = file.Data();
+        return { Memory::ReadI32(base + 40), Memory::ReadI32(base + 44), Memory::ReadI32(base + 48) };
+    }
+
+    Math::iv3 LevelCache::BoundMax() const {
+        const byte* const base = file.Data();
+        return { Memory::ReadI32(base + 52), Memory::ReadI32(base + 56), Memory::ReadI32(base + 60) };
+    }
+
+    Span<const LevelTile> LevelCache::Tiles() const {
+        const byte* const base = file.Data();
+        return Span<const LevelTile>::Slice(Memory::TransmutePtr<const LevelTile>(base + HEADER_SIZE), Memory::ReadU32(base + 12));
+    }
+
+    void LevelCache::LoadInto(LevelData& level) const {
+        level.name        = Name();
+        level.description = Description();
+        level.boundMin    = BoundMin();
+        level.boundMax    = BoundMax();
+        level.tiles       = Vec<LevelTile>::New(Tiles());
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Utils/MappedFile.h"
+#include "Utils/Text.h"
+#include "Utils/Math/Vector.h"
+
+namespace Quasi::Graphics {
+    // a tile is stored exactly like this on disk, so the tile block is read straight out of the mapping
+    struct LevelTile {
+        Math::iv3 position;
+        u32 type;
+    };
+
+    struct LevelData {
+        String name, description;
+        Math::iv3 boundMin, boundMax;
+        Vec<LevelTile> tiles;
+    };
+
+    // a level packed into a flat binary, so big levels load without touching json.
+    // everything is little-endian, the layout is described in LevelCache.cpp
+    class LevelCache {
+        static constexpr u64 MAGIC = "QUASILVL"_u64;
+        static constexpr usize HEADER_SIZE = 80;
+
+        Text::MappedFile file;
+
+        explicit LevelCache(Text::MappedFile file) : file(std::move(file)) {}
+    public:
+        static constexpr u32 VERSION = 1;
+        static constexpr Str EXTENSION = ".qlevel";
+
+        LevelCache() = default;
+
+        // null if the cache is missing, corrupted, or wasn't made from a source with this size and time
+        static LevelCache Open(CStr cachePath, const Text::FileInfo& source);
+        static bool Write(CStr cachePath, const LevelData& level, const Text::FileInfo& source);
+        static String CachePathOf(Str sourcePath);
+
+        bool IsNull() const { return file.IsNull(); }
+
+        Str Name() const;
+        Str Description() const;
+        Math::iv3 BoundMin() const;
+        Math::iv3 BoundMax() const;
+        // points into the mapping, no copies
+        Span<const LevelTile> Tiles() const;
+
+        void LoadInto(LevelData& level) const;
+    private:
+        bool IsValid(const Text::FileInfo& source) const;
+    };
+}
@@ -0,0 +1,85 @@
+#include "LevelLoader.h"
+
+#include "Utils/CStr.h"
+#include "Utils/Debug/Logger.h"
+
+namespace Quasi::Graphics {
+    void LevelLoader::LoadFile(CStr filepath) {
+        const Option<Text::FileInfo> source = useCache ? Text::GetFileInfo(filepath) : nullptr;
+        const String cachePath = source ? LevelCache::CachePathOf(filepath) : String {};
+        if (source) {
+            const LevelCache cache = LevelCache::Open(CStr::FromUnchecked(cachePath), *source);
+            if (!cache.IsNull()) {
+                cache.LoadInto(level);
+                return;
+            }
+        }
+
+        const Text::MappedFile file = Text::MappedFile::Open(filepath);
+        Debug::Assert(!file.IsNull(), "couldn't open level file {}", filepath);
+        const bool loaded = Load(file.AsStr());
+        Debug::Assert(loaded, "couldn't load level file {}: {}", filepath, error);
+
+        if (source) LevelCache::Write(CStr::FromUnchecked(cachePath), level, *source);
+    }
+
+    bool LevelLoader::Load(Str json) {
+        error.Clear();
+        level = {};
+        const Option<Text::JsonDocument> doc = parser.Parse(json);
+        if (!doc) {
+            error = Text::Format("{} at byte {}", parser.Error(), parser.ErrorOffset());
+            return false;
+        }
+
+        const Text::JsonValue root = doc->Root();
+        if (!root.IsObject()) return Fail("a level has to be an object");
+        const auto asStr = [] (Text::JsonValue v) { return v.AsStr(); };
+        level.name        = root.Get("LevelName")  .AndThen(asStr).UnwrapOr(Str::Empty());
+        level.description = root.Get("Description").AndThen(asStr).UnwrapOr(Str::Empty());
+
+        const Option<Text::JsonValue> tiles = root.Get("Tiles");
+        if (!tiles || !tiles->IsArray()) return Fail("a level needs a Tiles array");
+        level.tiles.Reserve(tiles->Length());
+        usize i = 0;
+        for (const Text::JsonValue tile : tiles->Elements()) {
+            const Option<Math::iv3> position = tile.Get("Position").AndThen(ReadVector);
+            const Option<i64> type = tile.Get("Type").AndThen([] (Text::JsonValue v) { return v.AsInt(); });
+            if (!position) return Fail("Position has to be 3 integers", i);
+            if (!type || *type < 0 || *type > u32s::MAX) return Fail("Type has to be a positive integer", i);
+            level.tiles.Push({ *position, (u32)*type });
+            ++i;
+        }
+
+        // bounds are optional, they default to fitting every tile
+        const Option<Math::iv3> boundMin = root.Get("BoundMin").AndThen(ReadVector),
+                                boundMax = root.Get("BoundMax").AndThen(ReadVector);
+        Math::iv3 min = level.tiles ? level.tiles[0].position : Math::iv3 {}, max = min;
+        if (!boundMin || !boundMax) {
+            for (const LevelTile& t : level.tiles) {
+                min = Math::iv3::Min(min, t.position);
+                max = Math::iv3::Max(max, t.position);
+            }
+        }
+        level.boundMin = boundMin.UnwrapOr(min);
+        level.boundMax = boundMax.UnwrapOr(max);
+        return true;
+    }
+
+    Option<Math::iv3> LevelLoader::ReadVector(Text::JsonValue value) {
+        if (value.Length() != 3) return nullptr;
+        Math::iv3 v;
+        u32 i = 0;
+        for (const Text::JsonValue component : value.Elements()) {
+            const Option<i64> x = component.AsInt();
+            if (!x || *x < i32s::MIN || *x > i32s::MAX) return nullptr;
+            v[i++] = (int)*x;
+        }
+        return v;
+    }
+
+    bool LevelLoader::Fail(Str message, usize tile) {
+        error = tile == (usize)-1 ? String { message } : Text::Format("tile #{}: {}", tile, message);
+        return false;
+    }
+}
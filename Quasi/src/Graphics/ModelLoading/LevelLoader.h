@@ -0,0 +1,35 @@
+#pragma once
+
+#include "LevelCache.h"
+
+#include "Utils/Text/Json.h"
+
+namespace Quasi::Graphics {
+    // loads the json levels in res/levels:
+    // { "LevelName": "..", "Description": "..", "BoundMin": [x, y, z], "BoundMax": [x, y, z],
+    //   "Tiles": [ { "Position": [x, y, z], "Type": n }, .. ] }
+    class LevelLoader {
+        Text::JsonParser parser;
+        LevelData level;
+        String error;
+        bool useCache = true;
+    public:
+        LevelLoader() = default;
+
+        // reuses (or writes) a binary cache next to the file, see LevelCache
+        void LoadFile(CStr filepath);
+        // false if the json is invalid or isnt shaped like a level, see Error
+        bool Load(Str json);
+
+        void UseCache(bool enabled) { useCache = enabled; }
+        Str Error() const { return error; }
+
+        LevelData& GetLevel() { return level; }
+        const LevelData& GetLevel() const { return level; }
+
+        LevelData&& RetrieveLevel() { return std::move(level); }
+    private:
+        static Option<Math::iv3> ReadVector(Text::JsonValue value);
+        bool Fail(Str message, usize tile = -1);
+    };
+}
@@ -0,0 +1,256 @@
+#include "OBJModelCache.h"
+
+#include <bit>
+
+#include "Utils/CStr.h"
+
+namespace Quasi::Graphics {
+    // layout, all little-endian:
+    // header (64 bytes)
+    //    0 u64 magic, 8 u32 version, 12 u32 object count, 16 u32 material count, 20 u32 dependency count,
+    //   24 u64 source size, 32 i64 source modification time, 40 u64 total file size,
+    //   48 u32 vertex stride, 52 u32 index stride, 56 u32 vertex layout tag, 60 u32 (reserved)
+    // objects (48 bytes each)
+    //    0 u64 vertex block offset, 8 u64 index block offset, 16 u64 name offset,
+    //   24 u32 vertex count, 28 u32 triangle count, 32 u32 name length, 36 i32 material index,
+    //   40 u32 flags (bit 0 = smooth shading), 44 u32 (reserved)
+    // materials (80 bytes each)
+    //    0 u64 name offset, 8 u32 name length, 12 i32 illum,
+    //   16 f32[3] Ka, 28 f32[3] Kd, 40 f32[3] Ks, 52 f32[3] Ke, 64 f32 Ns, 68 f32 Ni, 72 f32 d, 76 u32 (reserved)
+    // dependencies (32 bytes each), the files besides the source that the model was built from
+    //    0 u64 path offset, 8 u32 path length, 12 u32 (reserved), 16 u64 size, 24 i64 modification time
+    // then every name and path packed together, then the vertex and index blocks, each aligned to BLOCK_ALIGN
+
+    // vertices and indices are stored as their in-memory representation
+    static_assert(std::endian::native == std::endian::little, "mesh cache blocks are mapped as-is");
+
+    String OBJModelCache::CachePathOf(Str sourcePath) {
+        String path = sourcePath;
+        path += EXTENSION;
+        path.AddNullTerm();
+        return path;
+    }
+
+    u32 OBJModelCache::VertexLayoutTag() {
+        u32 tag = 0;
+        for (const VertexBufferComponent& comp : OBJVertex::VERTEX_LAYOUT.GetComponents())
+            tag = tag * 31 + (comp.type->glID << 8 | comp.count << 2 | (u32)comp.norm << 1 | (u32)comp.integer);
+        return tag;
+    }
+
+    bool OBJModelCache::Write(CStr cachePath, const OBJModel& model, const Text::FileInfo& source,
+                              Span<const String> dependencies) {
+        const usize objectCount = model.objects.Length(), materialCount = model.materials.Length(),
+                    dependencyCount = dependencies.Length();
+        const auto alignUp = [] (usize x) { return (x + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1); };
+
+        Vec<Text::FileInfo> dependencyInfos = Vec<Text::FileInfo>::WithCap(dependencyCount);
+        for (const String& path : dependencies) {
+            const Option<Text::FileInfo> info = Text::GetFileInfo(CStr::FromUnchecked(path));
+            if (!info) return false;
+            dependencyInfos.Push(*info);
+        }
+
+        usize size = HEADER_SIZE + objectCount * OBJECT_SIZE + materialCount * MATERIAL_SIZE +
+                     dependencyCount * DEPENDENCY_SIZE;
+        const usize namesOffset = size;
+        for (const OBJObject&   obj : model.objects)   size += obj.name.Length();
+        for (const MTLMaterial& mat : model.materials) size += mat.name.Length();
+        for (const String&     path : dependencies)    size += path.Length();
+        for (const OBJObject& obj : model.objects) {
+            size = alignUp(size) + obj.mesh.vertices.ByteSize();
+            size = alignUp(size) + obj.mesh.indices.ByteSize();
+        }
+
+        Vec<byte> out = Vec<byte>::WithSize(size);
+        Memory::MemSet(out.Data(), 0, size);
+        byte* const base = out.Data();
+
+        Memory::WriteU64(MAGIC,                 base + 0);
+        Memory::WriteU32(VERSION,               base + 8);
+        Memory::WriteU32((u32)objectCount,      base + 12);
+        Memory::WriteU32((u32)materialCount,    base + 16);
+        Memory::WriteU32((u32)dependencyCount,  base + 20);
+        Memory::WriteU64(source.size,           base + 24);
+        Memory::WriteI64(source.lastModified,   base + 32);
+        Memory::WriteU64(size,                  base + 40);
+        Memory::WriteU32(sizeof(OBJVertex),     base + 48);
+        Memory::WriteU32(sizeof(TriIndices),    base + 52);
+        Memory::WriteU32(VertexLayoutTag(),     base + 56);
+
+        usize nameOffset = namesOffset, blockOffset = namesOffset;
+        for (const OBJObject&   obj : model.objects)   blockOffset += obj.name.Length();
+        for (const MTLMaterial& mat : model.materials) blockOffset += mat.name.Length();
+        for (const String&     path : dependencies)    blockOffset += path.Length();
+
+        byte* record = base + HEADER_SIZE;
+        for (const OBJObject& obj : model.objects) {
+            const usize vertexOffset = alignUp(blockOffset);
+            const usize indexOffset  = alignUp(vertexOffset + obj.mesh.vertices.ByteSize());
+            blockOffset = indexOffset + obj.mesh.indices.ByteSize();
+
+            Memory::WriteU64(vertexOffset,                      record + 0);
+            Memory::WriteU64(indexOffset,                       record + 8);
+            Memory::WriteU64(nameOffset,                        record + 16);
+            Memory::WriteU32((u32)obj.mesh.vertices.Length(),   record + 24);
+            Memory::WriteU32((u32)obj.mesh.indices.Length(),    record + 28);
+            Memory::WriteU32((u32)obj.name.Length(),            record + 32);
+            Memory::WriteI32(obj.materialIndex,                 record + 36);
+            Memory::WriteU32(obj.smoothShading ? 1 : 0,         record + 40);
+
+            Memory::MemCopyNoOverlap(base + nameOffset,   obj.name.Data(),          obj.name.Length());
+            Memory::MemCopyNoOverlap(base + vertexOffset, obj.mesh.vertices.Data(), obj.mesh.vertices.ByteSize());
+            Memory::MemCopyNoOverlap(base + indexOffset,  obj.mesh.indices.Data(),  obj.mesh.indices.ByteSize());
+            nameOffset += obj.name.Length();
+            record += OBJECT_SIZE;
+        }
+
+        for (const MTLMaterial& mat : model.materials) {
+            Memory::WriteU64(nameOffset,             record + 0);
+            Memory::WriteU32((u32)mat.name.Length(), record + 8);
+            Memory::WriteI32(mat.illum,              record + 12);
+            const Math::fColor3* colors[] = { &mat.Ka, &mat.Kd, &mat.Ks, &mat.Ke };
+            for (u32 c = 0; c < 4; ++c) {
+                Memory::WriteU32(f32s::BitsOf(colors[c]->r), record + 16 + c * 12);
+                Memory::WriteU32(f32s::BitsOf(colors[c]->g), record + 20 + c * 12);
+                Memory::WriteU32(f32s::BitsOf(colors[c]->b), record + 24 + c * 12);
+            }
+            Memory::WriteU32(f32s::BitsOf(mat.Ns), record + 64);
+            Memory::WriteU32(f32s::BitsOf(mat.Ni), record + 68);
+            Memory::WriteU32(f32s::BitsOf(mat.d),  record + 72);
+
+            Memory::MemCopyNoOverlap(base + nameOffset, mat.name.Data(), mat.name.Length());
+            nameOffset += mat.name.Length();
+            record += MATERIAL_SIZE;
+        }
+
+        for (usize i = 0; i < dependencyCount; ++i) {
+            const Str path = dependencies[i];
+            Memory::WriteU64(nameOffset,                        record + 0);
+            Memory::WriteU32((u32)path.Length(),                record + 8);
+            Memory::WriteU64(dependencyInfos[i].size,           record + 16);
+            Memory::WriteI64(dependencyInfos[i].lastModified,   record + 24);
+
+            Memory::MemCopyNoOverlap(base + nameOffset, path.Data(), path.Length());
+            nameOffset += path.Length();
+            record += DEPENDENCY_SIZE;
+        }
+
+        return Text::WriteFileBinary(cachePath, out);
+    }
+
+    OBJModelCache OBJModelCache::Open(CStr cachePath, const Text::FileInfo& source) {
+        OBJModelCache cache { Text::MappedFile::Open(cachePath) };
+        if (cache.IsNull() || !cache.IsValid(source)) return {};
+        return cache;
+    }
+
+    bool OBJModelCache::IsValid(const Text::FileInfo& source) const {
+        const byte* const base = file.Data();
+        const usize size = file.Length();
+        if (size < HEADER_SIZE) return false;
+        if (Memory::ReadU64(base + 0)  != MAGIC ||
+            Memory::ReadU32(base + 8)  != VERSION ||
+            Memory::ReadU64(base + 24) != source.size ||
+            Memory::ReadI64(base + 32) != source.lastModified ||
+            Memory::ReadU64(base + 40) != size ||
+            Memory::ReadU32(base + 48) != sizeof(OBJVertex) ||
+            Memory::ReadU32(base + 52) != sizeof(TriIndices) ||
+            Memory::ReadU32(base + 56) != VertexLayoutTag())
+            return false;
+
+        const usize objectCount = ObjectCount(), materialCount = MaterialCount(),
+                    dependencyCount = Memory::ReadU32(base + 20);
+        if (HEADER_SIZE + objectCount * OBJECT_SIZE + materialCount * MATERIAL_SIZE +
+            dependencyCount * DEPENDENCY_SIZE > size) return false;
+
+        // bounds check everything once here, so the getters can trust the records
+        const auto inBounds = [&] (u64 offset, u64 length) { return offset <= size && length <= size - offset; };
+        const byte* record = base + HEADER_SIZE;
+        for (usize i = 0; i < objectCount; ++i, record += OBJECT_SIZE) {
+            const u64 vertexOffset = Memory::ReadU64(record + 0),
+                      indexOffset  = Memory::ReadU64(record + 8);
+            if (vertexOffset % BLOCK_ALIGN || indexOffset % BLOCK_ALIGN) return false;
+            if (!inBounds(vertexOffset, (u64)Memory::ReadU32(record + 24) * sizeof(OBJVertex)) ||
+                !inBounds(indexOffset,  (u64)Memory::ReadU32(record + 28) * sizeof(TriIndices)) ||
+                !inBounds(Memory::ReadU64(record + 16), Memory::ReadU32(record + 32)))
+                return false;
+        }
+        for (usize i = 0; i < materialCount; ++i, record += MATERIAL_SIZE) {
+            if (!inBounds(Memory::ReadU64(record + 0), Memory::ReadU32(record + 8)))
+                return false;
+        }
+        for (usize i = 0; i < dependencyCount; ++i, record += DEPENDENCY_SIZE) {
+            const u64 pathOffset = Memory::ReadU64(record + 0), pathLength = Memory::ReadU32(record + 8);
+            if (!inBounds(pathOffset, pathLength)) return false;
+
+            String path = Str::Slice((const char*)base + pathOffset, pathLength);
+            path.AddNullTerm();
+            const Option<Text::FileInfo> info = Text::GetFileInfo(CStr::FromUnchecked(path));
+            if (!info || info->size != Memory::ReadU64(record + 16) || info->lastModified != Memory::ReadI64(record + 24))
+                return false;
+        }
+        return true;
+    }
+
+    usize OBJModelCache::ObjectCount() const {
+        return Memory::ReadU32(file.Data() + 12);
+    }
+
+    usize OBJModelCache::MaterialCount() const {
+        return Memory::ReadU32(file.Data() + 16);
+    }
+
+    OBJModelCache::ObjectView OBJModelCache::GetObject(usize i) const {
+        const byte* const base = file.Data();
+        const byte* const record = base + HEADER_SIZE + i * OBJECT_SIZE;
+        return {
+            .name = Str::Slice((const char*)base + Memory::ReadU64(record + 16), Memory::ReadU32(record + 32)),
+            .vertices = Span<const OBJVertex>::Slice(
+                Memory::TransmutePtr<const OBJVertex>(base + Memory::ReadU64(record + 0)), Memory::ReadU32(record + 24)),
+            .indices = Span<const TriIndices>::Slice(
+                Memory::TransmutePtr<const TriIndices>(base + Memory::ReadU64(record + 8)), Memory::ReadU32(record + 28)),
+            .materialIndex = Memory::ReadI32(record + 36),
+            .smoothShading = (Memory::ReadU32(record + 40) & 1) != 0,
+        };
+    }
+
+    MTLMaterial OBJModelCache::GetMaterial(usize i) const {
+        const byte* const base = file.Data();
+        const byte* const record = base + HEADER_SIZE + ObjectCount() * OBJECT_SIZE + i * MATERIAL_SIZE;
+        const auto readFloat = [&] (usize offset) { return f32s::FromBits(Memory::ReadU32(record + offset)); };
+        const auto readColor = [&] (usize offset) {
+            return Math::fColor3 { readFloat(offset), readFloat(offset + 4), readFloat(offset + 8) };
+        };
+
+        MTLMaterial mat;
+        mat.name = Str::Slice((const char*)base + Memory::ReadU64(record + 0), Memory::ReadU32(record + 8));
+        mat.illum = Memory::ReadI32(record + 12);
+        mat.Ka = readColor(16);
+        mat.Kd = readColor(28);
+        mat.Ks = readColor(40);
+        mat.Ke = readColor(52);
+        mat.Ns = readFloat(64);
+        mat.Ni = readFloat(68);
+        mat.d  = readFloat(72);
+        return mat;
+    }
+
+    void OBJModelCache::LoadInto(OBJModel& model) const {
+        const usize materialBase = model.materials.Length();
+        for (usize i = 0; i < MaterialCount(); ++i)
+            model.materials.Push(GetMaterial(i));
+
+        model.objects.Reserve(ObjectCount());
+        for (usize i = 0; i < ObjectCount(); ++i) {
+            const ObjectView view = GetObject(i);
+            OBJObject& obj = model.objects.Push({});
+            obj.name = view.name;
+            obj.mesh.vertices = Vec<OBJVertex>::New(view.vertices);
+            obj.mesh.indices  = Vec<TriIndices>::New(view.indices);
+            obj.smoothShading = view.smoothShading;
+            obj.materialIndex = view.materialIndex == -1 ? -1 : view.materialIndex + (int)materialBase;
+            obj.model = &model;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "OBJModel.h"
+#include "Utils/MappedFile.h"
+#include "Utils/Text.h"
+
+namespace Quasi::Graphics {
+    // a binary snapshot of a loaded OBJModel, so large models dont need to be reparsed every launch.
+    // everything is little-endian, the layout is described in OBJModelCache.cpp.
+    // vertex and index blocks are aligned, so they're read straight out of the mapped file
+    class OBJModelCache {
+        static constexpr u64 MAGIC = "QUASIOBJ"_u64;
+        static constexpr usize HEADER_SIZE = 64, OBJECT_SIZE = 48, MATERIAL_SIZE = 80, DEPENDENCY_SIZE = 32;
+
+        Text::MappedFile file;
+
+        explicit OBJModelCache(Text::MappedFile file) : file(std::move(file)) {}
+    public:
+        static constexpr u32 VERSION = 2;
+        static constexpr usize BLOCK_ALIGN = 16;
+        static constexpr Str EXTENSION = ".qmesh";
+
+        struct ObjectView {
+            Str name;
+            Span<const OBJVertex> vertices;
+            Span<const TriIndices> indices;
+            int materialIndex;
+            bool smoothShading;
+        };
+
+        OBJModelCache() = default;
+
+        // null if the cache is missing, corrupted, was made for another vertex layout,
+        // or if the source or any of the files it depends on (.mtl) changed size or time
+        static OBJModelCache Open(CStr cachePath, const Text::FileInfo& source);
+        // dependencies are null terminated paths, fails if any of them cant be found
+        static bool Write(CStr cachePath, const OBJModel& model, const Text::FileInfo& source,
+                          Span<const String> dependencies = {});
+        static String CachePathOf(Str sourcePath);
+        // identifies the components of OBJVertex, so a layout change invalidates old caches
+        static u32 VertexLayoutTag();
+
+        bool IsNull() const { return file.IsNull(); }
+
+        usize ObjectCount() const;
+        usize MaterialCount() const;
+        ObjectView GetObject(usize i) const;
+        MTLMaterial GetMaterial(usize i) const;
+
+        // copies everything out of the mapping, appending to the model
+        void LoadInto(OBJModel& model) const;
+    private:
+        bool IsValid(const Text::FileInfo& source) const;
+    };
+}
@@ -1,15 +1,34 @@
 #include "OBJModelLoader.h"
-#include "Utils/Algorithm.h"
-#include "Utils/Comparison.h"
+
+#include <thread>
+
+#include "Utils/HashMap.h"
 
 #include "Utils/Iter/LinesIter.h"
 #include "Utils/Text/Parsing.h"
 #include "Utils/Iter/SplitIter.h"
+#include "Utils/MappedFile.h"
 
 namespace Quasi::Graphics {
-    void OBJModelLoader::LoadFile(CStr filepath) {
+    void OBJModelLoader::LoadFile(CStr filepath, u32 threadCount) {
         Text::SplitDirectory(filepath).TieTo(folder, filename);
-        Load(Text::ReadFile(filepath).Assert());
+
+        const Option<Text::FileInfo> source = useCache ? Text::GetFileInfo(filepath) : nullptr;
+        const String cachePath = source ? OBJModelCache::CachePathOf(filepath) : String {};
+        if (source) {
+            const OBJModelCache cache = OBJModelCache::Open(CStr::FromUnchecked(cachePath), *source);
+            if (!cache.IsNull()) {
+                cache.LoadInto(model);
+                return;
+            }
+        }
+
+        const Text::MappedFile file = Text::MappedFile::Open(filepath);
+        Debug::Assert(!file.IsNull(), "couldn't open obj file {}", filepath);
+        // everything that outlives the mapping (names, paths) is copied out while parsing
+        LoadParallel(file.AsStr(), threadCount);
+
+        if (source) OBJModelCache::Write(CStr::FromUnchecked(cachePath), model, *source, materialFiles);
     }
 
     void OBJModelLoader::Load(Str string) {
@@ -17,18 +36,42 @@ namespace Quasi::Graphics {
         CreateModel();
     }
 
-    void OBJModelLoader::LoadMaterialFile(CStr filepath) {
-        const usize len = folder.Length() + filepath.Length() + 2;
-        char* fullpath = Memory::QAlloca$(char, len),
-            * acc = fullpath;
+    void OBJModelLoader::LoadParallel(Str string, u32 threadCount) {
+        if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        const usize chunkCount = std::clamp<usize>(string.Length() / MIN_CHUNK_SIZE, 1, threadCount);
+
+        // every slice ends right after a newline, so no line is ever split between two threads
+        Vec<Str> slices = Vec<Str>::WithCap(chunkCount);
+        for (usize i = 1, begin = 0; i <= chunkCount; ++i) {
+            usize end = std::max(begin, string.Length() * i / chunkCount);
+            const OptionUsize newline = string.Skip(end).Find('\n');
+            end = newline && i != chunkCount ? end + *newline + 1 : string.Length();
+            slices.Push(string.Substr(begin, end - begin));
+            begin = end;
+        }
+
+        Vec<ParsedChunk> chunks = Vec<ParsedChunk>::WithCap(chunkCount);
+        for (usize i = 0; i < chunkCount; ++i) chunks.Push({});
 
-        Memory::MemCopy(acc, folder.Data(), folder.Length()); acc += folder.Length();
-        *acc++ = '\\';
-        Memory::MemCopy(acc, filepath.Data(), filepath.Length());
+        Vec<std::thread> workers = Vec<std::thread>::WithCap(chunkCount - 1);
+        for (usize i = 1; i < chunkCount; ++i)
+            workers.Push(std::thread { [&, i] { ParseChunk(slices[i], chunks[i]); } });
+        ParseChunk(slices[0], chunks[0]);
+        for (std::thread& worker : workers) worker.join();
 
+        CreateModelFromChunks(chunks);
+    }
+
+    void OBJModelLoader::LoadMaterialFile(CStr filepath) {
+        // mtl paths are relative to the obj. '/' works as a separator on every platform
+        String fullpath = folder;
+        if (!fullpath.IsEmpty()) fullpath += '/';
+        fullpath += filepath;
+        fullpath.AddNullTerm();
 
-        mats.LoadFile(CStr::SliceUnchecked(fullpath, len));
+        mats.LoadFile(CStr::FromUnchecked(fullpath));
         model.materials = std::move(mats.materials);
+        materialFiles.Push(std::move(fullpath));
     }
 
     void OBJModelLoader::LoadMaterial(Str string) {
@@ -36,28 +79,23 @@ namespace Quasi::Graphics {
         model.materials = std::move(mats.materials);
     }
 
-    void OBJModelLoader::ParseProperty(const Str line) {
+    OBJModelLoader::OBJProperty OBJModelLoader::ReadProperty(const Str line) {
+        OBJProperty prop = { Empty {} };
         const OptionUsize spaceIdx = line.Find(' ');
-        if (!spaceIdx) return;
+        if (!spaceIdx) return prop;
         const auto [prefix, data] = line.SplitAt(*spaceIdx);
 
-        OBJProperty prop = { Empty {} };
-
         switch (Memory::ReadZeroExtU64Big(prefix.Data(), prefix.Length())) {
             case "v"_u64:  prop.Set(Vertex       { Math::fv3::Parse(data, " ").UnwrapOr(Math::fv3 { Math::NaN }) }); break;
             case "vt"_u64: prop.Set(VertexTex    { Math::fv2::Parse(data, " ").UnwrapOr(Math::fv2 { Math::NaN }) }); break;
             case "vn"_u64: prop.Set(VertexNormal { Math::fv3::Parse(data, " ").UnwrapOr(Math::fv3 { Math::NaN }) }); break;
             case "vp"_u64: prop.Set(VertexParam  { Math::fv3::Parse(data, " ").UnwrapOr(Math::fv3 { Math::NaN }) }); break;
             case "f"_u64: {
+                // the same as the chunked parser, so a missing t or n is -1 on both paths
                 Face face;
+                Str rest = data;
                 u32 i = 0;
-                for (const Str idx : data.Split(" ")) {
-                    if (i >= 3) break;
-                    const auto [v, t, n] = Math::iv3::Parse(idx, "/",
-                        [](Str x) -> Option<int> { return Text::Parse<int>(x).UnwrapOr(-1); }).UnwrapOr({ -1 });
-                    face.indices[i][0] = v; face.indices[i][1] = t; face.indices[i][2] = n;
-                    ++i;
-                }
+                while (i < 3 && ParseFaceVertex(rest, face.indices[i])) ++i;
                 if (i == 3) prop.Set(face);
             } break;
             case "l"_u64: {
@@ -78,7 +116,11 @@ namespace Quasi::Graphics {
             } break;
             default:;
         }
+        return prop;
+    }
 
+    void OBJModelLoader::ParseProperty(const Str line) {
+        OBJProperty prop = ReadProperty(line);
         if (!prop.Is<Empty>())
             properties.Push(std::move(prop));
     }
@@ -89,6 +131,54 @@ namespace Quasi::Graphics {
         }
     }
 
+    void OBJModelLoader::ParseChunk(Str chunk, ParsedChunk& out) {
+        for (Str line : chunk.Lines()) {
+            line = line.TrimEnd('\r');
+            if (line.Length() < 3) continue;
+
+            if (line[0] == 'v' && line[1] == ' ') {
+                Math::fv3 v;
+                out.vertex.Push(ParseFloats(line.Skip(2), v.AsSpan()) ? v : Math::fv3 { Math::NaN });
+            } else if (line[0] == 'v' && line[1] == 't' && line[2] == ' ') {
+                Math::fv2 t;
+                out.vertexTexture.Push(ParseFloats(line.Skip(3), t.AsSpan()) ? t : Math::fv2 { Math::NaN });
+            } else if (line[0] == 'v' && line[1] == 'n' && line[2] == ' ') {
+                Math::fv3 n;
+                out.vertexNormal.Push(ParseFloats(line.Skip(3), n.AsSpan()) ? n : Math::fv3 { Math::NaN });
+            } else if (line[0] == 'f' && line[1] == ' ') {
+                Face face;
+                Str data = line.Skip(2);
+                u32 i = 0;
+                while (i < 3 && ParseFaceVertex(data, face.indices[i])) ++i;
+                if (i == 3) out.faces.Push(face);
+            } else {
+                OBJProperty prop = ReadProperty(line);
+                if (!prop.Is<Empty>())
+                    out.properties.Push({ out.faces.Length(), std::move(prop) });
+            }
+        }
+    }
+
+    bool OBJModelLoader::ParseFloats(Str data, Span<f32> out) {
+        return Text::Parser<f32>::ParseMany(data, out) == out.Length();
+    }
+
+    bool OBJModelLoader::ParseFaceVertex(Str& data, int (&out)[3]) {
+        data = data.TrimStart(' ');
+        if (data.IsEmpty()) return false;
+
+        const usize end = data.Find(' ').UnwrapOr(data.Length());
+        Str vtn = data.First(end);
+        data.Advance(end);
+        // each of v/t/n may be missing, as in 'v', 'v/t' or 'v//n'
+        for (int& index : out) {
+            const usize slash = vtn.Find('/').UnwrapOr(vtn.Length());
+            index = slash ? Text::Parse<int>(vtn.First(slash)).UnwrapOr(-1) : -1;
+            vtn.Advance(slash == vtn.Length() ? slash : slash + 1);
+        }
+        return true;
+    }
+
     void OBJModelLoader::CreateModel() {
         u32 lastObj = 0;
         for (u32 i = 0; i < properties.Length(); ++i) {
@@ -133,47 +223,98 @@ namespace Quasi::Graphics {
         ResolveObjectIndices(object);
     }
 
+    void OBJModelLoader::CreateModelFromChunks(Span<const ParsedChunk> chunks) {
+        usize vCount = 0, tCount = 0, nCount = 0, fCount = 0;
+        for (const ParsedChunk& c : chunks) {
+            vCount += c.vertex.Length();
+            tCount += c.vertexTexture.Length();
+            nCount += c.vertexNormal.Length();
+            fCount += c.faces.Length();
+        }
+        vertex       .Reserve(vCount);
+        vertexTexture.Reserve(tCount);
+        vertexNormal .Reserve(nCount);
+        faces        .Reserve(fCount);
+
+        // obj indices are global to the file, so chunks can just be concatenated in order
+        OptRef<OBJObject> object = nullptr;
+        usize objectBegin = 0;
+        for (const ParsedChunk& c : chunks) {
+            const usize faceBase = faces.Length();
+            vertex       .Extend(c.vertex);
+            vertexTexture.Extend(c.vertexTexture);
+            vertexNormal .Extend(c.vertexNormal);
+            faces        .Extend(c.faces);
+
+            for (const auto& [faceIndex, prop] : c.properties) {
+                prop.Visit(
+                    [&] (const MaterialLib& matfile) {
+                        LoadMaterialFile(CStr::FromUnchecked(matfile.dir));
+                    },
+                    [&] (const Object& obj) {
+                        const usize objectEnd = faceBase + faceIndex;
+                        if (object) ResolveObjectIndices(*object, faces.Subspan(objectBegin, objectEnd - objectBegin));
+                        objectBegin = objectEnd;
+
+                        object = model.objects.Push({});
+                        object->model = &model;
+                        object->name = obj.name;
+                    },
+                    [&] (const UseMaterial& usemat) {
+                        if (!object) return;
+                        const OptionUsize i = model.materials.FindIf(
+                            [&](const MTLMaterial& m) { return m.name == usemat.name; }
+                        );
+                        if (!i) return;
+                        object->materialIndex = (int)*i;
+                    },
+                    [&] (SmoothShade ss) { if (object) object->smoothShading = ss.enabled; },
+                    [] (const auto&) {}
+                );
+            }
+        }
+        if (object) ResolveObjectIndices(*object, faces.Subspan(objectBegin));
+        faces.Clear();
+    }
+
     void OBJModelLoader::ResolveObjectIndices(OBJObject& obj) {
-        struct Cmp3 {
-            Comparison operator()(const Math::iv3& tripleA, const Math::iv3& tripleB) const {
-                const auto [ax, ay, az] = tripleA;
-                const auto [bx, by, bz] = tripleB;
-                return ax != bx ? Cmp::Between(ax, bx) : ay != by ? Cmp::Between(ay, by) : Cmp::Between(az, bz);
+        ResolveObjectIndices(obj, faces);
+        faces.Clear();
+    }
+
+    void OBJModelLoader::ResolveObjectIndices(OBJObject& obj, Span<const Face> objFaces) {
+        struct TripleHasher {
+            Hashing::Hash operator()(const Math::iv3& triple) const {
+                return Hashing::HashBytes(Span<const Math::iv3>::Only(triple).AsBytes());
             }
         };
 
-        // a hashset is actually worse than a vector lol, cuz i need indices
-        Vec<Math::iv3> indices;
-        for (const Face& f : faces) {
-            indices.Push({ f.indices[0][0], f.indices[0][1], f.indices[0][2] });
-            indices.Push({ f.indices[1][0], f.indices[1][1], f.indices[1][2] });
-            indices.Push({ f.indices[2][0], f.indices[2][1], f.indices[2][2] });
-        }
-        indices.SortBy(Cmp3 {});
-        indices.RemoveDups();
-        obj.mesh.vertices = indices.MapEach(
-            [&] (const Math::iv3& triple) {
-                return OBJVertex {
-                    triple.x == -1 ? Math::fv3 {} : vertex[triple.x - 1],
-                    triple.y == -1 ? Math::fv2 {} : vertexTexture[triple.y - 1],
-                    triple.z == -1 ? Math::fv3 {} : vertexNormal[triple.z - 1]
-                };
-            }
-        );
+        // maps each v/t/n triple to its vertex, vertices stay in order of first use.
+        // smooth meshes end up with about half a vertex per face, hard edged ones closer to two.
+        // two per face keeps the hard edged ones from growing the table over and over
+        HashMap<Math::iv3, u32, TripleHasher> uniqueVertices;
+        uniqueVertices.Reserve(objFaces.Length() * 2);
 
+        Vec<OBJVertex>& vertices = obj.mesh.vertices;
         Vec<TriIndices>& ind = obj.mesh.indices;
-        ind.Reserve(faces.Length());
-        for (const Face& f : faces) {
-            Math::iv3 v1 { f.indices[0][0], f.indices[0][1], f.indices[0][2] };
-            Math::iv3 v2 { f.indices[1][0], f.indices[1][1], f.indices[1][2] };
-            Math::iv3 v3 { f.indices[2][0], f.indices[2][1], f.indices[2][2] };
-            const auto [_1, i1] = indices.BinarySearchWith([&] (const Math::iv3& x) { return Cmp3 {}(x, v1); });
-            const auto [_2, i2] = indices.BinarySearchWith([&] (const Math::iv3& x) { return Cmp3 {}(x, v2); });
-            const auto [_3, i3] = indices.BinarySearchWith([&] (const Math::iv3& x) { return Cmp3 {}(x, v3); });
-            ind.Push({ (u32)i1, (u32)i2, (u32)i3 });
+        vertices.Reserve(objFaces.Length());
+        ind.Reserve(objFaces.Length());
+        for (const Face& f : objFaces) {
+            u32 tri[3];
+            for (u32 c = 0; c < 3; ++c) {
+                const auto [v, t, n] = f.indices[c];
+                const u32 index = uniqueVertices.GetOrInsert({ v, t, n }, (u32)vertices.Length());
+                if (index == vertices.Length()) {
+                    vertices.Push(OBJVertex {
+                        v == -1 ? Math::fv3 {} : vertex[v - 1],
+                        t == -1 ? Math::fv2 {} : vertexTexture[t - 1],
+                        n == -1 ? Math::fv3 {} : vertexNormal[n - 1]
+                    });
+                }
+                tri[c] = index;
+            }
+            ind.Push({ tri[0], tri[1], tri[2] });
         }
-
-        faces.Clear();
     }
 
     OBJModel&& OBJModelLoader::RetrieveModel() {
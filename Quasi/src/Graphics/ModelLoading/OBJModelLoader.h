@@ -2,6 +2,7 @@
 
 #include "MTLMaterialLoader.h"
 #include "OBJModel.h"
+#include "OBJModelCache.h"
 
 #include "Utils/Math/Vector.h"
 
@@ -30,6 +31,21 @@ namespace Quasi::Graphics {
             Vertex, VertexTex, VertexNormal, VertexParam,
             Face, Line,
             SmoothShade> {};
+
+        // a property that isnt plain geometry, tagged with how many faces were parsed before it
+        struct ChunkProperty { usize faceIndex; OBJProperty prop; };
+        // the result of parsing one newline-aligned slice of a file.
+        // geometry goes straight into typed arrays, skipping the variant entirely
+        struct ParsedChunk {
+            Vec<Math::fv3> vertex;
+            Vec<Math::fv2> vertexTexture;
+            Vec<Math::fv3> vertexNormal;
+            Vec<Face> faces;
+            Vec<ChunkProperty> properties;
+        };
+
+        // files smaller than this arent worth splitting across threads
+        static constexpr usize MIN_CHUNK_SIZE = 1 << 20;
     private:
         Vec<OBJProperty> properties;
         MTLMaterialLoader mats;
@@ -41,20 +57,35 @@ namespace Quasi::Graphics {
         Vec<Face> faces;
 
         String folder, filename;
+        // every .mtl loaded for this model, the cache is only valid while these stay the same
+        Vec<String> materialFiles;
+        bool useCache = true;
     public:
         OBJModelLoader() = default;
 
-        void LoadFile(CStr filepath);
+        // reuses (or writes) a binary cache next to the file, see OBJModelCache
+        void LoadFile(CStr filepath, u32 threadCount = 0);
         void Load(Str string);
+        // threadCount of 0 uses every hardware thread
+        void LoadParallel(Str string, u32 threadCount = 0);
         void LoadMaterialFile(CStr filepath);
         void LoadMaterial(Str string);
 
+        static OBJProperty ReadProperty(Str line);
         void ParseProperty(Str line);
         void ParseProperties(Str string);
 
+        static void ParseChunk(Str chunk, ParsedChunk& out);
+        static bool ParseFloats(Str data, Span<f32> out);
+        static bool ParseFaceVertex(Str& data, int (&out)[3]);
+
         void CreateModel();
         void CreateObject(Span<const OBJProperty> objprop);
+        void CreateModelFromChunks(Span<const ParsedChunk> chunks);
         void ResolveObjectIndices(OBJObject& obj);
+        void ResolveObjectIndices(OBJObject& obj, Span<const Face> objFaces);
+
+        void UseCache(bool enabled) { useCache = enabled; }
 
         OBJModel& GetModel() { return model; }
         const OBJModel& GetModel() const { return model; }
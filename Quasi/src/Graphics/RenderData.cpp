@@ -17,8 +17,8 @@ namespace Quasi::Graphics {
 
 		dest.device = from.device;
 		from.device = nullptr;
-		dest.deviceIndex = from.deviceIndex;
-		from.deviceIndex = 0;
+		dest.deviceKey = from.deviceKey;
+		from.deviceKey = {};
 	}
 
 	RenderData::~RenderData() {
@@ -77,7 +77,7 @@ namespace Quasi::Graphics {
 		if (device) {
 			OptRef prev = device; // prevent infinte loop: deleterender -> erase renderdata -> destructor
 			device = nullptr;
-			prev->DeleteRender(deviceIndex);
+			prev->DeleteRender(deviceKey);
 		}
 	}
 }
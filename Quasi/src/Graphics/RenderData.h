@@ -5,6 +5,7 @@
 #include "GLs/IndexBuffer.h"
 #include "GLs/Shader.h"
 #include "GLs/VertexElement.h"
+#include "Utils/SlotMap.h"
 
 namespace Quasi::Graphics {
 	class FrameBuffer;
@@ -34,7 +35,7 @@ namespace Quasi::Graphics {
 		usize indexOffset = 0;
 
 		OptRef<GraphicsDevice> device;
-		usize deviceIndex = 0;
+		SlotKey deviceKey;
 
 		friend class GraphicsDevice;
 
@@ -80,6 +81,9 @@ namespace Quasi::Graphics {
 		template <class T> friend class RenderObject;
 	};
 
+	// whether the device still has the render behind this key
+	bool RenderIsAlive(SlotKey key);
+
 	template <class T> void RenderData::PushVertex(const T& vertex) {
 		const byte* rawbytes = Memory::TransmutePtr<const byte>(&vertex);
 		Memory::MemCopyNoOverlap(&vertexData[vertexOffset], rawbytes, sizeof(T));
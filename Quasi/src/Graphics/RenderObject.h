@@ -22,24 +22,30 @@ namespace Quasi::Graphics {
 
     template <class T>
     class RenderObject {
-        OptRef<RenderData> rd;
+        // the render data is boxed by the device so the pointer stays put while it's alive,
+        // the key is what tells whether it still is
+        OptRef<RenderData> data;
+        SlotKey key;
     public:
 		RenderObject() = default;
-        RenderObject(RenderData& d) : rd(d) {}
+        RenderObject(RenderData& d) : data(d), key(d.deviceKey) {}
 
-        RenderObject(const RenderObject& ro) : rd(ro.rd) {}
-		RenderObject& operator=(const RenderObject& ro) { rd = ro.rd; return *this; }
+        RenderObject(const RenderObject& ro) : data(ro.data), key(ro.key) {}
+		RenderObject& operator=(const RenderObject& ro) { data = ro.data; key = ro.key; return *this; }
         
-		RenderObject(RenderObject&& ro) noexcept : rd(ro.rd) { ro.rd = nullptr; }
-		RenderObject& operator=(RenderObject&& ro) noexcept { rd = ro.rd; ro.rd = nullptr; return *this; }
+		RenderObject(RenderObject&& ro) noexcept : data(ro.data), key(ro.key) { ro.data = nullptr; ro.key = {}; }
+		RenderObject& operator=(RenderObject&& ro) noexcept { data = ro.data; key = ro.key; ro.data = nullptr; ro.key = {}; return *this; }
 
         ~RenderObject() { }
            
-		void Bind() const { rd->Bind(); }
-		void Unbind() const { rd->Unbind(); }
+		void Bind() const { GetRenderData().Bind(); }
+		void Unbind() const { GetRenderData().Unbind(); }
 
-              RenderData& GetRenderData()       { return *rd; }
-        const RenderData& GetRenderData() const { return *rd; }
+        // false once the device has deleted the render, even if a new render has taken its slot
+        bool IsAlive() const { return RenderIsAlive(key); }
+
+              RenderData& GetRenderData()       { CheckAlive(); return *data; }
+        const RenderData& GetRenderData() const { CheckAlive(); return *data; }
 
         const RenderData* operator->() const { return &GetRenderData(); }
     	RenderData* operator->() { return &GetRenderData(); }
@@ -51,10 +57,10 @@ namespace Quasi::Graphics {
     	void DrawInstanced(const Mesh<T>& mesh, int instances, const DrawOptions& options = {}) { DrawInstanced({ &mesh }, instances, options); }
     	void DrawInstanced(const CollectionAny auto& meshes, int instances, const DrawOptions& options = {});
 
-    	void BeginContext() { rd->BufferUnload(); rd->Clear(); }
-    	void AddMesh(const Mesh<T>& mesh) { rd->Add(mesh); }
-    	void AddMeshes(const CollectionAny auto& meshes) { for (const Mesh<T>& m : meshes) rd->Add(m); }
-    	void AddMeshes(IList<const Mesh<T>*> meshes) { for (auto* m : meshes) rd->Add(*m); }
+    	void BeginContext() { GetRenderData().BufferUnload(); GetRenderData().Clear(); }
+    	void AddMesh(const Mesh<T>& mesh) { GetRenderData().Add(mesh); }
+    	void AddMeshes(const CollectionAny auto& meshes) { for (const Mesh<T>& m : meshes) GetRenderData().Add(m); }
+    	void AddMeshes(IList<const Mesh<T>*> meshes) { for (auto* m : meshes) GetRenderData().Add(*m); }
 
 		struct RawBatch {
     		u32 iOffset;
@@ -73,35 +79,39 @@ namespace Quasi::Graphics {
     		TriIndices* IndexData() { return Memory::TransmutePtr<TriIndices>(rd->indexData.Data()) + iOffset; }
     	};
 
-		RawBatch NewBatch() { return RawBatch { (u32)(rd->vertexOffset / sizeof(T)), *rd }; }
+		RawBatch NewBatch() { return RawBatch { (u32)(GetRenderData().vertexOffset / sizeof(T)), GetRenderData() }; }
 		void AddMeshB(auto&& meshBuilder, auto&& gpass) {
     		meshBuilder.Merge((decltype(gpass))gpass, NewBatch());
     	}
 
-    	void EndContext() { rd->BufferLoad(); }
+    	void EndContext() { GetRenderData().BufferLoad(); }
 
      	void DrawContext(const DrawOptions& options = {}) {
-    		rd->Render(Memory::AsMut(options.shader.UnwrapOr(rd->shader)), options.arguments, options.useDefaultArguments);
+    		GetRenderData().Render(Memory::AsMut(options.shader.UnwrapOr(GetRenderData().shader)), options.arguments, options.useDefaultArguments);
     	}
     	void DrawContextInstanced(int instances, const DrawOptions& options = {}) {
-    		rd->RenderInstanced(Memory::AsMut(options.shader.UnwrapOr(rd->shader)), instances, options.arguments, options.useDefaultArguments);
+    		GetRenderData().RenderInstanced(Memory::AsMut(options.shader.UnwrapOr(GetRenderData().shader)), instances, options.arguments, options.useDefaultArguments);
     	}
 
-		void Destroy() { rd->Destroy(); }
+		void Destroy() { GetRenderData().Destroy(); }
 
-	    void SetCamera(const Math::Matrix3D& cam) { rd->camera = cam; }
-	    void SetProjection(const Math::Matrix3D& proj) { rd->projection = proj; }
+	    void SetCamera(const Math::Matrix3D& cam) { GetRenderData().camera = cam; }
+	    void SetProjection(const Math::Matrix3D& proj) { GetRenderData().projection = proj; }
 	    
-	    void UseShader(Str code) { rd->shader = Shader::New(code); }
-	    void UseShaderFromFile(CStr file) { rd->shader = Shader::FromFile(file); }
+	    void UseShader(Str code) { GetRenderData().shader = Shader::New(code); }
+	    void UseShaderFromFile(CStr file) { GetRenderData().shader = Shader::FromFile(file); }
 	    void UseShaderFromFile(CStr vert, CStr frag, CStr geom = {})
-    	{ rd->shader = Shader::FromFile(vert, frag, geom); }
+    	{ GetRenderData().shader = Shader::FromFile(vert, frag, geom); }
+    private:
+	    void CheckAlive() const {
+    		Debug::QAssert$(IsAlive(), "render object used after its render was deleted");
+    	}
     };
 
     template <class T>
 	void RenderObject<T>::Draw(IList<const Mesh<T>*> meshes, const DrawOptions& options) {
 	    BeginContext();
-    	for (auto* m : meshes) rd->Add(*m);
+    	for (auto* m : meshes) GetRenderData().Add(*m);
     	EndContext();
     	DrawContext(options);
     }
@@ -117,7 +127,7 @@ namespace Quasi::Graphics {
     template <class T>
 	void RenderObject<T>::DrawInstanced(IList<const Mesh<T>*> meshes, int instances, const DrawOptions& options) {
     	BeginContext();
-    	for (auto* m : meshes) rd->Add(*m);
+    	for (auto* m : meshes) GetRenderData().Add(*m);
     	EndContext();
     	DrawContextInstanced(instances, options);
     }
@@ -0,0 +1,127 @@
+#include "SpriteInstancer.h"
+
+#include "GraphicsDevice.h"
+#include "Utils/Algorithm.h"
+
+namespace Quasi::Graphics {
+    SpriteInstance SpriteInstance::FromWidth(const SubTexture& subtex, const Math::fv2& pos, float w,
+                                             const Math::Rotor2D& rotation, const Math::fColor& tint) {
+        const Math::fv2 subImgSize = subtex.tex->Size().As<float>() * subtex.rect.Size();
+        return {
+            .Position = pos,
+            .HalfSize = Math::fv2 { w, w / subImgSize.AspectRatio() } * 0.5f,
+            .Rotation = rotation.AsUnitVector(),
+            .UVMin    = subtex.rect.min,
+            .UVMax    = subtex.rect.max,
+            .Tint     = tint,
+        };
+    }
+
+    void SpriteInstanceBuffer::Push(const SpriteInstance& instance, float depth, u8 layer) {
+        instances.Push(instance);
+        keys.Push(SortKey(depth, layer));
+    }
+
+    void SpriteInstanceBuffer::Clear() {
+        instances.Clear();
+        keys.Clear();
+        sorted.Clear();
+    }
+
+    u64 SpriteInstanceBuffer::SortKey(float depth, u8 layer) {
+        // adding 0 turns -0 into 0, otherwise the two would sort apart. then flipped for deepest first
+        const u32 ordered = Algorithm::RadixSorting::ToUnsignedKey(depth + 0.0f);
+        return (u64)layer << 32 | ~ordered;
+    }
+
+    Span<const SpriteInstance> SpriteInstanceBuffer::Sort(Memory::LinearArena* scratch) {
+        const usize n = instances.Length();
+        order.Clear();
+        for (u32 i = 0; i < n; ++i) order.Push(i);
+        {
+            // only the sort's own buffers, order and sorted are kept from frame to frame
+            Memory::ArenaScope scope { scratch };
+            // stable, so sprites with the same key stay in push order
+            order.RadixSortByKey([&] (u32 i) { return keys[i]; });
+        }
+
+        sorted.Clear();
+        sorted.Reserve(n);
+        for (const u32 i : order) sorted.Push(instances[i]);
+        return sorted;
+    }
+
+    void SpriteInstancer::CreateRender(GraphicsDevice& gd, u32 maxInstances) {
+        this->maxInstances = maxInstances;
+        render = gd.CreateNewRender<Vertex2D>(4, 2);
+        instanceBuffer = VertexBuffer::New(maxInstances * sizeof(SpriteInstance));
+        // the quad's corner is attribute 0, the instance attributes go after it
+        render->varray.AddInstanceBuffer(instanceBuffer, SpriteInstance::INSTANCE_LAYOUT, 1);
+
+        render.UseShader(
+            Q_GLSL_SHADER(330 core,
+                (
+                    layout (location = 0) in vec2 corner;
+                    layout (location = 1) in vec2 position;
+                    layout (location = 2) in vec2 halfSize;
+                    layout (location = 3) in vec2 rotation;
+                    layout (location = 4) in vec2 uvMin;
+                    layout (location = 5) in vec2 uvMax;
+                    layout (location = 6) in vec4 tint;
+                    out vec2 vTexCoord;
+                    out vec4 vTint;
+                    uniform mat4 u_projection, u_view;
+                    void main() {
+                        vec2 local = corner * halfSize;
+                        vec2 world = position + vec2(local.x * rotation.x - local.y * rotation.y,
+                                                     local.x * rotation.y + local.y * rotation.x);
+                        gl_Position = u_projection * u_view * vec4(world, 0.0, 1.0);
+                        vTexCoord = mix(uvMin, uvMax, corner * 0.5 + 0.5);
+                        vTint = tint;
+                    }
+                ),
+                (
+                    layout (location = 0) out vec4 glColor;
+                    in vec2 vTexCoord;
+                    in vec4 vTint;
+                    uniform sampler2D u_texture;
+                    void main() {
+                        // premultiplied, same as the canvas
+                        vec4 color = vTint * texture(u_texture, vTexCoord);
+                        glColor = vec4(color.rgb * color.a, color.a);
+                    }
+                )
+            )
+        );
+        // same space as the canvas: pixels, from the bottom left
+        const Math::fv2 screenSize = gd.GetWindowSize().As<float>();
+        render.SetProjection(Math::Matrix3D::OrthoProjection({ 0, screenSize.AddZ(1) }));
+
+        // the quad never changes, so it's only uploaded once
+        render.BeginContext();
+        RenderData& rd = render.GetRenderData();
+        for (const Math::fv2 corner : { Math::fv2 { -1, -1 }, Math::fv2 { -1, 1 }, Math::fv2 { 1, 1 }, Math::fv2 { 1, -1 } })
+            rd.PushVertex(Vertex2D { corner });
+        rd.PushIndex({ 0, 1, 2 });
+        rd.PushIndex({ 0, 2, 3 });
+        render.EndContext();
+    }
+
+    void SpriteInstancer::Draw(const Texture2D& texture) {
+        Memory::LinearArena& frame = render.GetRenderData().device->GetFrameArena();
+        const Span<const SpriteInstance> sprites = buffer.Sort(&frame);
+        // the arguments are gone after this frame too. drawing itself stays on the heap,
+        // the shader's uniform cache can grow in there and has to outlive the frame
+        DrawOptions options;
+        {
+            Memory::ArenaScope scope { frame };
+            options = UseArgs({ { "u_texture", texture, 0 } });
+        }
+        for (usize start = 0; start < sprites.Length(); start += maxInstances) {
+            const Span<const SpriteInstance> batch = sprites.Skip(start).First(std::min<usize>(maxInstances, sprites.Length() - start));
+            instanceBuffer.SetData(batch);
+            render.DrawContextInstanced((int)batch.Length(), options);
+        }
+        buffer.Clear();
+    }
+}
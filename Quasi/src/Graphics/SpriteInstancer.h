@@ -0,0 +1,72 @@
+#pragma once
+#include "RenderObject.h"
+#include "TextureAtlas.h"
+#include "Utils/Arena.h"
+
+namespace Quasi::Graphics {
+    class GraphicsDevice;
+
+    // one sprite of an instanced draw, exactly what ends up in the instance buffer.
+    // the quad is centered on Position, and UVMin goes on the corner at -HalfSize before rotating
+    struct SpriteInstance {
+        Math::fv2 Position;
+        Math::fv2 HalfSize;
+        Math::fv2 Rotation; // cos and sin
+        Math::fv2 UVMin, UVMax;
+        Math::fColor Tint;
+
+        inline static const auto INSTANCE_LAYOUT =
+            VertexBufferLayout::FromTypes<Math::fv2, Math::fv2, Math::fv2, Math::fv2, Math::fv2, Math::fColor>();
+
+        // the same quad as Canvas::DrawSTextureW with the canvas transform set to the position and rotation
+        static SpriteInstance FromWidth(const SubTexture& subtex, const Math::fv2& pos, float w,
+                                        const Math::Rotor2D& rotation = {}, const Math::fColor& tint = 1);
+    };
+
+    // the cpu half of instanced sprites: records instances with a sort key and puts them in draw order.
+    // nothing here touches gl, so the recorded buffer can be checked on its own
+    class SpriteInstanceBuffer {
+        Vec<SpriteInstance> instances, sorted;
+        Vec<u64> keys;
+        Vec<u32> order;
+    public:
+        SpriteInstanceBuffer() = default;
+
+        // lower layers are drawn first no matter the depth. within a layer deeper sprites are drawn first,
+        // and sprites with the same layer and depth keep the order they were pushed in
+        void Push(const SpriteInstance& instance, float depth = 0, u8 layer = 0);
+        void Clear();
+
+        usize Count() const { return instances.Length(); }
+        bool IsEmpty() const { return instances.IsEmpty(); }
+
+        // sorts everything pushed so far, the result is what gets uploaded.
+        // the sort's scratch space comes from the arena if theres one
+        Span<const SpriteInstance> Sort(Memory::LinearArena* scratch = nullptr);
+        Span<const SpriteInstance> Sorted() const { return sorted; }
+        Span<const SpriteInstance> Recorded() const { return instances; }
+
+        // layer in the top bits, then the depth flipped so that bigger depths come first. -0 sorts as 0
+        static u64 SortKey(float depth, u8 layer);
+    };
+
+    // draws every instance of a SpriteInstanceBuffer as one instanced quad, all from one texture
+    class SpriteInstancer {
+        SpriteInstanceBuffer buffer;
+        RenderObject<Vertex2D> render;
+        VertexBuffer instanceBuffer;
+        u32 maxInstances = 0;
+    public:
+        SpriteInstancer() = default;
+
+        void CreateRender(GraphicsDevice& gd, u32 maxInstances = 1024);
+
+        void Push(const SpriteInstance& instance, float depth = 0, u8 layer = 0) { buffer.Push(instance, depth, layer); }
+        SpriteInstanceBuffer& Buffer() { return buffer; }
+        const SpriteInstanceBuffer& Buffer() const { return buffer; }
+
+        // sorts, uploads and draws everything pushed since the last draw, then clears.
+        // past maxInstances it takes more than one draw call
+        void Draw(const Texture2D& texture);
+    };
+}
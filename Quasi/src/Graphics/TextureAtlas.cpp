@@ -1,6 +1,7 @@
 #include "TextureAtlas.h"
 #include "Utils/Algorithm.h"
 #include "Utils/Iter/MapIter.h"
+#include "Utils/Debug/Logger.h"
 
 namespace Quasi::Graphics {
     TextureAtlas::TextureAtlas(Span<ImageView> sprites, bool pixelated, int padding) {
@@ -15,7 +16,7 @@ namespace Quasi::Graphics {
 
         spriteLookup.Reserve(spriteNames.Length());
         for (usize i = 0; i < spriteNames.Length(); ++i) {
-            spriteLookup.Insert(spriteNames[indices[i]], i);
+            spriteLookup.Insert(Atom::Of(spriteNames[indices[i]]), i);
         }
 
         PackSprites(sprites, pixelated, padding);
@@ -57,6 +58,9 @@ namespace Quasi::Graphics {
 
         // atlas.ExportPNG("debug.png");
         fullTexture = Texture2D::New(atlas, { .pixelated = pixelated });
+        uvRects = Vec<Math::fRect2D>::WithCap(spritesheet.Length());
+        for (const Math::iRect2D& px : spritesheet)
+            uvRects.Push(fullTexture.Px2UV(px));
     }
 
     TextureAtlas TextureAtlas::FromFiles(Span<const CStr> files, Span<const Str> spriteNames, bool pixelated, int padding) {
@@ -69,10 +73,27 @@ namespace Quasi::Graphics {
         return { spriteViews, spriteNames, pixelated, padding };
     }
 
-    Math::iRect2D TextureAtlas::GetPx(Str name) const {
+    Option<TextureAtlas::Handle> TextureAtlas::Find(Str name) const {
+        // a name that was never interned cant be in any atlas
+        const Option<Atom> atom = Atom::Find(name);
+        return atom ? Find(*atom) : nullptr;
+    }
+
+    Option<TextureAtlas::Handle> TextureAtlas::Find(Atom name) const {
         const Option<u32> id = spriteLookup.Get(name).Copied();
-        if (!id) return Math::iRect2D::Empty();
-        return GetPx(*id);
+        return id ? Options::Some(Handle { *id }) : nullptr;
+    }
+
+    TextureAtlas::Handle TextureAtlas::GetHandle(Str name) const {
+        const Option<Handle> h = Find(name);
+        Debug::Assert(h.HasValue(), "no sprite named {} in the atlas", name);
+        return *h;
+    }
+
+    Math::iRect2D TextureAtlas::GetPx(Str name) const {
+        const Option<Handle> h = Find(name);
+        if (!h) return Math::iRect2D::Empty();
+        return GetPx(*h);
     }
 
     Math::iRect2D TextureAtlas::GetPx(u32 id) const {
@@ -80,10 +101,12 @@ namespace Quasi::Graphics {
     }
 
     Math::fRect2D TextureAtlas::GetUV(Str name) const {
-        return fullTexture.Px2UV(GetPx(name));
+        const Option<Handle> h = Find(name);
+        if (!h) return fullTexture.Px2UV(Math::iRect2D::Empty());
+        return GetUV(*h);
     }
 
     Math::fRect2D TextureAtlas::GetUV(u32 id) const {
-        return fullTexture.Px2UV(GetPx(id));
+        return uvRects[id];
     }
 }
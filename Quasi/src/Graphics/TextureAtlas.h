@@ -1,6 +1,7 @@
 #pragma once
 #include "Image.h"
 #include "GLs/Texture.h"
+#include "Utils/Atom.h"
 
 namespace Quasi::Graphics {
     struct SubTexture {
@@ -11,8 +12,14 @@ namespace Quasi::Graphics {
     class TextureAtlas {
         Texture2D fullTexture;
         Vec<Math::iRect2D> spritesheet;
-        HashMap<String, u32> spriteLookup;
+        Vec<Math::fRect2D> uvRects; // spritesheet in uv space, so fetching a sprite doesnt divide
+        HashMap<Atom, u32> spriteLookup;
     public:
+        // a sprite looked up once, ahead of time. using it is just indexing, no hashing
+        struct Handle {
+            u32 index = 0;
+        };
+
         TextureAtlas() = default;
         TextureAtlas(Span<ImageView> sprites, bool pixelated = false, int padding = 1);
         TextureAtlas(Span<ImageView> sprites, Span<const Str> spriteNames, bool pixelated = false, int padding = 1);
@@ -24,12 +31,20 @@ namespace Quasi::Graphics {
         Texture2D& GetTexture() { return fullTexture; }
         const Texture2D& GetTexture() const { return fullTexture; }
 
+        Option<Handle> Find(Str name)  const;
+        Option<Handle> Find(Atom name) const;
+        // asserts that the sprite exists
+        Handle GetHandle(Str name) const;
+
         Math::iRect2D GetPx(Str name) const;
         Math::iRect2D GetPx(u32 id)   const;
+        Math::iRect2D GetPx(Handle h) const { return spritesheet[h.index]; }
         Math::fRect2D GetUV(Str name) const;
         Math::fRect2D GetUV(u32 id)   const;
+        Math::fRect2D GetUV(Handle h) const { return uvRects[h.index]; }
 
         SubTexture operator[](Str name) const { return { fullTexture, GetUV(name) }; }
         SubTexture operator[](u32 id)   const { return { fullTexture, GetUV(id) }; }
+        SubTexture operator[](Handle h) const { return { fullTexture, uvRects[h.index] }; }
     };
 }
@@ -0,0 +1,214 @@
+#include "TileMap.h"
+
+#include "CameraController2D.h"
+#include "GraphicsDevice.h"
+#include "ModelLoading/LevelCache.h"
+
+namespace Quasi::Graphics {
+    TileMap::TileMap(Math::uv2 size, float tileSize, Math::iv2 offset)
+        : size(size), chunkCount((size + (CHUNK_SIZE - 1)) / CHUNK_SIZE), offset(offset), tileSize(tileSize) {
+        tiles = Vec<u32>::WithSize(size.x * size.y);
+        Memory::MemSet(tiles.Data(), 0, tiles.ByteSize());
+        chunks.ResizeExtra(chunkCount.x * chunkCount.y);
+    }
+
+    TileMap TileMap::FromLevel(const LevelData& level, int layer, float tileSize) {
+        const Math::iv2 min = level.boundMin.As2D(), max = level.boundMax.As2D();
+        TileMap map { (Math::uv2)(max - min + 1), tileSize, min };
+        for (const LevelTile& t : level.tiles) {
+            if (t.position.z != layer) continue;
+            const Math::uv2 p = (Math::uv2)(t.position.As2D() - min);
+            // bounds in the file can be smaller than the tiles
+            if (p.x >= map.size.x || p.y >= map.size.y) continue;
+            map.tiles[p.y * map.size.x + p.x] = t.type;
+        }
+        return map;
+    }
+
+    void TileMap::Set(u32 x, u32 y, u32 type) {
+        u32& tile = tiles[y * size.x + x];
+        if (tile == type) return;
+        tile = type;
+        chunks[y / CHUNK_SIZE * chunkCount.x + x / CHUNK_SIZE].dirty = true;
+    }
+
+    void TileMap::Fill(const Math::uRect2D& area, u32 type) {
+        const Math::uv2 min = Math::uv2::Min(area.min, size), max = Math::uv2::Min(area.max, size);
+        for (u32 y = min.y; y < max.y; ++y)
+            for (u32 x = min.x; x < max.x; ++x)
+                tiles[y * size.x + x] = type;
+        if (min.x >= max.x || min.y >= max.y) return;
+        for (u32 cy = min.y / CHUNK_SIZE; cy <= (max.y - 1) / CHUNK_SIZE; ++cy)
+            for (u32 cx = min.x / CHUNK_SIZE; cx <= (max.x - 1) / CHUNK_SIZE; ++cx)
+                chunks[cy * chunkCount.x + cx].dirty = true;
+    }
+
+    void TileMap::MarkAllDirty() {
+        for (Chunk& c : chunks) c.dirty = true;
+    }
+
+    Math::fRect2D TileMap::ChunkBounds(u32 cx, u32 cy) const {
+        const Math::iv2 min = offset + (Math::iv2)(Math::uv2 { cx, cy } * CHUNK_SIZE),
+                        max = offset + (Math::iv2)Math::uv2::Min(Math::uv2 { cx + 1, cy + 1 } * CHUNK_SIZE, size);
+        return { (Math::fv2)min * tileSize, (Math::fv2)max * tileSize };
+    }
+
+    void TileMap::Update(const Math::fRect2D& viewport) {
+        stats = {};
+        visible.Clear();
+        if (!tiles) return;
+
+        // chunks are on a grid, so the visible ones are found directly instead of testing every chunk
+        const Math::fv2 chunkWorldSize = CHUNK_SIZE * tileSize, origin = (Math::fv2)offset * tileSize;
+        const Math::fv2 lo = (viewport.min - origin) / chunkWorldSize, hi = (viewport.max - origin) / chunkWorldSize;
+        // written so a nan viewport fails too
+        if (!(hi.x >= 0 && hi.y >= 0 && lo.x < (float)chunkCount.x && lo.y < (float)chunkCount.y)) return;
+        // clamped while still floats, casting a float past u32's range is undefined
+        const u32 minX = (u32)std::max(lo.x, 0.0f), maxX = (u32)std::min(hi.x, (float)(chunkCount.x - 1)),
+                  minY = (u32)std::max(lo.y, 0.0f), maxY = (u32)std::min(hi.y, (float)(chunkCount.y - 1));
+
+        for (u32 cy = minY; cy <= maxY; ++cy) {
+            for (u32 cx = minX; cx <= maxX; ++cx) {
+                const u32 i = cy * chunkCount.x + cx;
+                if (chunks[i].dirty) {
+                    RebuildChunk(i);
+                    ++stats.rebuiltChunks;
+                }
+                if (chunks[i].mesh.indices.IsEmpty()) continue;
+                visible.Push(i);
+                stats.triangles += chunks[i].mesh.indices.Length();
+            }
+        }
+        stats.visibleChunks = visible.Length();
+    }
+
+    void TileMap::Update(const CameraController2D& camera) {
+        Update(camera.GetViewport());
+    }
+
+    void TileMap::RebuildChunk(u32 index) {
+        Chunk& chunk = chunks[index];
+        chunk.mesh.Clear();
+        chunk.dirty = false;
+
+        const u32 x0 = index % chunkCount.x * CHUNK_SIZE, y0 = index / chunkCount.x * CHUNK_SIZE;
+        const u32 w = std::min(CHUNK_SIZE, size.x - x0), h = std::min(CHUNK_SIZE, size.y - y0);
+        const u32* const base = &tiles[y0 * size.x + x0];
+        const auto at = [&] (u32 x, u32 y) { return base[y * size.x + x]; };
+
+        // greedy meshing: take the widest run of one type, then grow it upwards while every row below it matches.
+        // one bit per tile thats already in a quad
+        static_assert(CHUNK_SIZE <= 32, "a row of a chunk has to fit in the mask");
+        u32 merged[CHUNK_SIZE] = {};
+        for (u32 y = 0; y < h; ++y) {
+            for (u32 x = 0; x < w; ++x) {
+                const u32 type = at(x, y);
+                if (type == EMPTY || merged[y] >> x & 1) continue;
+
+                u32 runWidth = 1;
+                while (x + runWidth < w && !(merged[y] >> (x + runWidth) & 1) && at(x + runWidth, y) == type) ++runWidth;
+                const u32 runMask = (u32)(((1ull << runWidth) - 1) << x);
+
+                u32 runHeight = 1;
+                for (; y + runHeight < h; ++runHeight) {
+                    if (merged[y + runHeight] & runMask) break;
+                    const u32* row = base + (y + runHeight) * size.x + x;
+                    u32 i = 0;
+                    while (i < runWidth && row[i] == type) ++i;
+                    if (i != runWidth) break;
+                }
+                for (u32 dy = 0; dy < runHeight; ++dy) merged[y + dy] |= runMask;
+
+                const Math::fv2 min = (Math::fv2)(offset + Math::iv2 { (int)(x0 + x), (int)(y0 + y) }) * tileSize,
+                                max = min + Math::fv2 { (float)runWidth, (float)runHeight } * tileSize;
+                const float tw = (float)runWidth, th = (float)runHeight;
+                chunk.mesh.PushPolygon({
+                    TileVertex { min,                { 0,  0  }, type },
+                    TileVertex { { max.x, min.y },   { tw, 0  }, type },
+                    TileVertex { max,                { tw, th }, type },
+                    TileVertex { { min.x, max.y },   { 0,  th }, type },
+                });
+                x += runWidth - 1;
+            }
+        }
+    }
+
+    void TileMap::CreateRender(GraphicsDevice& gd, u32 maxQuads) {
+        // a whole chunk has to fit in one batch, a checkerboard chunk is the worst case
+        maxQuads = std::max(maxQuads, CHUNK_SIZE * CHUNK_SIZE);
+        render = gd.CreateNewRender<TileVertex>(maxQuads * 4, maxQuads * 2);
+        render.UseShader(
+            Q_GLSL_SHADER(330 core,
+                (
+                    layout (location = 0) in vec2 position;
+                    layout (location = 1) in vec2 tileCoord;
+                    layout (location = 2) in int type;
+                    out vec2 vTileCoord;
+                    flat out int vType;
+                    uniform mat4 u_projection, u_view;
+                    void main() {
+                        gl_Position = u_projection * u_view * vec4(position, 0.0, 1.0);
+                        vTileCoord = tileCoord;
+                        vType = type;
+                    }
+                ),
+                (
+                    layout (location = 0) out vec4 glColor;
+                    in vec2 vTileCoord;
+                    flat in int vType;
+                    uniform sampler2D u_tileset;
+                    uniform ivec2 u_tilesetSize;
+                    void main() {
+                        int tile = vType - 1;
+                        vec2 cell = vec2(tile % u_tilesetSize.x, tile / u_tilesetSize.x);
+                        vec2 scale = 1.0 / vec2(u_tilesetSize);
+                        // gradients come from the unwrapped coordinate, so the seams inside a merged quad dont pick a tiny mip
+                        glColor = textureGrad(u_tileset, (cell + fract(vTileCoord)) * scale,
+                                              dFdx(vTileCoord) * scale, dFdy(vTileCoord) * scale);
+                    }
+                )
+            )
+        );
+        const Math::fv2 halfWindow = (Math::fv2)gd.GetWindowSize() * 0.5f;
+        render.SetProjection(Math::Matrix3D::OrthoProjection({ (-halfWindow).AddZ(-1), halfWindow.AddZ(1) }));
+    }
+
+    void TileMap::Draw(const CameraController2D& camera, const Texture2D& tileset, Math::uv2 tilesetSize) {
+        Update(camera);
+        render.SetCamera(camera.GetViewMatrix3D());
+        const ShaderArgs args = { { "u_tileset", tileset, 0 }, { "u_tilesetSize", (Math::iv2)tilesetSize } };
+
+        // the buffers are only refilled when something on screen changed, otherwise last frame's data is drawn again
+        const RenderData& rd = render.GetRenderData();
+        const usize maxVertices = rd.vertexData.Length() / sizeof(TileVertex), maxIndices = rd.indexData.Length();
+        const bool reupload = stats.rebuiltChunks || visible.AsSpan() != uploaded.AsSpan();
+        if (!reupload && visible) {
+            render.DrawContext(UseArgs(args));
+            stats.drawCalls = 1;
+            return;
+        }
+
+        uploaded.Clear();
+        render.BeginContext();
+        for (const u32 i : visible) {
+            const Mesh<TileVertex>& mesh = chunks[i].mesh;
+            // flush whenever the next chunk wouldnt fit
+            if (rd.vertexOffset / sizeof(TileVertex) + mesh.vertices.Length() > maxVertices ||
+                rd.indexOffset + mesh.indices.Length() * 3 > maxIndices) {
+                render.EndContext();
+                render.DrawContext(UseArgs(args));
+                ++stats.drawCalls;
+                uploaded.Clear();
+                render.BeginContext();
+            }
+            render.AddMesh(mesh);
+            uploaded.Push(i);
+        }
+        render.EndContext();
+        if (!visible) return;
+        render.DrawContext(UseArgs(args));
+        ++stats.drawCalls;
+        // only the last batch is still in the buffers, so a split frame always uploads again
+        if (stats.drawCalls > 1) uploaded.Clear();
+    }
+}
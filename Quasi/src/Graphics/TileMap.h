@@ -0,0 +1,79 @@
+#pragma once
+#include "Mesh.h"
+#include "RenderObject.h"
+#include "GLs/Texture.h"
+
+namespace Quasi::Graphics {
+    class GraphicsDevice;
+    class CameraController2D;
+    struct LevelData;
+
+    struct TileVertex {
+        Math::fv2 Position;
+        Math::fv2 TileCoord; // in tiles from the corner of the merged quad, the shader repeats the tile with fract
+        u32 Type;
+
+        QuasiDefineVertex$(TileVertex, 2D, (Position, Position)(TileCoord)(Type))
+    };
+
+    // a grid of tile types, split into CHUNK_SIZE x CHUNK_SIZE chunks that each keep their own mesh.
+    // a chunk's mesh is only rebuilt when one of its tiles changes and it's on screen,
+    // and runs of the same type are merged into as few quads as possible
+    class TileMap {
+    public:
+        static constexpr u32 CHUNK_SIZE = 32;
+        static constexpr u32 EMPTY = 0;
+
+        struct Chunk {
+            Mesh<TileVertex> mesh;
+            bool dirty = true;
+        };
+
+        struct FrameStats {
+            u32 visibleChunks = 0, rebuiltChunks = 0, drawCalls = 0;
+            usize triangles = 0;
+        };
+    private:
+        Math::uv2 size, chunkCount;
+        Math::iv2 offset; // the tile coordinates of tiles[0]
+        float tileSize = 1;
+        Vec<u32> tiles;
+        Vec<Chunk> chunks;
+
+        Vec<u32> visible, uploaded;
+        FrameStats stats;
+
+        RenderObject<TileVertex> render;
+    public:
+        TileMap() = default;
+        explicit TileMap(Math::uv2 size, float tileSize = 1, Math::iv2 offset = {});
+
+        // a slice of a level at one z, every tile type is kept as is
+        static TileMap FromLevel(const LevelData& level, int layer, float tileSize = 1);
+
+        Math::uv2 Size() const { return size; }
+        Math::uv2 ChunkCount() const { return chunkCount; }
+        float TileSize() const { return tileSize; }
+        Math::iv2 Offset() const { return offset; }
+        // x and y are relative to the map, not in tile coordinates
+        u32 Get(u32 x, u32 y) const { return tiles[y * size.x + x]; }
+        void Set(u32 x, u32 y, u32 type);
+        void Fill(const Math::uRect2D& area, u32 type);
+        void MarkAllDirty();
+
+        const Chunk& ChunkAt(u32 cx, u32 cy) const { return chunks[cy * chunkCount.x + cx]; }
+        Math::fRect2D ChunkBounds(u32 cx, u32 cy) const;
+
+        // finds the chunks overlapping the viewport (in world units) and rebuilds the dirty ones among them
+        void Update(const Math::fRect2D& viewport);
+        void Update(const CameraController2D& camera);
+        Span<const u32> VisibleChunks() const { return visible; }
+        const FrameStats& GetStats() const { return stats; }
+
+        // the tileset is a grid of tilesetSize tiles, type n uses the (n - 1)th tile in reading order
+        void CreateRender(GraphicsDevice& gd, u32 maxQuads = 16384);
+        void Draw(const CameraController2D& camera, const Texture2D& tileset, Math::uv2 tilesetSize);
+    private:
+        void RebuildChunk(u32 index);
+    };
+}
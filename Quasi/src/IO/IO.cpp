@@ -9,6 +9,7 @@
 
 namespace Quasi::IO {
     IO::IO(Graphics::GraphicsDevice& gd) : gdevice(gd) {
+        if (!gd.GetWindow()) return; // headless, theres nothing to listen to
         SetUserPtr();
 
         glfwSetFramebufferSizeCallback(gd.GetWindow(), [] (GLFWwindow* window, int width, int height) {
@@ -11,6 +11,7 @@ namespace Quasi::IO {
     const GLFWwindow* KeyboardType::inputWindow() const { return io->gdevice->GetWindow(); }
     
     KeyboardType::KeyboardType(IO& io) : io(io) {
+        if (!inputWindow()) return; // headless, theres nothing to listen to
         glfwSetKeyCallback(inputWindow(),
             // clever hack >:)
             [](GLFWwindow* win, auto... args) {
@@ -10,6 +10,7 @@ namespace Quasi::IO {
     const GLFWwindow* MouseType::inputWindow() const { return io->gdevice->GetWindow(); }
 
     MouseType::MouseType(IO& io) : io(io) {
+        if (!inputWindow()) return; // headless, theres nothing to listen to
         glfwSetMouseButtonCallback(inputWindow(),
             [](GLFWwindow* window, int button, int action, int mods) {
                 IO::GetIOPtr(window)->Mouse.OnGlfwMouseCallback(window, button, action, mods);
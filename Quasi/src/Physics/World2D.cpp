@@ -64,7 +64,7 @@ namespace Quasi::Physics2D {
         }
 
 
-        bodies.SortByKey([&] (const Box<Body>& b) { return b->boundingBox.min.x; });
+        bodies.RadixSortByKey([&] (const Box<Body>& b) { return b->boundingBox.min.x; });
         // std::ranges::sort(bodyIndicesSorted, [&](u32 i, u32 j) { return cmpr(bodies[i]) < cmpr(bodies[j]); });
 
         // sweep impl
@@ -1,4 +1,6 @@
 #pragma once
+#include <algorithm>
+
 #include "Vec.h"
 
 namespace Quasi::Algorithm {
@@ -158,8 +160,8 @@ namespace Quasi::Algorithm {
 
             template <class T>
             void SmallSortGeneral(Span<T> span, Comparator<T> auto&& cmp) {
-                T* stackArray = (T*)_alloca(sizeof(T) * SMALL_SORT_GENERAL_SCRATCH_LEN);
-                return SmallSortGeneralScratched(span, Spans::Slice(stackArray, SMALL_SORT_GENERAL_SCRATCH_LEN), cmp);
+                Memory::ScratchArray<T, sizeof(T) * SMALL_SORT_GENERAL_SCRATCH_LEN> stackArray { SMALL_SORT_GENERAL_SCRATCH_LEN };
+                return SmallSortGeneralScratched(span, Spans::Slice(stackArray.Data(), SMALL_SORT_GENERAL_SCRATCH_LEN), cmp);
             }
 
             template <class T>
@@ -863,12 +865,12 @@ namespace Quasi::Algorithm {
         if (sizeof(T) * std::min(left, right) <= MAX_STACK_ARRAY_SIZE) {
             T* begin = mid - left;
             if (left < right) {
-                T* temp = Memory::QAlloca$(T, left);
+                Memory::ScratchArray<T, MAX_STACK_ARRAY_SIZE> temp { left };
                 Memory::RangeConstructMoveNoOverlap(temp, begin, left);
                 Memory::RangeMove                  (begin, mid, right);
                 Memory::RangeMoveNoOverlap         (begin + right, temp, left);
             } else {
-                T* temp = Memory::QAlloca$(T, right);
+                Memory::ScratchArray<T, MAX_STACK_ARRAY_SIZE> temp { right };
                 Memory::RangeConstructMoveNoOverlap(temp, mid, right);
                 Memory::RangeMoveRev               (begin + right, begin, left);
                 Memory::RangeMoveNoOverlap         (begin, temp, right);
@@ -1003,6 +1005,81 @@ namespace Quasi::Algorithm {
             output[i] = input[srcIndices[i]];
         }
     }
+
+    // lsd radix sort, stable. keys are integers or floats, mapped to unsigned ints that sort the same way
+    namespace RadixSorting {
+        template <class K> concept RadixKey = Integer<K> || Floating<K>;
+
+        // below this insertion sort wins, clearing the histograms alone costs more
+        constexpr usize RADIX_SORT_THRESHOLD = 64;
+        // bigger elements are sorted as key + index pairs and permuted at the end
+        constexpr usize RADIX_SORT_MAX_DIRECT_SIZE = 16;
+
+        template <RadixKey K>
+        auto ToUnsignedKey(K key) {
+            if constexpr (Floating<K>) {
+                // negatives get every bit flipped so bigger magnitudes come first, positives go above them
+                using U = typename NumInfo<K>::EquivalentInt;
+                const U bits = NumInfo<K>::BitsOf(key);
+                return bits ^ (-(bits >> (sizeof(U) * 8 - 1)) | NumInfo<K>::SIGN_MASK);
+            } else if constexpr (Signed<K>) {
+                return (IntoUnsigned<K>)((IntoUnsigned<K>)key ^ (IntoUnsigned<K>)1 << (sizeof(K) * 8 - 1));
+            } else return key;
+        }
+
+        // keyf gives unsigned keys. sorted back and forth between span and scratch,
+        // skipping bytes that are the same in every key
+        template <class T>
+        void LsdSort(Span<T> span, T* scratch, auto&& keyf) {
+            using U = decltype(keyf(span[0]));
+            static constexpr usize PASSES = sizeof(U);
+            const usize len = span.Length();
+
+            usize counts[PASSES][256] = {};
+            for (const T& x : span) {
+                const U key = keyf(x);
+                for (usize p = 0; p < PASSES; ++p) ++counts[p][(key >> (p * 8)) & 0xFF];
+            }
+
+            T* src = span.Data(), *dst = scratch;
+            for (usize p = 0; p < PASSES; ++p) {
+                usize* offsets = counts[p];
+                if (offsets[(keyf(src[0]) >> (p * 8)) & 0xFF] == len) continue;
+                for (usize d = 0, sum = 0; d < 256; ++d) {
+                    const usize n = offsets[d];
+                    offsets[d] = sum;
+                    sum += n;
+                }
+                for (usize i = 0; i < len; ++i)
+                    dst[offsets[(keyf(src[i]) >> (p * 8)) & 0xFF]++] = src[i];
+                std::swap(src, dst);
+            }
+            if (src != span.Data()) Memory::RangeCopyNoOverlap(span.Data(), src, len);
+        }
+
+        template <IsMut T>
+        void RadixSortByKey(Span<T> span, FnArgs<const T&> auto&& keyf) {
+            const usize len = span.Length();
+            const auto unsignedKey = [&] (const T& x) { return ToUnsignedKey(keyf(x)); };
+            if (len < RADIX_SORT_THRESHOLD)
+                return SortingDetails::SmallSort::SmallSortFallback(span, Cmp::CompareKeyed { unsignedKey });
+
+            if constexpr (TrivialCopy<T> && sizeof(T) <= RADIX_SORT_MAX_DIRECT_SIZE) {
+                Memory::ScratchArray<T> scratch { len };
+                LsdSort(span, scratch.Data(), unsignedKey);
+            } else {
+                using U = decltype(unsignedKey(span[0]));
+                struct KeyIndex { U key; u32 index; };
+                Memory::ScratchArray<KeyIndex> keys { len * 2 };
+                for (usize i = 0; i < len; ++i) keys[i] = { unsignedKey(span[i]), (u32)i };
+                LsdSort(Spans::Slice(keys.Data(), len), keys + len, [] (const KeyIndex& k) { return k.key; });
+
+                Memory::ScratchArray<u32> order { len };
+                for (usize i = 0; i < len; ++i) order[i] = keys[i].index;
+                ApplyRevPermutationInPlace(span, Spans::Slice(order.Data(), len));
+            }
+        }
+    }
 }
 
 namespace Quasi {
@@ -1066,6 +1143,11 @@ namespace Quasi {
         return SortBy(Cmp::CompareKeyed { keyf });
     }
 
+    template <class T>
+    void Span<T>::RadixSortByKey(FnArgs<const T&> auto&& keyf) requires IsMut<T> {
+        return Algorithm::RadixSorting::RadixSortByKey(*this, keyf);
+    }
+
     template <class T> bool Span<T>::IsSortedBy(Comparator<T> auto&& cmp) const {
         return Algorithm::SortingDetails::IsSorted(*this, cmp);
     }
@@ -0,0 +1,85 @@
+#include "Arena.h"
+
+#include "Debug/Logger.h"
+
+namespace Quasi::Memory {
+    void ArenaRegion::Register(const byte* block, usize size) {
+        while (Registering.test_and_set(std::memory_order_acquire)) {}
+        bool registered = false;
+        for (Slot& slot : Slots) {
+            if (slot.end.load(std::memory_order_relaxed) != 0) continue;
+            slot.begin.store((usize)block, std::memory_order_relaxed);
+            slot.end.store((usize)block + size, std::memory_order_release);
+            const u32 index = (u32)(&slot - Slots);
+            if (index >= SlotsUsed.load(std::memory_order_relaxed)) SlotsUsed.store(index + 1, std::memory_order_release);
+            registered = true;
+            break;
+        }
+        Registering.clear(std::memory_order_release);
+        Debug::Assert(registered, "more than {} arena regions are live at once", MAX_REGIONS);
+    }
+
+    void ArenaRegion::Unregister(const byte* block) {
+        while (Registering.test_and_set(std::memory_order_acquire)) {}
+        for (Slot& slot : Slots) {
+            if (slot.begin.load(std::memory_order_relaxed) != (usize)block || slot.end.load(std::memory_order_relaxed) == 0) continue;
+            slot.end.store(0, std::memory_order_release);
+            slot.begin.store(0, std::memory_order_relaxed);
+            break;
+        }
+        Registering.clear(std::memory_order_release);
+    }
+
+    LinearArena::LinearArena(usize capacity)
+        : block((byte*)::operator new (capacity)), capacity(capacity), ownsBlock(true) {
+        ArenaRegion::Register(block, capacity);
+    }
+
+    LinearArena::~LinearArena() {
+        if (ActiveArena == this) ActiveArena = nullptr;
+        if (!ownsBlock) return;
+        ArenaRegion::Unregister(block);
+        ::operator delete (block);
+    }
+
+    void* LinearArena::TryAllocate(usize size) {
+        // zero sized allocations still need an address inside the block, or FreeRaw would delete them
+        size = std::max<usize>(size, 1);
+        const usize start = (used + ALIGN - 1) & ~(ALIGN - 1);
+        if (start > capacity || size > capacity - start) {
+            ++overflows;
+            return nullptr;
+        }
+        used = start + size;
+        highWater = std::max(highWater, used);
+        ++allocations;
+        return block + start;
+    }
+
+    void LinearArena::Reset() {
+        if constexpr (Debug::Logger::DEBUG) MemSet(block, POISON, used);
+        used = 0;
+        allocations = 0;
+        overflows = 0;
+    }
+
+    ArenaScope::ArenaScope(LinearArena& arena) : ArenaScope(&arena) {}
+
+    ArenaScope::ArenaScope(LinearArena* arena) : previous(LinearArena::ActiveArena) {
+        if (!arena) return;
+        // FreeRaw would delete anything allocated from outside the region
+        Debug::Assert(ArenaRegion::Contains(arena->block), "scoped arena isnt in the arena region");
+        LinearArena::ActiveArena = arena;
+    }
+
+    FrameArena::FrameArena(usize capacity)
+        : block((byte*)::operator new (capacity * 2)),
+          arenas { LinearArena { block, capacity }, LinearArena { block + capacity, capacity } } {
+        ArenaRegion::Register(block, capacity * 2);
+    }
+
+    FrameArena::~FrameArena() {
+        ArenaRegion::Unregister(block);
+        ::operator delete (block);
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+#include "Memory.h"
+
+namespace Quasi::Memory {
+    // the blocks of memory arenas are allowed to hand out. FreeRaw checks every pointer against them,
+    // so its a couple of atomic loads and compares per live region, from any thread
+    class ArenaRegion {
+    public:
+        static constexpr u32 MAX_REGIONS = 8;
+    private:
+        // End goes first when a region is unregistered and last when one is registered,
+        // so a reader never sees a slot that covers memory it shouldnt
+        struct Slot { std::atomic<usize> begin, end; };
+        inline static Slot Slots[MAX_REGIONS] {};
+        inline static std::atomic<u32> SlotsUsed = 0; // slots past this were never registered
+        inline static std::atomic_flag Registering;
+    public:
+        static void Register(const byte* block, usize size);
+        static void Unregister(const byte* block);
+
+        static bool Contains(const void* ptr) {
+            const usize p = (usize)ptr, used = SlotsUsed.load(std::memory_order_acquire);
+            for (usize i = 0; i < used; ++i)
+                if (Slots[i].begin.load(std::memory_order_relaxed) <= p && p < Slots[i].end.load(std::memory_order_relaxed))
+                    return true;
+            return false;
+        }
+    };
+
+    // a bump allocator over one fixed block. nothing is freed on its own, everything goes at once on Reset.
+    // while an ArenaScope is active, AllocateRaw (and so Vec, String and HashMap) draws from the arena,
+    // and FreeRaw ignores anything inside an ArenaRegion. whatever doesnt fit falls back to the heap.
+    // arena memory is never handed to delete, Vec::IntoBox moves an arena backed buffer to the heap first.
+    class LinearArena {
+        byte* block = nullptr;
+        usize capacity = 0, used = 0;
+        usize highWater = 0, allocations = 0, overflows = 0;
+        bool ownsBlock = false;
+
+        inline static thread_local LinearArena* ActiveArena = nullptr;
+
+        friend class ArenaScope;
+    public:
+        static constexpr usize ALIGN = alignof(std::max_align_t);
+        static constexpr byte POISON = 0xCD; // everything reset gets filled with this in debug builds
+
+        // allocates its own block and registers it as an ArenaRegion
+        explicit LinearArena(usize capacity);
+        // over part of a block someone else owns and registered
+        LinearArena(byte* block, usize capacity) : block(block), capacity(capacity) {}
+        ~LinearArena();
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        // null if it doesnt fit
+        void* TryAllocate(usize size);
+        void Reset();
+
+        bool Owns(const void* ptr) const { return block <= (const byte*)ptr && (const byte*)ptr < block + capacity; }
+
+        usize Used() const { return used; }
+        usize Capacity() const { return capacity; }
+        usize HighWater() const { return highWater; }
+        usize AllocationCount() const { return allocations; } // since the last reset
+        usize OverflowCount() const { return overflows; }     // since the last reset
+
+        static LinearArena* Active() { return ActiveArena; }
+        static bool IsArenaMemory(const void* ptr) { return ArenaRegion::Contains(ptr); }
+    };
+
+    // routes this thread's allocations to an arena until the scope ends
+    class ArenaScope {
+        LinearArena* previous;
+    public:
+        explicit ArenaScope(LinearArena& arena);
+        // a null arena leaves whatever was active in place
+        explicit ArenaScope(LinearArena* arena);
+        ~ArenaScope() { LinearArena::ActiveArena = previous; }
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+    };
+
+    // two arenas taking turns, so anything allocated in a frame stays valid through the next one.
+    // both halves share one block, which is registered as one ArenaRegion
+    class FrameArena {
+        byte* block;
+        LinearArena arenas[2];
+        u32 current = 0;
+    public:
+        static constexpr usize DEFAULT_CAPACITY = 4 * 1024 * 1024;
+
+        explicit FrameArena(usize capacity = DEFAULT_CAPACITY);
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        LinearArena& Current() { return arenas[current]; }
+        const LinearArena& Current() const { return arenas[current]; }
+        // the last finished frame, its stats are complete
+        const LinearArena& Previous() const { return arenas[current ^ 1]; }
+
+        // frees everything from 2 frames ago
+        void NextFrame() { current ^= 1; arenas[current].Reset(); }
+    };
+}
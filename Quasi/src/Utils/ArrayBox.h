@@ -17,6 +17,8 @@ namespace Quasi {
         ArrayBox(Nullptr) : buf(nullptr), size(0) {}
         using IResource<Span<T>, ArrayBox>::IResource;
         using IResource<Span<T>, ArrayBox>::operator=;
+        ArrayBox(ArrayBox&& box) noexcept { this->MoveConstructOp(box); }
+        ArrayBox& operator=(ArrayBox&& box) noexcept { this->MoveAssignOp(box); return *this; }
 
         static ArrayBox Allocate      (usize amt) { return { Memory::AllocateArray<T>(amt), amt }; }
         static ArrayBox AllocateUninit(usize amt) { return { Memory::AllocateArrayUninit<T>(amt), amt }; }
@@ -68,6 +70,8 @@ namespace Quasi {
         explicit operator bool() const { return buf != nullptr; }
     };
 
+    template <class T> struct Memory::TriviallyRelocatable<ArrayBox<T>> { static constexpr bool VALUE = true; };
+
     template <class T, class A> ArrayBox<T> Box<T, A>::IntoArrayBox() {
         return ArrayBox<T>::Own(Release(), 1);
     }
@@ -0,0 +1,58 @@
+#include "Atom.h"
+
+#include "HashMap.h"
+#include "Vec.h"
+
+namespace Quasi {
+    // names are copied into pages that are never reallocated, so the Strs in lookup stay valid
+    struct AtomTable {
+        static constexpr usize PAGE_SIZE = 4096;
+
+        Vec<Vec<char>> pages;
+        Vec<Str> names;
+        HashMap<Str, u32> lookup;
+
+        AtomTable() {
+            names.Push(Str::Empty());
+            lookup.Insert(Str::Empty(), 0);
+        }
+
+        Str Store(Str name) {
+            if (!pages || pages.Last().Length() + name.Length() > pages.Last().Capacity())
+                pages.Push(Vec<char>::WithCap(std::max(PAGE_SIZE, name.Length())));
+            Vec<char>& page = pages.Last();
+            const usize start = page.Length();
+            page.Extend(name.AsSpan());
+            return Str::Slice(page.Data() + start, name.Length());
+        }
+
+        static AtomTable& Global() {
+            static AtomTable table;
+            return table;
+        }
+    };
+
+    Atom Atom::Of(Str name) {
+        AtomTable& table = AtomTable::Global();
+        if (const Option<u32> id = table.lookup.Get(name).Copied()) return FromId(*id);
+
+        const u32 id = (u32)table.names.Length();
+        const Str stored = table.Store(name);
+        table.names.Push(stored);
+        table.lookup.Insert(stored, id);
+        return FromId(id);
+    }
+
+    Option<Atom> Atom::Find(Str name) {
+        const Option<u32> id = AtomTable::Global().lookup.Get(name).Copied();
+        return id ? Options::Some(FromId(*id)) : nullptr;
+    }
+
+    usize Atom::Count() {
+        return AtomTable::Global().names.Length();
+    }
+
+    Str Atom::Name() const {
+        return AtomTable::Global().names[id];
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "Str.h"
+
+namespace Quasi {
+    // an interned string. every name gets one id for the whole program, so atoms compare and hash as a u32,
+    // and the name itself is never copied again. the table only grows, so interning is meant for names that are
+    // known at load time, and it isnt locked: dont intern from several threads at once
+    struct Atom {
+        u32 id = 0; // 0 is always the empty string
+
+        Atom() = default;
+        static Atom FromId(u32 id) { Atom a; a.id = id; return a; }
+
+        // interns the name if it wasnt already
+        static Atom Of(Str name);
+        // only looks the name up, so asking about arbitrary strings doesnt fill the table
+        static Option<Atom> Find(Str name);
+        static usize Count();
+
+        Str Name() const;
+        Hashing::Hash GetHashCode() const { return Hashing::HashInt(id); }
+
+        bool IsEmpty() const { return id == 0; }
+        bool operator==(const Atom&) const = default;
+    };
+}
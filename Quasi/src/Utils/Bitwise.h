@@ -1,7 +1,29 @@
 #pragma once
 #include "Numeric.h"
 
+#if defined(_MSC_VER) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
 namespace Quasi::Bitwise {
     bool ContainsNullByte(u64 x);
     u32 PlaceOfNullByte(u64 x); // this uses big endian: 01234567 where 0 is the highest position, && assumes there is a null byte
+
+    // the full 128 bit product, returns the high half
+    inline u64 Mul128(u64 a, u64 b, u64& lo) {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 u128; // keeps -pedantic quiet
+        const u128 p = (u128)a * b;
+        lo = (u64)p;
+        return (u64)(p >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return _umul128(a, b, &lo);
+#else
+        const u64 ll = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF), lh = (a & 0xFFFFFFFF) * (b >> 32),
+                  hl = (a >> 32) * (b & 0xFFFFFFFF),        hh = (a >> 32) * (b >> 32);
+        const u64 mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+        lo = mid << 32 | (ll & 0xFFFFFFFF);
+        return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+    }
 }
@@ -138,6 +138,10 @@ namespace Quasi {
         template <class _T, class _A> friend struct Box;
     };
 
+    template <class T, class A> struct Memory::TriviallyRelocatable<Box<T, A>> {
+        static constexpr bool VALUE = TrivialRelocate<A>;
+    };
+
     namespace Boxs {
         template <class T>
         Box<T> New(T val) { return Box<T>::New(std::move(val)); }
@@ -0,0 +1,214 @@
+#include "AsyncLogger.h"
+
+#include <cerrno>
+#include <csignal>
+
+#include "Utils/CStr.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Quasi::Debug {
+#ifdef _WIN32
+    static int FileDescriptor(std::FILE* file) { return _fileno(file); }
+    static isize RawWrite(int fd, const char* data, usize len) { return _write(fd, data, (unsigned)std::min<usize>(len, 1 << 30)); }
+#else
+    static int FileDescriptor(std::FILE* file) { return fileno(file); }
+    static isize RawWrite(int fd, const char* data, usize len) { return write(fd, data, len); }
+#endif
+
+    // write() until everything is out, safe to call from a signal handler
+    static void WriteAll(int fd, const char* data, usize len) {
+        while (len) {
+            const isize n = RawWrite(fd, data, len);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return;
+            data += n;
+            len  -= (usize)n;
+        }
+    }
+
+    LogRing::LogRing(usize capacity, std::thread::id owner)
+        : data(ArrayBox<byte>::AllocateUninit(std::bit_ceil(std::max<usize>(capacity, 256)))), owner(owner) {
+        // touched once up front, so the first lap around it doesnt page fault on every few logs
+        Memory::MemSet(data.Data(), 0, data.Length());
+    }
+
+    usize LogRing::Drain(FuncRef<void(const byte*)> read) {
+        usize t = tail.load(std::memory_order_relaxed), count = 0;
+        const usize h = head.load(std::memory_order_acquire), cap = Capacity();
+        while (t != h) {
+            const usize offset = t & (cap - 1);
+            const u32 size = Memory::ReadU32Native(&data[offset]);
+            if (size == 0) { t += cap - offset; continue; }
+            read(&data[offset]);
+            t += size;
+            ++count;
+            // released one at a time, so a blocked producer gets going again early
+            tail.store(t, std::memory_order_release);
+        }
+        tail.store(t, std::memory_order_release);
+        return count;
+    }
+
+    AsyncLogger::AsyncLogger(std::FILE* out, OverflowPolicy policy, usize ringSize)
+        : file(out ? out : stdout), fd(FileDescriptor(file)), ownsFile(false), policy(policy), ringSize(ringSize),
+          formatted(ArrayBox<char>::AllocateUninit(BATCH_SIZE)), id(NextId.fetch_add(1, std::memory_order_relaxed)) {
+        // anything stdio still has buffered goes first, everything after is written past it
+        std::fflush(file);
+        for (std::atomic<AsyncLogger*>& live : LiveLoggers) {
+            AsyncLogger* none = nullptr;
+            if (live.compare_exchange_strong(none, this, std::memory_order_acq_rel)) break;
+        }
+        worker = std::thread { [this] { Run(); } };
+    }
+
+    AsyncLogger::AsyncLogger(CStr filename, OverflowPolicy policy, usize ringSize)
+        : AsyncLogger(std::fopen(filename.Data(), "w"), policy, ringSize) {
+        ownsFile = file != stdout;
+    }
+
+    AsyncLogger::~AsyncLogger() {
+        for (std::atomic<AsyncLogger*>& live : LiveLoggers) {
+            AsyncLogger* self = this;
+            if (live.compare_exchange_strong(self, nullptr, std::memory_order_acq_rel)) break;
+        }
+        stopping.store(true, std::memory_order_release);
+        worker.join();
+        if (ownsFile) std::fclose(file);
+    }
+
+    LogRing* AsyncLogger::RegisterThread() {
+        while (registering.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+
+        const std::thread::id self = std::this_thread::get_id();
+        const u32 count = ringCount.load(std::memory_order_relaxed);
+        LogRing* ring = nullptr;
+        for (u32 i = 0; i < count; ++i)
+            if (rings[i]->Owner() == self) { ring = rings[i].Data(); break; }
+        if (!ring && count < MAX_THREADS) {
+            rings[count] = Box<LogRing>::Build(ringSize, self);
+            ring = rings[count].Data();
+            ringCount.store(count + 1, std::memory_order_release);
+        }
+
+        registering.clear(std::memory_order_release);
+        // too many threads, these just get dropped
+        if (!ring) return nullptr;
+        CachedId = id;
+        CachedRing = ring;
+        return ring;
+    }
+
+    byte* AsyncLogger::ReserveSlow(LogRing& ring, usize size) {
+        if (size <= ring.Capacity() && policy == BLOCK) {
+            while (!stopping.load(std::memory_order_relaxed)) {
+                if (byte* out = ring.TryReserve(size)) return out;
+                std::this_thread::yield();
+            }
+        }
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    void AsyncLogger::Run() {
+        auto writeRecord = [&] (const LogRecord& record) {
+            message.Clear();
+            line.Clear();
+            record.write(Text::StringWriter::WriteTo(message), record.fmt, record.Args());
+            record.logger->FmtLog(Text::StringWriter::WriteTo(line), message, record.severity, record.time, record.loc);
+            Append(line);
+        };
+
+        while (true) {
+            const bool stop = stopping.load(std::memory_order_acquire);
+            const u64 flushes = flushesRequested.load(std::memory_order_acquire);
+            while (draining.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+            usize written = DrainAll(writeRecord);
+            const usize lost = dropped.load(std::memory_order_relaxed);
+            if (lost != reportedDropped) {
+                line.Clear();
+                Text::FormatTo(Text::StringWriter::WriteTo(line), "[{} logs dropped]\n"_fmt, lost - reportedDropped);
+                Append(line);
+                reportedDropped = lost;
+            }
+            written += WriteFormatted();
+            draining.clear(std::memory_order_release);
+            flushesDone.store(flushes, std::memory_order_release);
+
+            if (stop) break;
+            if (!written && flushes == flushesRequested.load(std::memory_order_relaxed))
+                std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+
+    usize AsyncLogger::DrainAll(FuncRef<void(const LogRecord&)> write) {
+        usize count = 0;
+        const u32 n = ringCount.load(std::memory_order_acquire);
+        for (u32 i = 0; i < n; ++i)
+            count += rings[i]->Drain([&] (const byte* record) { write(*(const LogRecord*)record); });
+        return count;
+    }
+
+    void AsyncLogger::Append(Str text) {
+        usize len = formattedLength.load(std::memory_order_relaxed);
+        if (len + text.Length() > formatted.Length()) {
+            WriteFormatted();
+            len = 0;
+        }
+        // too big for the buffer at all, so it goes straight out
+        if (text.Length() > formatted.Length()) return WriteAll(fd, text.Data(), text.Length());
+        Memory::MemCopyNoOverlap(formatted.Data() + len, text.Data(), text.Length());
+        formattedLength.store(len + text.Length(), std::memory_order_release);
+    }
+
+    usize AsyncLogger::WriteFormatted() {
+        const usize len = formattedLength.load(std::memory_order_relaxed);
+        if (!len) return 0;
+        WriteAll(fd, formatted.Data(), len);
+        formattedLength.store(0, std::memory_order_release);
+        return len;
+    }
+
+    void AsyncLogger::CrashFlush() {
+        // holding the drain flag stops the worker between batches. it might be the thread that crashed,
+        // so past a while this goes on without it, and leaves the rings alone since the worker could be in them
+        bool stopped = false;
+        for (u32 i = 0; i < CRASH_SPINS && !stopped; ++i)
+            stopped = !draining.test_and_set(std::memory_order_acquire);
+
+        WriteAll(fd, formatted.Data(), formattedLength.load(std::memory_order_acquire));
+        if (!stopped) return;
+
+        // formatting isnt safe in here, so queued records only get their format strings written out
+        static constexpr char UNFORMATTED[] = "[unformatted] ";
+        DrainAll([&] (const LogRecord& record) {
+            WriteAll(fd, UNFORMATTED, sizeof(UNFORMATTED) - 1);
+            WriteAll(fd, record.fmt.Data(), record.fmt.Length());
+            WriteAll(fd, "\n", 1);
+        });
+    }
+
+    void AsyncLogger::OnCrash(int signal) {
+        for (std::atomic<AsyncLogger*>& live : LiveLoggers)
+            if (AsyncLogger* logger = live.load(std::memory_order_acquire)) logger->CrashFlush();
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+
+    void AsyncLogger::InstallCrashHandlers() {
+        for (const int signal : { SIGSEGV, SIGABRT, SIGFPE, SIGILL })
+            std::signal(signal, OnCrash);
+    }
+
+    void AsyncLogger::Flush() {
+        const u64 target = flushesRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+        while (flushesDone.load(std::memory_order_acquire) < target) std::this_thread::yield();
+    }
+
+    byte* ReserveAsyncRecord(AsyncLogger& async, usize size) { return async.Reserve(size); }
+    void CommitAsyncRecord(AsyncLogger& async) { async.Commit(); }
+}
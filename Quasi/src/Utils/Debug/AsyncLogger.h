@@ -0,0 +1,155 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+#include "Logger.h"
+#include "Utils/ArrayBox.h"
+
+namespace Quasi {
+    struct CStr;
+}
+
+namespace Quasi::Debug {
+    // one producer, one consumer byte ring. records are 8 byte aligned and never wrap around the end,
+    // a record that wouldnt fit leaves a 0 size marker and starts over at the front
+    class LogRing {
+        ArrayBox<byte> data;
+        std::thread::id owner;
+        // the producer keeps its own copy of the tail, so it only touches the consumer's cache line when full
+        usize cachedTail = 0, pending = 0;
+        alignas(64) std::atomic<usize> head = 0;
+        alignas(64) std::atomic<usize> tail = 0;
+    public:
+        LogRing(usize capacity, std::thread::id owner);
+
+        usize Capacity() const { return data.Length(); }
+        std::thread::id Owner() const { return owner; }
+
+        // producer side, null if full
+        byte* TryReserve(usize size) {
+            const usize h = head.load(std::memory_order_relaxed), cap = Capacity();
+            const usize offset = h & (cap - 1);
+            const usize skip = offset + size > cap ? cap - offset : 0;
+            if (h + skip + size - cachedTail > cap) {
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (h + skip + size - cachedTail > cap) return nullptr;
+            }
+            if (skip) Memory::WriteU32Native(0, &data[offset]);
+            pending = skip + size;
+            return &data[skip ? 0 : offset];
+        }
+        void Commit() { head.store(head.load(std::memory_order_relaxed) + pending, std::memory_order_release); }
+
+        // consumer side, calls the function on every committed record and returns how many there were
+        usize Drain(FuncRef<void(const byte*)> read);
+        bool IsEmpty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+    };
+
+    // moves logging off the calling thread. a log is copied as a LogRecord into the thread's own ring,
+    // and a background thread decodes, formats and writes them out in batches.
+    // strings are copied, everything else has to be trivially copyable. the format string, the Logger
+    // and anything the arguments point to have to outlive the record, string literals always do.
+    // everything queued is written out by Flush and on destruction. with InstallCrashHandlers, a crash
+    // writes out whatever was already formatted, and just the format strings of what was still queued
+    class AsyncLogger {
+    public:
+        enum OverflowPolicy { DROP, BLOCK };
+
+        static constexpr usize DEFAULT_RING_SIZE = 64 * 1024; // per thread
+        static constexpr usize MAX_THREADS = 64;
+        static constexpr usize BATCH_SIZE = 64 * 1024;        // written out once this fills up
+        static constexpr usize MAX_LIVE = 8;                  // loggers the crash handlers can see at once
+        static constexpr std::chrono::milliseconds IDLE_SLEEP { 1 };
+        static constexpr u32 CRASH_SPINS = 1 << 24;           // how long a crash waits for the worker to let go
+    private:
+        std::FILE* file;
+        int fd; // written to directly, so the crash handlers can write to it without stdio
+        bool ownsFile;
+        OverflowPolicy policy;
+        usize ringSize;
+
+        Box<LogRing> rings[MAX_THREADS];
+        std::atomic<u32> ringCount = 0;
+        std::atomic_flag registering, draining;
+        std::atomic<usize> dropped = 0;
+        usize reportedDropped = 0;
+
+        std::atomic<bool> stopping = false;
+        std::atomic<u64> flushesRequested = 0, flushesDone = 0;
+        // formatted logs not written out yet. the buffer never moves and the length is only
+        // bumped once the bytes are in, so a crash can write out exactly what is there
+        ArrayBox<char> formatted;
+        std::atomic<usize> formattedLength = 0;
+        String line, message;
+        std::thread worker;
+
+        u64 id;
+        inline static std::atomic<u64> NextId = 1;
+        inline static thread_local u64 CachedId = 0;
+        inline static thread_local LogRing* CachedRing = nullptr;
+        inline static std::atomic<AsyncLogger*> LiveLoggers[MAX_LIVE] {};
+
+        LogRing* ThreadRing() { return CachedId == id ? CachedRing : RegisterThread(); }
+        LogRing* RegisterThread();
+        byte* ReserveSlow(LogRing& ring, usize size);
+
+        template <class... Ts>
+        void PushRecord(const Logger& logger, Severity severity, Str fmt, const SourceLoc& loc,
+                        LogRecord::WriteFn write, const Ts&... args) {
+            const usize size = LogRecord::SizeOf(args...);
+            byte* out = Reserve(size);
+            if (!out) return;
+            LogRecord::Emplace(out, size, logger, severity, fmt, loc, write, args...);
+            Commit();
+        }
+
+        void Run();
+        usize DrainAll(FuncRef<void(const LogRecord&)> write);
+        void Append(Str text);
+        usize WriteFormatted();
+        void CrashFlush();
+        static void OnCrash(int signal);
+    public:
+        explicit AsyncLogger(std::FILE* out = stdout, OverflowPolicy policy = DROP, usize ringSize = DEFAULT_RING_SIZE);
+        explicit AsyncLogger(CStr filename, OverflowPolicy policy = DROP, usize ringSize = DEFAULT_RING_SIZE);
+        // writes out everything still queued
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        // space for a record in this thread's ring, null (and counted as dropped) if it doesnt fit
+        byte* Reserve(usize size) {
+            LogRing* ring = ThreadRing();
+            if (!ring) { dropped.fetch_add(1, std::memory_order_relaxed); return nullptr; }
+            byte* out = ring->TryReserve(size);
+            return out ? out : ReserveSlow(*ring, size);
+        }
+        // publishes the record from the last Reserve on this thread
+        void Commit() { ThreadRing()->Commit(); }
+
+        // only strings and trivially copyable arguments can be queued
+        template <class... Ts> static constexpr bool CAN_QUEUE = LogRecord::CAN_QUEUE<Ts...>;
+
+        template <class... Ts> requires CAN_QUEUE<Ts...>
+        void Push(const Logger& logger, Severity severity, Str fmt, const SourceLoc& loc, const Ts&... args) {
+            PushRecord(logger, severity, fmt, loc, &LogRecord::WriteDynamic<Ts...>, args...);
+        }
+
+        template <Text::FixedString S, class... Ts> requires CAN_QUEUE<Ts...>
+        void Push(const Logger& logger, Severity severity, Text::StaticFormat<S>, const SourceLoc& loc, const Ts&... args) {
+            PushRecord(logger, severity, Str::Slice(S.buf, S.SIZE), loc, &LogRecord::WriteStatic<S, Ts...>, args...);
+        }
+
+        // blocks until everything pushed before it is written
+        void Flush();
+        void SetPolicy(OverflowPolicy p) { policy = p; }
+        usize DroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+        // on SIGSEGV, SIGABRT, SIGFPE and SIGILL, writes out what every live logger has formatted
+        // and the format strings of what it still had queued, then lets the process die as it would have.
+        // the handler only uses atomics and write(), nothing in it allocates, formats or touches stdio
+        static void InstallCrashHandlers();
+    };
+}
@@ -34,15 +34,14 @@ namespace Quasi::Debug {
     void Logger::FmtLog(Text::StringWriter output, Str log, Severity severity, DateTime time, const SourceLoc& fileLoc) const {
         const Text::ConsoleColor scol = severity->color;
         Text::FormatTo(output,
-            "{}[{:%y-%M-%d %H:%m:%s.%u}]{} {}> {}{:<8}",
+            "{}[{:%y-%M-%d %H:%m:%s.%u}]{} {}> {}{:<8}"_fmt,
             scol, time, Text::RESET, name,
-            scol, Text::Format("[{}]:", severity->name)
+            scol, Text::Format("[{}]:"_fmt, severity->name)
         );
         FmtSourceLoc(output, fileLoc);
         output.Write(log);
         output.SetColor(Text::RESET);
         output.Write('\n');
-        fflush(stdout);
     }
 
     Str Logger::FmtFile(Str fullname) const {
@@ -51,8 +50,8 @@ namespace Quasi::Debug {
 
     void Logger::FmtSourceLoc(Text::StringWriter output, const SourceLoc& loc) const {
         includeFunction ?
-            FormatTo(output, "{}:{}:{} in {}: ", FmtFile(loc.file_name()), loc.line(), loc.column(), loc.function_name()) :
-            FormatTo(output, "{}:{}:{}: ", FmtFile(loc.file_name()), loc.line(), loc.column());
+            FormatTo(output, "{}:{}:{} in {}: "_fmt, FmtFile(loc.file_name()), loc.line(), loc.column(), loc.function_name()) :
+            FormatTo(output, "{}:{}:{}: "_fmt, FmtFile(loc.file_name()), loc.line(), loc.column());
     }
 
     void Logger::LogNoOut(const Severity sv, const Str s, const SourceLoc& loc) {
@@ -62,6 +61,7 @@ namespace Quasi::Debug {
 
     void Logger::ConsoleLog(const Severity sv, const Str s, const SourceLoc& loc) {
         FmtLog(logOut, s, sv, Timer::Now(), loc);
+        fflush(stdout);
     }
 
     void Logger::Log(const Severity sv, const Str s, const SourceLoc& loc) {
@@ -74,7 +74,7 @@ namespace Quasi::Debug {
 
     void Logger::AssertMsg(const bool assert, Str msg, const SourceLoc& loc) {
         if (!assert) {
-            Log(Severity::ERROR, Text::Format("Assertion failed: {}", msg), loc);
+            Log(Severity::ERROR, Text::Format("Assertion failed: {}"_fmt, msg), loc);
             DebugBreak();
         }
     }
@@ -128,18 +128,18 @@ namespace Quasi::Text {
             switch (fmt[i + 1]) {
                 case '%': out.Write('%'); ++len; ++i; continue;
                 case 'y': len += FormatObjectTo(out, (i32)ymd.year());                   ++i; continue;
-                case 'M': len += Text::FormatTo(out, "{:02}", (u32)ymd.month());         ++i; continue;
+                case 'M': len += Text::FormatTo(out, "{:02}"_fmt, (u32)ymd.month());         ++i; continue;
                 case 'N': len += out.Write(MONTH_NAMES[(u32)ymd.month()]);               ++i; continue;
                 case 'n': len += out.Write(MONTH_NAMES[(u32)ymd.month()].First(3));      ++i; continue;
-                case 'd': len += Text::FormatTo(out, "{:02}", (u32)ymd.day());           ++i; continue;
+                case 'd': len += Text::FormatTo(out, "{:02}"_fmt, (u32)ymd.day());           ++i; continue;
                 case 'A': len += out.Write(WEEKDAY_NAMES[(u32)ymd.day()]);               ++i; continue;
                 case 'a': len += out.Write(WEEKDAY_NAMES[(u32)ymd.day()].First(3));      ++i; continue;
-                case 'h': len += Text::FormatTo(out, "{:02}", hms.hours().count() % 12); ++i; continue;
-                case 'H': len += Text::FormatTo(out, "{:02}", hms.hours().count());      ++i; continue;
+                case 'h': len += Text::FormatTo(out, "{:02}"_fmt, hms.hours().count() % 12); ++i; continue;
+                case 'H': len += Text::FormatTo(out, "{:02}"_fmt, hms.hours().count());      ++i; continue;
                 case 'g': len += out.Write(hms.hours() >= 12h ? "PM"_str : "AM"_str);    ++i; continue;
-                case 'm': len += Text::FormatTo(out, "{:02}", hms.minutes().count());    ++i; continue;
-                case 's': len += Text::FormatTo(out, "{:02}", hms.seconds().count());    ++i; continue;
-                case 'u': len += Text::FormatTo(out, "{:03}", hms.subseconds().count()); ++i; continue;
+                case 'm': len += Text::FormatTo(out, "{:02}"_fmt, hms.minutes().count());    ++i; continue;
+                case 's': len += Text::FormatTo(out, "{:02}"_fmt, hms.seconds().count());    ++i; continue;
+                case 'u': len += Text::FormatTo(out, "{:03}"_fmt, hms.subseconds().count()); ++i; continue;
                 default:;
             }
         }
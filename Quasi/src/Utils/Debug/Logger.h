@@ -45,6 +45,119 @@ namespace Quasi::Debug {
         SourceLoc fileLoc;
     };
 
+    class Logger;
+    class AsyncLogger;
+
+    // a log queued for the AsyncLogger, as a binary record: this header, then the raw arguments.
+    // write is a decoder standing in for the format string and the argument types.
+    // strings are copied, everything else has to be trivially copyable
+    struct LogRecord {
+        using WriteFn = FuncPtr<usize, Text::StringWriter, Str, const byte*>;
+
+        u32 size; // the whole record, arguments included. 0 means skip to the start of the ring
+        Severity severity;
+        const Logger* logger;
+        WriteFn write;
+        Str fmt;
+        SourceLoc loc;
+        DateTime time;
+
+        const byte* Args() const { return (const byte*)this + sizeof(LogRecord); }
+
+        template <class T> static constexpr bool IS_STRING = ConvTo<const T&, Str>;
+        template <class T> using Decoded = IfElse<IS_STRING<T>, Str, T>;
+        template <class... Ts> static constexpr bool CAN_QUEUE = ((IS_STRING<Ts> || TrivialCopy<Ts>) && ...);
+
+        template <class T> static usize EncodedSize(const T& arg) {
+            if constexpr (IS_STRING<T>) return sizeof(u32) + Str { arg }.Length();
+            else return sizeof(T);
+        }
+        template <class T> static byte* Encode(byte* out, const T& arg) {
+            if constexpr (IS_STRING<T>) {
+                const Str s = arg;
+                Memory::WriteU32Native((u32)s.Length(), out);
+                Memory::MemCopyNoOverlap(out + sizeof(u32), s.Data(), s.Length());
+                return out + sizeof(u32) + s.Length();
+            } else {
+                Memory::MemCopyNoOverlap(out, &arg, sizeof(T));
+                return out + sizeof(T);
+            }
+        }
+        template <class T> static Decoded<T> Decode(const byte*& in) {
+            if constexpr (IS_STRING<T>) {
+                const u32 len = Memory::ReadU32Native(in);
+                const Str s = Str::Slice((const char*)in + sizeof(u32), len);
+                in += sizeof(u32) + len;
+                return s;
+            } else {
+                T value;
+                Memory::MemCopyNoOverlap(&value, in, sizeof(T));
+                in += sizeof(T);
+                return value;
+            }
+        }
+
+        template <class... Ts>
+        static usize WriteDynamic(Text::StringWriter out, Str fmt, [[maybe_unused]] const byte* args) {
+            // braced init goes left to right, so the arguments come out in order
+            const Tuple<Decoded<Ts>...> values { Decode<Ts>(args)... };
+            return [&]<usize... Is>(IntSeq<Is...>) {
+                return Text::FormatTo(out, fmt, values.template Get<Is>()...);
+            } (IntRangeSeq<sizeof...(Ts)> {});
+        }
+
+        template <Text::FixedString S, class... Ts>
+        static usize WriteStatic(Text::StringWriter out, Str, [[maybe_unused]] const byte* args) {
+            const Tuple<Decoded<Ts>...> values { Decode<Ts>(args)... };
+            return [&]<usize... Is>(IntSeq<Is...>) {
+                return Text::FormatTo(out, Text::StaticFormat<S> {}, values.template Get<Is>()...);
+            } (IntRangeSeq<sizeof...(Ts)> {});
+        }
+
+        // the whole record, padded so the next one stays 8 byte aligned
+        template <class... Ts> static usize SizeOf(const Ts&... args) {
+            return ((sizeof(LogRecord) + ... + EncodedSize(args)) + 7) & ~(usize)7;
+        }
+        template <class... Ts>
+        static void Emplace(byte* out, usize size, const Logger& logger, Severity severity, Str fmt, const SourceLoc& loc,
+                            WriteFn write, const Ts&... args) {
+            new (out) LogRecord { (u32)size, severity, &logger, write, fmt, loc, Timer::Now() };
+            [[maybe_unused]] byte* argOut = out + sizeof(LogRecord);
+            ((argOut = Encode(argOut, args)), ...);
+        }
+    };
+
+    // the format string of a LogFmt call, a runtime string or a "..."_fmt parsed at compile time.
+    // it knows the argument types, so it brings the formatter for a log written right away,
+    // and the decoder for a queued one (null if the arguments cant be queued)
+    template <class... Ts>
+    struct LogFmtStr {
+        Str fmt;
+        SourceLoc loc;
+        FuncPtr<String, Str, const Ts&...> format;
+        LogRecord::WriteFn write = nullptr;
+
+        LogFmtStr(const char* f, const SourceLoc& l = SourceLoc::current()) : LogFmtStr(Str { f }, l) {}
+        LogFmtStr(Str f, const SourceLoc& l = SourceLoc::current()) : fmt(f), loc(l), format(&FormatDynamic) {
+            if constexpr (LogRecord::CAN_QUEUE<Ts...>) write = &LogRecord::WriteDynamic<Ts...>;
+        }
+        // the literal is kept in fmt too, its what a crash flush writes for a record it couldnt format
+        template <Text::FixedString S>
+        LogFmtStr(Text::StaticFormat<S>, const SourceLoc& l = SourceLoc::current())
+            : fmt(Str::Slice(S.buf, S.SIZE)), loc(l), format(&FormatStatic<S>) {
+            if constexpr (LogRecord::CAN_QUEUE<Ts...>) write = &LogRecord::WriteStatic<S, Ts...>;
+        }
+
+        static String FormatDynamic(Str f, const Ts&... args) { return Text::Format(f, args...); }
+        template <Text::FixedString S>
+        static String FormatStatic(Str, const Ts&... args) { return Text::Format(Text::StaticFormat<S> {}, args...); }
+    };
+
+    // the AsyncLogger side of LogFmt, defined in AsyncLogger.cpp so only users of the logger need its header.
+    // reserving gives null if the record got dropped, otherwise it has to be committed on the same thread
+    byte* ReserveAsyncRecord(AsyncLogger& async, usize size);
+    void CommitAsyncRecord(AsyncLogger& async);
+
     class Logger {
         Text::StringWriter logOut;
         Text::ColoredStr name = { Text::RESET, "LOG" };
@@ -55,6 +168,7 @@ namespace Quasi::Debug {
         bool includeFunction : 1 = true;
         bool recordLogs : 1 = false;
         u32 lPad = 50;
+        OptRef<AsyncLogger> async = nullptr;
 
     public:
         static Logger InternalLog;
@@ -76,6 +190,8 @@ namespace Quasi::Debug {
         void SetIncludeFunc(const bool flag) { includeFunction = flag; }
         void SetRecordLogs(const bool flag) { recordLogs = flag; }
         void SetLocPad(const u32 pad) { lPad = pad; }
+        // LogFmt goes through the async logger while one is set, see AsyncLogger.h
+        void SetAsync(OptRef<AsyncLogger> backend) { async = backend; }
 
         void FmtLog(Text::StringWriter output, const LogEntry& log) const;
         void FmtLog(Text::StringWriter output, Str log, Severity severity, DateTime time, const SourceLoc& fileLoc) const;
@@ -89,9 +205,7 @@ namespace Quasi::Debug {
 
         void WriteAllLogs(Text::StringWriter out, Severity filter = Severity::NONE);
 
-        template <class ...Ts> void LogFmt(Severity s, const FmtStr& fmt, const Ts&... args) {
-            this->Log(s, Text::Format(fmt.fmt, args...), fmt.loc);
-        }
+        template <class ...Ts> void LogFmt(Severity s, const LogFmtStr<NoInfer<Ts>...>& fmt, const Ts&... args);
 
         template <class ...Ts> void Assert(bool assert, const FmtStr& fmt, const Ts&... args) {
             if (assert) return;
@@ -121,6 +235,21 @@ namespace Quasi::Debug {
         static void WinEnableANSI();
     };
 
+    template <class ...Ts> void Logger::LogFmt(Severity s, const LogFmtStr<NoInfer<Ts>...>& fmt, const Ts&... args) {
+        if constexpr (LogRecord::CAN_QUEUE<Ts...>) {
+            // recorded logs and breaks need the message right away
+            if (async && !recordLogs && !Overrides(breakLevel, s)) {
+                const usize size = LogRecord::SizeOf(args...);
+                if (byte* out = ReserveAsyncRecord(*async, size)) {
+                    LogRecord::Emplace(out, size, *this, s, fmt.fmt, fmt.loc, fmt.write, args...);
+                    CommitAsyncRecord(*async);
+                }
+                return;
+            }
+        }
+        this->Log(s, fmt.format(fmt.fmt, args...), fmt.loc);
+    }
+
     inline void SetFilter(Severity s) { Logger::GetInternalLog().SetFilter(s); }
     inline void SetBreakLevel(Severity s) { Logger::GetInternalLog().SetBreakLevel(s); }
 
@@ -136,7 +265,7 @@ namespace Quasi::Debug {
 
     inline void Write(Text::StringWriter out, Severity filter = Severity::NONE) { Logger::GetInternalLog().WriteAllLogs(out, filter); }
 
-    template <class ...Ts> void LogFmt(Severity s, const FmtStr& fmt, const Ts&... args) {
+    template <class ...Ts> void LogFmt(Severity s, const LogFmtStr<NoInfer<Ts>...>& fmt, const Ts&... args) {
         Logger::GetInternalLog().LogFmt(s, fmt, args...);
     }
 
@@ -202,4 +331,4 @@ namespace Quasi::Text {
     struct Formatter<Debug::DateTime> {
         static usize FormatTo(StringWriter out, const Debug::DateTime& time, Str fmt);
     };
-}
\ No newline at end of file
+}
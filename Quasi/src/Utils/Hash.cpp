@@ -1,4 +1,8 @@
 #include "Hash.h"
+
+#include <cstring>
+
+#include "Bitwise.h"
 #include "Span.h"
 
 namespace Quasi::Hashing {
@@ -14,6 +18,14 @@ namespace Quasi::Hashing {
     }
 
     Hash HashBytes(Span<const byte> bytes) {
+#ifdef Q_HASH_BYTES_MURMUR
+        return HashBytesMurmur(bytes);
+#else
+        return HashBytesRapid(bytes);
+#endif
+    }
+
+    Hash HashBytesMurmur(Span<const byte> bytes) {
         // from https://github.com/martinus/robin-hood-hashing/blob/master/src/include/robin_hood.h#L692
         static constexpr u64 M_FACTOR = 0xc6a4a7935bd1e995,
                              H_SEED   = 0xe17a1465;
@@ -59,6 +71,73 @@ namespace Quasi::Hashing {
         return AsHash(h);
     }
 
+    namespace RapidDetails {
+        // Memory::ReadU64Native isnt inlined, and this runs for every string key
+        inline u64 Read64(const byte* p) { u64 x; std::memcpy(&x, p, sizeof(x)); return x; }
+        inline u64 Read32(const byte* p) { u32 x; std::memcpy(&x, p, sizeof(x)); return x; }
+
+        inline u64 Mix(u64 a, u64 b) {
+            u64 lo;
+            const u64 hi = Bitwise::Mul128(a, b, lo);
+            return lo ^ hi;
+        }
+
+        static constexpr u64 SECRET[3] = { 0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3 };
+    }
+
+    Hash HashBytesRapid(Span<const byte> bytes, u64 seed) {
+        // https://github.com/Nicoshev/rapidhash, v1
+        using namespace RapidDetails;
+        const byte* p = bytes.Data();
+        const usize len = bytes.Length();
+
+        seed ^= Mix(seed ^ SECRET[0], SECRET[1]) ^ len;
+        u64 a, b;
+        if (len <= 16) [[likely]] {
+            if (len >= 4) {
+                // 2 to 4 overlapping u32s cover everything, without a loop or a switch
+                const byte* last = p + len - 4;
+                const usize delta = (len & 24) >> (len >> 3);
+                a = Read32(p) << 32 | Read32(last);
+                b = Read32(p + delta) << 32 | Read32(last - delta);
+            } else if (len > 0) {
+                a = (u64)p[0] << 56 | (u64)p[len >> 1] << 32 | p[len - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            usize i = len;
+            if (i > 48) {
+                // 3 independent lanes, so the multiplies overlap
+                u64 see1 = seed, see2 = seed;
+                do {
+                    seed = Mix(Read64(p)      ^ SECRET[0], Read64(p + 8)  ^ seed);
+                    see1 = Mix(Read64(p + 16) ^ SECRET[1], Read64(p + 24) ^ see1);
+                    see2 = Mix(Read64(p + 32) ^ SECRET[2], Read64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i >= 48);
+                seed ^= see1 ^ see2;
+            }
+            if (i > 16) {
+                seed = Mix(Read64(p) ^ SECRET[2], Read64(p + 8) ^ seed ^ SECRET[1]);
+                if (i > 32)
+                    seed = Mix(Read64(p + 16) ^ SECRET[2], Read64(p + 24) ^ seed);
+            }
+            // the last 16 bytes, which can overlap with whatever was already mixed
+            a = Read64(p + i - 16);
+            b = Read64(p + i - 8);
+        }
+        a ^= SECRET[1];
+        b ^= seed;
+        // the full 128 bit product, lo in a and hi in b
+        u64 lo;
+        b = Bitwise::Mul128(a, b, lo);
+        a = lo;
+        return AsHash(Mix(a ^ SECRET[0] ^ len, b ^ SECRET[1]));
+    }
+
     Hash HashCombine(Hash a, Hash b) {
         return AsHash(a ^ (b + 0x9e3779b9 + (a << 6) + (a >> 2)));
     }
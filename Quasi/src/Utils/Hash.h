@@ -13,7 +13,12 @@ namespace Quasi::Hashing {
     usize AsIndex(Hash h);
 
     Hash HashInt(usize x);
+    // rapidhash unless built with Q_HASH_BYTES_MURMUR
     Hash HashBytes(Span<const byte> bytes);
+    // the murmur 2 style loop from robin hood, 8 bytes at a time
+    Hash HashBytesMurmur(Span<const byte> bytes);
+    // rapidhash (a wyhash variant), 48 bytes at a time over 3 lanes, and the tail is read as overlapping words
+    Hash HashBytesRapid(Span<const byte> bytes, u64 seed = 0);
     Hash HashCombine(Hash a, Hash b);
 
     template <class T> struct Hasher {
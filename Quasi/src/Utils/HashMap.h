@@ -2,6 +2,10 @@
 #include "Hash.h"
 #include "Utils/Debug/Logger.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 // ported from robin_hood's hashmap implementation
 // https://github.com/martinus/robin-hood-hashing
 namespace Quasi {
@@ -826,13 +830,24 @@ namespace Quasi {
         PairType& Insert(Key&&      k, Value v) { return InsertOrAssignInternal(std::move(k), std::move(v))[1_st]; }
         Option<Value> Replace(const Key& k, Value v) { return ReplaceInternal(k,            std::move(v)); }
         Option<Value> Replace(Key&&      k, Value v) { return ReplaceInternal(std::move(k), std::move(v)); }
+        // returns the value associated with the key, inserting v first if there wasn't one
+        Value& GetOrInsert(const Key& k, Value v) {
+            const auto [i, result] = InsertKeyAndPrepareSlot(k);
+            InitOrWriteNode(i, k, std::move(v), result);
+            return kvData[i].GetValue();
+        }
+        Value& GetOrInsert(Key&& k, Value v) {
+            const auto [i, result] = InsertKeyAndPrepareSlot(k);
+            InitOrWriteNode(i, std::move(k), std::move(v), result);
+            return kvData[i].GetValue();
+        }
 
         // removes the key in the map
         bool Remove(const Key& k) {
             const OptionUsize i = FindIndexOf(k);
             if (!i) return false;
 
-            ShiftDown(i);
+            ShiftDown(*i);
             --elmCount;
             return true;
         }
@@ -860,7 +875,7 @@ namespace Quasi {
             if (!i) return nullptr;
 
             Value val = std::move(kvData[*i].GetValue());
-            ShiftDown(i);
+            ShiftDown(*i);
             --elmCount;
             return val;
         }
@@ -871,7 +886,7 @@ namespace Quasi {
             if (!i) return nullptr;
 
             PairType kvpair = std::move(*kvData[*i]);
-            ShiftDown(i);
+            ShiftDown(*i);
             --elmCount;
             return kvpair;
         }
@@ -1106,8 +1121,517 @@ namespace Quasi {
         friend ICollection<KeyValuePair<Key, Value>, HashTable>;
     };
 
+    namespace HashTables {
+        // control bytes of a SwissTable. full slots hold the low 7 bits of their hash instead, so the top bit is free
+        enum Ctrl : i8 { EMPTY = -128, DELETED = -2 };
+
+        // what the ctrl pointer of a table with nothing allocated points to, so lookups dont need a branch for it
+        alignas(16) inline constexpr i8 EMPTY_GROUP[16] = {
+            EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
+            EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
+        };
+
+        // 16 control bytes matched at once, every match is one bit of a mask
+        struct CtrlGroup {
+            static constexpr usize WIDTH = 16;
+#ifdef __SSE2__
+            __m128i ctrl;
+
+            explicit CtrlGroup(const i8* p) : ctrl(_mm_loadu_si128((const __m128i*)p)) {}
+
+            u32 Match(i8 h2)  const { return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)); }
+            u32 MatchEmpty()  const { return Match(EMPTY); }
+            // empty and deleted are the only negative bytes
+            u32 MatchFree()   const { return (u32)_mm_movemask_epi8(ctrl); }
+            u32 MatchFull()   const { return MatchFree() ^ 0xFFFF; }
+#else
+            const i8* ctrl;
+
+            explicit CtrlGroup(const i8* p) : ctrl(p) {}
+
+            u32 Match(i8 h2) const {
+                u32 m = 0;
+                for (u32 i = 0; i < WIDTH; ++i) m |= (u32)(ctrl[i] == h2) << i;
+                return m;
+            }
+            u32 MatchEmpty() const { return Match(EMPTY); }
+            u32 MatchFree()  const {
+                u32 m = 0;
+                for (u32 i = 0; i < WIDTH; ++i) m |= (u32)(ctrl[i] < 0) << i;
+                return m;
+            }
+            u32 MatchFull()  const { return MatchFree() ^ 0xFFFF; }
+#endif
+        };
+    }
+
+    // A flat open addressing hashmap in the style of abseil's swiss tables.
+    // Has the same interface as HashTable, see HashMap for picking between the two.
+    //
+    // This implementation uses the following memory layout:
+    //
+    // [pair, pair, ... pair | ctrl, ctrl, ... ctrl, cloned ctrl ]
+    //
+    // * pair: the key value pair itself, only constructed if its ctrl byte is full. there are always 2^n pairs.
+    //
+    // * ctrl: one byte per slot, either EMPTY, DELETED (a tombstone) or the low 7 bits of the slot's hash.
+    //   the first WIDTH - 1 bytes are cloned after the end, so a group can be loaded starting from any slot.
+    //
+    // Lookups start at a slot picked by the rest of the hash and match a whole group of ctrl bytes against
+    // the 7 bit hash, only comparing keys where it matches. A group with an empty slot ends the search,
+    // otherwise groups are probed in triangular steps, which visits every group of a 2^n table once.
+    template <class Key, class Value, class Hasher>
+    struct SwissTable : ICollection<KeyValuePair<Key, Value>, SwissTable<Key, Value, Hasher>> {
+        using KeyType = Key;
+        using ValueType = Value;
+        using PairType = KeyValuePair<Key, Value>;
+        using HasherType = Hasher;
+    private:
+        using Group = HashTables::CtrlGroup;
+        static constexpr usize GROUP_WIDTH = Group::WIDTH;
+        // a table is never smaller than a group, so a group never sees the same slot twice
+        static constexpr usize MIN_CAPACITY = GROUP_WIDTH;
+
+        u64       hashMultiplier = 0xc4ceb9fe1a85ec53;
+        PairType* slots          = nullptr;
+        i8*       ctrl           = const_cast<i8*>(HashTables::EMPTY_GROUP); // never written to while mask is 0
+        usize     elmCount       = 0;
+        usize     mask           = 0; // capacity - 1, or 0 if nothing is allocated
+        usize     growthLeft     = 0; // empty slots that can still be filled before growing
+        [[no_unique_address]] Hasher hasher;
+
+        static bool IsFull(i8 c) { return c >= 0; }
+        static usize MaxElmsFor(usize capacity) { return capacity - capacity / 8; }
+        static usize CtrlBytesFor(usize capacity) { return capacity + GROUP_WIDTH - 1; }
+
+        usize Capacity() const { return mask ? mask + 1 : 0; }
+
+        // same extra mixing as HashTable, the low 7 bits go in the ctrl bytes and the rest picks the slot
+        u64 HashOf(const auto& key) const {
+            u64 h = (u64)hasher(key);
+            h *= hashMultiplier;
+            return h ^ h >> 33;
+        }
+        static i8    H2(u64 h) { return (i8)(h & 0x7F); }
+        static usize H1(u64 h) { return (usize)(h >> 7); }
+
+        void SetCtrl(usize i, i8 c) {
+            ctrl[i] = c;
+            if (i < GROUP_WIDTH - 1) ctrl[i + mask + 1] = c;
+        }
+
+        // generic iterator for keys, values, valuesmut, pairs, and pairsmut
+        enum class IterPart { PAIR, KEY, VALUE };
+        template <class T, IterPart Part>
+        struct TableIter : IIterator<T&, TableIter<T, Part>> {
+            friend IIterator<T&, TableIter>;
+        private:
+            using SlotPtr = AddConstIf<PairType, T>*;
+            friend struct SwissTable;
+            SlotPtr slots = nullptr;
+            const i8* ctrl = nullptr;
+            usize index = 0, capacity = 0;
+
+            TableIter(SlotPtr s, const i8* c, usize i, usize cap) : slots(s), ctrl(c), index(i), capacity(cap) {}
+        public:
+            using Item = T&;
+
+            TableIter() = default;
+
+            static TableIter FromFwd(SlotPtr s, const i8* c, usize cap) {
+                TableIter it { s, c, 0, cap };
+                it.FastForward();
+                return it;
+            }
+
+            void FastForward() {
+                while (index < capacity) {
+                    u32 full = Group { ctrl + index }.MatchFull();
+                    // past the end are the cloned bytes
+                    if (capacity - index < GROUP_WIDTH) full &= (1u << (capacity - index)) - 1;
+                    if (full) {
+                        index += u32s::CountRightZeros(full);
+                        return;
+                    }
+                    index += GROUP_WIDTH;
+                }
+                index = capacity;
+            }
+
+            Item CurrentImpl() const {
+                if constexpr (Part == IterPart::PAIR)     return slots[index];
+                else if constexpr (Part == IterPart::KEY) return slots[index].key;
+                else                                      return slots[index].value;
+            }
+            void AdvanceImpl() {
+                ++index;
+                FastForward();
+            }
+            bool CanNextImpl() const { return index < capacity; }
+        };
+    public:
+        explicit SwissTable(Hasher h = {}) : hasher(std::move(h)) {}
+
+        SwissTable(Collection<PairType> auto&& kvpairs, Hasher h = {}) : hasher(std::move(h)) {
+            Insert(kvpairs);
+        }
+
+        SwissTable(IList<PairType> initlist, Hasher h = {}) : hasher(std::move(h)) {
+            Insert(Spans::FromIList(initlist));
+        }
+
+        static SwissTable WithCap(usize cap, Hasher h = {}) {
+            SwissTable st { std::move(h) };
+            st.Reserve(cap);
+            return st;
+        }
+
+        SwissTable(SwissTable&& t) noexcept : hasher(std::move(t.hasher)) { Steal(t); }
+
+        SwissTable& operator=(SwissTable&& t) noexcept {
+            if (&t == this) return *this;
+            Destroy();
+            hasher = std::move(t.hasher);
+            Steal(t);
+            return *this;
+        }
+
+        // an exact copy, the ctrl bytes are copied as is and only the full slots are constructed
+        SwissTable(const SwissTable& t) : hashMultiplier(t.hashMultiplier), hasher(t.hasher) {
+            if (!t.mask) return;
+            InitData(t.mask + 1);
+            Memory::MemCopyNoOverlap(ctrl, t.ctrl, CtrlBytesFor(mask + 1));
+            for (usize i = 0; i <= mask; ++i)
+                if (IsFull(ctrl[i])) Memory::ConstructCopyAt(&slots[i], t.slots[i]);
+            elmCount   = t.elmCount;
+            growthLeft = t.growthLeft;
+        }
+
+        SwissTable& operator=(const SwissTable& t) {
+            if (&t == this) return *this;
+            SwissTable copy { t };
+            return *this = std::move(copy);
+        }
+
+        ~SwissTable() { Destroy(); }
+
+        // Clears all data, without resizing.
+        void Clear() {
+            // tombstones are cleared too, so this runs even when theres nothing in the table
+            if (!mask) return;
+            DestroySlots();
+            Memory::MemSet(ctrl, (byte)HashTables::EMPTY, CtrlBytesFor(mask + 1));
+            elmCount = 0;
+            growthLeft = MaxElmsFor(mask + 1);
+        }
+
+        const Hasher& GetHasher() const { return hasher; }
+        Hasher&       GetHasher()       { return hasher; }
+
+        usize Count()   const { return elmCount; }
+        static usize MaxCount() { return u64s::MAX; }
+        bool IsEmpty()  const { return elmCount == 0; }
+        explicit operator bool() const { return elmCount != 0; }
+
+        static float MaxLoadFactor() { return 7.0f / 8.0f; }
+        float LoadFactor() const { return mask ? (float)Count() / (mask + 1) : 0.0f; }
+        usize GetMask() const { return mask; }
+
+        // Checks if both tables contain the same entries. Order is irrelevant.
+        bool operator==(const SwissTable& other) const {
+            if (Count() != other.Count()) return false;
+            for (const PairType& entry : other) {
+                const OptionUsize i = FindIndexOf(entry.key);
+                if (!i || !(slots[*i].value == entry.value)) return false;
+            }
+            return true;
+        }
+
+        Value& operator[](const Key& key) { return GetOrInsert(key, Value {}); }
+        Value& operator[](Key&& key)      { return GetOrInsert(std::move(key), Value {}); }
+        OptRef<const Value> operator[](const Key& key) const { return Get(key); }
+        OptRef<const Value> operator[](const auto& kview) const { return Get(kview); }
+        // kview can be anything that hashes the same as its key and compares equal with it, like a Str for String keys
+        OptRef<const Value> Get(const auto& kview) const {
+            const OptionUsize i = FindIndexOf(kview);
+            return i ? OptRefs::SomeRef(slots[*i].value) : nullptr;
+        }
+    private:
+        OptionUsize FindIndexOf(const auto& key) const { return FindWithHash(key, HashOf(key)); }
+
+        OptionUsize FindWithHash(const auto& key, u64 h) const {
+            const i8 h2 = H2(h);
+            for (usize pos = H1(h) & mask, step = 0;;) {
+                const Group g { ctrl + pos };
+                for (u32 match = g.Match(h2); match; match &= match - 1) {
+                    const usize i = (pos + u32s::CountRightZeros(match)) & mask;
+                    if (key == slots[i].key) [[likely]] return i;
+                }
+                if (g.MatchEmpty()) [[likely]] return nullptr;
+                step += GROUP_WIDTH;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        usize FindFirstFree(u64 h) const {
+            for (usize pos = H1(h) & mask, step = 0;;) {
+                if (const u32 free = Group { ctrl + pos }.MatchFree())
+                    return (pos + u32s::CountRightZeros(free)) & mask;
+                step += GROUP_WIDTH;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        // claims a free slot for a key that isnt in the table yet. the slot's pair still has to be constructed
+        usize PrepareInsert(u64 h) {
+            usize i = FindFirstFree(h);
+            // reusing a tombstone doesnt use up any growth
+            if (growthLeft == 0 && ctrl[i] != HashTables::DELETED) [[unlikely]] {
+                Grow();
+                i = FindFirstFree(h);
+            }
+            growthLeft -= ctrl[i] == HashTables::EMPTY;
+            SetCtrl(i, H2(h));
+            ++elmCount;
+            return i;
+        }
+
+        // finds the key, or constructs a pair for it with the value from makeValue
+        template <class Kfwd>
+        Tuple<usize, bool> FindOrInsert(Kfwd&& k, auto&& makeValue) {
+            const u64 h = HashOf(k);
+            if (const OptionUsize i = FindWithHash(k, h)) return { *i, false };
+            const usize i = PrepareInsert(h);
+            Memory::ConstructAt(&slots[i], std::forward<Kfwd>(k), makeValue());
+            return { i, true };
+        }
+
+        void EraseAt(usize i) {
+            Memory::DestructAt(&slots[i]);
+            --elmCount;
+            // if every window of a group that covers this slot also has an empty one, no probe ever
+            // went past this slot, so it can be empty again instead of a tombstone
+            const u32 emptyBefore = Group { ctrl + ((i - GROUP_WIDTH) & mask) }.MatchEmpty(),
+                      emptyAfter  = Group { ctrl + i }.MatchEmpty();
+            const bool neverProbedPast = emptyBefore && emptyAfter &&
+                u16s::CountLeftZeros((u16)emptyBefore) + u32s::CountRightZeros(emptyAfter) < GROUP_WIDTH;
+            SetCtrl(i, neverProbedPast ? HashTables::EMPTY : HashTables::DELETED);
+            growthLeft += neverProbedPast;
+        }
+    public:
+        void Insert(const Collection<PairType> auto& collection) {
+            for (auto&& kv : collection)
+                Insert(kv.key, kv.value);
+        }
+
+        void Insert(IList<PairType> ilist) {
+            for (const auto& kv : ilist)
+                Insert(kv.key, kv.value);
+        }
+
+        OptRef<PairType> TryInsert(const Key& k, Value v) { return TryInsertInternal(k,            std::move(v)); }
+        OptRef<PairType> TryInsert(Key&& k,      Value v) { return TryInsertInternal(std::move(k), std::move(v)); }
+        Tuple<PairType&, bool> InsertOrAssign(const Key& k, Value v) { return InsertOrAssignInternal(k,            std::move(v)); }
+        Tuple<PairType&, bool> InsertOrAssign(Key&&      k, Value v) { return InsertOrAssignInternal(std::move(k), std::move(v)); }
+        PairType& Insert(const Key& k, Value v) { return InsertOrAssignInternal(k,            std::move(v))[1_st]; }
+        PairType& Insert(Key&&      k, Value v) { return InsertOrAssignInternal(std::move(k), std::move(v))[1_st]; }
+        Option<Value> Replace(const Key& k, Value v) { return ReplaceInternal(k,            std::move(v)); }
+        Option<Value> Replace(Key&&      k, Value v) { return ReplaceInternal(std::move(k), std::move(v)); }
+        // returns the value associated with the key, inserting v first if there wasn't one
+        Value& GetOrInsert(const Key& k, Value v) { return GetOrInsertInternal(k,            std::move(v)); }
+        Value& GetOrInsert(Key&& k, Value v)      { return GetOrInsertInternal(std::move(k), std::move(v)); }
+    private:
+        template <class Kfwd>
+        Value& GetOrInsertInternal(Kfwd&& k, Value v) {
+            // inserting can reallocate, so slots cant be read before this
+            const usize i = FindOrInsert(std::forward<Kfwd>(k), [&] { return std::move(v); })[1_st];
+            return slots[i].value;
+        }
+
+        template <class Kfwd>
+        OptRef<PairType> TryInsertInternal(Kfwd&& k, Value v) {
+            const auto [i, inserted] = FindOrInsert(std::forward<Kfwd>(k), [&] { return std::move(v); });
+            return inserted ? OptRefs::SomeRef(slots[i]) : nullptr;
+        }
+
+        template <class Kfwd>
+        Tuple<PairType&, bool> InsertOrAssignInternal(Kfwd&& k, Value v) {
+            const auto [i, inserted] = FindOrInsert(std::forward<Kfwd>(k), [&] { return std::move(v); });
+            if (!inserted) slots[i].value = std::move(v);
+            return { slots[i], inserted };
+        }
+
+        template <class Kfwd>
+        Option<Value> ReplaceInternal(Kfwd&& k, Value v) {
+            const auto [i, inserted] = FindOrInsert(std::forward<Kfwd>(k), [&] { return std::move(v); });
+            if (inserted) return nullptr;
+            std::swap(slots[i].value, v);
+            return v;
+        }
+    public:
+        // removes the key in the map
+        bool Remove(const auto& kview) {
+            const OptionUsize i = FindIndexOf(kview);
+            if (!i) return false;
+            EraseAt(*i);
+            return true;
+        }
+
+        // nothing moves when removing, so the iterator just stays on the removed slot until it's advanced
+        template <class T, IterPart Part>
+        void RemoveAt(TableIter<T, Part>& iter) {
+            EraseAt(iter.index);
+        }
+
+        void KeepEntries(Predicate<PairType> auto&& pred) {
+            for (auto iter = IterImpl(); iter.CanNext(); iter.Advance()) {
+                if (!pred(iter.Current()))
+                    RemoveAt(iter);
+            }
+        }
+
+        // removes the key value pair, and returns the value as well
+        Option<Value> Take(const auto& kview) {
+            const OptionUsize i = FindIndexOf(kview);
+            if (!i) return nullptr;
+
+            Value val = std::move(slots[*i].value);
+            EraseAt(*i);
+            return val;
+        }
+
+        // removes the key value pair, and returns the pair as well
+        Option<PairType> TakeEntry(const auto& kview) {
+            const OptionUsize i = FindIndexOf(kview);
+            if (!i) return nullptr;
+
+            PairType kvpair = std::move(slots[*i]);
+            EraseAt(*i);
+            return kvpair;
+        }
+
+        bool Contains(const auto& kview) const {
+            return FindIndexOf(kview).HasValue();
+        }
+    protected:
+        TableIter<const PairType, IterPart::PAIR> IterImpl() const { return TableIter<const PairType, IterPart::PAIR>::FromFwd(slots, ctrl, Capacity()); }
+        TableIter<PairType, IterPart::PAIR>    IterMutImpl()       { return TableIter<PairType,       IterPart::PAIR>::FromFwd(slots, ctrl, Capacity()); }
+    public:
+        TableIter<const PairType, IterPart::PAIR> IterStartingAt(const auto& kview) const {
+            const OptionUsize i = FindIndexOf(kview);
+            if (!i) return {};
+            return { slots, ctrl, *i, Capacity() };
+        }
+
+        TableIter<const Key,   IterPart::KEY>   Keys()   const { return TableIter<const Key,   IterPart::KEY>  ::FromFwd(slots, ctrl, Capacity()); }
+        TableIter<const Value, IterPart::VALUE> Values() const { return TableIter<const Value, IterPart::VALUE>::FromFwd(slots, ctrl, Capacity()); }
+        TableIter<Value,       IterPart::VALUE> ValuesMut()    { return TableIter<Value,       IterPart::VALUE>::FromFwd(slots, ctrl, Capacity()); }
+
+        // rebuilds the table with room for at least c elements, which also clears out every tombstone
+        void Rehash(usize c) { Resize(CapacityFor(std::max(c, elmCount))); }
+
+        // makes room for at least c elements without growing
+        void Reserve(usize c) {
+            const usize capacity = CapacityFor(std::max(c, elmCount));
+            if (capacity > Capacity()) Resize(capacity);
+        }
+
+        // If possible reallocates the map to a smaller one.
+        void Compact() {
+            if (!elmCount) {
+                Destroy();
+                Init();
+                return;
+            }
+            const usize capacity = CapacityFor(elmCount);
+            if (capacity < Capacity()) Resize(capacity);
+        }
+    private:
+        static usize CapacityFor(usize count) {
+            usize capacity = MIN_CAPACITY;
+            while (MaxElmsFor(capacity) < count && capacity != 0) capacity *= 2;
+            if (capacity == 0) [[unlikely]] HashTables::AbortOverflowError();
+            return capacity;
+        }
+
+        void Grow() {
+            // mostly tombstones: cleaning them out makes enough room, so keep the size
+            if (mask && elmCount * 2 <= MaxElmsFor(mask + 1)) Resize(mask + 1);
+            else Resize(mask ? (mask + 1) * 2 : MIN_CAPACITY);
+        }
+
+        void Resize(usize capacity) {
+            PairType* const oldSlots = slots;
+            const i8* const oldCtrl  = ctrl;
+            const usize oldCapacity  = Capacity();
+
+            InitData(capacity);
+            for (usize i = 0; i < oldCapacity; ++i) {
+                if (!IsFull(oldCtrl[i])) continue;
+                const u64 h = HashOf(oldSlots[i].key);
+                const usize j = FindFirstFree(h);
+                SetCtrl(j, H2(h));
+                Memory::ConstructMoveAt(&slots[j], std::move(oldSlots[i]));
+                Memory::DestructAt(&oldSlots[i]);
+            }
+            growthLeft -= elmCount;
+            if (oldCapacity) Memory::FreeRaw(oldSlots);
+        }
+
+        // allocates an empty table, keeping elmCount
+        void InitData(usize capacity) {
+            slots = (PairType*)Memory::AllocateRaw(capacity * sizeof(PairType) + CtrlBytesFor(capacity));
+            ctrl = Memory::TransmutePtr<i8>(slots + capacity);
+            Memory::MemSet(ctrl, (byte)HashTables::EMPTY, CtrlBytesFor(capacity));
+            mask = capacity - 1;
+            growthLeft = MaxElmsFor(capacity);
+        }
+
+        void DestroySlots() {
+            if constexpr (!TrivialDestruct<PairType>) {
+                for (usize i = 0; i <= mask; ++i)
+                    if (IsFull(ctrl[i])) Memory::DestructAt(&slots[i]);
+            }
+        }
+
+        void Destroy() {
+            if (!mask) return;
+            DestroySlots();
+            Memory::FreeRaw(slots);
+        }
+
+        void Init() {
+            slots      = nullptr;
+            ctrl       = const_cast<i8*>(HashTables::EMPTY_GROUP);
+            elmCount   = 0;
+            mask       = 0;
+            growthLeft = 0;
+        }
+
+        void Steal(SwissTable& t) {
+            hashMultiplier = t.hashMultiplier;
+            slots          = t.slots;
+            ctrl           = t.ctrl;
+            elmCount       = t.elmCount;
+            mask           = t.mask;
+            growthLeft     = t.growthLeft;
+            t.Init();
+        }
+
+        friend ICollection<KeyValuePair<Key, Value>, SwissTable>;
+    };
+
+    // the robin hood table, or the swiss table when built with Q_HASHMAP_SWISS
+#ifdef Q_HASHMAP_SWISS
+    template <class K, class V, class Hasher = Hashing::DefaultHasher>
+    struct HashMap : SwissTable<K, V, Hasher> {};
+#else
     template <class K, class V, class Hasher = Hashing::DefaultHasher>
     struct HashMap : HashTable<sizeof(KeyValuePair<K, V>) <= sizeof(usize) * 6, K, V, Hasher> {};
+#endif
+
+    template <class K, class V, class Hasher = Hashing::DefaultHasher>
+    struct SwissMap : SwissTable<K, V, Hasher> {};
 
     template <class K, class Hasher = Hashing::DefaultHasher>
     struct HashSet : HashTable<sizeof(K) <= sizeof(usize) * 6, K, void, Hasher> {};
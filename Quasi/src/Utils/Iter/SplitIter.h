@@ -18,8 +18,12 @@ namespace Quasi::Iter {
                 return;
             }
             source.Advance(i + separator.Length());
-            for (i = 0; i < source.Length(); ++i) {
-                if (source.Skip(i).StartsWith(separator)) return;
+            if constexpr (SameAs<View, Str>) {
+                i = source.Find(separator).UnwrapOr(source.Length());
+            } else {
+                for (i = 0; i < source.Length(); ++i) {
+                    if (source.Skip(i).StartsWith(separator)) return;
+                }
             }
         }
         bool CanNextImpl() const { return !source.IsEmpty(); }
@@ -0,0 +1,22 @@
+#include "SplitOneOfIter.h"
+
+#include "Utils/Text/ByteSearch.h"
+
+namespace Quasi::Iter {
+    Str SplitOneOfIter::CurrentImpl() const {
+        return source.First(i);
+    }
+
+    void SplitOneOfIter::AdvanceImpl() {
+        if (i == source.Length()) {
+            source.Advance(i);
+            return;
+        }
+        source.Advance(i + 1);
+        i = Text::ByteSearch::FindOneOf(source, separators);
+    }
+
+    bool SplitOneOfIter::CanNextImpl() const {
+        return !source.IsEmpty();
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "Utils/Str.h"
+
+namespace Quasi::Iter {
+    struct SplitOneOfIter : IIterator<const Str, SplitOneOfIter> {
+        using Item = const Str;
+        friend IIterator;
+    private:
+        Str source, separators;
+        usize i = -1;
+        SplitOneOfIter(Str src, Str seps) : source(src), separators(seps) { AdvanceImpl(); }
+    protected:
+        Str CurrentImpl() const;
+        void AdvanceImpl();
+        bool CanNextImpl() const;
+    public:
+        static SplitOneOfIter New(Str s, Str seps) { return { s, seps }; }
+    };
+}
@@ -378,6 +378,8 @@ namespace Quasi {
         void Sort     ()                             mut { return super().AsSpanMut().Sort(); }
         void SortBy   (Comparator<T> auto&& cmp)     mut { return super().AsSpanMut().SortBy(cmp); }
         void SortByKey(FnArgs<const T&> auto&& keyf) mut { return super().AsSpanMut().SortByKey(keyf); }
+        void RadixSort     ()                             mut { return super().AsSpanMut().RadixSort(); }
+        void RadixSortByKey(FnArgs<const T&> auto&& keyf) mut { return super().AsSpanMut().RadixSortByKey(keyf); }
 
         // void SortStable() TODO i cant be bothered to do this
         // void SortStableBy(Fn<bool, const T&, const T&> auto&& cmp)
@@ -0,0 +1,224 @@
+#include "JobSystem.h"
+
+namespace Quasi::Jobs {
+    // chase-lev, with the memory orders from "correct and efficient work-stealing for weak memory models"
+    bool JobSystem::Worker::Push(Job* job) {
+        const i64 b = bottom.load(std::memory_order_relaxed), t = top.load(std::memory_order_acquire);
+        if (b - t >= (i64)POOL_SIZE) return false;
+        // release on the slot as well, it's what hands the job's contents to a thief. free on x86
+        deque[b & (POOL_SIZE - 1)].store(job, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Job* JobSystem::Worker::Pop() {
+        const i64 b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Job* job = deque[b & (POOL_SIZE - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // the last one left, a thief might be going for it too
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* JobSystem::Worker::Steal() {
+        i64 t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const i64 b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Job* job = deque[t & (POOL_SIZE - 1)].load(std::memory_order_acquire);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return job;
+    }
+
+    JobSystem::JobSystem(u32 workerThreads) : mainThread(std::this_thread::get_id()) {
+        workerCount = std::min<u32>(workerThreads + 1, MAX_WORKERS);
+        for (u32 i = 0; i < workerCount; ++i)
+            workers[i] = Box<Worker>::Build(*this, i);
+        CurrentWorker = workers[0].Data();
+        for (u32 i = 1; i < workerCount; ++i)
+            workers[i]->thread = std::thread { [this, i] { WorkerLoop(*workers[i]); } };
+    }
+
+    JobSystem::~JobSystem() {
+        stopping.store(true, std::memory_order_release);
+        wakeSignal.fetch_add(1, std::memory_order_release);
+        wakeSignal.notify_all();
+        for (u32 i = 1; i < workerCount; ++i)
+            workers[i]->thread.join();
+        if (CurrentWorker == workers[0].Data()) CurrentWorker = nullptr;
+    }
+
+    u32 JobSystem::DefaultWorkerCount() {
+        const u32 hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    void JobSystem::WorkerLoop(Worker& self) {
+        CurrentWorker = &self;
+        u32 idle = 0;
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (Job* job = FindWork(self)) {
+                Run(self, *job);
+                idle = 0;
+                continue;
+            }
+            if (++idle < SPINS_BEFORE_SLEEP) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // announce the nap first, then look once more. a push either sees us sleeping or we see its job
+            const u32 seen = wakeSignal.load(std::memory_order_acquire);
+            sleeping.fetch_add(1, std::memory_order_seq_cst);
+            if (Job* job = FindWork(self)) {
+                sleeping.fetch_sub(1, std::memory_order_relaxed);
+                Run(self, *job);
+            } else {
+                if (!stopping.load(std::memory_order_acquire))
+                    wakeSignal.wait(seen, std::memory_order_acquire);
+                sleeping.fetch_sub(1, std::memory_order_relaxed);
+                self.sleeps.fetch_add(1, std::memory_order_relaxed);
+            }
+            idle = 0;
+        }
+    }
+
+    Job* JobSystem::FindWork(Worker& self) {
+        if (Job* job = self.Pop()) return job;
+        // start somewhere random, so thieves dont all pile onto the same victim
+        self.victimState ^= self.victimState << 13;
+        self.victimState ^= self.victimState >> 17;
+        self.victimState ^= self.victimState << 5;
+        const u32 start = self.victimState % workerCount;
+        for (u32 i = 0; i < workerCount; ++i) {
+            const u32 victim = (start + i) % workerCount;
+            if (victim == self.index) continue;
+            if (Job* job = workers[victim]->Steal()) {
+                self.stolen.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void JobSystem::Run(Worker& self, Job& job) {
+        job.run(job);
+        self.executed.fetch_add(1, std::memory_order_relaxed);
+        JobCounter* counter = job.counter;
+        job.busy.store(false, std::memory_order_release);
+        Finish(counter);
+    }
+
+    void JobSystem::Finish(JobCounter* counter) {
+        if (!counter) return;
+        u32 left = counter->pending.load(std::memory_order_relaxed);
+        while (left > 1)
+            if (counter->pending.compare_exchange_weak(left, left - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) return;
+
+        // the last one out holds the lock while it hits 0. whoever waits on the counter might throw it away
+        // right after, so it isnt done until the lock is let go, and that's the last thing touching it here
+        while (counter->locked.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+        counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+        Job* released = counter->waiting;
+        counter->waiting = nullptr;
+        counter->locked.clear(std::memory_order_release);
+
+        while (released) {
+            Job* next = released->next;
+            Submit(released);
+            released = next;
+        }
+    }
+
+    void JobSystem::Submit(Job* job) {
+        if (job->onMainThread) {
+            const std::lock_guard lock { mainLock };
+            mainQueue.Push(job);
+            return;
+        }
+        Worker& self = *CurrentWorker;
+        // the deque is full, so this thread is already busy enough. just do it now
+        if (!self.Push(job)) return Run(self, *job);
+        Wake();
+    }
+
+    void JobSystem::SubmitAfter(Job* job, JobCounter* after) {
+        if (after) {
+            while (after->locked.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+            // checked under the lock, so the last job to finish either sees this one or it sees 0
+            const bool held = after->pending.load(std::memory_order_acquire) != 0;
+            if (held) {
+                job->next = after->waiting;
+                after->waiting = job;
+            }
+            after->locked.clear(std::memory_order_release);
+            if (held) return;
+        }
+        Submit(job);
+    }
+
+    void JobSystem::Wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) == 0) return;
+        wakeSignal.fetch_add(1, std::memory_order_release);
+        wakeSignal.notify_one();
+    }
+
+    void JobSystem::Wait(const JobCounter& counter) {
+        Worker& self = *CurrentWorker;
+        const bool onMain = self.index == 0;
+        u32 idle = 0;
+        while (!counter.IsDone()) {
+            if (Job* job = FindWork(self)) {
+                Run(self, *job);
+                idle = 0;
+            } else if (onMain && RunMainThreadJobs()) {
+                idle = 0;
+            } else if (++idle >= SPINS_BEFORE_SLEEP) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    usize JobSystem::RunMainThreadJobs() {
+        Vec<Job*> jobs;
+        {
+            const std::lock_guard lock { mainLock };
+            if (mainQueue.IsEmpty()) return 0;
+            jobs = std::move(mainQueue);
+        }
+        // these can wait on other jobs in turn, which comes back in here. so the queue isnt held while running
+        for (Job* job : jobs) {
+            job->run(*job);
+            JobCounter* counter = job->counter;
+            job->busy.store(false, std::memory_order_release);
+            Finish(counter);
+        }
+        mainExecuted.fetch_add(jobs.Length(), std::memory_order_relaxed);
+        return jobs.Length();
+    }
+
+    void JobSystem::NextFrame() {
+        for (u32 i = 0; i < workerCount; ++i) {
+            Worker& w = *workers[i];
+            w.lastFrame = {
+                w.executed.exchange(0, std::memory_order_relaxed),
+                w.stolen  .exchange(0, std::memory_order_relaxed),
+                w.sleeps  .exchange(0, std::memory_order_relaxed),
+            };
+        }
+        mainLastFrame = mainExecuted.exchange(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "ArrayBox.h"
+#include "Box.h"
+#include "Func.h"
+#include "Vec.h"
+
+namespace Quasi::Jobs {
+    struct Job;
+
+    // counts the jobs scheduled against it that havent finished yet.
+    // jobs scheduled to run after it are held here, and released once it hits 0
+    class JobCounter {
+        std::atomic<u32> pending = 0;
+        std::atomic_flag locked;
+        Job* waiting = nullptr; // linked through Job::next
+
+        friend class JobSystem;
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        u32 Pending() const { return pending.load(std::memory_order_acquire); }
+        bool IsDone() const { return Pending() == 0 && !locked.test(std::memory_order_acquire); }
+    };
+
+    // a function pointer and its captures inline, exactly one cache line.
+    // captures have to be trivially copyable and fit in the payload, so capture big things by reference
+    struct alignas(64) Job {
+        static constexpr usize PAYLOAD_SIZE = 32;
+
+        FuncPtr<void, const Job&> run;
+        JobCounter* counter;
+        Job* next;
+        bool onMainThread;
+        std::atomic<bool> busy = false; // from being made until it finishes, the slot isnt reused before that
+        alignas(8) byte payload[PAYLOAD_SIZE];
+
+        template <class T> const T& Payload() const { return *Memory::TransmutePtr<const T>(payload); }
+    };
+
+    struct JobStats {
+        u64 executed = 0, stolen = 0, sleeps = 0;
+    };
+
+    // a work stealing scheduler. every worker, the main thread included, owns a chase-lev deque:
+    // it pushes and pops its own jobs from the bottom, idle workers steal the oldest ones from the top.
+    // jobs are made in a ring per thread, one thread can have up to POOL_SIZE of them in flight at a time.
+    // jobs can be scheduled from the main thread or from inside other jobs, not from random threads
+    class JobSystem {
+    public:
+        static constexpr usize MAX_WORKERS = 64;
+        static constexpr usize POOL_SIZE = 4096; // per worker, also the size of each deque
+        static constexpr u32 SPINS_BEFORE_SLEEP = 64;
+        static constexpr usize ALLOCATE_PROBES = 16;
+    private:
+        struct alignas(64) Worker {
+            alignas(64) std::atomic<i64> top = 0;
+            alignas(64) std::atomic<i64> bottom = 0;
+            ArrayBox<std::atomic<Job*>> deque = ArrayBox<std::atomic<Job*>>::Allocate(POOL_SIZE);
+            ArrayBox<Job> pool = ArrayBox<Job>::Allocate(POOL_SIZE);
+            u64 poolNext = 0;
+            JobSystem* system;
+            u32 index, victimState;
+            std::atomic<u64> executed = 0, stolen = 0, sleeps = 0;
+            JobStats lastFrame;
+            std::thread thread;
+
+            Worker(JobSystem& system, u32 index) : system(&system), index(index), victimState(index * 0x9E3779B9 + 1) {}
+
+            // the next free slot in the ring. only looks a little ahead, busy slots mean there's plenty queued anyways
+            Job* Allocate() {
+                for (usize i = 0; i < ALLOCATE_PROBES; ++i) {
+                    Job* job = &pool[poolNext++ & (POOL_SIZE - 1)];
+                    if (!job->busy.load(std::memory_order_acquire)) return job;
+                }
+                return nullptr;
+            }
+            bool Push(Job* job);
+            Job* Pop();
+            Job* Steal();
+        };
+
+        Box<Worker> workers[MAX_WORKERS];
+        u32 workerCount = 0;
+        std::thread::id mainThread;
+
+        std::mutex mainLock;
+        Vec<Job*> mainQueue;
+        std::atomic<u64> mainExecuted = 0;
+        u64 mainLastFrame = 0;
+
+        std::atomic<bool> stopping = false;
+        std::atomic<u32> sleeping = 0, wakeSignal = 0;
+
+        inline static thread_local Worker* CurrentWorker = nullptr;
+
+        void WorkerLoop(Worker& self);
+        Job* FindWork(Worker& self);
+        void Run(Worker& self, Job& job);
+        void Finish(JobCounter* counter);
+        void Submit(Job* job);
+        void Wake();
+
+        Job* NewJob(FuncPtr<void, const Job&> run, JobCounter* counter, bool onMain) {
+            Job* job = CurrentWorker->Allocate();
+            // this thread has too many jobs out, help out until one comes back
+            while (!job) {
+                if (Job* other = FindWork(*CurrentWorker)) Run(*CurrentWorker, *other);
+                else std::this_thread::yield();
+                job = CurrentWorker->Allocate();
+            }
+            job->busy.store(true, std::memory_order_relaxed);
+            job->run = run;
+            job->counter = counter;
+            job->next = nullptr;
+            job->onMainThread = onMain;
+            if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+        // holds the job back until after is done
+        void SubmitAfter(Job* job, JobCounter* after);
+
+        template <class F> static void RunClosure(const Job& job) { job.Payload<F>()(); }
+
+        template <class F> void ScheduleClosure(F&& fn, JobCounter* counter, JobCounter* after, bool onMain) {
+            using Closure = RemQual<F>;
+            static_assert(sizeof(Closure) <= Job::PAYLOAD_SIZE && alignof(Closure) <= 8,
+                          "job captures dont fit inline, capture by reference instead");
+            static_assert(TrivialCopy<Closure> && TrivialDestruct<Closure>, "job captures have to be trivially copyable");
+            Job* job = NewJob(&RunClosure<Closure>, counter, onMain);
+            Memory::MemCopyNoOverlap(job->payload, &fn, sizeof(Closure));
+            SubmitAfter(job, after);
+        }
+
+        template <class F> struct ForRange {
+            const F* fn;
+            usize begin, end, grain;
+        };
+        // keeps halving the range and handing off the upper half, so thieves take the biggest pieces
+        template <class F> static void RunForRange(const Job& job) {
+            ForRange<F> range = job.Payload<ForRange<F>>();
+            JobSystem& system = *CurrentWorker->system;
+            while (range.end - range.begin > range.grain) {
+                const usize mid = range.begin + (range.end - range.begin) / 2;
+                Job* half = system.NewJob(&RunForRange<F>, job.counter, false);
+                const ForRange<F> upper = { range.fn, mid, range.end, range.grain };
+                Memory::MemCopyNoOverlap(half->payload, &upper, sizeof(upper));
+                system.Submit(half);
+                range.end = mid;
+            }
+            if constexpr (FnArgs<const F&, usize, usize>)
+                (*range.fn)(range.begin, range.end);
+            else for (usize i = range.begin; i < range.end; ++i) (*range.fn)(i);
+        }
+    public:
+        // the calling thread becomes the main thread. 0 workers means jobs only run while waiting
+        explicit JobSystem(u32 workerThreads = DefaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        static u32 DefaultWorkerCount();
+
+        // fn is called with no arguments. counter goes down once it finishes, and it only starts after 'after' is done
+        template <class F> void Schedule(F&& fn, JobCounter* counter = nullptr, JobCounter* after = nullptr) {
+            ScheduleClosure((F&&)fn, counter, after, false);
+        }
+        // for anything that has to be on the main thread, like gl calls. runs in RunMainThreadJobs or while the main thread waits
+        template <class F> void ScheduleOnMain(F&& fn, JobCounter* counter = nullptr, JobCounter* after = nullptr) {
+            ScheduleClosure((F&&)fn, counter, after, true);
+        }
+
+        // fn either takes one index or a (begin, end) chunk. chunks are never bigger than grain.
+        // fn is only borrowed, every chunk is done by the time this returns
+        template <class F> void ParallelFor(usize begin, usize end, usize grain, const F& fn) {
+            if (begin >= end) return;
+            JobCounter done;
+            Job* job = NewJob(&RunForRange<F>, &done, false);
+            const ForRange<F> range = { &fn, begin, end, std::max<usize>(grain, 1) };
+            Memory::MemCopyNoOverlap(job->payload, &range, sizeof(range));
+            Submit(job);
+            Wait(done);
+        }
+
+        // runs other jobs until the counter is done, so waiting inside a job doesnt block its worker
+        void Wait(const JobCounter& counter);
+        usize RunMainThreadJobs();
+
+        bool IsMainThread() const { return std::this_thread::get_id() == mainThread; }
+        u32 WorkerCount() const { return workerCount; } // the main thread counts as worker 0
+
+        // stats are counted per frame, NextFrame moves them over to LastFrameStats
+        void NextFrame();
+        const JobStats& LastFrameStats(u32 worker) const { return workers[worker]->lastFrame; }
+        u64 LastFrameMainJobs() const { return mainLastFrame; }
+    };
+}
@@ -0,0 +1,73 @@
+#include "MappedFile.h"
+
+#include "CStr.h"
+
+// mapping is platform specific, so the implementations are split below
+
+#ifdef _WIN32
+#include <windows.h>
+
+namespace Quasi::Text {
+    MappedFile MappedFile::Open(CStr fname) {
+        static constexpr byte EMPTY_FILE[1] = {};
+
+        HANDLE file = CreateFileA(fname.Data(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+        LARGE_INTEGER fsize;
+        if (!GetFileSizeEx(file, &fsize)) { CloseHandle(file); return nullptr; }
+        if (fsize.QuadPart == 0) { CloseHandle(file); return MappedFile { EMPTY_FILE, 0, nullptr }; }
+
+        // the mapping keeps the file alive, so the file handle can be closed right away
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) return nullptr;
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) { CloseHandle(mapping); return nullptr; }
+        return MappedFile { (const byte*)view, (usize)fsize.QuadPart, mapping };
+    }
+
+    void MappedFile::Close() {
+        if (mapping) {
+            UnmapViewOfFile(data);
+            CloseHandle(mapping);
+        }
+        data = nullptr;
+        size = 0;
+        mapping = nullptr;
+    }
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Quasi::Text {
+    MappedFile MappedFile::Open(CStr fname) {
+        static constexpr byte EMPTY_FILE[1] = {};
+
+        const int fd = open(fname.Data(), O_RDONLY);
+        if (fd < 0) return nullptr;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) { close(fd); return nullptr; }
+        if (st.st_size == 0) { close(fd); return MappedFile { EMPTY_FILE, 0, nullptr }; }
+
+        void* view = mmap(nullptr, (usize)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED) return nullptr;
+        madvise(view, (usize)st.st_size, MADV_SEQUENTIAL);
+        return MappedFile { (const byte*)view, (usize)st.st_size, nullptr };
+    }
+
+    void MappedFile::Close() {
+        if (size) munmap((void*)data, size);
+        data = nullptr;
+        size = 0;
+        mapping = nullptr;
+    }
+}
+#endif
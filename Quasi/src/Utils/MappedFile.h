@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Str.h"
+#include "Span.h"
+
+namespace Quasi {
+    struct CStr;
+}
+
+namespace Quasi::Text {
+    // a read-only view of a whole file mapped into memory. unmapped on destruction.
+    // prefer this over ReadFile for large files, pages are only loaded when touched.
+    class MappedFile {
+        const byte* data = nullptr;
+        usize size = 0;
+        void* mapping = nullptr; // windows file mapping handle, unused elsewhere
+
+        MappedFile(const byte* data, usize size, void* mapping) : data(data), size(size), mapping(mapping) {}
+    public:
+        MappedFile() = default;
+        MappedFile(Nullptr) {}
+        ~MappedFile() { Close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& mf) noexcept : data(mf.data), size(mf.size), mapping(mf.mapping) {
+            mf.data = nullptr; mf.size = 0; mf.mapping = nullptr;
+        }
+        MappedFile& operator=(MappedFile&& mf) noexcept {
+            Close();
+            data = mf.data; size = mf.size; mapping = mf.mapping;
+            mf.data = nullptr; mf.size = 0; mf.mapping = nullptr;
+            return *this;
+        }
+
+        // returns a null mapping if the file couldn't be opened.
+        // empty files are valid but have no data
+        static MappedFile Open(CStr fname);
+        void Close();
+
+        const byte* Data() const { return data; }
+        usize Length() const { return size; }
+        Span<const byte> AsBytes() const { return Span<const byte>::Slice(data, size); }
+        Str AsStr() const { return Str::Slice((const char*)data, size); }
+
+        bool IsNull() const { return data == nullptr && mapping == nullptr; }
+        explicit operator bool() const { return !IsNull(); }
+    };
+}
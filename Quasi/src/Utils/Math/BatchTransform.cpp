@@ -0,0 +1,270 @@
+#include "BatchTransform.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define Q_BATCHTRANSFORM_X86
+#include <immintrin.h>
+#endif
+
+namespace Quasi::Math {
+    void BatchTransform::Points2DScalar(byte* data, usize stride, usize count, const Matrix2D& m) {
+        const float* c = m.Data(); // columns are 3 floats apart
+        for (usize i = 0; i < count; ++i) {
+            float* p = At(data, stride, i);
+            const float x = p[0], y = p[1];
+            p[0] = x * c[0] + y * c[3] + c[6];
+            p[1] = x * c[1] + y * c[4] + c[7];
+        }
+    }
+
+    void BatchTransform::Points3DScalar(byte* data, usize stride, usize count, const Matrix3D& m) {
+        const float* c = m.Data(); // columns are 4 floats apart
+        for (usize i = 0; i < count; ++i) {
+            float* p = At(data, stride, i);
+            const float x = p[0], y = p[1], z = p[2];
+            p[0] = x * c[0] + y * c[4] + z * c[8]  + c[12];
+            p[1] = x * c[1] + y * c[5] + z * c[9]  + c[13];
+            p[2] = x * c[2] + y * c[6] + z * c[10] + c[14];
+        }
+    }
+
+    void BatchTransform::Normals2DScalar(byte* data, usize stride, usize count, const Matrix2x2& m) {
+        const float* c = m.Data();
+        for (usize i = 0; i < count; ++i) {
+            float* n = At(data, stride, i);
+            const float x = n[0] * c[0] + n[1] * c[2],
+                        y = n[0] * c[1] + n[1] * c[3];
+            const float inv = 1.0f / std::sqrt(x * x + y * y);
+            n[0] = x * inv;
+            n[1] = y * inv;
+        }
+    }
+
+    void BatchTransform::Normals3DScalar(byte* data, usize stride, usize count, const Matrix3x3& m) {
+        const float* c = m.Data();
+        for (usize i = 0; i < count; ++i) {
+            float* n = At(data, stride, i);
+            const float x = n[0] * c[0] + n[1] * c[3] + n[2] * c[6],
+                        y = n[0] * c[1] + n[1] * c[4] + n[2] * c[7],
+                        z = n[0] * c[2] + n[1] * c[5] + n[2] * c[8];
+            const float inv = 1.0f / std::sqrt(x * x + y * y + z * z);
+            n[0] = x * inv;
+            n[1] = y * inv;
+            n[2] = z * inv;
+        }
+    }
+
+#ifdef Q_BATCHTRANSFORM_X86
+    // the vertices are interleaved with whatever else, so everything is loaded and stored exactly,
+    // 2d as a 64 bit half and 3d as a half plus a single. nothing past the last vertex is ever touched
+    void BatchTransform::Points2DSse2(byte* data, usize stride, usize count, const Matrix2D& m) {
+        const float* c = m.Data();
+        const __m128 cx = _mm_setr_ps(c[0], c[1], c[0], c[1]),
+                     cy = _mm_setr_ps(c[3], c[4], c[3], c[4]),
+                     ct = _mm_setr_ps(c[6], c[7], c[6], c[7]);
+        usize i = 0;
+        for (; i + 2 <= count; i += 2) {
+            float* p0 = At(data, stride, i), *p1 = At(data, stride, i + 1);
+            const __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p0), (const __m64*)p1);
+            const __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0)),
+                         y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, cx), _mm_mul_ps(y, cy)), ct);
+            _mm_storel_pi((__m64*)p0, r);
+            _mm_storeh_pi((__m64*)p1, r);
+        }
+        Points2DScalar(data + i * stride, stride, count - i, m);
+    }
+
+    void BatchTransform::Points3DSse2(byte* data, usize stride, usize count, const Matrix3D& m) {
+        const float* c = m.Data();
+        const __m128 cx = _mm_loadu_ps(c), cy = _mm_loadu_ps(c + 4), cz = _mm_loadu_ps(c + 8), ct = _mm_loadu_ps(c + 12);
+        for (usize i = 0; i < count; ++i) {
+            float* p = At(data, stride, i);
+            const __m128 v = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p), _mm_load_ss(p + 2));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), cx),
+                _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), cy)),
+                _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), cz)), ct);
+            _mm_storel_pi((__m64*)p, r);
+            _mm_store_ss(p + 2, _mm_movehl_ps(r, r));
+        }
+    }
+
+    void BatchTransform::Normals2DSse2(byte* data, usize stride, usize count, const Matrix2x2& m) {
+        const float* c = m.Data();
+        const __m128 cx = _mm_setr_ps(c[0], c[1], c[0], c[1]),
+                     cy = _mm_setr_ps(c[2], c[3], c[2], c[3]);
+        usize i = 0;
+        for (; i + 2 <= count; i += 2) {
+            float* n0 = At(data, stride, i), *n1 = At(data, stride, i + 1);
+            const __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)n0), (const __m64*)n1);
+            const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0)), cx),
+                                        _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1)), cy));
+            const __m128 sq = _mm_mul_ps(r, r);
+            const __m128 lenSq = _mm_add_ps(_mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 0, 0)), _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(3, 3, 1, 1)));
+            const __m128 out = _mm_mul_ps(r, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lenSq)));
+            _mm_storel_pi((__m64*)n0, out);
+            _mm_storeh_pi((__m64*)n1, out);
+        }
+        Normals2DScalar(data + i * stride, stride, count - i, m);
+    }
+
+    void BatchTransform::Normals3DSse2(byte* data, usize stride, usize count, const Matrix3x3& m) {
+        const float* c = m.Data();
+        const __m128 cx = _mm_setr_ps(c[0], c[1], c[2], 0), cy = _mm_setr_ps(c[3], c[4], c[5], 0), cz = _mm_setr_ps(c[6], c[7], c[8], 0);
+        for (usize i = 0; i < count; ++i) {
+            float* n = At(data, stride, i);
+            const __m128 v = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)n), _mm_load_ss(n + 2));
+            const __m128 r = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), cx),
+                _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), cy)),
+                _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), cz));
+            const __m128 sq = _mm_mul_ps(r, r);
+            const __m128 lenSq = _mm_add_ps(_mm_add_ps(
+                _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(0, 0, 0, 0)),
+                _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1))),
+                _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2)));
+            const __m128 out = _mm_mul_ps(r, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lenSq)));
+            _mm_storel_pi((__m64*)n, out);
+            _mm_store_ss(n + 2, _mm_movehl_ps(out, out));
+        }
+    }
+
+    // no fma here, so the results stay bit for bit the same as the other levels
+    __attribute__((target("avx2")))
+    void BatchTransform::Points2DAvx2(byte* data, usize stride, usize count, const Matrix2D& m) {
+        const float* c = m.Data();
+        const __m256 cx = _mm256_setr_ps(c[0], c[1], c[0], c[1], c[0], c[1], c[0], c[1]),
+                     cy = _mm256_setr_ps(c[3], c[4], c[3], c[4], c[3], c[4], c[3], c[4]),
+                     ct = _mm256_setr_ps(c[6], c[7], c[6], c[7], c[6], c[7], c[6], c[7]);
+        usize i = 0;
+        for (; i + 4 <= count; i += 4) {
+            float* p0 = At(data, stride, i),     *p1 = At(data, stride, i + 1),
+                 * p2 = At(data, stride, i + 2), *p3 = At(data, stride, i + 3);
+            const __m128 lo = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p0), (const __m64*)p1),
+                         hi = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p2), (const __m64*)p3);
+            const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+            const __m256 r = _mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 0, 0)), cx),
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 1, 1)), cy)), ct);
+            const __m128 rlo = _mm256_castps256_ps128(r), rhi = _mm256_extractf128_ps(r, 1);
+            _mm_storel_pi((__m64*)p0, rlo);
+            _mm_storeh_pi((__m64*)p1, rlo);
+            _mm_storel_pi((__m64*)p2, rhi);
+            _mm_storeh_pi((__m64*)p3, rhi);
+        }
+        Points2DSse2(data + i * stride, stride, count - i, m);
+    }
+
+    __attribute__((target("avx2")))
+    void BatchTransform::Points3DAvx2(byte* data, usize stride, usize count, const Matrix3D& m) {
+        const float* c = m.Data();
+        const __m256 cx = _mm256_broadcast_ps((const __m128*)c),     cy = _mm256_broadcast_ps((const __m128*)(c + 4)),
+                     cz = _mm256_broadcast_ps((const __m128*)(c + 8)), ct = _mm256_broadcast_ps((const __m128*)(c + 12));
+        usize i = 0;
+        for (; i + 2 <= count; i += 2) {
+            float* p0 = At(data, stride, i), *p1 = At(data, stride, i + 1);
+            const __m128 lo = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p0), _mm_load_ss(p0 + 2)),
+                         hi = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p1), _mm_load_ss(p1 + 2));
+            const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+            const __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)), cx),
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), cy)),
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), cz)), ct);
+            const __m128 rlo = _mm256_castps256_ps128(r), rhi = _mm256_extractf128_ps(r, 1);
+            _mm_storel_pi((__m64*)p0, rlo);
+            _mm_store_ss(p0 + 2, _mm_movehl_ps(rlo, rlo));
+            _mm_storel_pi((__m64*)p1, rhi);
+            _mm_store_ss(p1 + 2, _mm_movehl_ps(rhi, rhi));
+        }
+        Points3DSse2(data + i * stride, stride, count - i, m);
+    }
+
+    __attribute__((target("avx2")))
+    void BatchTransform::Normals2DAvx2(byte* data, usize stride, usize count, const Matrix2x2& m) {
+        const float* c = m.Data();
+        const __m256 cx = _mm256_setr_ps(c[0], c[1], c[0], c[1], c[0], c[1], c[0], c[1]),
+                     cy = _mm256_setr_ps(c[2], c[3], c[2], c[3], c[2], c[3], c[2], c[3]);
+        usize i = 0;
+        for (; i + 4 <= count; i += 4) {
+            float* n0 = At(data, stride, i),     *n1 = At(data, stride, i + 1),
+                 * n2 = At(data, stride, i + 2), *n3 = At(data, stride, i + 3);
+            const __m128 lo = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)n0), (const __m64*)n1),
+                         hi = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)n2), (const __m64*)n3);
+            const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+            const __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 0, 0)), cx),
+                                           _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 1, 1)), cy));
+            const __m256 sq = _mm256_mul_ps(r, r);
+            const __m256 lenSq = _mm256_add_ps(_mm256_permute_ps(sq, _MM_SHUFFLE(2, 2, 0, 0)), _mm256_permute_ps(sq, _MM_SHUFFLE(3, 3, 1, 1)));
+            const __m256 out = _mm256_mul_ps(r, _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lenSq)));
+            const __m128 olo = _mm256_castps256_ps128(out), ohi = _mm256_extractf128_ps(out, 1);
+            _mm_storel_pi((__m64*)n0, olo);
+            _mm_storeh_pi((__m64*)n1, olo);
+            _mm_storel_pi((__m64*)n2, ohi);
+            _mm_storeh_pi((__m64*)n3, ohi);
+        }
+        Normals2DSse2(data + i * stride, stride, count - i, m);
+    }
+
+    __attribute__((target("avx2")))
+    void BatchTransform::Normals3DAvx2(byte* data, usize stride, usize count, const Matrix3x3& m) {
+        const float* c = m.Data();
+        const __m256 cx = _mm256_setr_ps(c[0], c[1], c[2], 0, c[0], c[1], c[2], 0),
+                     cy = _mm256_setr_ps(c[3], c[4], c[5], 0, c[3], c[4], c[5], 0),
+                     cz = _mm256_setr_ps(c[6], c[7], c[8], 0, c[6], c[7], c[8], 0);
+        usize i = 0;
+        for (; i + 2 <= count; i += 2) {
+            float* n0 = At(data, stride, i), *n1 = At(data, stride, i + 1);
+            const __m128 lo = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)n0), _mm_load_ss(n0 + 2)),
+                         hi = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)n1), _mm_load_ss(n1 + 2));
+            const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+            const __m256 r = _mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)), cx),
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), cy)),
+                _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), cz));
+            const __m256 sq = _mm256_mul_ps(r, r);
+            const __m256 lenSq = _mm256_add_ps(_mm256_add_ps(
+                _mm256_permute_ps(sq, _MM_SHUFFLE(0, 0, 0, 0)),
+                _mm256_permute_ps(sq, _MM_SHUFFLE(1, 1, 1, 1))),
+                _mm256_permute_ps(sq, _MM_SHUFFLE(2, 2, 2, 2)));
+            const __m256 out = _mm256_mul_ps(r, _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lenSq)));
+            const __m128 olo = _mm256_castps256_ps128(out), ohi = _mm256_extractf128_ps(out, 1);
+            _mm_storel_pi((__m64*)n0, olo);
+            _mm_store_ss(n0 + 2, _mm_movehl_ps(olo, olo));
+            _mm_storel_pi((__m64*)n1, ohi);
+            _mm_store_ss(n1 + 2, _mm_movehl_ps(ohi, ohi));
+        }
+        Normals3DSse2(data + i * stride, stride, count - i, m);
+    }
+
+    BatchTransform::Level BatchTransform::BestLevel() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? AVX2 : SSE2;
+    }
+
+    void BatchTransform::UseLevel(Level level) {
+        switch (std::min(level, BestLevel())) {
+            case AVX2:   active = { AVX2,   Points2DAvx2,   Points3DAvx2,   Normals2DAvx2,   Normals3DAvx2 };   break;
+            case SSE2:   active = { SSE2,   Points2DSse2,   Points3DSse2,   Normals2DSse2,   Normals3DSse2 };   break;
+            case SCALAR:
+            default:     active = { SCALAR, Points2DScalar, Points3DScalar, Normals2DScalar, Normals3DScalar }; break;
+        }
+    }
+#else
+    BatchTransform::Level BatchTransform::BestLevel() { return SCALAR; }
+    void BatchTransform::UseLevel(Level) {}
+#endif
+
+    Str BatchTransform::LevelName(Level level) {
+        switch (level) {
+            case AVX2: return "AVX2";
+            case SSE2: return "SSE2";
+            case SCALAR:
+            default:   return "Scalar";
+        }
+    }
+
+    const bool BatchTransform::DETECTED = (UseLevel(BestLevel()), true);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "Matrix.h"
+
+namespace Quasi::Math {
+    // transforms a whole stream of positions or normals in place, stepping through interleaved vertices by stride.
+    // picks the widest simd the cpu supports once at startup, same as Text::ByteSearch.
+    // results match the per vertex MatrixTransform2D/3D, normals get renormalized too
+    struct BatchTransform {
+        enum Level { SCALAR, SSE2, AVX2 };
+
+        static void Points2D (byte* data, usize stride, usize count, const Matrix2D& m)  { active.points2D (data, stride, count, m); }
+        static void Points3D (byte* data, usize stride, usize count, const Matrix3D& m)  { active.points3D (data, stride, count, m); }
+        static void Normals2D(byte* data, usize stride, usize count, const Matrix2x2& m) { active.normals2D(data, stride, count, m); }
+        static void Normals3D(byte* data, usize stride, usize count, const Matrix3x3& m) { active.normals3D(data, stride, count, m); }
+
+        static Level BestLevel();
+        static Level CurrentLevel() { return active.level; }
+        // clamped to what the cpu supports, mostly for benchmarking
+        static void  UseLevel(Level level);
+        static Str   LevelName(Level level);
+    private:
+        struct Kernels {
+            Level level;
+            void (*points2D) (byte*, usize, usize, const Matrix2D&);
+            void (*points3D) (byte*, usize, usize, const Matrix3D&);
+            void (*normals2D)(byte*, usize, usize, const Matrix2x2&);
+            void (*normals3D)(byte*, usize, usize, const Matrix3x3&);
+        };
+
+        static float* At(byte* data, usize stride, usize i) { return Memory::TransmutePtr<float>(data + i * stride); }
+
+        static void Points2DScalar (byte* data, usize stride, usize count, const Matrix2D& m);
+        static void Points3DScalar (byte* data, usize stride, usize count, const Matrix3D& m);
+        static void Normals2DScalar(byte* data, usize stride, usize count, const Matrix2x2& m);
+        static void Normals3DScalar(byte* data, usize stride, usize count, const Matrix3x3& m);
+
+        // only defined on x86. sse2 does a vertex per register in 3d and two in 2d, avx2 twice that
+        static void Points2DSse2 (byte* data, usize stride, usize count, const Matrix2D& m);
+        static void Points3DSse2 (byte* data, usize stride, usize count, const Matrix3D& m);
+        static void Normals2DSse2(byte* data, usize stride, usize count, const Matrix2x2& m);
+        static void Normals3DSse2(byte* data, usize stride, usize count, const Matrix3x3& m);
+        static void Points2DAvx2 (byte* data, usize stride, usize count, const Matrix2D& m);
+        static void Points3DAvx2 (byte* data, usize stride, usize count, const Matrix3D& m);
+        static void Normals2DAvx2(byte* data, usize stride, usize count, const Matrix2x2& m);
+        static void Normals3DAvx2(byte* data, usize stride, usize count, const Matrix3x3& m);
+
+        inline static constinit Kernels active = { SCALAR, Points2DScalar, Points3DScalar, Normals2DScalar, Normals3DScalar };
+        static const bool DETECTED;
+    };
+}
@@ -0,0 +1,131 @@
+#include "Random.h"
+
+namespace Quasi::Math {
+    Xoshiro256pp Xoshiro256pp::FromSeed(u64 seed) {
+        SplitMix64 seeder { seed };
+        return {{ seeder.Next64(), seeder.Next64(), seeder.Next64(), seeder.Next64() }};
+    }
+
+    void Xoshiro256pp::Jump() {
+        static constexpr u64 JUMP[] = { 0x180EC6D33CFD0ABA, 0xD5A61266F0C9392C, 0xA9582618E03FC9AA, 0x39ABDC4529B1661C };
+        u64 next[4] = {};
+        for (const u64 jump : JUMP) {
+            for (u32 b = 0; b < 64; ++b) {
+                if (jump & (1ULL << b))
+                    for (u32 i = 0; i < 4; ++i) next[i] ^= s[i];
+                Next64();
+            }
+        }
+        for (u32 i = 0; i < 4; ++i) s[i] = next[i];
+    }
+
+    void Xoshiro256pp::LongJump() {
+        static constexpr u64 LONG_JUMP[] = { 0x76E15D3EFEFDCBBF, 0xC5004E441C522FB3, 0x77710069854EE241, 0x39109BB02ACBE635 };
+        u64 next[4] = {};
+        for (const u64 jump : LONG_JUMP) {
+            for (u32 b = 0; b < 64; ++b) {
+                if (jump & (1ULL << b))
+                    for (u32 i = 0; i < 4; ++i) next[i] ^= s[i];
+                Next64();
+            }
+        }
+        for (u32 i = 0; i < 4; ++i) s[i] = next[i];
+    }
+
+    Pcg32 Pcg32::FromSeed(u64 seed, u64 stream) {
+        Pcg32 pcg { 0, stream << 1 | 1 };
+        pcg.Next32();
+        pcg.state += seed;
+        pcg.Next32();
+        return pcg;
+    }
+
+    void Pcg32::Discard(u64 num) {
+        // x -> a^n x + c (a^(n-1) + ... + a + 1), built up by squaring
+        u64 accMult = 1, accPlus = 0, curMult = MULTIPLIER, curPlus = increment;
+        for (; num; num >>= 1) {
+            if (num & 1) {
+                accMult *= curMult;
+                accPlus = accPlus * curMult + curPlus;
+            }
+            curPlus = (curMult + 1) * curPlus;
+            curMult *= curMult;
+        }
+        state = accMult * state + accPlus;
+    }
+
+    u64 RandomGenerator::SeedFromSeeder(std::seed_seq& seq) {
+        u32 seed[2];
+        seq.generate(seed, seed + 2);
+        return (u64)seed[0] << 32 | seed[1];
+    }
+
+    void RandomGenerator::SetSeed(u64 val) {
+        seed = val;
+        switch (engine) {
+            case PCG32:  pcg    = Pcg32::FromSeed(val);        break;
+            case WYRAND: wyrand = WyRand::FromSeed(val);       break;
+            case XOSHIRO256PP:
+            default:     xoshiro = Xoshiro256pp::FromSeed(val); break;
+        }
+    }
+
+    RandomGenerator RandomGenerator::Split() {
+        RandomGenerator child = *this;
+        switch (engine) {
+            case PCG32:  child.pcg = Pcg32::FromSeed(GetRaw64(), GetRaw64()); break;
+            case WYRAND: child.wyrand = WyRand::FromSeed(SplitMix64 { GetRaw64() }.Next64()); break;
+            case XOSHIRO256PP:
+            // the child keeps going from here, this one skips past everything the child could ever use
+            default:     xoshiro.Jump(); break;
+        }
+        return child;
+    }
+
+    RandomGenerator RandomGenerator::Stream(u32 index) const {
+        RandomGenerator stream = *this;
+        switch (engine) {
+            // a different increment is a different sequence, and theres 2^63 of them
+            case PCG32:  stream.pcg = Pcg32::FromSeed(pcg.state, (pcg.increment >> 1) + index + 1); break;
+            // no real streams here, just a far off and well mixed starting point
+            case WYRAND: stream.wyrand.state = SplitMix64 { wyrand.state ^ (u64)index << 32 }.Next64(); break;
+            case XOSHIRO256PP:
+            // long jumps, so splitting this or any other stream never runs into another stream
+            default:     for (u32 i = 0; i <= index; ++i) stream.xoshiro.LongJump(); break;
+        }
+        return stream;
+    }
+
+    template <class E>
+    void RandomGenerator::FillRaw(E& e, Span<u32> out) {
+        u32* data = out.Data();
+        const usize len = out.Length();
+        usize i = 0;
+        if constexpr (!std::is_same_v<E, Pcg32>) {
+            // both halves of every u64
+            for (; i + 2 <= len; i += 2) {
+                const u64 x = e.Next64();
+                data[i]     = (u32)x;
+                data[i + 1] = (u32)(x >> 32);
+            }
+        }
+        for (; i < len; ++i) data[i] = e.Next32();
+    }
+
+    void RandomGenerator::Fill(Span<u32> out) {
+        Visit([&] (auto& e) { FillRaw(e, out); });
+    }
+
+    void RandomGenerator::Fill(Span<f32> out, f32 min, f32 max) {
+        // written as bits into a local block first, then converted in a separate loop that vectorizes
+        static constexpr usize BLOCK = 256;
+        u32 bits[BLOCK];
+        const f32 scale = (max - min) * 0x1.0p-24f;
+        for (usize start = 0; start < out.Length(); start += BLOCK) {
+            const usize n = std::min(BLOCK, out.Length() - start);
+            Fill(Span<u32>::Slice(bits, n));
+            for (usize i = 0; i < n; ++i)
+                out[start + i] = min + (f32)(bits[i] >> 8) * scale;
+        }
+    }
+}
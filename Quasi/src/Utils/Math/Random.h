@@ -3,49 +3,205 @@
 #include <chrono>
 
 #include "Constants.h"
+#include "Vector.h"
+#include "Utils/Bitwise.h"
+#include "Utils/Span.h"
 
 namespace Quasi::Math {
+    // seeds the other engines, one u64 of state. see https://prng.di.unimi.it/splitmix64.c
+    struct SplitMix64 {
+        u64 state;
+
+        u64 Next64() {
+            u64 z = (state += 0x9E3779B97F4A7C15);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            return z ^ (z >> 31);
+        }
+    };
+
+    // see https://prng.di.unimi.it/xoshiro256plusplus.c. 32 bytes of state, period 2^256 - 1
+    struct Xoshiro256pp {
+        u64 s[4];
+
+        static Xoshiro256pp FromSeed(u64 seed);
+        u64 Next64() {
+            const u64 result = std::rotl(s[0] + s[3], 23) + s[0], t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = std::rotl(s[3], 45);
+            return result;
+        }
+        u32 Next32() { return (u32)(Next64() >> 32); }
+
+        // same as calling Next64 2^128 times, splits the period into 2^128 streams
+        void Jump();
+        // same as 2^192 calls, for streams of streams
+        void LongJump();
+        void Discard(u64 num) { for (; num; --num) Next64(); }
+    };
+
+    // pcg-xsh-rr, 64 bits of state with 2^63 separate streams. see https://www.pcg-random.org
+    struct Pcg32 {
+        u64 state, increment;
+
+        static constexpr u64 MULTIPLIER = 6364136223846793005;
+        static Pcg32 FromSeed(u64 seed, u64 stream = 0);
+        u32 Next32() {
+            const u64 old = state;
+            state = old * MULTIPLIER + increment;
+            return std::rotr((u32)(((old >> 18) ^ old) >> 27), (int)(old >> 59));
+        }
+        u64 Next64() { const u64 hi = Next32(); return hi << 32 | Next32(); }
+
+        // jumps ahead in log2(num) steps
+        void Discard(u64 num);
+    };
+
+    // a counter hashed with one 128 bit multiply. the fastest here, one u64 of state.
+    // see https://github.com/wangyi-fudan/wyhash
+    struct WyRand {
+        u64 state;
+
+        static constexpr u64 INCREMENT = 0xA0761D6478BD642F, MIX = 0xE7037ED1A0B428DB;
+        static WyRand FromSeed(u64 seed) { return { seed }; }
+        u64 Next64() {
+            state += INCREMENT;
+            u64 lo;
+            const u64 hi = Bitwise::Mul128(state, state ^ MIX, lo);
+            return hi ^ lo;
+        }
+        u32 Next32() { return (u32)(Next64() >> 32); }
+
+        void Discard(u64 num) { state += num * INCREMENT; }
+    };
+
     // man why doesnt c++ just have a standard random library thats actually easy to use
+    // the engine is picked at runtime, every call goes through a switch that the branch predictor
+    // always gets right. the Fill functions only switch once for the whole span.
+    // also works as a std uniform random bit generator, for the std distributions
     struct RandomGenerator {
+        enum Engine { XOSHIRO256PP, PCG32, WYRAND };
+        static constexpr Engine DEFAULT_ENGINE = XOSHIRO256PP;
+
         inline static std::seed_seq seeder {
             std::random_device {}(),
             (u32)std::chrono::steady_clock::now().time_since_epoch().count()
         };
-        std::mt19937 device { GetSeed() };
+    private:
+        Engine engine;
+        u64 seed = 0; // the last one given to SetSeed
+        union {
+            Xoshiro256pp xoshiro;
+            Pcg32 pcg;
+            WyRand wyrand;
+        };
+
+        template <class F> decltype(auto) Visit(F&& f) {
+            switch (engine) {
+                case PCG32:  return f(pcg);
+                case WYRAND: return f(wyrand);
+                case XOSHIRO256PP:
+                default:     return f(xoshiro);
+            }
+        }
 
+        static u64 SeedFromSeeder(std::seed_seq& seq);
+        template <class E> static void FillRaw(E& e, Span<u32> out);
+    public:
         template <class T> using IntDistribution   = std::uniform_int_distribution<T>;
         template <class T> using RealDistribution  = std::uniform_real_distribution<T>;
         template <class T> using GaussDistribution = std::normal_distribution<T>;
         using BoolDistribution = std::bernoulli_distribution;
 
-        RandomGenerator() = default;
+        explicit RandomGenerator(Engine e = DEFAULT_ENGINE) : engine(e), xoshiro() { Reseed(); }
+        RandomGenerator(Engine e, u64 seed) : engine(e), xoshiro() { SetSeed(seed); }
+
+        Engine GetEngine() const { return engine; }
+        // the new engine starts over from the last seed
+        void SetEngine(Engine e) { engine = e; SetSeed(seed); }
 
         static std::seed_seq& GetSeed() { return seeder; }
-        void SetSeed(const u32 val) { device.seed(val); }
-        template <class Sq> void SetSeed(Sq& newSeeder) { device.seed(newSeeder()); }
-        void Reseed() { device.seed(seeder); }
+        void SetSeed(u64 val);
+        template <class Sq> void SetSeed(Sq& newSeeder) { SetSeed((u64)newSeeder()); }
+        void Reseed() { SetSeed(SeedFromSeeder(seeder)); }
 
-        void Discard(u64 num) { device.discard(num); }
-        u32 GetRaw() { return device(); }
+        void Discard(u64 num) { Visit([&] (auto& e) { e.Discard(num); }); }
+        u32 GetRaw() { return Visit([] (auto& e) { return e.Next32(); }); }
+        u64 GetRaw64() { return Visit([] (auto& e) { return e.Next64(); }); }
+
+        using result_type = u64;
+        static constexpr u64 min() { return 0; }
+        static constexpr u64 max() { return ~0ULL; }
+        u64 operator()() { return GetRaw64(); }
+
+        // a uniform integer in [0, bound) without modulo bias, mostly without dividing at all.
+        // see https://arxiv.org/abs/1805.10941
+        u32 GetBounded(u32 bound) {
+            u64 m = (u64)GetRaw() * bound;
+            if ((u32)m < bound) {
+                const u32 threshold = -bound % bound;
+                while ((u32)m < threshold) m = (u64)GetRaw() * bound;
+            }
+            return (u32)(m >> 32);
+        }
+        u64 GetBounded64(u64 bound) {
+            u64 lo, hi = Bitwise::Mul128(GetRaw64(), bound, lo);
+            if (lo < bound) {
+                const u64 threshold = -bound % bound;
+                while (lo < threshold) hi = Bitwise::Mul128(GetRaw64(), bound, lo);
+            }
+            return hi;
+        }
+
+        // independent streams for other threads. Split changes this generator, Stream doesnt and
+        // always gives the same generator for the same index. streams can be split again,
+        // xoshiro streams are 2^192 apart and splits only ever move 2^128 at a time
+        RandomGenerator Split();
+        RandomGenerator Stream(u32 index) const;
+
+        // fills the whole span at once, much faster than calling Get for each.
+        // u32s are the raw bits, floats are uniform in [min, max)
+        void Fill(Span<u32> out);
+        void Fill(Span<f32> out, f32 min = 0, f32 max = 1);
 
         template <Integer I> I Get(I min, I max) { return GetIncl(min, (I)(max - 1)); }
-        template <Integer I> I GetIncl(I min, I max) { return IntDistribution<I> { min, max } (device); }
+        template <Integer I> I GetIncl(I min, I max) {
+            using U = IntoUnsigned<I>;
+            // the full range wraps around to 0
+            const U range = (U)((U)max - (U)min + 1);
+            if constexpr (sizeof(I) <= sizeof(u32)) {
+                return (I)((U)min + (U)(range ? GetBounded(range) : GetRaw()));
+            } else {
+                return (I)((U)min + (U)(range ? GetBounded64(range) : GetRaw64()));
+            }
+        }
 
-        template <Floating F> F Get(F min = 0, F max = 1) { return RealDistribution<F> { min, max } (device); }
+        template <Floating F> F Get(F min = 0, F max = 1) {
+            // as many random bits as fit in the mantissa
+            if constexpr (sizeof(F) == sizeof(f32)) {
+                return min + (max - min) * ((F)(GetRaw() >> 8) * (F)0x1.0p-24);
+            } else {
+                return min + (max - min) * ((F)(GetRaw64() >> 11) * (F)0x1.0p-53);
+            }
+        }
 
         template <Floating F> F GetLogarithmic(F min = 0, F max = 1)
         { return std::log(Get(std::exp(min), std::exp(max))); }
         template <Floating F> F GetExponential(F min = 0, F max = 1)
         { return std::exp(Get(std::log(min), std::log(max))); }
 
-        template <Floating F> F GetGaussian(F mean, F stddev) { return GaussDistribution<F> { mean, stddev } (device); }
+        template <Floating F> F GetGaussian(F mean, F stddev) { return GaussDistribution<F> { mean, stddev } (*this); }
 
         u8 GetByte(u8 min, u8 max) { return (u8)Get<u16>(min, max); }
 
-        bool GetBool(f32 probability = 0.5f) { return BoolDistribution { probability } (device); }
+        bool GetBool(f32 probability = 0.5f) { return Get<f32>() < probability; }
         bool GetBool(int num, int denom) { return Get(0, denom) >= num; }
 
-        template <class F> auto GetForDistribution(F f) -> decltype(f(0)) { return f(device); }
+        template <class F> auto GetForDistribution(F f) -> decltype(f(0)) { return f(*this); }
 
         template <class T>
         T Choose(IList<T> ilist) { return Choose(Spans::FromIList(ilist)); }
@@ -163,6 +163,8 @@ namespace Quasi::Math {
         Rect operator*(const VecT& scale)    const { return { min * scale, max * scale }; }
         Rect operator/(const VecT& invScale) const { return { min / invScale, max / invScale }; }
 
+        bool operator==(const Rect&) const = default;
+
         template <class U>
         Rect<U, N> As() const { return { min.template As<U>(), max.template As<U>() }; }
         template <class U>
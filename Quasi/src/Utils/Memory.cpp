@@ -1,13 +1,17 @@
 #include <cstring>
 
 #include "Memory.h"
+#include "Arena.h"
 
 namespace Quasi {
     void* Memory::AllocateRaw(usize size) {
+        if (LinearArena* arena = LinearArena::Active())
+            if (void* mem = arena->TryAllocate(size)) return mem;
         return ::operator new (size);
     }
 
     void Memory::FreeRaw(void* mem) {
+        if (LinearArena::IsArenaMemory(mem)) return;
         return ::operator delete (mem);
     }
 
@@ -139,8 +143,7 @@ namespace Quasi {
     }
 
     void Memory::MemCopy(void* out, const void* in, usize bytes) {
-        for (usize i = 0; i < bytes; ++i)
-            ((byte*)out)[i] = ((byte*)in)[i];
+        std::memmove(out, in, bytes);
     }
 
     void Memory::MemCopyNoOverlap(void* out, const void* in, usize bytes) {
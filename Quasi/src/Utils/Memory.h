@@ -1,6 +1,14 @@
 #pragma once
 #include "Type.h"
 
+#ifdef _WIN32
+#include <malloc.h>
+#define Q_ALLOCA_FN _alloca
+#else
+#include <alloca.h>
+#define Q_ALLOCA_FN alloca
+#endif
+
 namespace Quasi::Memory {
     template <class T> constexpr usize AlignOf() { return alignof(T); }
     template <class T> constexpr usize SizeOf() { return sizeof(T); }
@@ -25,6 +33,7 @@ namespace Quasi::Memory {
         return dynamic_cast<AddConstIf<Der, Base>*>(base);
     }
 
+    // draws from the active arena if theres one, see Arena.h
     void* AllocateRaw(usize size);
     template <class T> T* Allocate(auto&&... args) { return new T { std::forward<decltype(args)>(args)... }; }
     template <class T> T* AllocateArray(usize size, auto&&... args) { return new T[size] { std::forward<decltype(args)>(args)... }; }
@@ -106,6 +115,7 @@ namespace Quasi::Memory {
     u32 ByteSwap32(u32 x);
     u64 ByteSwap64(u64 x);
 
+    // fine on overlapping ranges, like memmove
     void MemCopy(void* out, const void* in, usize bytes);
     // WARNING: undefined behavior on overlapping pointer ranges
     void MemCopyNoOverlap(void* __restrict__ out, const void* __restrict__ in, usize bytes);
@@ -199,13 +209,50 @@ namespace Quasi::Memory {
         for (; data < dataEnd; ++data) data->~T();
     }
 
+    // types that stay valid when their bytes are copied somewhere else and the original is just forgotten.
+    // trivially copyable types always are, types that only own heap pointers (Vec, Box, String) opt in
+    // by specializing this. anything pointing into itself must not.
+    template <class T> struct TriviallyRelocatable { static constexpr bool VALUE = std::is_trivially_copyable_v<T>; };
+    template <class T> concept TrivialRelocate = TriviallyRelocatable<RemConst<T>>::VALUE;
+
+    // move constructs every element into out and destructs the original, which is a memcpy when possible
+    // WARNING: undefined behavior on overlapping pointer ranges
+    template <class T> void RangeRelocateNoOverlap(T* __restrict__ out, T* __restrict__ in, usize count) {
+        if constexpr (TrivialRelocate<T>) {
+            if (count) MemCopyNoOverlap(out, in, count * sizeof(T));
+        } else {
+            for (usize i = 0; i < count; ++i) {
+                Memory::ConstructMoveAt(&out[i], std::move(in[i]));
+                in[i].~T();
+            }
+        }
+    }
+
 #define Q_GETTER_MUT(FN, ...) (decltype(this->FN(__VA_ARGS__)))(Memory::AsConstPtr(this))->FN(__VA_ARGS__)
 #define QGetterMut$ Q_GETTER_MUT
 
     // usage: just do Memory::QAlloca$(T, 32) or something like that
-#define Q_ALLOCA(T, SIZE) UpcastPtr<T>(_alloca(sizeof(T) * (SIZE)))
+#define Q_ALLOCA(T, SIZE) UpcastPtr<T>(Q_ALLOCA_FN(sizeof(T) * (SIZE)))
 #define QAlloca$(...) Q_ALLOCA(__VA_ARGS__)
 
+    // uninitialized space for count T's, on the stack if it fits in STACK_BYTES and the heap otherwise.
+    // unlike alloca, fine to use in loops and with sizes that come from outside.
+    // the heap side goes through AllocateRaw, so inside an ArenaScope it comes from the arena
+    template <class T, usize STACK_BYTES = 4096>
+    class ScratchArray {
+        alignas(T) byte stack[STACK_BYTES];
+        T* data;
+    public:
+        explicit ScratchArray(usize count)
+            : data(sizeof(T) * count <= STACK_BYTES ? (T*)stack : (T*)AllocateRaw(count * sizeof(T))) {}
+        ~ScratchArray() { if (data != (T*)stack) FreeRaw(data); }
+        ScratchArray(const ScratchArray&) = delete;
+        ScratchArray& operator=(const ScratchArray&) = delete;
+
+        T* Data() const { return data; }
+        operator T*() const { return data; }
+    };
+
     // usage: add a scope guard to a code block without having to type out the variable name, cleans up automatically afterwards
 #define QWith$(...) if (auto __VA_ARGS__; true)
 }
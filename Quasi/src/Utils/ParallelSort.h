@@ -0,0 +1,92 @@
+#pragma once
+#include "Algorithm.h"
+#include "JobSystem.h"
+
+// splits the sort into a chunk per worker, then merges them back together, also in parallel.
+// kept out of Algorithm.h so the sort headers dont drag the job system in with them
+namespace Quasi::Algorithm {
+    namespace ParallelSorting {
+        // smaller chunks arent worth a job
+        constexpr usize PARALLEL_SORT_MIN_CHUNK = 16 * 1024;
+
+        // how many elements of a go before the first k elements of the merged output, ties go to a
+        template <class T>
+        usize MergeSplit(Span<T> a, Span<T> b, usize k, Comparator<T> auto&& cmp) {
+            usize lo = k > b.Length() ? k - b.Length() : 0, hi = std::min(k, a.Length());
+            while (lo < hi) {
+                const usize i = (lo + hi) / 2;
+                if (cmp(b[k - i - 1], a[i]) < 0) hi = i;
+                else lo = i + 1;
+            }
+            return lo;
+        }
+
+        template <class T>
+        void MergeInto(Span<T> a, Span<T> b, T* out, Comparator<T> auto&& cmp) {
+            usize i = 0, j = 0;
+            while (i < a.Length() && j < b.Length())
+                *out++ = cmp(b[j], a[i]) < 0 ? std::move(b[j++]) : std::move(a[i++]);
+            for (; i < a.Length(); ++i) *out++ = std::move(a[i]);
+            for (; j < b.Length(); ++j) *out++ = std::move(b[j]);
+        }
+    }
+
+    // unstable. has to be called from the job system's main thread or from inside a job
+    template <IsMut T>
+    void ParallelSortBy(Jobs::JobSystem& jobs, Span<T> span, Comparator<T> auto&& cmp) {
+        using namespace ParallelSorting;
+
+        const usize len = span.Length();
+        const usize workers = std::max(jobs.WorkerCount(), 1u);
+        const usize chunkCount = std::clamp<usize>(len / PARALLEL_SORT_MIN_CHUNK, 1, workers);
+        if (chunkCount == 1) return SortingDetails::Sort(span, cmp);
+
+        // chunk i is [bounds[i], bounds[i + 1])
+        Vec<usize> bounds = Vec<usize>::WithCap(chunkCount + 1);
+        for (usize i = 0; i <= chunkCount; ++i) bounds.Push(len * i / chunkCount);
+        jobs.ParallelFor(0, chunkCount, 1, [&] (usize i) {
+            SortingDetails::Sort(span.SubspanMut(bounds[i], bounds[i + 1] - bounds[i]), cmp);
+        });
+
+        // merged pairwise, back and forth with the buffer. every merge is split into
+        // enough pieces that all workers stay busy until the last one
+        T* const buffer = Memory::AllocateArrayUninit<T>(len);
+        Memory::RangeConstructMoveNoOverlap(buffer, span.Data(), len);
+        T* src = span.Data(), *dst = buffer;
+
+        struct MergeTask { usize begin, mid, end, outBegin, outEnd; };
+        Vec<MergeTask> tasks;
+        while (bounds.Length() > 2) {
+            const usize runs = bounds.Length() - 1, pairs = runs / 2;
+            const usize piecesPerPair = std::max<usize>(workers / pairs, 1);
+            tasks.Clear();
+            for (usize r = 0; r + 1 < runs; r += 2) {
+                const usize begin = bounds[r], mid = bounds[r + 1], end = bounds[r + 2];
+                for (usize k = 0; k < piecesPerPair; ++k)
+                    tasks.Push({ begin, mid, end, begin + (end - begin) * k / piecesPerPair, begin + (end - begin) * (k + 1) / piecesPerPair });
+            }
+            if (runs % 2) tasks.Push({ bounds[runs - 1], bounds[runs], bounds[runs], bounds[runs - 1], bounds[runs] });
+
+            jobs.ParallelFor(0, tasks.Length(), 1, [&] (usize t) {
+                const MergeTask& m = tasks[t];
+                Span<T> a = Spans::Slice(src + m.begin, m.mid - m.begin), b = Spans::Slice(src + m.mid, m.end - m.mid);
+                const usize aFrom = MergeSplit(a, b, m.outBegin - m.begin, cmp), aTo = MergeSplit(a, b, m.outEnd - m.begin, cmp);
+                const usize bFrom = m.outBegin - m.begin - aFrom, bTo = m.outEnd - m.begin - aTo;
+                MergeInto(a.SubspanMut(aFrom, aTo - aFrom), b.SubspanMut(bFrom, bTo - bFrom), dst + m.outBegin, cmp);
+            });
+
+            Vec<usize> merged = Vec<usize>::WithCap(pairs + 2);
+            for (usize r = 0; r < runs; r += 2) merged.Push(bounds[r]);
+            merged.Push(len);
+            bounds = std::move(merged);
+            std::swap(src, dst);
+        }
+
+        if (src != span.Data()) Memory::RangeMoveNoOverlap(span.Data(), src, len);
+        Memory::RangeDestruct(buffer, len);
+        Memory::FreeNoDestruct(buffer);
+    }
+
+    template <IsMut T>
+    void ParallelSort(Jobs::JobSystem& jobs, Span<T> span) { return ParallelSortBy(jobs, span, Cmp::Compare {}); }
+}
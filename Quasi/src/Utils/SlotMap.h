@@ -0,0 +1,118 @@
+#pragma once
+#include "Vec.h"
+#include "Ref.h"
+
+namespace Quasi {
+    // a handle into a SlotMap. it goes stale once its value is removed,
+    // even if the slot gets reused, since every reuse bumps the generation
+    struct SlotKey {
+        static constexpr u32 NONE = ~0u;
+        u32 index = NONE, generation = 0;
+
+        bool IsNull() const { return index == NONE; }
+        bool operator==(const SlotKey&) const = default;
+    };
+
+    // values live densely (so iterating is just a Vec), and keys go through a slot table to find them.
+    // inserting and removing are O(1): removing moves the last value into the hole.
+    // because of that, references to values dont survive a removal, keys do
+    template <class T>
+    class SlotMap {
+        struct Slot {
+            u32 denseOrNextFree; // where the value is, or the next free slot if this one is free
+            u32 generation;      // odd while in use
+        };
+
+        Vec<T> values;
+        Vec<u32> valueSlots; // the slot of each value, for fixing up the moved value on removal
+        Vec<Slot> slots;
+        u32 freeHead = SlotKey::NONE;
+    public:
+        SlotMap() = default;
+
+        usize Length() const { return values.Length(); }
+        bool IsEmpty() const { return values.IsEmpty(); }
+
+        template <class... Args>
+        SlotKey Emplace(Args&&... args) {
+            u32 slot;
+            if (freeHead != SlotKey::NONE) {
+                slot = freeHead;
+                freeHead = slots[slot].denseOrNextFree;
+            } else {
+                slot = (u32)slots.Length();
+                slots.Push({ 0, 0 });
+            }
+            Slot& s = slots[slot];
+            s.denseOrNextFree = (u32)values.Length();
+            ++s.generation;
+            values.Push(T(std::forward<Args>(args)...));
+            valueSlots.Push(slot);
+            return { slot, s.generation };
+        }
+        SlotKey Insert(const T& value) { return Emplace(value); }
+        SlotKey Insert(T&& value)      { return Emplace(std::move(value)); }
+
+        bool Contains(SlotKey key) const {
+            return key.index < slots.Length() && slots[key.index].generation == key.generation && (key.generation & 1);
+        }
+
+        OptRef<T>       Get(SlotKey key)       { return Contains(key) ? OptRefs::SomeRef(values[slots[key.index].denseOrNextFree]) : nullptr; }
+        OptRef<const T> Get(SlotKey key) const { return Contains(key) ? OptRefs::SomeRef(values[slots[key.index].denseOrNextFree]) : nullptr; }
+        T&       operator[](SlotKey key)       { return *Get(key); }
+        const T& operator[](SlotKey key) const { return *Get(key); }
+
+        Option<T> Take(SlotKey key) {
+            if (!Contains(key)) return nullptr;
+            const u32 dense = slots[key.index].denseOrNextFree;
+            Option<T> out = Options::Some(std::move(values[dense]));
+            EraseAt(key.index, dense);
+            return out;
+        }
+
+        bool Remove(SlotKey key) {
+            if (!Contains(key)) return false;
+            EraseAt(key.index, slots[key.index].denseOrNextFree);
+            return true;
+        }
+
+        void Clear() {
+            for (const u32 slot : valueSlots) Free(slot);
+            values.Clear();
+            valueSlots.Clear();
+        }
+
+        // the key of the value at a dense index, so a loop over Values() can still remove things
+        SlotKey KeyAt(usize dense) const {
+            const u32 slot = valueSlots[dense];
+            return { slot, slots[slot].generation };
+        }
+
+        Span<T>       Values()       { return values.AsSpan(); }
+        Span<const T> Values() const { return values.AsSpan(); }
+
+        auto begin()       { return values.begin(); }
+        auto begin() const { return values.begin(); }
+        auto end()         { return values.end(); }
+        auto end()   const { return values.end(); }
+    private:
+        void Free(u32 slot) {
+            Slot& s = slots[slot];
+            ++s.generation;
+            s.denseOrNextFree = freeHead;
+            freeHead = slot;
+        }
+
+        void EraseAt(u32 slot, u32 dense) {
+            const u32 last = (u32)values.Length() - 1;
+            if (dense != last) {
+                values[dense] = std::move(values[last]);
+                valueSlots[dense] = valueSlots[last];
+                slots[valueSlots[dense]].denseOrNextFree = dense;
+            }
+            values.Pop();
+            valueSlots.Pop();
+            Free(slot);
+        }
+    };
+}
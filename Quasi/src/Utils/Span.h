@@ -298,15 +298,18 @@ namespace Quasi {
         bool BinaryContainsKey  (FnArgs<const T&> auto&& keyf, auto&& targetKey) const { const auto [found, _] = BinarySearchByKey(keyf(targetKey)); return found; }
         bool BinaryContainsByKey(FnArgs<const T&> auto&& keyf, const T& target)  const { const auto [found, _] = BinarySearchByKey(keyf(target));    return found; }
 
-        void Sort() mut { return SortBy(Cmp::LessThan {}); }
+        void Sort() mut { return SortBy(Cmp::Compare {}); }
         void SortBy(Comparator<T> auto&& cmp) mut;
         void SortByKey(FnArgs<const T&> auto&& keyf) mut;
+        // stable, keys have to be integers or floats. beats SortByKey from a few hundred elements up
+        void RadixSort() mut { return RadixSortByKey([] (const T& x) { return x; }); }
+        void RadixSortByKey(FnArgs<const T&> auto&& keyf) mut;
 
         // void SortStable() TODO i cant be bothered to do this
         // void SortStableBy(Fn<bool, const T&, const T&> auto&& cmp)
         // void SortStableByKey(auto&& keyf)
 
-        bool IsSorted() const { return IsSortedBy(Cmp::LessThan {}); }
+        bool IsSorted() const { return IsSortedBy(Cmp::Compare {}); }
         bool IsSortedBy(Comparator<T> auto&& cmp) const;
         bool IsSortedByKey(FnArgs<const T&> auto&& keyf) const;
 
@@ -338,10 +341,10 @@ namespace Quasi {
         void Fill(const T& value) mut { for (T& t : *this) t = value; }
         void FillWith(Fn<T> auto&& factory) mut { for (T& t : *this) t = factory(); }
         void FillDefault() { return FillWith(Combinate::Constructor<T> {}); }
-        void CloneFrom(Span<const T> span) mut { Memory::RangeCopy(data, span.data, span.count); }
-        void MoveFrom(Span span) mut { Memory::RangeMove(data, span.data, span.count); }
+        void CloneFrom(Span<const T> span) mut { Memory::RangeCopy(data, span.data, span.size); }
+        void MoveFrom(Span span) mut { Memory::RangeMove(data, span.data, span.size); }
         // void CopyFromSelf(IntegerRange, usize dest)
-        void SwapWith(Span span) mut { Memory::RangeSwap(data, span.data, span.count); }
+        void SwapWith(Span span) mut { Memory::RangeSwap(data, span.data, span.size); }
 
         // Tuple<Span, Span<AddConstIf<SimdT, T>>, Span> AsSimd() const;
 
@@ -6,6 +6,8 @@
 #include "CStr.h"
 #include "Iter/LinesIter.h"
 #include "Iter/SplitIter.h"
+#include "Iter/SplitOneOfIter.h"
+#include "Text/ByteSearch.h"
 #include "Text/StringWriter.h"
 
 namespace Quasi {
@@ -17,7 +19,7 @@ namespace Quasi {
         Option<char> TryFromDigitRadix(u32 digit, u32 radix) { return digit < radix ? Options::Some(FromHexDigit(digit)) : nullptr; }
 
         u32         ToDigit      (char digit) { return (u32)(digit - '0'); }
-        u32         ToHexDigit   (char digit) { return IsNumeric(digit) ? digit - '0' : IsUpper(digit) ? digit - 'A' : digit - 'a'; }
+        u32         ToHexDigit   (char digit) { return IsNumeric(digit) ? digit - '0' : IsUpper(digit) ? digit - 'A' + 10 : digit - 'a' + 10; }
         Option<u32> TryToDigit   (char digit) { return IsDigit(digit)    ? Options::Some(ToDigit(digit))    : nullptr; }
         Option<u32> TryToHexDigit(char digit) { return IsHexDigit(digit) ? Options::Some(ToHexDigit(digit)) : nullptr; }
         Option<u32> TryToDigitRadix(char digit, u32 radix) { return IsDigitRadix(digit, radix) ? Options::Some(ToHexDigit(digit)) : nullptr; }
@@ -119,15 +121,10 @@ namespace Quasi {
     strdef BufferIterator<char&>       strcls::IterMut() requires mut { return { this->Data(), this->DataEnd() }; }
 
     strdef Iter::SplitIter<Str> strcls::Split(Str sep) const { return Iter::SplitIter<Str>::New(AsStr(), sep); }
+    strdef Iter::SplitOneOfIter strcls::SplitOneOf(Str seps) const { return Iter::SplitOneOfIter::New(AsStr(), seps); }
     strdef Iter::LinesIter strcls::Lines() const { return Iter::LinesIter::New(AsStr()); }
     strdef usize strcls::CountLines() const { return CountChars('\n') + 1; }
-    strdef usize strcls::CountChars(char c) const {
-        usize zeroCount = 0;
-        for (usize i = 0; i < this->Length(); ++i) {
-            zeroCount += this->Data()[i] == c;
-        }
-        return zeroCount;
-    }
+    strdef usize strcls::CountChars(char c) const { return Text::ByteSearch::CountChar(AsStr(), c); }
 
     strdef Str              strcls::AsStr()      const        { return Str   ::Slice(this->Data(), this->Length()); }
     strdef StrMut           strcls::AsStrMut()   requires mut { return StrMut::Slice(this->Data(), this->Length()); }
@@ -236,14 +233,17 @@ namespace Quasi {
 
     strdef void  strcls::Reverse() requires mut { AsSpanMut().Reverse(); }
 
-    strdef OptionUsize strcls::Find   (char c)  const { for (usize i = 0; i < this->Length(); ++i) if (At(i) == c) return i; return nullptr; }
+    strdef OptionUsize strcls::Find   (char c)  const {
+        const usize i = Text::ByteSearch::FindChar(AsStr(), c);
+        return i == this->Length() ? nullptr : OptionUsize { i };
+    }
     strdef OptionUsize strcls::RevFind(char c)  const { for (usize i = this->Length(); i --> 0; )  if (At(i) == c) return i; return nullptr; }
     strdef bool    strcls::Contains   (char c)  const { return Find   (c).HasValue(); }
     strdef bool    strcls::RevContains(char c)  const { return RevFind(c).HasValue(); }
     strdef OptionUsize strcls::Find   (Str str) const {
-        for (usize i = 0; i + str.Length() < this->Length(); ++i)
-            if (Substr(i, str.Length()) == str) return i;
-        return nullptr;
+        if (str.Length() > this->Length()) return nullptr;
+        const usize i = Text::ByteSearch::FindStr(AsStr(), str);
+        return i == this->Length() ? nullptr : OptionUsize { i };
     }
     strdef OptionUsize strcls::RevFind(Str str) const {
         for (usize i = this->Length() + 1; --i >= str.Length(); )
@@ -253,7 +253,8 @@ namespace Quasi {
     strdef bool  strcls::Contains   (Str str) const { return Find   (str) != -1; }
     strdef bool  strcls::RevContains(Str str) const { return RevFind(str) != -1; }
     strdef Tuple<OptionUsize, OptionUsize> strcls::FindOneOf(Span<const char> anyc) const {
-        const OptionUsize i = FindIf(Chr::Set { anyc });
+        const usize found = Text::ByteSearch::FindOneOf(AsStr(), Str::Slice(anyc.Data(), anyc.Length()));
+        const OptionUsize i = found == this->Length() ? nullptr : OptionUsize { found };
         return { i, i ? anyc.Find(At(*i)) : nullptr };
     }
     strdef Tuple<OptionUsize, OptionUsize> strcls::RevFindOneOf(Span<const char> anyc) const {
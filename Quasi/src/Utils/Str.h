@@ -8,6 +8,7 @@ namespace Quasi {
 
     namespace Iter {
         struct LinesIter;
+        struct SplitOneOfIter;
     }
 
     struct Str;
@@ -75,6 +76,8 @@ namespace Quasi {
         // Utf8CharsIter Utf8Chars() const;
         // SplitWhitespaceIter SplitWhitespace() const;
         Iter::SplitIter<Str> Split(Str sep) const;
+        // splits on any of the characters in seps
+        Iter::SplitOneOfIter SplitOneOf(Str seps) const;
         Iter::LinesIter Lines() const;
         usize CountLines() const;
         usize CountChars(char c) const;
@@ -178,6 +178,9 @@ namespace Quasi {
         String& operator+=(Str rhs);
     };
 
+    // both representations are self contained, so strings can be moved around as bytes
+    template <> struct Memory::TriviallyRelocatable<String> { static constexpr bool VALUE = true; };
+
     template <class T> Str    Span<T>::AsStr() const requires SameAs<const T, const char> { return Str::Slice(data, size); }
     template <class T> StrMut Span<T>::AsStrMut()    requires SameAs<      T,       char> { return StrMut::Slice(data, size); }
 
@@ -1,5 +1,6 @@
 #include "Text.h"
 
+#include <filesystem>
 #include <fstream>
 
 #include "CStr.h"
@@ -48,6 +49,23 @@ namespace Quasi::Text {
         return false;
     }
 
+    bool WriteFileBinary(CStr fname, Span<const byte> contents) {
+        if (std::ofstream out { fname.Data(), std::ios::binary }) {
+            out.write((const char*)contents.Data(), (isize)contents.Length());
+            return out.good();
+        }
+        return false;
+    }
+
+    Option<FileInfo> GetFileInfo(CStr fname) {
+        std::error_code err;
+        const auto size = std::filesystem::file_size(fname.Data(), err);
+        if (err) return nullptr;
+        const auto modified = std::filesystem::last_write_time(fname.Data(), err);
+        if (err) return nullptr;
+        return FileInfo { (u64)size, (i64)modified.time_since_epoch().count() };
+    }
+
     bool ExistsFile(CStr fname) {
         return std::ifstream { fname.Data() }.good();
     }
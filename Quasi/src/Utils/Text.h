@@ -12,8 +12,18 @@ namespace Quasi::Text {
     Option<String> ReadFile(CStr fname);
     Option<String> ReadFileBinary(CStr fname);
     bool WriteFile(CStr fname, Str contents);
+    bool WriteFileBinary(CStr fname, Span<const byte> contents);
     bool ExistsFile(CStr fname);
 
+    struct FileInfo {
+        u64 size;
+        // in filesystem clock ticks, only meaningful when compared to other FileInfos
+        i64 lastModified;
+
+        bool operator==(const FileInfo&) const = default;
+    };
+    Option<FileInfo> GetFileInfo(CStr fname);
+
     Tuple<Str, Str> SplitDirectory(Str fname);
 
     String AutoIndent(Str text);
@@ -42,16 +52,6 @@ namespace Quasi::Text {
         const Str fullname = details::t<T>();
         return fullname.Substr(details::T_START_IDX, fullname.Length() - details::T_TOTAL_SIZE);
     }
-    template <usize N>
-    struct FixedString  {
-        char buf[N + 1]{};
-        constexpr FixedString(const char* s) {
-            for (unsigned i = 0; i != N; ++i) buf[i] = s[i];
-        }
-        constexpr operator const char*() const { return buf; }
-        static constexpr usize SIZE = N;
-    };
-    template <usize N> FixedString(const char (&)[N]) -> FixedString<N - 1>;
 
     enum ConsoleColor : u32 {
         RESET = 0,
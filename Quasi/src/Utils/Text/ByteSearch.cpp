@@ -0,0 +1,249 @@
+#include "ByteSearch.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define Q_BYTESEARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Quasi::Text {
+    usize ByteSearch::FindCharSwar(Str text, char c) {
+        const char* data = text.Data();
+        const usize len = text.Length();
+        const u64 pattern = ONES * (u8)c;
+        usize i = 0;
+        for (; i + 8 <= len; i += 8) {
+            const u64 x = Memory::ReadU64(data + i) ^ pattern;
+            // borrows only ever go upwards, so the lowest flagged byte is always a real match
+            if (const u64 found = (x - ONES) & ~x & HIGHS) return i + std::countr_zero(found) / 8;
+        }
+        for (; i < len; ++i) if (data[i] == c) return i;
+        return len;
+    }
+
+    usize ByteSearch::CountCharSwar(Str text, char c) {
+        const char* data = text.Data();
+        const usize len = text.Length();
+        const u64 pattern = ONES * (u8)c;
+        usize count = 0, i = 0;
+        for (; i + 8 <= len; i += 8) {
+            const u64 x = Memory::ReadU64(data + i) ^ pattern;
+            // exact, the high bit ends up set for every nonzero byte without carrying into the next
+            count += std::popcount(~(((x & ~HIGHS) + ~HIGHS) | x) & HIGHS);
+        }
+        for (; i < len; ++i) count += data[i] == c;
+        return count;
+    }
+
+    usize ByteSearch::FindOneOfSwar(Str text, Str set) {
+        if (set.Length() == 1) return FindCharSwar(text, set[0]);
+        bool isInSet[256] = {};
+        for (usize s = 0; s < set.Length(); ++s) isInSet[(u8)set[s]] = true;
+        for (usize i = 0; i < text.Length(); ++i)
+            if (isInSet[(u8)text[i]]) return i;
+        return text.Length();
+    }
+
+    usize ByteSearch::FindStrSwar(Str text, Str pat) {
+        const usize len = text.Length(), plen = pat.Length();
+        if (plen <= 1) return plen ? FindCharSwar(text, pat[0]) : 0;
+        if (plen > len) return len;
+
+        // same filter as the simd versions, only positions where the first and last byte match get compared
+        const char* data = text.Data();
+        const u64 first = ONES * (u8)pat.First(), last = ONES * (u8)pat.Last();
+        const auto zeroBytes = [] (u64 x) { return ~(((x & ~HIGHS) + ~HIGHS) | x) & HIGHS; };
+        usize i = 0;
+        for (; i + plen - 1 + 8 <= len; i += 8) {
+            u64 mask = zeroBytes(Memory::ReadU64(data + i) ^ first) & zeroBytes(Memory::ReadU64(data + i + plen - 1) ^ last);
+            for (; mask; mask &= mask - 1) {
+                const usize at = i + std::countr_zero(mask) / 8;
+                if (std::memcmp(data + at + 1, pat.Data() + 1, plen - 2) == 0) return at;
+            }
+        }
+        for (; i + plen <= len; ++i)
+            if (std::memcmp(data + i, pat.Data(), plen) == 0) return i;
+        return len;
+    }
+
+#ifdef Q_BYTESEARCH_X86
+    usize ByteSearch::FindCharSse2(Str text, char c) {
+        const char* data = text.Data();
+        const usize len = text.Length();
+        const __m128i pattern = _mm_set1_epi8(c);
+        usize i = 0;
+        for (; i + 16 <= len; i += 16) {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+            if (const u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)))
+                return i + std::countr_zero(mask);
+        }
+        return i + FindCharSwar(text.Skip(i), c);
+    }
+
+    usize ByteSearch::CountCharSse2(Str text, char c) {
+        const char* data = text.Data();
+        const usize len = text.Length();
+        const __m128i pattern = _mm_set1_epi8(c);
+        usize count = 0, i = 0;
+        while (i + 16 <= len) {
+            // matches are -1, so subtracting counts them per byte. flushed before any byte can overflow
+            __m128i counts = _mm_setzero_si128();
+            const usize blocks = std::min<usize>((len - i) / 16, 255);
+            for (usize b = 0; b < blocks; ++b, i += 16) {
+                const __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+                counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(block, pattern));
+            }
+            const __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+            count += (usize)_mm_extract_epi16(sums, 0) + (usize)_mm_extract_epi16(sums, 4);
+        }
+        return count + CountCharSwar(text.Skip(i), c);
+    }
+
+    usize ByteSearch::FindOneOfSse2(Str text, Str set) {
+        if (set.Length() == 1) return FindCharSse2(text, set[0]);
+        if (set.Length() > 16) return FindOneOfSwar(text, set);
+
+        const char* data = text.Data();
+        const usize len = text.Length();
+        __m128i patterns[16];
+        for (usize s = 0; s < set.Length(); ++s) patterns[s] = _mm_set1_epi8(set[s]);
+        usize i = 0;
+        for (; i + 16 <= len; i += 16) {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+            __m128i matches = _mm_setzero_si128();
+            for (usize s = 0; s < set.Length(); ++s)
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, patterns[s]));
+            if (const u32 mask = (u32)_mm_movemask_epi8(matches))
+                return i + std::countr_zero(mask);
+        }
+        return i + FindOneOfSwar(text.Skip(i), set);
+    }
+
+    usize ByteSearch::FindStrSse2(Str text, Str pat) {
+        const usize len = text.Length(), plen = pat.Length();
+        if (plen <= 1) return plen ? FindCharSse2(text, pat[0]) : 0;
+        if (plen > len) return len;
+
+        // wojciech mula's filter: only positions where both the first and last byte match get compared
+        const char* data = text.Data();
+        const __m128i first = _mm_set1_epi8(pat.First()), last = _mm_set1_epi8(pat.Last());
+        usize i = 0;
+        for (; i + plen - 1 + 16 <= len; i += 16) {
+            const __m128i head = _mm_loadu_si128((const __m128i*)(data + i)),
+                          tail = _mm_loadu_si128((const __m128i*)(data + i + plen - 1));
+            u32 mask = (u32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+            for (; mask; mask &= mask - 1) {
+                const usize at = i + std::countr_zero(mask);
+                if (std::memcmp(data + at + 1, pat.Data() + 1, plen - 2) == 0) return at;
+            }
+        }
+        return i + FindStrSwar(text.Skip(i), pat);
+    }
+
+    __attribute__((target("avx2")))
+    usize ByteSearch::FindCharAvx2(Str text, char c) {
+        const char* data = text.Data();
+        const usize len = text.Length();
+        const __m256i pattern = _mm256_set1_epi8(c);
+        usize i = 0;
+        for (; i + 32 <= len; i += 32) {
+            const __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+            if (const u32 mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)))
+                return i + std::countr_zero(mask);
+        }
+        return i + FindCharSse2(text.Skip(i), c);
+    }
+
+    __attribute__((target("avx2")))
+    usize ByteSearch::CountCharAvx2(Str text, char c) {
+        const char* data = text.Data();
+        const usize len = text.Length();
+        const __m256i pattern = _mm256_set1_epi8(c);
+        usize count = 0, i = 0;
+        while (i + 32 <= len) {
+            __m256i counts = _mm256_setzero_si256();
+            const usize blocks = std::min<usize>((len - i) / 32, 255);
+            for (usize b = 0; b < blocks; ++b, i += 32) {
+                const __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+                counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(block, pattern));
+            }
+            const __m256i wide = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+            const __m128i sums = _mm_add_epi64(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+            count += (usize)_mm_extract_epi16(sums, 0) + (usize)_mm_extract_epi16(sums, 4);
+        }
+        return count + CountCharSse2(text.Skip(i), c);
+    }
+
+    __attribute__((target("avx2")))
+    usize ByteSearch::FindOneOfAvx2(Str text, Str set) {
+        if (set.Length() == 1) return FindCharAvx2(text, set[0]);
+        if (set.Length() > 16) return FindOneOfSwar(text, set);
+
+        const char* data = text.Data();
+        const usize len = text.Length();
+        __m256i patterns[16];
+        for (usize s = 0; s < set.Length(); ++s) patterns[s] = _mm256_set1_epi8(set[s]);
+        usize i = 0;
+        for (; i + 32 <= len; i += 32) {
+            const __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+            __m256i matches = _mm256_setzero_si256();
+            for (usize s = 0; s < set.Length(); ++s)
+                matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, patterns[s]));
+            if (const u32 mask = (u32)_mm256_movemask_epi8(matches))
+                return i + std::countr_zero(mask);
+        }
+        return i + FindOneOfSse2(text.Skip(i), set);
+    }
+
+    __attribute__((target("avx2")))
+    usize ByteSearch::FindStrAvx2(Str text, Str pat) {
+        const usize len = text.Length(), plen = pat.Length();
+        if (plen <= 1) return plen ? FindCharAvx2(text, pat[0]) : 0;
+        if (plen > len) return len;
+
+        const char* data = text.Data();
+        const __m256i first = _mm256_set1_epi8(pat.First()), last = _mm256_set1_epi8(pat.Last());
+        usize i = 0;
+        for (; i + plen - 1 + 32 <= len; i += 32) {
+            const __m256i head = _mm256_loadu_si256((const __m256i*)(data + i)),
+                          tail = _mm256_loadu_si256((const __m256i*)(data + i + plen - 1));
+            u32 mask = (u32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+            for (; mask; mask &= mask - 1) {
+                const usize at = i + std::countr_zero(mask);
+                if (std::memcmp(data + at + 1, pat.Data() + 1, plen - 2) == 0) return at;
+            }
+        }
+        return i + FindStrSse2(text.Skip(i), pat);
+    }
+
+    ByteSearch::Level ByteSearch::BestLevel() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? AVX2 : SSE2;
+    }
+
+    void ByteSearch::UseLevel(Level level) {
+        switch (std::min(level, BestLevel())) {
+            case AVX2:   active = { AVX2,   FindCharAvx2, CountCharAvx2, FindOneOfAvx2, FindStrAvx2 }; break;
+            case SSE2:   active = { SSE2,   FindCharSse2, CountCharSse2, FindOneOfSse2, FindStrSse2 }; break;
+            case SCALAR:
+            default:     active = { SCALAR, FindCharSwar, CountCharSwar, FindOneOfSwar, FindStrSwar }; break;
+        }
+    }
+#else
+    ByteSearch::Level ByteSearch::BestLevel() { return SCALAR; }
+    void ByteSearch::UseLevel(Level) {}
+#endif
+
+    Str ByteSearch::LevelName(Level level) {
+        switch (level) {
+            case AVX2: return "AVX2";
+            case SSE2: return "SSE2";
+            case SCALAR:
+            default:   return "SWAR";
+        }
+    }
+
+    const bool ByteSearch::DETECTED = (UseLevel(BestLevel()), true);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Utils/Str.h"
+
+namespace Quasi::Text {
+    // the byte scanning behind Str's Find, CountChars and the line/split iterators.
+    // uses the widest simd the cpu supports, picked once at startup, or swar everywhere else.
+    // every search returns the length of the text when nothing is found
+    struct ByteSearch {
+        enum Level { SCALAR, SSE2, AVX2 };
+
+        static usize FindChar (Str text, char c)   { return active.findChar (text, c); }
+        static usize CountChar(Str text, char c)   { return active.countChar(text, c); }
+        static usize FindOneOf(Str text, Str set)  { return active.findOneOf(text, set); }
+        static usize FindStr  (Str text, Str pat)  { return active.findStr  (text, pat); }
+
+        static Level BestLevel();
+        static Level CurrentLevel() { return active.level; }
+        // clamped to what the cpu supports, mostly for benchmarking
+        static void  UseLevel(Level level);
+        static Str   LevelName(Level level);
+    private:
+        struct Kernels {
+            Level level;
+            usize (*findChar) (Str, char);
+            usize (*countChar)(Str, char);
+            usize (*findOneOf)(Str, Str);
+            usize (*findStr)  (Str, Str);
+        };
+
+        // 8 bytes at a time in a u64
+        static constexpr u64 ONES = 0x0101010101010101, HIGHS = 0x8080808080808080;
+        static usize FindCharSwar (Str text, char c);
+        static usize CountCharSwar(Str text, char c);
+        static usize FindOneOfSwar(Str text, Str set);
+        static usize FindStrSwar  (Str text, Str pat);
+
+        // only defined on x86
+        static usize FindCharSse2 (Str text, char c);
+        static usize CountCharSse2(Str text, char c);
+        static usize FindOneOfSse2(Str text, Str set);
+        static usize FindStrSse2  (Str text, Str pat);
+        static usize FindCharAvx2 (Str text, char c);
+        static usize CountCharAvx2(Str text, char c);
+        static usize FindOneOfAvx2(Str text, Str set);
+        static usize FindStrAvx2  (Str text, Str pat);
+
+        // starts out scalar so anything searching during static init still works
+        inline static constinit Kernels active = { SCALAR, FindCharSwar, CountCharSwar, FindOneOfSwar, FindStrSwar };
+        static const bool DETECTED;
+    };
+}
@@ -16,7 +16,7 @@ namespace Quasi::Text {
             const char c = fmt[i];
             if (c != '{' && c != '}') { ++i; continue; }
             if (i + 1 < fmt.Length() && fmt[i + 1] == c) {
-                writeLen += output.Write(c);
+                writeLen += output.Write(fmt.Substr(prev, i + 1 - prev));
                 i = (prev = i + 2);
                 continue;
             }
@@ -52,28 +52,30 @@ namespace Quasi::Text {
     TextFormatOptions TextFormatOptions::Configure(Str opt) {
         // the format specifier follows: (?'char'.)?(?'align'[<^>])(?'len'[0-9]+)
         // 'char': fill character, 'align': left, middle (prioritize filling right) or right, 'len' is len
+        // a trailing '?' escapes the text, so {:?} works on its own
         TextFormatOptions options;
         if (!opt) return options;
 
-        if (opt[0] != '<' && opt[0] != '^' && opt[0] != '>') {
+        if (opt.Last() == '?') {
+            options.escape = true;
+            opt.Shorten(1);
+        }
+        if (!opt) return options;
+
+        // same as the number formatters, the fill only counts if an alignment comes after it
+        if (opt.Length() > 1 && (opt[1] == '<' || opt[1] == '^' || opt[1] == '>')) {
             options.pad = opt[0];
             opt.Advance(1);
         }
 
-        if (!opt) return options;
         if (opt[0] == '^') {
             options.alignment = CENTER;
         } else {
             options.alignment = (Alignment)(opt[0] - '<');
         }
 
-        if (opt.Last() == '?') {
-            options.escape = true;
-            opt.Shorten(1);
-        }
-        if (!opt) return options;
-
-        options.targetLength = Parse<usize>(opt.Tail()).Assert();
+        if (opt.Length() > 1)
+            options.targetLength = Parse<usize>(opt.Tail()).Assert();
 
         return options;
     }
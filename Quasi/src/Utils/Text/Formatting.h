@@ -7,6 +7,11 @@ namespace Quasi {
 }
 
 namespace Quasi::Text {
+    /* required methods:
+     * usize FormatTo(StringWriter sw, const T& object, const FormatOptions& options);
+     * (optional) FormatOptions ConfigureOptions(Str opt);
+     * (optional) constexpr bool ValidSpec(FormatSpec spec); checks specs of _fmt strings at compile time
+     */
     template <class T> struct Formatter {};
 
     template <class T>
@@ -45,6 +50,213 @@ namespace Quasi::Text {
         return Text::FormatDynamicTypesTo<Ts...>(output, fmt, argParams);
     }
 
+    template <usize N>
+    struct FixedString  {
+        char buf[N + 1]{};
+        constexpr FixedString(const char* s) {
+            for (unsigned i = 0; i != N; ++i) buf[i] = s[i];
+        }
+        constexpr operator const char*() const { return buf; }
+        static constexpr usize SIZE = N;
+    };
+    template <usize N> FixedString(const char (&)[N]) -> FixedString<N - 1>;
+
+    // reads through a format spec in constant expressions, see Formatter::ValidSpec
+    struct FormatSpec {
+        const char* it;
+        const char* end;
+
+        constexpr bool Done() const { return it == end; }
+        constexpr bool Eat(char c) {
+            if (it == end || *it != c) return false;
+            ++it;
+            return true;
+        }
+        constexpr bool EatAnyOf(const char* set) {
+            if (it == end) return false;
+            for (; *set; ++set) if (*it == *set) { ++it; return true; }
+            return false;
+        }
+        constexpr bool EatDigits() {
+            const char* start = it;
+            while (it != end && '0' <= *it && *it <= '9') ++it;
+            return it != start;
+        }
+        // a number that doesnt start with 0, so its not mistaken for zero padding
+        constexpr bool EatNumber() { return it != end && *it != '0' && EatDigits(); }
+        // (?'fill'.)?(?'align'[<^>]), the fill only counts when an alignment follows it
+        constexpr bool EatFillAlign() {
+            const auto isAlign = [] (char c) { return c == '<' || c == '^' || c == '>'; };
+            if (end - it >= 2 && isAlign(it[1])) { it += 2; return true; }
+            if (it != end && isAlign(*it)) { ++it; return true; }
+            return false;
+        }
+
+        template <class T> static constexpr bool Validate(FormatSpec spec) {
+            if constexpr (requires { Formatter<T>::ValidSpec(spec); })
+                return Formatter<T>::ValidSpec(spec);
+            else return true;
+        }
+    };
+
+    // one piece of a format string: some literal text, then maybe a replacement field
+    struct FormatSegment {
+        static constexpr u8 NO_ARG = 0xFF;
+        u16 literalStart = 0, literalLength = 0;
+        u16 specStart = 0, specLength = 0;
+        u8 arg = NO_ARG;
+    };
+
+    struct FormatStringInfo {
+        usize segmentCount = 0, literalLength = 0;
+        u64 usedArgs = 0;
+    };
+
+    // not constexpr on purpose, calling it stops compilation with the reason in the error trace
+    inline void FormatStringError(const char*) {}
+
+    // splits a format string into segments, or only counts them if out is null.
+    // follows the same rules as FormatToDynamic: {}, {index}, {:spec}, {index:spec}, {{ and }}
+    consteval FormatStringInfo ParseFormatString(const char* fmt, usize length, FormatSegment* out) {
+        FormatStringInfo info;
+        FormatSegment discard;
+        const auto push = [&] (usize literalStart, usize literalEnd) -> FormatSegment& {
+            FormatSegment& segment = out ? out[info.segmentCount] : discard;
+            segment.literalStart  = (u16)literalStart;
+            segment.literalLength = (u16)(literalEnd - literalStart);
+            ++info.segmentCount;
+            info.literalLength += literalEnd - literalStart;
+            return segment;
+        };
+
+        if (length > 0xFFFF) FormatStringError("format string is too long");
+        usize i = 0, literalStart = 0, nextArg = 0;
+        while (i < length) {
+            const char c = fmt[i];
+            if (c != '{' && c != '}') { ++i; continue; }
+            if (i + 1 < length && fmt[i + 1] == c) {
+                // keep one of the two braces as text
+                push(literalStart, i + 1);
+                i = literalStart = i + 2;
+                continue;
+            }
+            if (c == '}') FormatStringError("unmatched '}' in format string, use '}}' for a literal brace");
+
+            usize close = i + 1, colon = 0;
+            for (; close < length && fmt[close] != '}'; ++close) {
+                if (fmt[close] == '{') FormatStringError("'{' inside a replacement field");
+                if (fmt[close] == ':' && !colon) colon = close;
+            }
+            if (close == length) FormatStringError("no closing '}' in format string");
+
+            const usize indexEnd = colon ? colon : close;
+            usize arg = nextArg;
+            if (indexEnd > i + 1) {
+                arg = 0;
+                for (usize j = i + 1; j < indexEnd; ++j) {
+                    if (fmt[j] < '0' || fmt[j] > '9') FormatStringError("argument index isnt a number");
+                    arg = arg * 10 + (fmt[j] - '0');
+                    if (arg >= 64) FormatStringError("argument index is too large");
+                }
+            }
+            if (nextArg >= 64) FormatStringError("too many replacement fields");
+
+            FormatSegment& field = push(literalStart, i);
+            field.arg = (u8)arg;
+            if (colon) {
+                field.specStart  = (u16)(colon + 1);
+                field.specLength = (u16)(close - colon - 1);
+            }
+            info.usedArgs |= 1ull << arg;
+            ++nextArg;
+            i = literalStart = close + 1;
+        }
+        push(literalStart, length);
+        return info;
+    }
+
+    // a format string parsed at compile time, made with "..."_fmt.
+    // the literals and fields are split up once into a table, formatting just walks it without dispatch.
+    // field indices and specs are checked against the argument types wherever it is formatted
+    template <FixedString S>
+    struct StaticFormat {
+        static constexpr FormatStringInfo INFO = ParseFormatString(S.buf, S.SIZE, nullptr);
+        static constexpr usize SEGMENT_COUNT = INFO.segmentCount, LITERAL_LENGTH = INFO.literalLength;
+
+        struct Table { FormatSegment segments[SEGMENT_COUNT]; };
+        static constexpr Table TABLE = [] () consteval {
+            Table table {};
+            ParseFormatString(S.buf, S.SIZE, table.segments);
+            return table;
+        } ();
+
+        template <class... Ts>
+        static consteval bool ValidSpecs() {
+            constexpr FuncPtr<bool, FormatSpec> validators[] = { &FormatSpec::Validate<Ts>..., nullptr };
+            for (const FormatSegment& seg : TABLE.segments) {
+                if (seg.arg == FormatSegment::NO_ARG || !seg.specLength) continue;
+                if (!validators[seg.arg]({ S.buf + seg.specStart, S.buf + seg.specStart + seg.specLength }))
+                    return false;
+            }
+            return true;
+        }
+
+        template <usize I, class... Ts>
+        static usize WriteSegment(StringWriter output, const void* const args[]) {
+            static constexpr FormatSegment seg = TABLE.segments[I];
+            usize len = 0;
+            if constexpr (seg.literalLength != 0)
+                len += output.Write(Str::Slice(S.buf + seg.literalStart, seg.literalLength));
+            if constexpr (seg.arg != FormatSegment::NO_ARG) {
+                using T = TupleElement<seg.arg, Ts...>;
+                const T& arg = *Memory::UpcastPtr<T>(args[seg.arg]);
+                if constexpr (seg.specLength != 0)
+                    len += Text::FormatObjectTo(output, arg, Str::Slice(S.buf + seg.specStart, seg.specLength));
+                else if constexpr (requires (Str x) { Formatter<T>::ConfigureOptions(x); })
+                    len += Text::FormatObjectTo(output, arg, typename Formatter<T>::FormatOptions {});
+                else len += Text::FormatObjectTo(output, arg, Str::Empty());
+            }
+            return len;
+        }
+
+        template <class... Ts>
+        static usize WriteTo(StringWriter output, const void* const args[]) {
+            usize len = 0;
+            [&]<usize... Is>(IntSeq<Is...>) {
+                ((len += WriteSegment<Is, Ts...>(output, args)), ...);
+            } (IntRangeSeq<SEGMENT_COUNT> {});
+            return len;
+        }
+    };
+
+    template <FixedString S, class... Ts>
+    usize FormatTo(StringWriter output, StaticFormat<S>, const Ts&... args) {
+        using Fmt = StaticFormat<S>;
+        static_assert(sizeof...(Ts) < 64, "too many format arguments");
+        static_assert((Fmt::INFO.usedArgs >> sizeof...(Ts)) == 0, "format string refers to an argument that wasnt given");
+        static_assert(Fmt::INFO.usedArgs == (1ull << sizeof...(Ts)) - 1, "not every argument is used in the format string");
+        static_assert(Fmt::template ValidSpecs<Ts...>(), "format spec doesnt fit the type of its argument");
+
+        const void* argParams[] = { (const void*)&args..., nullptr };
+        return Fmt::template WriteTo<Ts...>(output, argParams);
+    }
+
+    template <FixedString S, class... Ts>
+    String Format(StaticFormat<S> fmt, const Ts&... args) {
+        // room for the literal text and a few characters per argument
+        String s = String::WithCap(StaticFormat<S>::LITERAL_LENGTH + 8 * sizeof...(Ts));
+        Text::FormatTo(StringWriter::WriteTo(s), fmt, args...);
+        return s;
+    }
+
+    // anything past the end of the buffer is cut off, returns how much was written
+    template <FixedString S, class... Ts>
+    usize FormatToBuffer(Span<char> buffer, StaticFormat<S> fmt, const Ts&... args) {
+        Span<char> rest = buffer;
+        Text::FormatTo(StringWriter::WriteToBuffer(rest), fmt, args...);
+        return buffer.Length() - rest.Length();
+    }
+
     template <class T> struct WithFormatOptions {
         T subject;
         typename Formatter<T>::FormatOptions options;
@@ -70,6 +282,11 @@ namespace Quasi::Text {
         bool escape = false;
 
         static TextFormatOptions Configure(Str opt);
+        static constexpr bool ValidSpec(FormatSpec spec) {
+            if (spec.EatFillAlign()) spec.EatDigits();
+            spec.Eat('?');
+            return spec.Done();
+        }
     };
 
     template <>
@@ -77,6 +294,7 @@ namespace Quasi::Text {
         using FormatOptions = TextFormatOptions;
 
         static FormatOptions ConfigureOptions(Str opt) { return TextFormatOptions::Configure(opt); }
+        static constexpr bool ValidSpec(FormatSpec spec) { return TextFormatOptions::ValidSpec(spec); }
         static usize FormatTo(StringWriter sw, Str input, const FormatOptions& options);
         static usize FormatNoEscape(StringWriter sw, Str input, const FormatOptions& options);
     };
@@ -86,6 +304,7 @@ namespace Quasi::Text {
         using FormatOptions = TextFormatOptions;
 
         static FormatOptions ConfigureOptions(Str opt) { return TextFormatOptions::Configure(opt); }
+        static constexpr bool ValidSpec(FormatSpec spec) { return TextFormatOptions::ValidSpec(spec); }
         static usize FormatTo(StringWriter sw, char c, const FormatOptions& options);
     };
 
@@ -106,6 +325,11 @@ namespace Quasi::Text {
 }
 
 
+namespace Quasi {
+    template <Text::FixedString S>
+    constexpr Text::StaticFormat<S> operator ""_fmt() { return {}; }
+}
+
 #pragma region Extra Type Formattings
 namespace Quasi::Text {
     template <> struct Formatter<void*> {
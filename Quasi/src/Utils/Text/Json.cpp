@@ -0,0 +1,444 @@
+#include "Json.h"
+
+#include <bit>
+
+#include "ByteSearch.h"
+#include "Num.h"
+#include "Parsing.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define Q_JSON_X86
+#include <immintrin.h>
+#endif
+
+namespace Quasi::Text {
+    void JsonIndexer::ClassifyScalar(const char* block, Masks& out) {
+        // bit 0 quote, 1 backslash, 2 structural, 3 whitespace
+        struct Table { u8 classes[256]; };
+        static constexpr Table CLASSES = [] {
+            Table t {};
+            t.classes['"'] = 1; t.classes['\\'] = 2;
+            for (const char c : { '{', '}', '[', ']', ':', ',' }) t.classes[(u8)c] = 4;
+            for (const char c : { ' ', '\t', '\n', '\r' })         t.classes[(u8)c] = 8;
+            return t;
+        } ();
+        out = {};
+        for (u32 i = 0; i < 64; ++i) {
+            const u64 c = CLASSES.classes[(u8)block[i]];
+            out.quote      |= (c & 1)        << i;
+            out.backslash  |= (c >> 1 & 1)   << i;
+            out.op         |= (c >> 2 & 1)   << i;
+            out.whitespace |= (c >> 3)       << i;
+        }
+    }
+
+#ifdef Q_JSON_X86
+    void JsonIndexer::ClassifySse2(const char* block, Masks& out) {
+        out = {};
+        for (u32 i = 0; i < 64; i += 16) {
+            const __m128i b = _mm_loadu_si128((const __m128i*)(block + i));
+            // [ and ] are { and } with bit 5 cleared
+            const __m128i lower = _mm_or_si128(b, _mm_set1_epi8(0x20));
+            const __m128i op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                _mm_or_si128(_mm_cmpeq_epi8(b,     _mm_set1_epi8(':')), _mm_cmpeq_epi8(b,     _mm_set1_epi8(','))));
+            const __m128i ws = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(b, _mm_set1_epi8(' ')),  _mm_cmpeq_epi8(b, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(b, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(b, _mm_set1_epi8('\r'))));
+            out.quote      |= (u64)(u16)_mm_movemask_epi8(_mm_cmpeq_epi8(b, _mm_set1_epi8('"')))  << i;
+            out.backslash  |= (u64)(u16)_mm_movemask_epi8(_mm_cmpeq_epi8(b, _mm_set1_epi8('\\'))) << i;
+            out.op         |= (u64)(u16)_mm_movemask_epi8(op) << i;
+            out.whitespace |= (u64)(u16)_mm_movemask_epi8(ws) << i;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void JsonIndexer::ClassifyAvx2(const char* block, Masks& out) {
+        out = {};
+        for (u32 i = 0; i < 64; i += 32) {
+            const __m256i b = _mm256_loadu_si256((const __m256i*)(block + i));
+            const __m256i lower = _mm256_or_si256(b, _mm256_set1_epi8(0x20));
+            const __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(b,     _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(b,     _mm256_set1_epi8(','))));
+            const __m256i ws = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(b, _mm256_set1_epi8(' ')),  _mm256_cmpeq_epi8(b, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(b, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(b, _mm256_set1_epi8('\r'))));
+            out.quote      |= (u64)(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, _mm256_set1_epi8('"')))  << i;
+            out.backslash  |= (u64)(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, _mm256_set1_epi8('\\'))) << i;
+            out.op         |= (u64)(u32)_mm256_movemask_epi8(op) << i;
+            out.whitespace |= (u64)(u32)_mm256_movemask_epi8(ws) << i;
+        }
+    }
+
+    JsonIndexer::Level JsonIndexer::BestLevel() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? AVX2 : SSE2;
+    }
+
+    void JsonIndexer::UseLevel(Level level) {
+        switch (std::min(level, BestLevel())) {
+            case AVX2:   active = { AVX2,   ClassifyAvx2 };   break;
+            case SSE2:   active = { SSE2,   ClassifySse2 };   break;
+            case SCALAR:
+            default:     active = { SCALAR, ClassifyScalar }; break;
+        }
+    }
+#else
+    JsonIndexer::Level JsonIndexer::BestLevel() { return SCALAR; }
+    void JsonIndexer::UseLevel(Level) {}
+#endif
+
+    Str JsonIndexer::LevelName(Level level) {
+        switch (level) {
+            case AVX2: return "AVX2";
+            case SSE2: return "SSE2";
+            case SCALAR:
+            default:   return "Scalar";
+        }
+    }
+
+    const bool JsonIndexer::DETECTED = (UseLevel(BestLevel()), true);
+
+    bool JsonIndexer::Index(Str json, Vec<u32>& out) {
+        // see https://arxiv.org/abs/1902.08318, everything below is branchless per block
+        static constexpr u64 EVEN = 0x5555555555555555;
+        const auto prefixXor = [] (u64 x) {
+            x ^= x << 1; x ^= x << 2; x ^= x << 4; x ^= x << 8; x ^= x << 16; x ^= x << 32;
+            return x;
+        };
+
+        const char* data = json.Data();
+        const usize len = json.Length();
+        u64 prevEscaped = 0, prevInString = 0, prevScalar = 0;
+        for (usize i = 0; i < len; i += 64) {
+            char padded[64];
+            const char* block = data + i;
+            if (len - i < 64) {
+                // spaces dont show up as anything
+                Memory::MemSet(padded, ' ', sizeof(padded));
+                Memory::MemCopyNoOverlap(padded, block, len - i);
+                block = padded;
+            }
+            Masks m;
+            active.classify(block, m);
+
+            // a backslash escapes the next byte if it starts an odd length run. runs on odd bits
+            // carry into the next even bit when added, which flips which bits count as escaped
+            const u64 backslash = m.backslash & ~prevEscaped;
+            const u64 followsEscape = backslash << 1 | prevEscaped;
+            const u64 oddStarts = backslash & ~EVEN & ~followsEscape;
+            u64 evenSequences;
+            prevEscaped = __builtin_add_overflow(oddStarts, backslash, &evenSequences);
+            const u64 escaped = (EVEN ^ (evenSequences << 1)) & followsEscape;
+
+            // opening quotes are inside the string, closing ones arent
+            const u64 quote = m.quote & ~escaped;
+            const u64 inString = prefixXor(quote) ^ prevInString;
+            prevInString = (u64)((i64)inString >> 63);
+
+            const u64 scalar = ~(m.op | m.whitespace | m.quote | inString);
+            const u64 scalarStarts = scalar & ~(scalar << 1 | prevScalar);
+            prevScalar = scalar >> 63;
+
+            u64 structural = (m.op & ~inString) | (quote & inString) | scalarStarts;
+            out.TryGrow(64);
+            u32* write = out.Data() + out.Length();
+            for (; structural; structural &= structural - 1)
+                *write++ = (u32)(i + std::countr_zero(structural));
+            out.SetLengthUnsafe(write - out.Data());
+        }
+        return prevInString == 0;
+    }
+
+    u32 JsonDocument::Next(u32 i) const {
+        switch (TagAt(i)) {
+            case '{': case '[':           return (u32)PayloadAt(i);
+            case '"': case 'l': case 'd': return i + 2;
+            default:                      return i + 1;
+        }
+    }
+
+    Str JsonDocument::StrAt(u32 i) const {
+        return Str::Slice(strings.Data() + PayloadAt(i), tape[i + 1]);
+    }
+
+    JsonValue::Type JsonValue::GetType() const {
+        switch (doc->TagAt(index)) {
+            case 't': case 'f': return BOOL;
+            case 'l':           return INT;
+            case 'd':           return FLOAT;
+            case '"':           return STRING;
+            case '[':           return ARRAY;
+            case '{':           return OBJECT;
+            case 'n':
+            default:            return NUL;
+        }
+    }
+
+    Option<bool> JsonValue::AsBool() const {
+        switch (doc->TagAt(index)) {
+            case 't': return true;
+            case 'f': return false;
+            default:  return nullptr;
+        }
+    }
+
+    Option<i64> JsonValue::AsInt() const {
+        if (doc->TagAt(index) != 'l') return nullptr;
+        return (i64)doc->tape[index + 1];
+    }
+
+    Option<f64> JsonValue::AsFloat() const {
+        switch (doc->TagAt(index)) {
+            case 'd': return std::bit_cast<f64>(doc->tape[index + 1]);
+            case 'l': return (f64)(i64)doc->tape[index + 1];
+            default:  return nullptr;
+        }
+    }
+
+    Option<Str> JsonValue::AsStr() const {
+        if (doc->TagAt(index) != '"') return nullptr;
+        return doc->StrAt(index);
+    }
+
+    usize JsonValue::Length() const {
+        const char tag = doc->TagAt(index);
+        if (tag != '[' && tag != '{') return 0;
+        const usize count = doc->PayloadAt(index) >> 32;
+        if (count < JsonDocument::MAX_COUNT) return count;
+        // too many to fit in the tape, count them by hand
+        usize n = 0;
+        if (tag == '[') for ([[maybe_unused]] const JsonValue _ : Elements()) ++n;
+        else            for ([[maybe_unused]] const JsonMember _ : Members()) ++n;
+        return n;
+    }
+
+    Option<JsonValue> JsonValue::Get(Str key) const {
+        for (const JsonMember member : Members())
+            if (member.key == key) return member.value;
+        return nullptr;
+    }
+
+    Option<JsonValue> JsonValue::At(usize i) const {
+        for (const JsonValue element : Elements()) {
+            if (i == 0) return element;
+            --i;
+        }
+        return nullptr;
+    }
+
+    JsonArrayIter JsonValue::Elements() const {
+        if (doc->TagAt(index) != '[') return { doc, 0, 0 };
+        return { doc, index + 1, (u32)doc->PayloadAt(index) - 1 };
+    }
+
+    JsonObjectIter JsonValue::Members() const {
+        if (doc->TagAt(index) != '{') return { doc, 0, 0 };
+        return { doc, index + 1, (u32)doc->PayloadAt(index) - 1 };
+    }
+
+    Option<JsonDocument> JsonParser::Parse(Str source) {
+        if (source.StartsWith("\xEF\xBB\xBF")) source.Advance(3);
+        json = source;
+        next = 0;
+        error = Str::Empty();
+        errorOffset = 0;
+        structurals.Clear();
+
+        if (source.Length() > (usize)u32s::MAX) { Fail("json is over 4 GiB", 0); return nullptr; }
+        // about one structural every 8 bytes in practice
+        structurals.Reserve(source.Length() / 8 + 64);
+        if (!JsonIndexer::Index(source, structurals)) { Fail("unterminated string", source.Length()); return nullptr; }
+
+        JsonDocument document;
+        document.tape.Reserve(structurals.Length() + 16);
+        doc = &document;
+        const bool ok = ParseValue(0) &&
+            (next == structurals.Length() || Fail("unexpected data after the root value", structurals[next]));
+        doc = nullptr;
+        if (!ok) return nullptr;
+        return document;
+    }
+
+    const char* JsonParser::TokenEnd() const {
+        const char* end = json.Data() + OffsetAt(next);
+        while (end > json.Data() && IsSpace(end[-1])) --end;
+        return end;
+    }
+
+    bool JsonParser::ParseValue(u32 depth) {
+        if (next >= structurals.Length()) return Fail("unexpected end of json", json.Length());
+        const u32 offset = structurals[next++];
+        switch (json[offset]) {
+            case '{': return ParseContainer(offset, depth, true);
+            case '[': return ParseContainer(offset, depth, false);
+            case '"': return ParseString(offset);
+            case 't': return ParseLiteral(offset, "true",  't');
+            case 'f': return ParseLiteral(offset, "false", 'f');
+            case 'n': return ParseLiteral(offset, "null",  'n');
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                return ParseNumber(offset);
+            default:  return Fail("unexpected character", offset);
+        }
+    }
+
+    bool JsonParser::ParseContainer(u32 offset, u32 depth, bool isObject) {
+        if (depth >= MAX_DEPTH) return Fail("json is nested too deep", offset);
+        const char close = isObject ? '}' : ']';
+        Vec<u64>& tape = doc->tape;
+        const usize open = tape.Length();
+        tape.Push(0); // filled in once the end is known
+
+        u64 count = 0;
+        if (Peek() == close) ++next;
+        else while (true) {
+            if (isObject) {
+                if (Peek() != '"') return Fail("expected a key", OffsetAt(next));
+                if (!ParseString(structurals[next++])) return false;
+                if (Peek() != ':') return Fail("expected ':' after a key", OffsetAt(next));
+                ++next;
+            }
+            if (!ParseValue(depth + 1)) return false;
+            ++count;
+
+            const char c = Peek();
+            if (c == ',') { ++next; continue; }
+            if (c == close) { ++next; break; }
+            return Fail(isObject ? "expected ',' or '}'" : "expected ',' or ']'", OffsetAt(next));
+        }
+
+        tape.Push(JsonDocument::Entry(close, open));
+        tape[open] = JsonDocument::Entry(isObject ? '{' : '[', tape.Length() | std::min(count, JsonDocument::MAX_COUNT) << 32);
+        return true;
+    }
+
+    bool JsonParser::ParseString(u32 offset) {
+        // the closing quote is the last thing before the next structural, so its found without scanning
+        const char* const begin = json.Data() + offset + 1, *const close = TokenEnd() - 1;
+        if (close < begin || *close != '"') return Fail("unterminated string", offset);
+
+        Vec<char>& strings = doc->strings;
+        const usize start = strings.Length();
+        const char* p = begin;
+        while (true) {
+            const usize stop = ByteSearch::FindChar(Str::Slice(p, close - p), '\\');
+            strings.Extend(Span<const char>::Slice(p, stop));
+            p += stop;
+            if (p == close) break;
+            if (!Unescape(++p, close)) return false;
+        }
+
+        doc->tape.Push(JsonDocument::Entry('"', start));
+        doc->tape.Push(strings.Length() - start);
+        return true;
+    }
+
+    bool JsonParser::Unescape(const char*& p, const char* end) {
+        Vec<char>& strings = doc->strings;
+        const usize offset = p - json.Data() - 1;
+        const auto readHex4 = [&] (const char* hex) -> Option<u32> {
+            if (end - hex < 4) return nullptr;
+            u32 code = 0;
+            for (u32 i = 0; i < 4; ++i) {
+                const Option<u32> digit = Chr::TryToHexDigit(hex[i]);
+                if (!digit) return nullptr;
+                code = code << 4 | *digit;
+            }
+            return code;
+        };
+
+        if (p == end) return Fail("invalid escape", offset);
+        switch (const char e = *p++) {
+            case '"': case '\\': case '/': strings.Push(e); return true;
+            case 'b': strings.Push('\b'); return true;
+            case 'f': strings.Push('\f'); return true;
+            case 'n': strings.Push('\n'); return true;
+            case 'r': strings.Push('\r'); return true;
+            case 't': strings.Push('\t'); return true;
+            case 'u': break;
+            default:  return Fail("invalid escape", offset);
+        }
+
+        const Option<u32> unit = readHex4(p);
+        if (!unit) return Fail("invalid unicode escape", offset);
+        p += 4;
+        u32 code = *unit;
+        if (code >= 0xD800 && code < 0xDC00) {
+            // a high surrogate has to be followed by a low one
+            const Option<u32> low = end - p >= 2 && p[0] == '\\' && p[1] == 'u' ? readHex4(p + 2) : nullptr;
+            if (!low || *low < 0xDC00 || *low >= 0xE000) return Fail("unpaired surrogate", offset);
+            p += 6;
+            code = 0x10000 + ((code - 0xD800) << 10) + (*low - 0xDC00);
+        } else if (code >= 0xDC00 && code < 0xE000) return Fail("unpaired surrogate", offset);
+
+        if (code < 0x80) strings.Push((char)code);
+        else if (code < 0x800) {
+            strings.Push((char)(0xC0 | code >> 6));
+            strings.Push((char)(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            strings.Push((char)(0xE0 | code >> 12));
+            strings.Push((char)(0x80 | (code >> 6 & 0x3F)));
+            strings.Push((char)(0x80 | (code & 0x3F)));
+        } else {
+            strings.Push((char)(0xF0 | code >> 18));
+            strings.Push((char)(0x80 | (code >> 12 & 0x3F)));
+            strings.Push((char)(0x80 | (code >> 6 & 0x3F)));
+            strings.Push((char)(0x80 | (code & 0x3F)));
+        }
+        return true;
+    }
+
+    bool JsonParser::ParseNumber(u32 offset) {
+        const char* const begin = json.Data() + offset, *const end = TokenEnd();
+        const auto isDigit = [] (char c) { return (u8)(c - '0') < 10; };
+        const char* p = begin;
+        const bool negative = *p == '-';
+        p += negative;
+
+        // json is stricter than the number parsers: no leading zeros, and digits on both sides of the dot.
+        // the integer part is accumulated on the way, it's exact up to 19 digits
+        const char* const intStart = p;
+        u64 magnitude = 0;
+        for (; p != end && isDigit(*p); ++p) magnitude = magnitude * 10 + (u64)(*p - '0');
+        const usize intDigits = p - intStart;
+        bool valid = intDigits && !(*intStart == '0' && intDigits > 1), isInt = true;
+        if (valid && p != end && *p == '.') {
+            const char* const fracStart = ++p;
+            while (p != end && isDigit(*p)) ++p;
+            valid = p != fracStart;
+            isInt = false;
+        }
+        if (valid && p != end && (*p | 0x20) == 'e') {
+            p += p + 1 != end && (p[1] == '+' || p[1] == '-') ? 2 : 1;
+            const char* const expStart = p;
+            while (p != end && isDigit(*p)) ++p;
+            valid = p != expStart;
+            isInt = false;
+        }
+        if (!valid || p != end) return Fail("invalid number", offset);
+
+        Vec<u64>& tape = doc->tape;
+        // integers stay exact as long as they fit, everything else becomes a double
+        if (isInt && intDigits <= 19 && magnitude <= (u64)i64s::MAX + negative) {
+            tape.Push(JsonDocument::Entry('l', 0));
+            tape.Push(negative ? 0 - magnitude : magnitude);
+            return true;
+        }
+
+        f64 value;
+        NumberConversion::FloatConv<f64>::ParseUntil(Str::Slice(begin, end - begin), value, {});
+        tape.Push(JsonDocument::Entry('d', 0));
+        tape.Push(std::bit_cast<u64>(value));
+        return true;
+    }
+
+    bool JsonParser::ParseLiteral(u32 offset, Str literal, char tag) {
+        const char* const begin = json.Data() + offset;
+        if (Str::Slice(begin, TokenEnd() - begin) != literal)
+            return Fail("unexpected character", offset);
+        doc->tape.Push(JsonDocument::Entry(tag, 0));
+        return true;
+    }
+}
@@ -0,0 +1,174 @@
+#pragma once
+#include "Utils/Iterator.h"
+#include "Utils/String.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Text {
+    // stage 1 of parsing json: the offset of every structural character ({}[]:,) outside of strings,
+    // every opening quote and the first byte of every number or literal, in order.
+    // 64 bytes are classified at a time with the widest simd the cpu supports, same as ByteSearch
+    struct JsonIndexer {
+        enum Level { SCALAR, SSE2, AVX2 };
+
+        // appends to out, false if a string never closes. offsets are u32, so json is limited to 4 GiB
+        static bool Index(Str json, Vec<u32>& out);
+
+        static Level BestLevel();
+        static Level CurrentLevel() { return active.level; }
+        // clamped to what the cpu supports, mostly for benchmarking
+        static void  UseLevel(Level level);
+        static Str   LevelName(Level level);
+    private:
+        // one bit per byte of a 64 byte block
+        struct Masks { u64 quote, backslash, op, whitespace; };
+        struct Kernels {
+            Level level;
+            void (*classify)(const char* block, Masks& out);
+        };
+
+        static void ClassifyScalar(const char* block, Masks& out);
+        // only defined on x86
+        static void ClassifySse2  (const char* block, Masks& out);
+        static void ClassifyAvx2  (const char* block, Masks& out);
+
+        inline static constinit Kernels active = { SCALAR, ClassifyScalar };
+        static const bool DETECTED;
+    };
+
+    class JsonDocument;
+    struct JsonMember;
+    struct JsonArrayIter;
+    struct JsonObjectIter;
+
+    // a cursor into a parsed document. cheap to copy, and only valid while its document lives
+    struct JsonValue {
+        enum Type { NUL, BOOL, INT, FLOAT, STRING, ARRAY, OBJECT };
+
+        const JsonDocument* doc;
+        u32 index;
+
+        Type GetType() const;
+        bool IsNull()   const { return GetType() == NUL; }
+        bool IsArray()  const { return GetType() == ARRAY; }
+        bool IsObject() const { return GetType() == OBJECT; }
+
+        Option<bool> AsBool()  const;
+        Option<i64>  AsInt()   const;
+        // ints convert too
+        Option<f64>  AsFloat() const;
+        // points into the document
+        Option<Str>  AsStr()   const;
+
+        // elements of an array or members of an object, 0 for anything else
+        usize Length() const;
+        // these walk the tape, containers are skipped over whole
+        Option<JsonValue> Get(Str key) const;
+        Option<JsonValue> At(usize i) const;
+        JsonArrayIter  Elements() const;
+        JsonObjectIter Members() const;
+    };
+
+    struct JsonMember {
+        Str key;
+        JsonValue value;
+    };
+
+    // the parsed document as a tape of u64s: a tag in the top byte, and a payload below it.
+    //   { [   payload is the index right after the matching } ], and the element count above bit 32
+    //   } ]   payload is the index of the matching { [
+    //   "     payload is the offset into strings, the next word is the length
+    //   l d   the next word is the i64 or the f64's bits
+    //   t f n no payload
+    class JsonDocument {
+        Vec<u64> tape;
+        Vec<char> strings;
+
+        friend class JsonParser;
+        friend struct JsonValue;
+        friend struct JsonArrayIter;
+        friend struct JsonObjectIter;
+
+        static constexpr u32 TAG_SHIFT = 56;
+        static constexpr u64 PAYLOAD_MASK = (1ull << TAG_SHIFT) - 1;
+        // counts past this are still right, just slow to get
+        static constexpr u64 MAX_COUNT = (1 << 24) - 1;
+        static constexpr u64 Entry(char tag, u64 payload) { return (u64)(u8)tag << TAG_SHIFT | payload; }
+
+        char TagAt(u32 i) const { return (char)(tape[i] >> TAG_SHIFT); }
+        u64 PayloadAt(u32 i) const { return tape[i] & PAYLOAD_MASK; }
+        Str StrAt(u32 i) const;
+        // the index of the value after this one
+        u32 Next(u32 i) const;
+    public:
+        JsonDocument() = default;
+
+        JsonValue Root() const { return { this, 0 }; }
+        usize TapeLength() const { return tape.Length(); }
+    };
+
+    struct JsonArrayIter : IIterator<const JsonValue, JsonArrayIter> {
+        using Item = const JsonValue;
+        friend IIterator;
+    private:
+        const JsonDocument* doc;
+        u32 at, stop;
+    public:
+        JsonArrayIter(const JsonDocument* doc, u32 at, u32 stop) : doc(doc), at(at), stop(stop) {}
+    protected:
+        JsonValue CurrentImpl() const { return { doc, at }; }
+        void AdvanceImpl() { at = doc->Next(at); }
+        bool CanNextImpl() const { return at < stop; }
+    };
+
+    struct JsonObjectIter : IIterator<const JsonMember, JsonObjectIter> {
+        using Item = const JsonMember;
+        friend IIterator;
+    private:
+        const JsonDocument* doc;
+        u32 at, stop;
+    public:
+        JsonObjectIter(const JsonDocument* doc, u32 at, u32 stop) : doc(doc), at(at), stop(stop) {}
+    protected:
+        JsonMember CurrentImpl() const { return { doc->StrAt(at), { doc, at + 2 } }; }
+        void AdvanceImpl() { at = doc->Next(at + 2); }
+        bool CanNextImpl() const { return at < stop; }
+    };
+
+    // stage 2: walks the structural index and writes the tape, unescaping strings and parsing numbers on the way.
+    // keeps its buffers around, so reusing one parser for many files doesnt reallocate
+    class JsonParser {
+    public:
+        static constexpr u32 MAX_DEPTH = 1024;
+    private:
+        Vec<u32> structurals;
+        usize next = 0;
+        Str json;
+        JsonDocument* doc = nullptr;
+
+        Str error;
+        usize errorOffset = 0;
+
+        char Peek() const { return next < structurals.Length() ? json[structurals[next]] : '\0'; }
+        usize OffsetAt(usize i) const { return i < structurals.Length() ? structurals[i] : json.Length(); }
+        static bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+        // where the token before the next structural ends, without trailing whitespace
+        const char* TokenEnd() const;
+        bool Fail(Str message, usize offset) { error = message; errorOffset = offset; return false; }
+
+        bool ParseValue(u32 depth);
+        bool ParseContainer(u32 offset, u32 depth, bool isObject);
+        bool ParseString(u32 offset);
+        bool ParseNumber(u32 offset);
+        bool ParseLiteral(u32 offset, Str literal, char tag);
+        // right after a backslash, moves p past the escape
+        bool Unescape(const char*& p, const char* end);
+    public:
+        JsonParser() = default;
+
+        // null on invalid json, see Error and ErrorOffset. a leading byte order mark is skipped
+        Option<JsonDocument> Parse(Str source);
+
+        Str Error() const { return error; }
+        usize ErrorOffset() const { return errorOffset; }
+    };
+}
@@ -1,7 +1,13 @@
 #include "Num.h"
 
+#include "Pow10Table.h"
+#include "Utils/Bitwise.h"
 #include "Utils/Debug/Logger.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace Quasi::Text {
     u32 NumberConversion::Add4Bytes(u32 a, u32 b) {
         static constexpr u32 EVEN_BYTES = 0xFF00FF00, ODD_BYTES = 0x00FF00FF;
@@ -287,27 +293,20 @@ namespace Quasi::Text {
 
     template <Floating F>
     OptionUsize NumberConversion::ParseNanOrInf(Str string, Out<F&> out) {
-        // utilizes u64s to optimize string comparisons
+        // utilizes u64s to optimize string comparisons, clearing bit 5 uppercases letters
         constexpr u64 CLEAR_CASE = 0xDFDFDFDFDFDFDFDF;
         if (string.Length() < 3) return nullptr;
-        if (string.Length() < 8) {
-            u64 first3 = string[0] << 16 | string[1] << 8 | string[0];
-            first3 &= CLEAR_CASE;
-            if (first3 == "INF"_u64) {
-                out = Math::Infinity;
-            } else if (first3 == "NAN"_u64) {
-                out = Math::NaN;
-            } else return nullptr;
-            return 3;
-        } else {
-            u64 first8 = Memory::ReadU64Big(string.Data());
-            first8 &= CLEAR_CASE;
-            if (first8 == "INFINITY"_u64) {
-                out = Math::Infinity;
-                return 8;
-            }
+        if (string.Length() >= 8 && (Memory::ReadU64Big(string.Data()) & CLEAR_CASE) == "INFINITY"_u64) {
+            out = Math::Infinity;
+            return 8;
         }
-        return nullptr;
+        const u64 first3 = ((u64)(u8)string[0] << 16 | (u64)(u8)string[1] << 8 | (u64)(u8)string[2]) & CLEAR_CASE;
+        if (first3 == "INF"_u64) {
+            out = Math::Infinity;
+        } else if (first3 == "NAN"_u64) {
+            out = Math::NaN;
+        } else return nullptr;
+        return 3;
     }
 
     template OptionUsize NumberConversion::ParseNanOrInf<f32>(Str string, Out<f32&> out);
@@ -411,7 +410,10 @@ namespace Quasi::Text {
                 len = u32s::Log10(skip8) + 1;
                 skip8 = U64ToBCD8(skip8);
                 skip8 |= 0x3030303030303030;
-                Memory::MemCopyNoOverlap(out, ((const char*)&skip8) + 8 - len, len);
+                // the digits are only in order when written big endian
+                char digits[8];
+                Memory::WriteU64Big(skip8, digits);
+                Memory::MemCopyNoOverlap(out, digits + 8 - len, len);
                 out += len;
             }
 
@@ -425,7 +427,9 @@ namespace Quasi::Text {
         x = U64ToBCD8(x);
         x |= 0x3030303030303030;
 
-        Memory::MemCopyNoOverlap(out, ((const char*)&x) + 8 - len, len);
+        char digits[8];
+        Memory::WriteU64Big(x, digits);
+        Memory::MemCopyNoOverlap(out, digits + 8 - len, len);
         return len;
     }
 
@@ -460,10 +464,12 @@ namespace Quasi::Text {
         }
 
         sw.WriteRepeat(options.pad, padLen - right);
-        sw.WriteRepeat(options.shouldPadZero ? '0' : ' ', targetnLen - nlen);
-
+        // zeros go between the sign and the digits, spaces before the sign
+        const u32 numPad = targetnLen - nlen - (sign != '\0');
+        if (!options.shouldPadZero) sw.WriteRepeat(' ', numPad);
         if (sign)
             sw.Write(sign);
+        if (options.shouldPadZero) sw.WriteRepeat('0', numPad);
 
         switch (options.base) {
             case IntFormatter::FormatOptions::DECIMAL: WriteU64Decimal(sw, num);          break;
@@ -545,206 +551,260 @@ namespace Quasi::Text {
         sw.Write(Str::Slice(strbuf + (u64s::BITS / 4) - hexDigits, hexDigits));
     }
 
-    char* NumberConversion::AddSign(f64 f, char* out, bool alwaysShowSign) {
-        if (f < 0) {
-            *out = '-';
-            return ++out;
-        }
-        if (alwaysShowSign) {
-            *out = '+';
-            return ++out;
-        }
-        return out;
-    }
-
-    char* NumberConversion::WriteFltDecimal(f64 f, char* out, u32 precision) {
-        if (precision == ~0) {
-            // builtin 3-digit max precision
-            u32 dig3 = f64s::FastToIntUnsigned(f * 1000);
-            if (dig3 == 0) {
-                return out;
-            } else {
-                dig3 = U64ToBCD4(dig3);
-                const u32 empty = u32s::CountRightZeros(dig3) / 8;
-                dig3 <<= 8;
-                dig3 |= 0x30'30'30'00;
-                *out++ = '.';
-                Memory::WriteU32Big(dig3, out);
-                out += 3 - empty;
-            }
+    NumberConversion::DecimalFloat NumberConversion::Schubfach(u64 c, i32 q, bool lowerBoundaryCloser) {
+        DecimalFloat d;
+        if (q <= 0 && -q < 64 && (c & ((1ULL << -q) - 1)) == 0) {
+            // small integers are already exact
+            d = { c >> -q, 0 };
         } else {
-            *out++ = '.';
-            u32 p = 0;
-            for (; p < precision; p += 2) {
-                f64 dig2;
-                f64s::SeparateDecimal(f * 100, dig2, f);
-
-                u32 i = (u32)f64s::FloorToIntUnsigned(f);
-                i = U64ToBCD2(i);
-                Memory::WriteU16Big(i | 0x3030, out);
-                out += 2;
+            // floor(log10(2^e)), floor(log10(3/4 * 2^e)) and floor(log2(10^e)), exact for anything a double can hold
+            const auto floorLog10Pow2             = [] (i32 e) { return (e * 1262611) >> 22; };
+            const auto floorLog10ThreeQuatersPow2 = [] (i32 e) { return (e * 1262611 - 524031) >> 22; };
+            const auto floorLog2Pow10             = [] (i32 e) { return (e * 1741647) >> 19; };
+            // g * cp / 2^128, rounded to odd so the bits cut off still count when comparing against the bounds
+            const auto roundToOdd = [] (const u64 (&g)[2], u64 cp) {
+                u64 x0, y0;
+                const u64 x1 = Bitwise::Mul128(g[1], cp, x0), y1 = Bitwise::Mul128(g[0], cp, y0);
+                const u64 z = y0 + x1;
+                return (y1 + (z < y0)) | (z > 1);
+            };
+
+            // everything is scaled by 4 so the bounds halfway to the neighboring floats are integers
+            const u64 cbl = 4 * c - 2 + lowerBoundaryCloser, cb = 4 * c, cbr = 4 * c + 2;
+            const i32 k = lowerBoundaryCloser ? floorLog10ThreeQuatersPow2(q) : floorLog10Pow2(q);
+            const i32 h = q + floorLog2Pow10(-k) + 1;
+            const u64 (&g)[2] = POW10_128[-k - POW10_MIN];
+            const u64 vbl = roundToOdd(g, cbl << h), vb = roundToOdd(g, cb << h), vbr = roundToOdd(g, cbr << h);
+            // round to even, so the bounds only count when c is even
+            const bool isEven = (c & 1) == 0;
+            const u64 lower = vbl + !isEven, upper = vbr - !isEven;
+
+            const u64 s = vb / 4;
+            d = { 0, k };
+            if (s >= 10) {
+                // try one digit less first
+                const u64 sp = s / 10;
+                const bool upInside = lower <= 40 * sp, wpInside = 40 * sp + 40 <= upper;
+                if (upInside != wpInside) d = { sp + wpInside, k + 1 };
             }
-            if (p < precision) {
-                *out++ = (char)(0x30 | f64s::FloorToIntUnsigned(f * 10));
+            if (!d.digits) {
+                const bool uInside = lower <= 4 * s, wInside = 4 * s + 4 <= upper;
+                if (uInside != wInside) d.digits = s + wInside;
+                else {
+                    // both or neither fit, take the closer one
+                    const u64 mid = 4 * s + 2;
+                    d.digits = s + (vb > mid || (vb == mid && (s & 1)));
+                }
             }
         }
-        return out;
+
+        // still shortest, but it can end in zeros
+        while (d.digits % 10 == 0) { d.digits /= 10; ++d.exponent; }
+        return d;
     }
 
-    char* NumberConversion::WriteFltSci(f64 f, char* out, u32 precision, char e, int log10) {
-        if (f == 0) {
-            if (precision == ~0) {
-                *out++ = '0';
-                return out;
-            }
-            Memory::WriteU16(".0"_u16, out);
-            out += 2;
-            while (precision --> 0)
-                *out++ = '0';
-            return out;
-        }
+    NumberConversion::DecimalFloat NumberConversion::ShortestDecimal(f32 f) {
+        if (f == 0) return { 0, 0 };
+        const u32 bits = f32s::BitsOf(f), mantissa = bits & f32s::MANTISSA_MASK;
+        const i32 exponent = (i32)(bits >> f32s::MANTISSA_BITS);
+        static constexpr i32 BIAS = 127 + f32s::MANTISSA_BITS;
+        return exponent ?
+            Schubfach(mantissa | (1u << f32s::MANTISSA_BITS), exponent - BIAS, mantissa == 0 && exponent > 1) :
+            Schubfach(mantissa, 1 - BIAS, false);
+    }
 
-        f64 mant, mantDec;
+    NumberConversion::DecimalFloat NumberConversion::ShortestDecimal(f64 f) {
+        if (f == 0) return { 0, 0 };
+        const u64 bits = f64s::BitsOf(f), mantissa = bits & f64s::MANTISSA_MASK;
+        const i32 exponent = (i32)(bits >> f64s::MANTISSA_BITS);
+        static constexpr i32 BIAS = 1023 + f64s::MANTISSA_BITS;
+        return exponent ?
+            Schubfach(mantissa | (1ULL << f64s::MANTISSA_BITS), exponent - BIAS, mantissa == 0 && exponent > 1) :
+            Schubfach(mantissa, 1 - BIAS, false);
+    }
 
-        if (log10 == i32s::MIN) {
-            f64 ilog;
-            f64s::SeparateDecimal(f64s::Log10(f), ilog, mant);
-            mant = f64s::Exp10(mant);
-        } else {
-            mant = f * f64s::Exp10(-log10);
+    void NumberConversion::ExactDecimal(BigDecimal& out, u64 c, i32 q) {
+        out.count = 0;
+        out.truncated = false;
+        char digits[u64s::DIGITS];
+        const u32 len = c ? U64FullToString(c, digits) : 0;
+        for (u32 i = 0; i < len; ++i) out.Push((u8)(digits[i] - '0'));
+        out.point = (i32)len;
+        out.Trim();
+        out.Shift(q);
+    }
+
+    void NumberConversion::RoundDigits(BigDecimal& d, i32 keep) {
+        if (keep >= d.count) return;
+        if (keep < 0) { d.count = 0; d.point = 0; return; }
+        // the digits are trimmed, so anything after the 5 means its past halfway
+        const u8 next = d.digits[keep];
+        const bool roundUp = next > 5 ||
+            (next == 5 && (keep + 1 < d.count || d.truncated || (keep > 0 && d.digits[keep - 1] % 2 == 1)));
+        d.count = keep;
+        if (roundUp) {
+            i32 i = keep - 1;
+            while (i >= 0 && d.digits[i] == 9) --i;
+            if (i < 0) { d.digits[0] = 1; d.count = 1; ++d.point; } // all 9s, rounded up to the next power of 10
+            else { ++d.digits[i]; d.count = i + 1; }
         }
-        f64s::SeparateDecimal(mant, mant, mantDec);
-
-        *out = (char)('0' | f64s::FastToIntUnsigned(mant));
-        out = WriteFltDecimal(mantDec, ++out, precision);
-        // ...E+... or ...E-...
-        Memory::WriteU16(e << 8 | (log10 < 0 ? '-' : '+'), out);
-        out += 2;
-        log10 = std::abs(log10);
-
-        {
-            u32 eStr = U64ToBCD4(log10);
-            const u32 empty = u32s::CountLeftZeros(eStr) / 8;
-            eStr <<= empty * 8;
-            eStr |= 0x30303030;
-            Memory::MemCopyNoOverlap(out, (const char*)&eStr, 4 - empty);
-            out += 4 - empty;
+        d.Trim();
+    }
+
+    char* NumberConversion::WriteDecimalFxd(char* out, Str digits, i32 exponent, u32 precision) {
+        if (digits.IsEmpty()) { digits = "0"_str; exponent = 0; }
+        const i32 len = (i32)digits.Length();
+        const i32 point = len + exponent; // digits before the decimal point
+        u32 decimals = 0;
+        if (point <= 0) {
+            out[0] = '0';
+            out[1] = '.';
+            Memory::MemSet(out + 2, '0', -point);
+            Memory::MemCopyNoOverlap(out + 2 - point, digits.Data(), len);
+            out += 2 - point + len;
+            decimals = len - point;
+        } else if (point < len) {
+            Memory::MemCopyNoOverlap(out, digits.Data(), point);
+            out[point] = '.';
+            Memory::MemCopyNoOverlap(out + point + 1, digits.Data() + point, len - point);
+            out += len + 1;
+            decimals = len - point;
+        } else {
+            Memory::MemCopyNoOverlap(out, digits.Data(), len);
+            Memory::MemSet(out + len, '0', point - len);
+            out += point;
         }
 
+        if (precision != ~0 && decimals < precision) {
+            if (!decimals) *out++ = '.';
+            Memory::MemSet(out, '0', precision - decimals);
+            out += precision - decimals;
+        }
         return out;
     }
 
-    char* NumberConversion::WriteFltFxd(f64 f, char* out, u32 width, u32 precision, int log10, char pad) {
-        if (f == 0) {
-            const u32 w = width > 1 ? width - 1 : 0;
-            Memory::MemSet(out, pad, w);
-            out += w;
-            *out++ = '0';
-
-            if (precision == ~0) return out;
-
+    char* NumberConversion::WriteDecimalSci(char* out, Str digits, i32 exponent, u32 precision, char e) {
+        if (digits.IsEmpty()) { digits = "0"_str; exponent = 0; }
+        const u32 len = (u32)digits.Length();
+        *out++ = digits[0];
+        const u32 decimals = precision == ~0 ? len - 1 : precision;
+        if (decimals) {
             *out++ = '.';
-            Memory::MemSet(out, pad, precision);
-
-            return out + precision;
-        } else if (f < 1) { // log will be negative
-            const u32 w = width > 1 ? width - 1 : 0;
-            Memory::MemSet(out, pad, w);
-            out += w;
-            *out++ = '0';
-        } else {
-            log10 = (log10 == i32s::MIN ? (int)f64s::FloorToIntUnsigned(f64s::Log10(f)) : log10) + 1;
+            Memory::MemCopyNoOverlap(out, digits.Data() + 1, len - 1);
+            Memory::MemSet(out + len - 1, '0', decimals - (len - 1));
+            out += decimals;
+        }
 
-            if (log10 < width) {
-                Memory::MemSet(out, pad, width - log10);
-                out += width - log10;
-            }
+        // ...e+... or ...e-...
+        const i32 exp10 = exponent + (i32)len - 1;
+        *out++ = e;
+        *out++ = exp10 < 0 ? '-' : '+';
+        out += U64ToString(std::abs(exp10), out);
+        return out;
+    }
 
-            if (log10 > 4) {
-                f64 frac;
-                f *= f64s::Exp10(-f64s::FastToFloatUnsigned(log10 - 4));
+    usize NumberConversion::FormatDigits(StringWriter sw, Str digits, i32 exponent, bool negative, bool scientific,
+                                         u32 precision, const FloatFormatter::FormatOptions& options) {
+        using enum FloatFormatter::FormatOptions::Mode;
 
-                for (; log10 > 4; log10 -= 4) {
-                    f64s::SeparateDecimal(f, f, frac);
+        const i32 len = std::max((i32)digits.Length(), 1);
+        const i32 point = digits.IsEmpty() ? 1 : len + exponent;
+        // -___.___e+___%
+        const i32 fxdDigits = std::max(point, 1) + 1 + std::max(-point, 0) + len + 1;
+        char* strbuf = Memory::QAlloca$(char, 1 + fxdDigits + (precision == ~0 ? 0 : precision) + 8);
+        char* start = strbuf + 1;
+        char* end = scientific ?
+            WriteDecimalSci(start, digits, exponent, precision, options.mode == SCI_CAP || options.mode == GEN_CAP ? 'E' : 'e') :
+            WriteDecimalFxd(start, digits, exponent, precision);
+        if (options.mode == PERCENTAGE) *end++ = '%';
+
+        const char sign = negative ? '-' : options.showSign ? '+' : '\0';
+        if (options.shouldPadZero) {
+            // zeros go between the sign and the digits
+            const usize numLen = end - start + (sign != '\0');
+            const usize padLen = options.width - std::min<usize>(options.width, numLen);
+            if (sign) sw.Write(sign);
+            sw.WriteRepeat('0', padLen);
+            sw.Write(Str::Slice(start, end - start));
+            return numLen + padLen;
+        }
+        if (sign) *--start = sign;
+        return Formatter<Str>::FormatTo(sw,
+            Str::Slice(start, end - start),
+            { options.width, options.alignment, options.pad, false }
+        );
+    }
 
-                    u32 topDigits = f64s::FastToIntUnsigned(f);
-                    topDigits = U64ToBCD4(topDigits);
-                    topDigits |= 0x30303030;
-                    Memory::WriteU32Big(topDigits, out);
-                    out += 4;
+    usize NumberConversion::FormatDecimal(StringWriter sw, DecimalFloat d, bool negative, const FloatFormatter::FormatOptions& options) {
+        using enum FloatFormatter::FormatOptions::Mode;
 
-                    f = frac * 10000;
-                }
+        if (options.mode == PERCENTAGE && d.digits) d.exponent += 2;
+        char digits[u64s::DIGITS];
+        const i32 len = d.digits ? (i32)U64FullToString(d.digits, digits) : 0;
+        const i32 point = d.digits ? len + d.exponent : 1;
+        bool scientific = false;
+        switch (options.mode) {
+            case SCIENTIFIC: case SCI_CAP: scientific = true; break;
+            case FIXED:
+                // huge and tiny numbers switch over like javascript does
+                scientific = point > 21 || point <= -6;
+                break;
+            case GENERAL: case GEN_CAP: {
+                // whichever is shorter
+                const i32 shown = std::max(len, 1);
+                const i32 fxdLen = point <= 0 ? 2 - point + shown : point < shown ? shown + 1 : point;
+                const i32 sciLen = shown + (shown > 1) + 2 + (point == 1 ? 1 : (i32)u64s::Log10(std::abs(point - 1)) + 1);
+                scientific = sciLen < fxdLen;
+                break;
             }
-            u32 d = f64s::FloorToIntUnsigned(f);
-            d = U64ToBCD4(d);
-            d |= 0x30303030;
-            d <<= (-8 * log10) & 31;
-            d = Memory::ByteSwap32(d);
-            Memory::MemCopyNoOverlap(out, (const char*)&d, log10);
-            out += log10;
-
-            [[maybe_unused]] f64 ignore;
-            f64s::SeparateDecimal(f, ignore, f);
+            default:;
         }
-
-        out = WriteFltDecimal(f, out, precision);
-
-        return out;
+        return FormatDigits(sw, Str::Slice(digits, len), d.exponent, negative, scientific, ~0, options);
     }
 
-    char* NumberConversion::WriteFltGen(f64 f, char* out, u32 width, u32 precision, char e) {
-        const int log = (int)f64s::Log10(f);
-        if (log > (int)width) {
-            return WriteFltSci(f, out, precision, e);
-        } else {
-            return WriteFltFxd(f, out, width, precision, log);
+    usize NumberConversion::FormatExact(StringWriter sw, u64 c, i32 q, bool negative, const FloatFormatter::FormatOptions& options) {
+        using enum FloatFormatter::FormatOptions::Mode;
+
+        BigDecimal d;
+        ExactDecimal(d, c, q);
+        if (options.mode == PERCENTAGE && d.count) d.point += 2;
+        const i32 precision = (i32)options.precision;
+        bool scientific = false;
+        u32 shownPrecision = options.precision;
+        switch (options.mode) {
+            case SCIENTIFIC: case SCI_CAP:
+                RoundDigits(d, precision + 1);
+                scientific = true;
+                break;
+            case GENERAL: case GEN_CAP: {
+                // printf's %g: precision is the significant digits, trailing zeros get cut off
+                const i32 significant = std::max(precision, 1);
+                RoundDigits(d, significant);
+                const i32 exp10 = d.count ? d.point - 1 : 0;
+                scientific = exp10 < -4 || exp10 >= significant;
+                shownPrecision = ~0;
+                break;
+            }
+            default:
+                RoundDigits(d, d.point + precision);
         }
-    }
 
-    usize NumberConversion::FormatFltSci(StringWriter sw, f64 f, const FloatFormatter::FormatOptions& options) {
-        // -_.___E+____
-        // break down:
-        // sign (1)
-        // first digit (1)
-        // decimal point (1)
-        // decimals (options.precision or 3 if none specified (~0)) -> add 4 for ~0
-        // E+ (2)
-        // exponent (max 4)
-        char* strbuf = Memory::QAlloca$(char, 1 + 1 + 1 + (options.precision + 4) + 2 + 4);
-        const char* end = WriteFltSci(
-            std::abs(f),
-            AddSign(f, strbuf, options.showSign),
-            options.precision,
-            options.mode == FloatFormatter::FormatOptions::SCI_CAP ? 'E' : 'e'
-        );
-        return Formatter<Str>::FormatTo(sw,
-            Str::Slice(strbuf, end - strbuf),
-            { options.width, options.alignment, options.pad, false }
-        );
+        char digits[BigDecimal::MAX_DIGITS];
+        for (i32 i = 0; i < d.count; ++i) digits[i] = (char)('0' + d.digits[i]);
+        return FormatDigits(sw, Str::Slice(digits, d.count), d.point - d.count, negative, scientific, shownPrecision, options);
     }
 
-    usize NumberConversion::FormatFltFxd(StringWriter sw, f64 f, const FloatFormatter::FormatOptions& options) {
-        // -___.___
-        // sign (1)
-        // digits (max(log10, width))
-        // decimal point (1)
-        // decimals (~0 -> 3, anything else -> itself)
-        const int log10 = (int)f64s::Log10(std::abs(f));
-        const u32 w = log10 <= 0 ? 1 : (log10 + 1);
-        char* strbuf = Memory::QAlloca$(char, 1 + std::max(w, options.width) + 1 + (options.precision + 4));
-        const char* end = WriteFltFxd(
-            std::abs(f),
-            AddSign(f, strbuf, options.showSign),
-            options.width,
-            options.precision,
-            log10,
-            options.pad
-        );
-        return Formatter<Str>::FormatTo(sw,
-            Str::Slice(strbuf, end - strbuf),
-            { options.width, options.alignment, options.pad, false }
-        );
+    usize NumberConversion::FormatFloating(StringWriter sw, f32 f, const FloatFormatter::FormatOptions& options) {
+        if (!f32s::IsFinite(f)) return FormatFloating(sw, (f64)f, options);
+        const bool negative = f32s::IsSignedNegative(f);
+        if (options.precision == ~0) return FormatDecimal(sw, ShortestDecimal(std::abs(f)), negative, options);
+
+        const u32 bits = f32s::BitsOf(f), mantissa = bits & f32s::MANTISSA_MASK;
+        const i32 exponent = (i32)((bits & ~f32s::SIGN_MASK) >> f32s::MANTISSA_BITS);
+        static constexpr i32 BIAS = 127 + f32s::MANTISSA_BITS;
+        return exponent ?
+            FormatExact(sw, mantissa | (1u << f32s::MANTISSA_BITS), exponent - BIAS, negative, options) :
+            FormatExact(sw, mantissa, 1 - BIAS, negative, options);
     }
 
     usize NumberConversion::FormatFloating(StringWriter sw, f64 f, const FloatFormatter::FormatOptions& options) {
@@ -753,43 +813,29 @@ namespace Quasi::Text {
         static constexpr char NaNString[] = "NaN%",
                               InfString[] = "-Infinity%";
 
-        if (f == Math::NaN) {
+        if (f64s::IsNaN(f)) {
             return Formatter<Str>::FormatTo(sw,
-                Str::Slice(NaNString, 3 + options.mode == PERCENTAGE),
+                Str::Slice(NaNString, 3 + (options.mode == PERCENTAGE)),
                 { options.width, options.alignment, options.pad, false }
             );
         }
         if (f64s::IsInf(f)) {
             const bool isPositive = f > 0;
             return Formatter<Str>::FormatTo(sw,
-                Str::Slice(InfString + isPositive, 9 - isPositive + options.mode == PERCENTAGE),
+                Str::Slice(InfString + isPositive, 9 - isPositive + (options.mode == PERCENTAGE)),
                 { options.width, options.alignment, options.pad, false }
             );
         }
 
-        switch (options.mode) {
-            case SCIENTIFIC:
-            case SCI_CAP:
-                return FormatFltSci(sw, f, options);
-            case FIXED: {
-                return FormatFltFxd(sw, f, options);
-            }
-            case GENERAL:
-            case GEN_CAP: {
-                if (std::abs(f) > f64s::Exp10(options.width) ||
-                    std::abs(f) < f64s::Exp10(-options.precision)) {
-                    FloatFormatter::FormatOptions fopt = options;
-                    fopt.mode = options.mode == GEN_CAP ? SCI_CAP : SCIENTIFIC;
-                    return FormatFltSci(sw, f, fopt);
-                } else {
-                    return FormatFltFxd(sw, f, options);
-                }
-            }
-            case PERCENTAGE: {
-                return FormatFltFxd(sw, f * 100, options);
-            }
-            default: return 0;
-        }
+        const bool negative = f64s::IsSignedNegative(f);
+        if (options.precision == ~0) return FormatDecimal(sw, ShortestDecimal(std::abs(f)), negative, options);
+
+        const u64 bits = f64s::BitsOf(f), mantissa = bits & f64s::MANTISSA_MASK;
+        const i32 exponent = (i32)((bits & ~f64s::SIGN_MASK) >> f64s::MANTISSA_BITS);
+        static constexpr i32 BIAS = 1023 + f64s::MANTISSA_BITS;
+        return exponent ?
+            FormatExact(sw, mantissa | (1ULL << f64s::MANTISSA_BITS), exponent - BIAS, negative, options) :
+            FormatExact(sw, mantissa, 1 - BIAS, negative, options);
     }
 
     usize Formatter<bool>::FormatTo(StringWriter sw, bool input, const FormatOptions& options) {
@@ -961,6 +1007,7 @@ namespace Quasi::Text {
                 case 'f': options.mode = FormatOptions::FIXED;      return options;
                 case 'G': options.mode = FormatOptions::GEN_CAP;    return options;
                 case 'g': options.mode = FormatOptions::GENERAL;    return options;
+                case '%': options.mode = FormatOptions::PERCENTAGE; return options;
                 default: {
                     if (opt.IsEmpty()) return options;
                     // Parse fill and alignment.
@@ -971,9 +1018,9 @@ namespace Quasi::Text {
                     options.alignment = align == '<' ? Align::LEFT : align == '^' ? Align::CENTER : Align::RIGHT;
                     opt.Advance(2);
                 }
-                if (opt.IsEmpty()) return options;
-                c = opt[0];
             }
+            if (opt.IsEmpty()) return options;
+            c = opt[0];
         }
 
         return options;
@@ -996,128 +1043,330 @@ namespace Quasi::Text {
         return nullptr;
     }
 
-    template <class N>
-    OptionUsize NumberConversion::FloatConv<N>::ParseUntil(Str string, Out<N&> out, FloatParser::ParseOptions options) {
-        const bool isFixed = (options.format & FloatParser::ParseOptions::FIXED),
-                   isSci   = (options.format & FloatParser::ParseOptions::SCIENTIFIC);
-
-        bool negative = false, hasSign = true;
-        if (string.StartsWith('+')) string.Advance(1);
-        else if (string.StartsWith('-')) { negative = true; string.Advance(1); }
-        else hasSign = false;
-
-        N num;
-        const usize integerPart = ParseInteger(string, num);
-
-        if (string.Length() == integerPart) {
-            if (isSci)
-                return nullptr;
-            out = negative ? -num : num;
-            return integerPart + hasSign;
+    void NumberConversion::AccumulateDigits(const char*& p, const char* end, u64& w) {
+#ifdef __SSE2__
+        while (end - p >= 16) {
+            // c - '0' < 10 as unsigned, sse2 only has signed compares so everything gets shifted down by 128
+            const __m128i block = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)p), _mm_set1_epi8((char)('0' + 128)));
+            const u32 isDigit = (u32)_mm_movemask_epi8(_mm_cmplt_epi8(block, _mm_set1_epi8(-128 + 10)));
+            const u32 run = std::countr_one(isDigit);
+            u32 i = 0;
+            for (; i + 8 <= run; i += 8) w = w * 100'000'000 + ParseDigits8(Memory::ReadU64(p + i));
+            if (i < run) {
+                // the rest of the run, padded with '0's in front
+                const u32 rest = run - i;
+                const u64 chunk = Memory::ReadU64(p + i) << (64 - 8 * rest) | "00000000"_u64 >> (8 * rest);
+                w = w * Math::POWERS_OF_10[rest] + ParseDigits8(chunk);
+            }
+            p += run;
+            if (run < 16) return;
         }
+#endif
+        for (; end - p >= 8 && AreAllDigits8(Memory::ReadU64(p)); p += 8)
+            w = w * 100'000'000 + ParseDigits8(Memory::ReadU64(p));
+        for (; p != end && Chr::IsDigit(*p); ++p)
+            w = w * 10 + (u64)(*p - '0');
+    }
 
-        usize decimalPart = 0;
-        if (string[integerPart] == '.') {
-            N decimal = 0;
-            decimalPart = ParseDecimal(string.Skip(integerPart + 1), decimal);
-            num += decimal;
+    usize NumberConversion::CountWhitespace(Str text) {
+        const char* p = text.Data(), *const end = p + text.Length();
+#ifdef __SSE2__
+        while (end - p >= 16) {
+            // anything up to ' ' counts, newlines and tabs included
+            const __m128i block = _mm_loadu_si128((const __m128i*)p);
+            const u32 isSpace = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(' ')), block));
+            const u32 run = std::countr_one(isSpace);
+            p += run;
+            if (run < 16) return p - text.Data();
         }
+#endif
+        while (p != end && (u8)*p <= ' ') ++p;
+        return p - text.Data();
+    }
 
-        const usize fixedPart = integerPart + decimalPart + 1;
+    void NumberConversion::BigDecimal::Push(u8 digit) {
+        if (count < MAX_DIGITS) digits[count++] = digit;
+        else truncated |= digit != 0;
+    }
+
+    void NumberConversion::BigDecimal::Trim() {
+        while (count > 0 && digits[count - 1] == 0) --count;
+        if (count == 0) point = 0;
+    }
 
-        if (fixedPart == string.Length()) {
-            out = negative ? -num : num;
-            return string.Length() + hasSign;
+    void NumberConversion::BigDecimal::ShiftLeft(u32 bits) {
+        // written back to front into a scratch buffer, since the digit count only goes up
+        u8 shifted[MAX_DIGITS + 20];
+        usize w = sizeof(shifted);
+        u64 n = 0;
+        for (i32 r = count - 1; r >= 0; --r) {
+            n += (u64)digits[r] << bits;
+            const u64 q = n / 10;
+            shifted[--w] = (u8)(n - q * 10);
+            n = q;
         }
+        for (; n > 0; n /= 10) shifted[--w] = (u8)(n % 10);
+
+        const i32 newCount = (i32)(sizeof(shifted) - w);
+        point += newCount - count;
+        count = std::min(newCount, (i32)MAX_DIGITS);
+        for (usize i = w + count; i < sizeof(shifted); ++i) truncated |= shifted[i] != 0;
+        Memory::MemCopyNoOverlap(digits, shifted + w, count);
+        Trim();
+    }
 
-        if (Chr::ToUpper(string[fixedPart]) == 'E' && isSci) {
-            if (decimalPart == 0) return nullptr;
-            const Str expStr = string.Skip(fixedPart + 1);
-            const OptionUsize expPart = ParseExponent(expStr, num);
-            if (!expPart) return nullptr;
+    void NumberConversion::BigDecimal::ShiftRight(u32 bits) {
+        i32 r = 0, w = 0;
+        u64 n = 0;
+        // enough leading digits to have something left after the shift
+        for (; (n >> bits) == 0; ++r) {
+            if (r >= count) {
+                if (n == 0) { count = 0; return; }
+                while ((n >> bits) == 0) { n *= 10; ++r; }
+                break;
+            }
+            n = n * 10 + digits[r];
+        }
+        point -= r - 1;
 
-            out = negative ? -num : num;
-            return hasSign + fixedPart + 1 + *expPart;
+        const u64 mask = (1ULL << bits) - 1;
+        for (; r < count; ++r) {
+            const u64 next = digits[r];
+            digits[w++] = (u8)(n >> bits);
+            n = (n & mask) * 10 + next;
+        }
+        for (; n > 0; n = (n & mask) * 10) {
+            const u8 d = (u8)(n >> bits);
+            if (w < (i32)MAX_DIGITS) digits[w++] = d;
+            else truncated |= d != 0;
         }
+        count = w;
+        Trim();
+    }
 
-        if (isFixed) return nullptr;
+    void NumberConversion::BigDecimal::Shift(i32 bits) {
+        if (count == 0) return;
+        for (; bits >  (i32)MAX_SHIFT; bits -= MAX_SHIFT) ShiftLeft(MAX_SHIFT);
+        for (; bits < -(i32)MAX_SHIFT; bits += MAX_SHIFT) ShiftRight(MAX_SHIFT);
+        if (bits > 0) ShiftLeft(bits);
+        else if (bits < 0) ShiftRight(-bits);
+    }
 
-        out = negative ? -num : num;
-        return hasSign + fixedPart;
+    u64 NumberConversion::BigDecimal::RoundedInteger() const {
+        if (point > 20) return ~0ULL;
+        u64 n = 0;
+        i32 i = 0;
+        for (; i < point && i < count; ++i) n = n * 10 + digits[i];
+        for (; i < point; ++i) n *= 10;
+        if (point < 0 || point >= count) return n;
+        // exactly halfway rounds to even, unless digits got cut off
+        const bool roundUp = digits[point] == 5 && point + 1 == count ?
+            truncated || (point > 0 && digits[point - 1] % 2 == 1) :
+            digits[point] >= 5;
+        return n + roundUp;
     }
 
-    template <class N>
-    usize NumberConversion::FloatConv<N>::ParseInteger(Str string, Out<N&> out) {
-        string = string.First(string.FindIf([] (Str x) { return !Chr::IsDigit(x[0]); }).UnwrapOr(string.Length()));
-        const usize totalLen = string.Length();
-        string = string.TrimStart('0');
+    u64 NumberConversion::BigDecimal::ToFloatBits(u32 mantissaBits, u32 exponentBits) {
+        const i32 bias = 1 - (1 << (exponentBits - 1)), maxExp = (1 << exponentBits) - 1;
+        const u64 infinity = (u64)maxExp << mantissaBits;
+        if (count == 0 || point < -330) return 0;
+        if (point > 310) return infinity;
 
-        if (string.Length() > NumInfo<N>::MAX_EXP10) {
-            out = Math::Infinity;
-            return totalLen;
+        // scale by powers of 2 until its in [0.5, 1). 10^i >= 2^POW2_STEPS[i]
+        static constexpr u8 POW2_STEPS[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+        i32 exp = 0;
+        while (point > 0) {
+            const i32 n = point >= 9 ? 27 : POW2_STEPS[point];
+            Shift(-n);
+            exp += n;
+        }
+        while (point < 0 || (point == 0 && digits[0] < 5)) {
+            const i32 n = -point >= 9 ? 27 : POW2_STEPS[-point];
+            Shift(n);
+            exp -= n;
         }
 
-        N num = 0;
-        usize i = 0;
-        for (; i < (string.Length() & ~3); i += 4) {
-            u32 dig = Memory::ReadU32(string.Data() + i);
-            dig = ParseDigits4(dig);
-            num = num * N { 10'000 } + dig;
+        // [1, 2) now, and subnormals are shifted down to the smallest exponent
+        --exp;
+        if (exp < bias + 1) {
+            const i32 n = bias + 1 - exp;
+            Shift(-n);
+            exp += n;
         }
-        for (; i < string.Length(); ++i) {
-            num = num * N { 10 } + Chr::ToDigit(string[i]);
+        if (exp - bias >= maxExp) return infinity;
+
+        Shift(1 + mantissaBits);
+        u64 mantissa = RoundedInteger();
+        if (mantissa == 2ULL << mantissaBits) {
+            mantissa >>= 1;
+            if (++exp - bias >= maxExp) return infinity;
         }
-        out = num;
-        return totalLen;
+        if (!(mantissa & (1ULL << mantissaBits))) exp = bias;
+        return (mantissa & ((1ULL << mantissaBits) - 1)) | (u64)(exp - bias) << mantissaBits;
     }
 
     template <class N>
-    usize NumberConversion::FloatConv<N>::ParseDecimal(Str string, InOut<N&> out) {
-        string = string.First(string.FindIf([] (Str x) { return !Chr::IsDigit(x[0]); }).UnwrapOr(string.Length()));
-        const usize totalLen = string.Length();
-        string = string.TrimEnd('0');
-
-        N decimal = 1.0f;
-        usize i = 0;
-        for (; i < (string.Length() & ~3); i += 4) {
-            u32 dig = Memory::ReadU32(string.Data() + i);
-            if (dig == "0000"_u32) continue;
-            dig = ParseDigits4(dig);
-            decimal *= N { 0.0001 };
-            const N newOut = out + decimal * dig;
-            if (newOut == out) return totalLen;
-            out = newOut;
+    OptionUsize NumberConversion::FloatConv<N>::ParseUntil(Str string, Out<N&> out, FloatParser::ParseOptions options) {
+        using Info = NumInfo<N>;
+        const char* const begin = string.Data(), *const end = begin + string.Length();
+        const char* p = begin;
+        const bool negative = p != end && *p == '-';
+        p += p != end && (*p == '-' || *p == '+');
+
+        u64 w = 0;
+        const char* const intStart = p;
+        AccumulateDigits(p, end, w);
+        const char* const intEnd = p, *fracStart = p, *fracEnd = p;
+        if (p != end && *p == '.') {
+            fracStart = ++p;
+            AccumulateDigits(p, end, w);
+            fracEnd = p;
         }
-        for (; i < string.Length(); ++i) {
-            decimal *= N { 0.1 };
-            if (string[i] == '0') continue;
-            const N newOut = out + decimal * Chr::ToDigit(string[i]);
-            if (newOut == out) return totalLen;
-            out = newOut;
+        if (intStart == intEnd && fracStart == fracEnd) {
+            if (p != intEnd) return nullptr; // just a '.'
+            const OptionUsize special = ParseNanOrInf(Str::Slice(p, end - p), out);
+            if (!special) return nullptr;
+            if (negative) out = -out;
+            return (usize)(p - begin) + *special;
         }
-        return totalLen;
+
+        i64 exponent = 0;
+        if ((options.format & FloatParser::ParseOptions::SCIENTIFIC) && p != end && (*p | 0x20) == 'e') {
+            const char* e = p + 1;
+            const bool negativeExp = e != end && *e == '-';
+            e += e != end && (*e == '-' || *e == '+');
+            if (e != end && Chr::IsDigit(*e)) {
+                for (; e != end && Chr::IsDigit(*e); ++e)
+                    if (exponent < 100'000) exponent = exponent * 10 + (*e - '0');
+                exponent = negativeExp ? -exponent : exponent;
+                p = e;
+            } else if (!(options.format & FloatParser::ParseOptions::FIXED)) return nullptr;
+        } else if (!(options.format & FloatParser::ParseOptions::FIXED)) return nullptr;
+
+        i64 q = exponent - (fracEnd - fracStart);
+        bool truncated = false;
+        if ((intEnd - intStart) + (fracEnd - fracStart) > 19) {
+            // w might have overflowed. leading zeros dont count, but past 19 real digits only the first 19 are kept
+            w = 0;
+            q = exponent;
+            u32 taken = 0;
+            for (const char* c = intStart; c != intEnd; ++c) {
+                if (!taken && *c == '0') continue;
+                if (taken < 19) { w = w * 10 + (u64)(*c - '0'); ++taken; }
+                else { ++q; truncated |= *c != '0'; }
+            }
+            for (const char* c = fracStart; c != fracEnd; ++c) {
+                if (!taken && *c == '0') { --q; continue; }
+                if (taken < 19) { w = w * 10 + (u64)(*c - '0'); ++taken; --q; }
+                else truncated |= *c != '0';
+            }
+        }
+
+        // both w and 10^q are exact floats, so one multiplication is correctly rounded (clinger's fast path)
+        static constexpr i64 EXACT_POW10_MAX = sizeof(N) == 4 ? 10 : 22;
+        static constexpr N EXACT_POW10[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        N result;
+        if (!truncated && w <= 1ULL << (Info::MANTISSA_BITS + 1) && -EXACT_POW10_MAX <= q && q <= EXACT_POW10_MAX) {
+            result = q < 0 ? (N)w / EXACT_POW10[-q] : (N)w * EXACT_POW10[q];
+        } else {
+            const u64 bits = EiselLemire(w, q);
+            // the cut off digits could only have mattered if rounding them up changes the result
+            result = truncated && bits != EiselLemire(w + 1, q) ?
+                FromLongDecimal(Str::Slice(intStart, intEnd - intStart), Str::Slice(fracStart, fracEnd - fracStart), exponent) :
+                Info::FromBits((typename Info::EquivalentInt)bits);
+        }
+        out = negative ? -result : result;
+        return (usize)(p - begin);
     }
 
     template <class N>
-    OptionUsize NumberConversion::FloatConv<N>::ParseExponent(Str string, InOut<N&> out) {
-        if (!string) return nullptr;
-
-        bool negExp = false;
-        if (string.StartsWith('+')) string.Advance(1);
-        if (string.StartsWith('-')) { negExp = true; string.Advance(1); }
-        if (!string) return nullptr;
+    usize NumberConversion::FloatConv<N>::ParseMany(Str& text, Span<N> out, FloatParser::ParseOptions options) {
+        usize n = 0;
+        for (; n < out.Length(); ++n) {
+            const Str rest = text.Skip(CountWhitespace(text));
+            const OptionUsize len = ParseUntil(rest, out[n], options);
+            // has to end in whitespace, 1.5,2 isnt a list
+            if (!len || (*len < rest.Length() && (u8)rest[*len] > ' ')) break;
+            text = rest.Skip(*len);
+        }
+        return n;
+    }
 
-        i32 exp = 0;
-        usize i = 0;
+    template <class N>
+    u64 NumberConversion::FloatConv<N>::EiselLemire(u64 w, i64 q) {
+        // see https://arxiv.org/abs/2101.11408 and https://github.com/fastfloat/fast_float
+        using Info = NumInfo<N>;
+        static constexpr i32 MANTISSA_BITS = Info::MANTISSA_BITS, MAX_EXP = (1 << Info::EXPONENT_BITS) - 1;
+        static constexpr i32 MIN_EXPONENT = -(MAX_EXP >> 1);
+        // anything outside underflows to 0 or overflows to infinity
+        static constexpr i64 Q_MIN = sizeof(N) == 4 ? -65 : -342, Q_MAX = sizeof(N) == 4 ? 38 : 308;
+        // halfway cases can only be exact in this range
+        static constexpr i64 EVEN_Q_MIN = sizeof(N) == 4 ? -17 : -4, EVEN_Q_MAX = sizeof(N) == 4 ? 10 : 23;
+        static constexpr u64 INFINITY_BITS = (u64)MAX_EXP << MANTISSA_BITS;
+
+        if (w == 0 || q < Q_MIN) return 0;
+        if (q > Q_MAX) return INFINITY_BITS;
+
+        const i32 lz = std::countl_zero(w);
+        w <<= lz;
+        // the table is rounded up, this wants it like fast_float's: exact for 5^0 to 5^55, rounded up
+        // for 5^-1 to 5^-27 (so exact halfway cases still show up), truncated past that
+        const u64 (&g)[2] = POW10_128[q - POW10_MIN];
+        const bool inexact = q < -27 || q > 55;
+        const u64 gLo = g[1] - inexact, gHi = g[0] - (inexact && g[1] == 0);
+
+        u64 lo, hi = Bitwise::Mul128(w, gHi, lo);
+        // only the top MANTISSA_BITS + 3 bits matter, the lower product only counts if it could carry into them
+        static constexpr u64 PRECISION_MASK = ~0ULL >> (MANTISSA_BITS + 3);
+        if ((hi & PRECISION_MASK) == PRECISION_MASK) {
+            u64 ignore;
+            const u64 carry = Bitwise::Mul128(w, gLo, ignore);
+            lo += carry;
+            hi += lo < carry;
+        }
 
-        for (; i < string.Length(); ++i) {
-            if (const Option d = Chr::TryToDigit(string[i])) {
-                if (exp < 10000) exp = exp * 10 + (i32)*d;
-            } else { out *= std::exp2(Math::LOG10_2 * (negExp ? -(float)exp : (float)exp)); return i; }
+        const i32 upperBit = (i32)(hi >> 63), shift = upperBit + 64 - MANTISSA_BITS - 3;
+        u64 mantissa = hi >> shift;
+        i32 power2 = (i32)((217706 * q) >> 16) + 63 + upperBit - lz - MIN_EXPONENT;
+        if (power2 <= 0) {
+            // subnormal
+            if (-power2 + 1 >= 64) return 0;
+            mantissa >>= -power2 + 1;
+            mantissa = (mantissa + (mantissa & 1)) >> 1;
+            // rounding up can make it normal again
+            power2 = mantissa < (1ULL << MANTISSA_BITS) ? 0 : 1;
+            return (mantissa & Info::MANTISSA_MASK) | (u64)power2 << MANTISSA_BITS;
         }
+        // exactly halfway between two floats, round to even instead of up
+        if (lo <= 1 && EVEN_Q_MIN <= q && q <= EVEN_Q_MAX && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+            mantissa &= ~1ULL;
+        mantissa = (mantissa + (mantissa & 1)) >> 1;
+        if (mantissa >= 2ULL << MANTISSA_BITS) {
+            mantissa = 1ULL << MANTISSA_BITS;
+            ++power2;
+        }
+        if (power2 >= MAX_EXP) return INFINITY_BITS;
+        return (mantissa & Info::MANTISSA_MASK) | (u64)power2 << MANTISSA_BITS;
+    }
 
-        out *= std::exp2(Math::LOG10_2 * (negExp ? -(float)exp : (float)exp));
-        return i;
+    template <class N>
+    N NumberConversion::FloatConv<N>::FromLongDecimal(Str integer, Str fraction, i64 exponent) {
+        using Info = NumInfo<N>;
+        BigDecimal d;
+        integer = integer.TrimStart('0');
+        if (integer.IsEmpty()) {
+            const Str significant = fraction.TrimStart('0');
+            d.point = -(i32)(fraction.Length() - significant.Length());
+            fraction = significant;
+        } else d.point = (i32)integer.Length();
+        for (const char c : integer)  d.Push((u8)(c - '0'));
+        for (const char c : fraction) d.Push((u8)(c - '0'));
+        d.Trim();
+        d.point = (i32)std::clamp<i64>(d.point + exponent, -100'000, 100'000);
+        return Info::FromBits((typename Info::EquivalentInt)d.ToFloatBits(Info::MANTISSA_BITS, Info::EXPONENT_BITS));
     }
 
     template struct NumberConversion::FloatConv<float>;
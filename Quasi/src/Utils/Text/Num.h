@@ -22,6 +22,15 @@ namespace Quasi::Text {
             enum Base { DECIMAL, BINARY, OCTAL, HEX, CAP_HEX } base = DECIMAL;
         };
         static FormatOptions ConfigureOptions(Str opt);
+        static constexpr bool ValidSpec(FormatSpec spec) {
+            if (spec.EatFillAlign()) spec.EatDigits();
+            spec.EatAnyOf("+ -");
+            spec.Eat('#');
+            spec.Eat('0');
+            spec.EatNumber();
+            spec.EatAnyOf("dXxob");
+            return spec.Done();
+        }
         template <class N> static usize FormatTo(StringWriter sw, N num, const FormatOptions& options);
     };
 
@@ -33,6 +42,8 @@ namespace Quasi::Text {
     template <> struct Formatter<i64> : IntFormatter {};
 
     struct FloatFormatter {
+        // without a precision, floats print the shortest digits that read back to the same value.
+        // with one, the exact value gets rounded to it, like printf. g takes it as significant digits
         // ((?'pad'.?)(?'align'[<^>])(?'totalLen'[0-9]+)\,)?(?'showSign'\+?)(?'shouldPadZero'0?)(?'width'[0-9]*)\.(?'precision'[0-9]*)(?'mode'[feEgG%])
         struct FormatOptions {
             u32 width = 0, precision = ~0;
@@ -43,6 +54,15 @@ namespace Quasi::Text {
             enum Mode { SCIENTIFIC, FIXED, GENERAL, SCI_CAP, GEN_CAP, PERCENTAGE } mode = FIXED;
         };
         static FormatOptions ConfigureOptions(Str opt);
+        static constexpr bool ValidSpec(FormatSpec spec) {
+            spec.EatFillAlign();
+            spec.EatAnyOf("+ -");
+            spec.Eat('0');
+            spec.EatNumber();
+            if (spec.Eat('.') && !spec.EatDigits()) return false;
+            spec.EatAnyOf("eEfFgG%");
+            return spec.Done();
+        }
         template <class N> static usize FormatTo(StringWriter sw, N num, const FormatOptions& options);
     };
 
@@ -102,10 +122,17 @@ namespace Quasi::Text {
     namespace NumberConversion {
         template <class N>
         struct FloatConv {
+            // correctly rounded, same results as strtod
             static OptionUsize ParseUntil(Str string, Out<N&> out, FloatParser::ParseOptions options);
-            static usize ParseInteger(Str string, Out<N&> out);
-            static usize ParseDecimal(Str string, InOut<N&> out);
-            static OptionUsize ParseExponent(Str string, InOut<N&> out);
+            // whitespace separated numbers, until out is full or something isnt a number.
+            // returns how many were parsed, text is left right after the last one
+            static usize ParseMany(Str& text, Span<N> out, FloatParser::ParseOptions options = {});
+
+            // the bits of the float closest to w * 10^q, w has at most 19 digits.
+            // see https://arxiv.org/abs/2101.11408
+            static u64 EiselLemire(u64 w, i64 q);
+            // the slow path for when the digits that didnt fit in w could change the rounding
+            static N FromLongDecimal(Str integer, Str fraction, i64 exponent);
         };
     }
 
@@ -194,14 +221,53 @@ namespace Quasi::Text {
         void WriteU64Octal  (StringWriter sw, u64 num, u32 octalDigits);
         void WriteU64Hex    (StringWriter sw, u64 num, u32 hexDigits, bool upperCase);
 
-        char* AddSign(f64 f, char* out, bool alwaysShowSign = false);
-        char* WriteFltDecimal(f64 f, char* out, u32 precision = ~0);
-        char* WriteFltSci(f64 f, char* out, u32 precision = ~0, char e = 'e', int log10 = i32s::MIN);
-        char* WriteFltFxd(f64 f, char* out, u32 width = 0, u32 precision = ~0, int log10 = i32s::MIN, char pad = ' ');
-        char* WriteFltGen(f64 f, char* out, u32 width = 0, u32 precision = ~0, char e = 'e');
+        // adds every digit from p onwards to w, stopping at the first non digit
+        void AccumulateDigits(const char*& p, const char* end, u64& w);
+        // any byte up to ' ' counts as whitespace
+        usize CountWhitespace(Str text);
+
+        // an arbitrary precision decimal, 0.digits * 10^point. only for inputs too long to round
+        // correctly any other way, see go's strconv/decimal.go
+        struct BigDecimal {
+            static constexpr u32 MAX_DIGITS = 800, MAX_SHIFT = 60;
+            u8 digits[MAX_DIGITS]; // 0-9, not chars
+            i32 count = 0, point = 0;
+            bool truncated = false; // nonzero digits were cut off past MAX_DIGITS
+
+            void Push(u8 digit);
+            void Trim();
+            void ShiftLeft (u32 bits);
+            void ShiftRight(u32 bits);
+            void Shift(i32 bits);
+            u64 RoundedInteger() const;
+            u64 ToFloatBits(u32 mantissaBits, u32 exponentBits);
+        };
+
+        // a float as digits * 10^exponent
+        struct DecimalFloat { u64 digits; i32 exponent; };
+        // the shortest digits that still parse back to the same float, the closest one if theres a tie.
+        // schubfach, see https://github.com/abolz/Drachennest. f has to be finite and positive
+        DecimalFloat ShortestDecimal(f32 f);
+        DecimalFloat ShortestDecimal(f64 f);
+        // the float is c * 2^q
+        DecimalFloat Schubfach(u64 c, i32 q, bool lowerBoundaryCloser);
+        // the exact value of c * 2^q, every digit of it. a double never has more than 767 significant digits
+        void ExactDecimal(BigDecimal& out, u64 c, i32 q);
+        // keeps the first keep digits (0 or less keeps nothing), rounding the exact value half to even
+        void RoundDigits(BigDecimal& d, i32 keep);
+
+        // digits * 10^exponent, with no leading zeros and empty for 0, already rounded to what gets shown.
+        // no precision (~0) writes every digit, otherwise exactly that many decimals, padded with zeros
+        char* WriteDecimalFxd(char* out, Str digits, i32 exponent, u32 precision = ~0);
+        char* WriteDecimalSci(char* out, Str digits, i32 exponent, u32 precision = ~0, char e = 'e');
 
-        usize FormatFltSci  (StringWriter sw, f64 f, const FloatFormatter::FormatOptions& options);
-        usize FormatFltFxd  (StringWriter sw, f64 f, const FloatFormatter::FormatOptions& options);
+        usize FormatDigits  (StringWriter sw, Str digits, i32 exponent, bool negative, bool scientific, u32 precision,
+                             const FloatFormatter::FormatOptions& options);
+        // the shortest digits, for when theres no precision
+        usize FormatDecimal (StringWriter sw, DecimalFloat d, bool negative, const FloatFormatter::FormatOptions& options);
+        // the exact digits of c * 2^q rounded to the precision, like printf
+        usize FormatExact   (StringWriter sw, u64 c, i32 q, bool negative, const FloatFormatter::FormatOptions& options);
+        usize FormatFloating(StringWriter sw, f32 f, const FloatFormatter::FormatOptions& options);
         usize FormatFloating(StringWriter sw, f64 f, const FloatFormatter::FormatOptions& options);
     }
 
@@ -22,6 +22,10 @@ namespace Quasi::Text {
         return WriteToFile(stderr);
     }
 
+    StringWriter StringWriter::WriteToBuffer(Span<char>& buffer) {
+        return { FuncRefs::FromRaw(&buffer, BufferWriteCallback) };
+    }
+
     void StringWriter::StringWriteCallback(void* s, Str str) {
         ((String*)s)->AppendStr(str);
     }
@@ -30,6 +34,13 @@ namespace Quasi::Text {
         std::fwrite(str.Data(), 1, str.Length(), (std::FILE*)file);
     }
 
+    void StringWriter::BufferWriteCallback(void* buffer, Str str) {
+        Span<char>& rest = *(Span<char>*)buffer;
+        const usize n = std::min(str.Length(), rest.Length());
+        Memory::MemCopyNoOverlap(rest.Data(), str.Data(), n);
+        rest = rest.SkipMut(n);
+    }
+
     usize StringWriter::Write(Str str) {
         writer(str);
         return str.Length();
@@ -41,12 +52,15 @@ namespace Quasi::Text {
     }
 
     usize StringWriter::WriteRepeat(char c, usize n) {
-        const u64 repeated8bytes = c * 0x0101'0101'0101'0101;
+        // padding is usually empty, dont bother the writer then
+        if (n == 0) return 0;
+        const u64 repeated8bytes = (u8)c * 0x0101'0101'0101'0101;
         const Str rep8 = Str::Slice((const char*)&repeated8bytes, 8);
-        for (; n > 8; n -= 8) {
+        usize left = n;
+        for (; left > 8; left -= 8) {
             Write(rep8);
         }
-        Write(rep8.Substr(0, n));
+        Write(rep8.Substr(0, left));
         return n;
     }
 
@@ -18,9 +18,12 @@ namespace Quasi::Text {
         static StringWriter WriteToFile(std::FILE* file);
         static StringWriter WriteToConsole();
         static StringWriter WriteToError();
+        // fills the buffer from the front and shrinks it, anything that doesnt fit is dropped
+        static StringWriter WriteToBuffer(Span<char>& buffer);
 
         static void StringWriteCallback(void* s, Str str);
         static void FileWriteCallback(void* file, Str str);
+        static void BufferWriteCallback(void* buffer, Str str);
 
         usize Write(Str str);
         usize Write(char c);
@@ -1,4 +1,5 @@
 #pragma once
+#include "Arena.h"
 #include "Func.h"
 #include "Comparison.h"
 #include "Option.h"
@@ -6,7 +7,15 @@
 
 namespace Quasi {
     namespace Vecs {
-        inline usize GrowCap(usize cap) { return std::max<usize>(cap * 2, 2); }
+        // how much capacity grows when a push overflows, in percent.
+        // 150 lets old blocks get reused by later growth, 200 reallocates less often
+#ifndef Q_VEC_GROWTH_PERCENT
+#define Q_VEC_GROWTH_PERCENT 200
+#endif
+        static constexpr usize GROWTH_PERCENT = Q_VEC_GROWTH_PERCENT;
+        static_assert(GROWTH_PERCENT > 100, "vecs have to grow");
+
+        inline usize GrowCap(usize cap) { return std::max<usize>(cap * GROWTH_PERCENT / 100, std::max<usize>(cap + 1, 2)); }
         template <class T> Vec<T> FromIList(IList<T> list) { return Vec<T>::FromIList(list); }
         template <class T, usize N> Vec<T> New(const T (&arr)[N]) { return Vec<T>::New(arr); }
         template <class T, usize N> Vec<T> New(T (&&arr)[N])      { return Vec<T>::New(std::move(arr)); }
@@ -94,16 +103,23 @@ namespace Quasi {
     private:
         void ReserveNext() { AllocToNew(Vecs::GrowCap(capacity)); }
         void MoveBuffer(T* buffer) {
-            for (usize i = 0; i < size; ++i) {
-                Memory::ConstructMoveAt(&buffer[i], std::move(data[i]));
-                Memory::DestructAt(&data[i]);
-            }
+            Memory::RangeRelocateNoOverlap(buffer, data, size);
             Memory::FreeRaw(data);
             data = buffer;
         }
-        void AllocToNew(usize buffSize) { MoveBuffer(AllocateBuffer(buffSize)); capacity = buffSize; }
+        void AllocToNew(usize buffSize) { MoveBuffer(buffSize ? AllocateBuffer(buffSize) : nullptr); capacity = buffSize; }
+        // a box deletes its buffer, which cant be done to arena memory, so that gets moved to the heap first
+        ArrayBox<T> ReleaseIntoBox(usize length) {
+            if (Memory::LinearArena::IsArenaMemory(data)) {
+                T* heap = Memory::AllocateArrayUninit<T>(length);
+                Memory::RangeRelocateNoOverlap(heap, data, size);
+                PretendClear();
+                return ArrayBox<T>::Own(heap, length);
+            }
+            return ArrayBox<T>::Own(Release(), length);
+        }
     public:
-        static T* AllocateBuffer(usize size) { return Memory::AllocateArrayUninit<T>(size); }
+        static T* AllocateBuffer(usize size) { return (T*)Memory::AllocateRaw(size * sizeof(T)); }
 
         bool CanFit(usize amount) const { return size + amount <= capacity; }
         void TryGrow(usize amount) { if (!CanFit(amount)) Reserve(amount); }
@@ -132,11 +148,11 @@ namespace Quasi {
         void ResizeExtraWith(usize extra, Fn<T> auto&& factory) { return ResizeWith(size + extra, factory); }
         void ResizeExtraDefault(usize extra) { return ResizeExtraWith(extra, Combinate::Constructor<T> {}); }
 
-        void ShrinkToFit() { AllocToNew(size); }
-        void ShrinkTo(usize minimum) { AllocToNew(std::max(size, minimum)); }
+        void ShrinkToFit() { ShrinkTo(0); }
+        void ShrinkTo(usize minimum) { const usize cap = std::max(size, minimum); if (cap < capacity) AllocToNew(cap); }
 
-        [[nodiscard]] ArrayBox<T> IntoBox()      { return ArrayBox<T>::Own(Release(), size); } // releases
-        [[nodiscard]] ArrayBox<T> IntoBoxWhole() { return ArrayBox<T>::Own(Release(), capacity); } // releases
+        [[nodiscard]] ArrayBox<T> IntoBox()      { return ReleaseIntoBox(size); }
+        [[nodiscard]] ArrayBox<T> IntoBoxWhole() { return ReleaseIntoBox(capacity); }
         ArrayBox<T> CloneToBox()   { return AsSpan().CollectToBox(); } // copies without extra cap
 
         const T& First() const { return data[0]; }
@@ -163,7 +179,16 @@ namespace Quasi {
         T    TakeUnordered(usize index) { --size; std::swap(data[index], data[size]); return std::move(data[size]); }
         void Pop()                      { --size; data[size].~T(); }
         T    Take()                     { --size; return std::move(data[size]); }
-        void Pop(usize index)           { --size; Memory::RangeMove(&data[index], &data[index + 1], size - index); }
+        void Pop(usize index) {
+            --size;
+            if constexpr (Memory::TrivialRelocate<T>) {
+                data[index].~T();
+                Memory::MemCopy(&data[index], &data[index + 1], (size - index) * sizeof(T));
+            } else {
+                Memory::RangeMove(&data[index], &data[index + 1], size - index);
+                data[size].~T();
+            }
+        }
         T    Take(usize index)          { T out = std::move(data[index]); Pop(index); return out; }
         bool      TryPopUnordered(usize index)  { if (IsEmpty()) return false;          PopUnordered(index);  return true; }
         Option<T> TryTakeUnordered(usize index) { if (IsEmpty()) return nullptr; return TakeUnordered(index);              }
@@ -180,13 +205,20 @@ namespace Quasi {
         OptRef<T> TryPush(const T& obj) { if (CanFit(1)) { return Push(obj);            } return nullptr; }
         OptRef<T> TryPush(T&& obj)      { if (CanFit(1)) { return Push(std::move(obj)); } return nullptr; }
 
-        void Insert(const T& obj, usize idx) {
-            TryGrow(1); Memory::RangeMoveRev(&data[idx + 1], &data[idx], size - idx);
-            Memory::ConstructCopyAt(&data[idx], obj); ++size;
-        }
+        void Insert(const T& obj, usize idx) { Insert(T(obj), idx); }
         void Insert(T&& obj, usize idx) {
-            TryGrow(1); Memory::RangeMoveRev(&data[idx + 1], &data[idx], size - idx);
-            Memory::ConstructMoveAt(&data[idx], std::move(obj)); ++size;
+            TryGrow(1);
+            if constexpr (Memory::TrivialRelocate<T>) {
+                Memory::MemCopy(&data[idx + 1], &data[idx], (size - idx) * sizeof(T));
+                Memory::ConstructMoveAt(&data[idx], std::move(obj));
+            } else if (idx == size) {
+                Memory::ConstructMoveAt(&data[idx], std::move(obj));
+            } else {
+                Memory::ConstructMoveAt(&data[size], std::move(data[size - 1]));
+                Memory::RangeMoveRev(&data[idx + 1], &data[idx], size - 1 - idx);
+                data[idx] = std::move(obj);
+            }
+            ++size;
         }
         void InsertSpan(Span<const T> vals, usize idx) {
             TryGrow(vals.Length()); Memory::RangeMoveRev(&data[idx + vals.Length()], &data[idx], size - idx);
@@ -205,7 +237,14 @@ namespace Quasi {
             for (auto&& i : items) { Push(std::forward<decltype(i)>(i)); }
         }
         void ExtendMove(Span<T> items)   { TryGrow(items.Length()); for (T& i : items) Push(i); }
-        void Extend(Span<const T> items) { TryGrow(items.Length()); for (const T& i : items) Push(i); }
+        void Extend(Span<const T> items) {
+            TryGrow(items.Length());
+            if constexpr (TrivialCopy<T>) {
+                if (items.IsEmpty()) return;
+                Memory::MemCopyNoOverlap(data + size, items.Data(), items.ByteSize());
+                size += items.Length();
+            } else for (const T& i : items) Push(i);
+        }
         void ExtendFromSelf(usize start) { return ExtendFromSelf(start, size - start); }
         void ExtendFromSelf(usize start, usize count) {
             TryGrow(count);
@@ -283,6 +322,8 @@ namespace Quasi {
         // } IntoIterImpl() { return { data, data + size }; }
     };
 
+    template <class T> struct Memory::TriviallyRelocatable<Vec<T>> { static constexpr bool VALUE = true; };
+
     template <class T> Vec<RemConst<T>> Span<T>::CollectToVec() const { return Vec<RemConst<T>>::New(*this); }
     template <class T> Vec<RemConst<T>> Span<T>::MoveToVec() requires IsMut<T> { return Vec<RemConst<T>>::MoveNew(*this); }
     template <class T> Vec<RemConst<T>> Span<T>::Repeat(usize num) const {
@@ -0,0 +1,74 @@
+#include "Test.h"
+
+#include "Utils/Arena.h"
+#include "Utils/ArrayBox.h"
+#include "Utils/Vec.h"
+
+using namespace Quasi;
+using namespace Quasi::Memory;
+
+int main() {
+    {
+        // owned arenas and frame arenas register their own regions, and can all be live at once
+        LinearArena a { 4096 }, b { 4096 };
+        FrameArena frames { 4096 };
+        void* fromA = a.TryAllocate(64);
+        void* fromB = b.TryAllocate(64);
+        void* fromFrame = frames.Current().TryAllocate(64);
+        QCheck$(LinearArena::IsArenaMemory(fromA) && LinearArena::IsArenaMemory(fromB) && LinearArena::IsArenaMemory(fromFrame));
+        frames.NextFrame();
+        QCheck$(LinearArena::IsArenaMemory(frames.Current().TryAllocate(64)));
+
+        Vec<u32> heap;
+        heap.Push(1);
+        QCheck$(!LinearArena::IsArenaMemory(heap.Data()));
+    }
+    {
+        // and once theyre gone, their memory isnt arena memory anymore
+        LinearArena* gone = new LinearArena { 4096 };
+        void* mem = gone->TryAllocate(64);
+        QCheck$(LinearArena::IsArenaMemory(mem));
+        delete gone;
+        QCheck$(!LinearArena::IsArenaMemory(mem));
+    }
+    {
+        // a Vec grown in an arena scope, turned into a box, ends up on the heap so the box can delete it
+        LinearArena arena { 1 << 16 };
+        ArrayBox<u32> box, whole;
+        {
+            ArenaScope scope { arena };
+            Vec<u32> v, w;
+            for (u32 i = 0; i < 100; ++i) v.Push(i * 3), w.Push(i);
+            QCheck$(LinearArena::IsArenaMemory(v.Data()) && LinearArena::IsArenaMemory(w.Data()));
+            const usize capacity = w.Capacity();
+            box = v.IntoBox();
+            whole = w.IntoBoxWhole();
+            QCheck$(whole.Length() == capacity);
+        }
+        QCheck$(!LinearArena::IsArenaMemory(box.Data()) && !LinearArena::IsArenaMemory(whole.Data()));
+        bool same = box.Length() == 100;
+        for (u32 i = 0; i < 100 && same; ++i) same = box[i] == i * 3 && whole[i] == i;
+        QCheck$(same);
+        arena.Reset();
+    }
+    {
+        // scratch space too big for the stack comes from the arena in a scope, and from the heap without one
+        LinearArena arena { 1 << 16 };
+        {
+            ArenaScope scope { arena };
+            ScratchArray<u32> scratch { 4096 };
+            QCheck$(arena.Owns(scratch.Data()));
+        }
+        ScratchArray<u32> scratch { 4096 };
+        QCheck$(!LinearArena::IsArenaMemory(scratch.Data()));
+
+        // a null arena leaves the active one alone
+        ArenaScope outer { arena };
+        {
+            ArenaScope none { nullptr };
+            QCheck$(LinearArena::Active() == &arena);
+        }
+    }
+
+    return Test::Finish("ArenaTests");
+}
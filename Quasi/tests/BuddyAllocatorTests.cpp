@@ -0,0 +1,109 @@
+#include "Test.h"
+
+#include "GLs/BuddyAllocator.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+using Block = BuddyAllocator::Block;
+
+// no two blocks share a unit, and every block sits on a multiple of its own size
+static bool Disjoint(const BuddyAllocator& alloc, Span<const Block> blocks) {
+    Vec<bool> taken;
+    taken.Resize(alloc.Capacity() / alloc.MinBlock(), false);
+    for (const Block& b : blocks) {
+        const u32 size = alloc.BlockSize(b);
+        if (b.offset % size || b.offset + size > alloc.Capacity()) return false;
+        for (u32 u = b.offset / alloc.MinBlock(); u < (b.offset + size) / alloc.MinBlock(); ++u) {
+            if (taken[u]) return false;
+            taken[u] = true;
+        }
+    }
+    return true;
+}
+
+static u32 UnitsOf(const BuddyAllocator& alloc, Span<const Block> blocks) {
+    u32 units = 0;
+    for (const Block& b : blocks) units += alloc.BlockSize(b);
+    return units;
+}
+
+int main() {
+    {
+        // the capacity rounds up to a power of 2 blocks, and counts round up to whole blocks
+        BuddyAllocator alloc { 1000, 64 };
+        QCheck$(alloc.Capacity() == 1024 && alloc.LargestFreeBlock() == 1024);
+        QCheck$(alloc.OrderFor(0) == 0 && alloc.OrderFor(64) == 0 && alloc.OrderFor(65) == 1 && alloc.OrderFor(1024) == 4);
+        QCheck$(!alloc.Allocate(1025));
+        // counts past the end of a u32 once rounded up dont wrap around to something small
+        QCheck$(alloc.OrderFor(u32s::MAX) == 26 && !alloc.Allocate(u32s::MAX));
+    }
+
+    {
+        // every unit handed out, then given back, merges back into one block
+        BuddyAllocator alloc { 16, 1 };
+        Vec<Block> blocks;
+        while (const Option<Block> b = alloc.Allocate(1)) blocks.Push(*b);
+        QCheck$(blocks.Length() == 16 && alloc.FreeUnits() == 0 && Disjoint(alloc, blocks));
+
+        // units 0 and 2 free: 2 units free but no more than 1 together
+        alloc.Free(blocks[0]);
+        alloc.Free(blocks[2]);
+        QCheck$(alloc.LargestFreeBlock() == 1 && alloc.Fragmentation() == 0.5f);
+        // unit 1 is 0's buddy, so they make a 2 and then a 4 with 2 and 3
+        alloc.Free(blocks[1]);
+        QCheck$(alloc.LargestFreeBlock() == 2);
+        alloc.Free(blocks[3]);
+        QCheck$(alloc.LargestFreeBlock() == 4 && alloc.Fragmentation() == 0.0f);
+
+        for (usize i = 4; i < blocks.Length(); ++i) alloc.Free(blocks[i]);
+        QCheck$(alloc.UsedUnits() == 0 && alloc.LargestFreeBlock() == 16);
+    }
+
+    {
+        // random churn, checked against the live blocks after every step
+        BuddyAllocator alloc { 1 << 16, 16 };
+        Vec<Block> live;
+        Math::SplitMix64 rng { 0xB0DD };
+        for (u32 i = 0; i < 20000; ++i) {
+            if (live.IsEmpty() || rng.Next64() % 8 < 5) {
+                const u32 count = (u32)(1 + rng.Next64() % (1 + (rng.Next64() % 4 ? 100 : 3000)));
+                if (const Option<Block> b = alloc.Allocate(count)) {
+                    QCheck$(alloc.BlockSize(*b) >= count && alloc.BlockSize(*b) < 2 * std::max(count, alloc.MinBlock()));
+                    live.Push(*b);
+                }
+            } else {
+                const usize at = rng.Next64() % live.Length();
+                alloc.Free(live[at]);
+                live[at] = live.Last();
+                live.Pop();
+            }
+            if (i % 500 == 0 && !QCheck$(Disjoint(alloc, live) && alloc.UsedUnits() == UnitsOf(alloc, live))) break;
+        }
+        QCheck$(alloc.Fragmentation() > 0.0f);
+
+        // repacking puts the same sizes back, biggest first and without any holes
+        const Vec<Block> packed = alloc.Repack(live);
+        QCheck$(packed.Length() == live.Length() && Disjoint(alloc, packed));
+        QCheck$(alloc.Fragmentation() == 0.0f && alloc.UsedUnits() == UnitsOf(alloc, live));
+        bool sameOrders = true;
+        u32 end = 0;
+        for (usize i = 0; i < packed.Length(); ++i) {
+            sameOrders &= packed[i].order == live[i].order;
+            end = std::max(end, packed[i].offset + alloc.BlockSize(packed[i]));
+        }
+        QCheck$(sameOrders && end == alloc.UsedUnits());
+
+        // and into twice the room, which leaves the top half untouched
+        const Vec<Block> grown = alloc.Repack(packed, alloc.Capacity() * 2);
+        u32 grownEnd = 0;
+        for (const Block& b : grown) grownEnd = std::max(grownEnd, b.offset + alloc.BlockSize(b));
+        QCheck$(alloc.Capacity() == 1 << 17 && grownEnd == end && Disjoint(alloc, grown));
+
+        for (const Block& b : grown) alloc.Free(b);
+        QCheck$(alloc.UsedUnits() == 0 && alloc.LargestFreeBlock() == alloc.Capacity());
+    }
+
+    return Test::Finish("BuddyAllocatorTests");
+}
@@ -0,0 +1,100 @@
+#include "Test.h"
+#include "GLStub.h"
+
+#include "GLs/BufferPool.h"
+#include "GLs/GLDebug.h"
+#include "GLs/Shader.h"
+#include "Utils/Math/Random.h"
+
+#include <bit>
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+struct Mesh { SlotKey key; u32 vertices, indices; };
+
+// every live range still has its own counts and blocks big enough for them, and no two blocks overlap
+static bool RangesHold(const BufferPool& pool, Span<const Mesh> meshes) {
+    Vec<bool> vertexTaken, indexTaken;
+    vertexTaken.Resize(pool.VertexCapacity(), false);
+    indexTaken.Resize(pool.IndexCapacity(), false);
+    const auto take = [] (Vec<bool>& taken, u32 begin, u32 count) {
+        if (begin + count > taken.Length()) return false;
+        for (u32 i = begin; i < begin + count; ++i) {
+            if (taken[i]) return false;
+            taken[i] = true;
+        }
+        return true;
+    };
+    for (const Mesh& m : meshes) {
+        if (!pool.Contains(m.key)) return false;
+        const PoolRange& r = pool.GetRange(m.key);
+        if (r.vertexCount != m.vertices || r.indexCount != m.indices) return false;
+        if (!take(vertexTaken, r.vertexBlock.offset, m.vertices) || !take(indexTaken, r.indexBlock.offset, m.indices)) return false;
+    }
+    return pool.RangeCount() == meshes.Length();
+}
+
+int main() {
+    {
+        BufferPool pool = BufferPool::New<Vertex2D>(256, 3 * 256);
+        QCheck$(pool.VertexCapacity() == 256 && pool.IndexCapacity() == 768);
+
+        Vec<Mesh> meshes;
+        Math::SplitMix64 rng { 0x9001 };
+        u32 growths = 0;
+        for (u32 i = 0; i < 3000; ++i) {
+            if (meshes.IsEmpty() || rng.Next64() % 3) {
+                const u32 vertices = (u32)(1 + rng.Next64() % 300), indices = 3 * (u32)(1 + rng.Next64() % 200);
+                const u32 vcap = pool.VertexCapacity(), icap = pool.IndexCapacity();
+                meshes.Push({ pool.Allocate(vertices, indices), vertices, indices });
+                // running out doubles the buffer, as many times as it takes
+                growths += vcap != pool.VertexCapacity();
+                QCheck$(pool.VertexCapacity() % vcap == 0 && std::has_single_bit(pool.VertexCapacity() / vcap));
+                QCheck$(pool.IndexCapacity()  % icap == 0 && std::has_single_bit(pool.IndexCapacity()  / icap));
+            } else {
+                const usize at = rng.Next64() % meshes.Length();
+                pool.Free(meshes[at].key);
+                QCheck$(!pool.Contains(meshes[at].key));
+                meshes[at] = meshes.Last();
+                meshes.Pop();
+            }
+            if (i % 100 == 0 && !QCheck$(RangesHold(pool, meshes))) break;
+        }
+        QCheck$(growths > 0 && RangesHold(pool, meshes));
+
+        // defragmenting copies every mesh once into a new buffer of each kind, and keeps the capacity
+        const u32 vcap = pool.VertexCapacity(), icap = pool.IndexCapacity();
+        Test::GLStub::Reset();
+        pool.Defragment();
+        QCheck$(Test::GLStub::Calls("CopyBufferSubData") == 2 * meshes.Length());
+        QCheck$(pool.Fragmentation() == 0.0f && pool.VertexCapacity() == vcap && pool.IndexCapacity() == icap);
+        QCheck$(RangesHold(pool, meshes));
+
+        // draws go through the one vertex array, with the range's base vertex
+        Test::GLStub::Reset();
+        const Shader shader = ShaderProgram::New("vert", "frag");
+        for (const Mesh& m : meshes) pool.Draw(m.key, shader);
+        QCheck$(Test::GLStub::Calls("DrawElementsBaseVertex") == meshes.Length() && Test::GLStub::Calls("BindVertexArray") <= 1);
+    }
+
+    {
+        // 4kb vertices, so doubling 2^19 of them would need a buffer of 2^32 bytes
+        VertexBufferLayout big;
+        big.Push<f32>(1024);
+        BufferPool pool = BufferPool::New(big, 1 << 19, 3 * 64);
+        const SlotKey all = pool.Allocate(1 << 19, 3);
+        QCheck$(!all.IsNull() && pool.VertexCapacity() == 1 << 19);
+
+        // the pool cant grow, so it says so with a null key instead of doubling forever
+        GLLogger().SetBreakLevel(Debug::Severity::CRITICAL);
+        const SlotKey more = pool.Allocate(1, 3);
+        GLLogger().SetBreakLevel(Debug::Severity::ERROR);
+        QCheck$(more.IsNull() && pool.RangeCount() == 1 && pool.VertexCapacity() == 1 << 19);
+        // and nothing was left allocated for the key that never came
+        pool.Free(all);
+        QCheck$(!pool.Allocate(1 << 19, 3).IsNull());
+    }
+
+    return Test::Finish("BufferPoolTests");
+}
@@ -0,0 +1,77 @@
+#include "GLStub.h"
+
+#include <cstring>
+#include <tuple>
+#include <glp.h>
+
+#include "Utils/HashMap.h"
+
+namespace Quasi::Test::GLStub {
+    static HashMap<Str, usize>& Counts() {
+        static HashMap<Str, usize> counts;
+        return counts;
+    }
+    static usize total = 0;
+    static GL::Uint nextID = 0;
+
+    usize Calls() { return total; }
+    usize Calls(Str name) { return Counts().Get(name).Copied().UnwrapOr(0); }
+    void Reset() { Counts().Clear(); total = 0; }
+
+    static bool StartsWith(const char* name, const char* prefix) { return std::strncmp(name, prefix, std::strlen(prefix)) == 0; }
+
+    template <class R, class... Ts>
+    static R Call(const char* name, Ts... args) {
+        ++total;
+        ++Counts().GetOrInsert(Str::Slice(name, std::strlen(name)), 0);
+
+        if constexpr (SameAs<std::tuple<Ts...>, std::tuple<GL::Isize, GL::Uint*>>) {
+            // GenBuffers, CreateTextures, ...
+            if (StartsWith(name, "Gen") || StartsWith(name, "Create")) {
+                const auto [n, ids] = std::tuple { args... };
+                for (GL::Isize i = 0; i < n; ++i) ids[i] = ++nextID;
+            }
+        }
+        if constexpr (sizeof...(Ts) > 0) {
+            using Last = std::tuple_element_t<sizeof...(Ts) - 1, std::tuple<Ts...>>;
+            // compile and link status, mostly
+            if constexpr (SameAs<Last, GL::Int*>)
+                if (StartsWith(name, "Get")) *std::get<sizeof...(Ts) - 1>(std::tuple { args... }) = 1;
+        }
+        if constexpr (SameAs<R, GL::Uint>) {
+            // CreateProgram, CreateShader
+            if (StartsWith(name, "Create")) return ++nextID;
+        }
+        if constexpr (SameAs<R, GL::Enum>) {
+            if (std::strcmp(name, "CheckFramebufferStatus") == 0) return GL::FRAMEBUFFER_COMPLETE;
+        }
+        if constexpr (!SameAs<R, void>) return R {};
+    }
+}
+
+namespace GL {
+#define COMMA() ,
+#define EMPTY()
+#define WAIT(X) X EMPTY() ()
+#define RUN(...) __VA_ARGS__
+#define CAT(A, B) A##B
+#define CAT2(A, B) CAT(A, B)
+#define DEL_FIRST(X, ...) __VA_ARGS__
+#define ARGS_1(T) WAIT(COMMA) T ARGS_2
+#define ARGS_2(V) V ARGS_1
+#define ARGS_1END
+#define ARGS_2END
+#define SEND_1(T) WAIT(COMMA) SEND_2
+#define SEND_2(V) V SEND_1
+#define SEND_1END
+#define SEND_2END
+
+#define STUB_FN(NAME, RET, ARGS) \
+    RET NAME(RUN(DEL_FIRST EMPTY() (CAT2(ARGS_1 ARGS, END)))) \
+    { return Quasi::Test::GLStub::Call<RET>(#NAME RUN(CAT2(SEND_1 ARGS, END))); }
+
+    GLPORT_ON_FUNCTIONS(STUB_FN)
+
+    bool Supports(const char*) { return true; }
+    Enum InitGLEW() { return 0; }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "Utils/Str.h"
+
+// a stand in for OpenGLPort's gl table, compiled into a test instead of linking glp.cpp.
+// every GL:: call is counted by name and does nothing, so gl objects and the render state can be used headless.
+// Gen* and Create* hand out fresh ids, Get*iv reports success, and everything else returns 0
+namespace Quasi::Test::GLStub {
+    // calls since the last Reset. names are without the gl prefix, like "BindBuffer"
+    usize Calls();
+    usize Calls(Str name);
+    void Reset();
+}
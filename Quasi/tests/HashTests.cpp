@@ -0,0 +1,221 @@
+#include "Test.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Utils/Hash.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+// rapidhash v1 as upstream wrote it (rapidhash.h, RAPIDHASH_FAST, RAPIDHASH_COMPACT off),
+// with its own 64x64 multiply so nothing here shares code with Hash.cpp
+namespace Reference {
+    static constexpr u64 RAPID_SEED = 0xbdd89aa982704029;
+    static constexpr u64 rapid_secret[3] = { 0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3 };
+
+    static void rapid_mum(u64* A, u64* B) {
+        const u64 ha = *A >> 32, hb = *B >> 32, la = (u32)*A, lb = (u32)*B;
+        const u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+        u64 c = t < rl;
+        const u64 lo = t + (rm1 << 32);
+        c += lo < t;
+        const u64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        *A = lo; *B = hi;
+    }
+    static u64 rapid_mix(u64 A, u64 B) { rapid_mum(&A, &B); return A ^ B; }
+    static u64 rapid_read64(const u8* p) { u64 v; std::memcpy(&v, p, sizeof(u64)); return v; }
+    static u64 rapid_read32(const u8* p) { u32 v; std::memcpy(&v, p, sizeof(u32)); return v; }
+    static u64 rapid_readSmall(const u8* p, usize k) { return ((u64)p[0] << 56) | ((u64)p[k >> 1] << 32) | p[k - 1]; }
+
+    static u64 rapidhash_internal(const void* key, usize len, u64 seed, const u64* secret) {
+        const u8* p = (const u8*)key;
+        seed ^= rapid_mix(seed ^ secret[0], secret[1]) ^ len;
+        u64 a, b;
+        if (len <= 16) {
+            if (len >= 4) {
+                const u8* plast = p + len - 4;
+                a = (rapid_read32(p) << 32) | rapid_read32(plast);
+                const u64 delta = ((len & 24) >> (len >> 3));
+                b = ((rapid_read32(p + delta) << 32) | rapid_read32(plast - delta));
+            } else if (len > 0) { a = rapid_readSmall(p, len); b = 0; }
+            else a = b = 0;
+        } else {
+            usize i = len;
+            if (i > 48) {
+                u64 see1 = seed, see2 = seed;
+                while (i >= 96) {
+                    seed = rapid_mix(rapid_read64(p)      ^ secret[0], rapid_read64(p + 8)  ^ seed);
+                    see1 = rapid_mix(rapid_read64(p + 16) ^ secret[1], rapid_read64(p + 24) ^ see1);
+                    see2 = rapid_mix(rapid_read64(p + 32) ^ secret[2], rapid_read64(p + 40) ^ see2);
+                    seed = rapid_mix(rapid_read64(p + 48) ^ secret[0], rapid_read64(p + 56) ^ seed);
+                    see1 = rapid_mix(rapid_read64(p + 64) ^ secret[1], rapid_read64(p + 72) ^ see1);
+                    see2 = rapid_mix(rapid_read64(p + 80) ^ secret[2], rapid_read64(p + 88) ^ see2);
+                    p += 96; i -= 96;
+                }
+                if (i >= 48) {
+                    seed = rapid_mix(rapid_read64(p)      ^ secret[0], rapid_read64(p + 8)  ^ seed);
+                    see1 = rapid_mix(rapid_read64(p + 16) ^ secret[1], rapid_read64(p + 24) ^ see1);
+                    see2 = rapid_mix(rapid_read64(p + 32) ^ secret[2], rapid_read64(p + 40) ^ see2);
+                    p += 48; i -= 48;
+                }
+                seed ^= see1 ^ see2;
+            }
+            if (i > 16) {
+                seed = rapid_mix(rapid_read64(p) ^ secret[2], rapid_read64(p + 8) ^ seed ^ secret[1]);
+                if (i > 32)
+                    seed = rapid_mix(rapid_read64(p + 16) ^ secret[2], rapid_read64(p + 24) ^ seed);
+            }
+            a = rapid_read64(p + i - 16); b = rapid_read64(p + i - 8);
+        }
+        a ^= secret[1]; b ^= seed; rapid_mum(&a, &b);
+        return rapid_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+
+    static u64 rapidhash_withSeed(const void* key, usize len, u64 seed) { return rapidhash_internal(key, len, seed, rapid_secret); }
+}
+
+static u64 Rapid(const byte* key, usize len, u64 seed) {
+    return (u64)Hashing::HashBytesRapid(Spans::Slice(key, len), seed);
+}
+
+// the reference's outputs for the bytes 0, 1, 2, ... of every length up to 64, with upstream's default seed
+static constexpr u64 KNOWN_ANSWERS[65] = {
+    0x5a6ef77074ebc84b, 0x48dfce108249b3f8, 0x154197438af9c87f, 0x4a25c2969d7e2f6a,
+    0xb4ee98f29eebfc4f, 0xd335af7c29c0008b, 0x756f531414f304e7, 0x4e2f07cf7ee597a5,
+    0xec1570c82e51623e, 0x30cb04ca5bc72caa, 0x003183d507139086, 0x396847fe2445b51a,
+    0x3d5ee1574f581163, 0x6a4a35632c994e15, 0xafa46273cb60f675, 0xce0f6fc7e52145eb,
+    0xdf7f47a6f1034c55, 0x6e168b32dd992016, 0x6c2abb70df08230c, 0xd206280dee2728b7,
+    0xc6a6bac1389a6baa, 0xa60c30a5533fe3fc, 0xe2c1d194a1a8a01e, 0xce0c94c9fa7055fa,
+    0x8624ce7c25efba87, 0xf254efbd6dd2f17e, 0xfc8729cba52c7f72, 0x0f7559c884986b75,
+    0x343957f960da71bb, 0x8af9de7992479cb9, 0xc708849bc6ff1ceb, 0xb50472f2fd41df04,
+    0x83e79621fc6e14aa, 0xe1e8623c0fe1afc6, 0x2e7fd742a110e5c5, 0x03533fe0bafd2c1c,
+    0x0f5404483fdef1c7, 0x901c1610f394ede1, 0x40645b5c9c2e3afe, 0xbe40f0575a8d1ccc,
+    0xb2ab7ff3c66bd5ed, 0x3ed784ac44fe1028, 0x683ed3916af97f0c, 0x0ca13a120f9f0988,
+    0xf8160186dc016775, 0x8d0d0f33a118fc53, 0x5691e6eaafbc94a2, 0xb842d9f19e621b30,
+    0xde39ec8d0e6155a0, 0x5935302eea87371f, 0xb1e0d312ad6c9c9e, 0x4fb25dc5bf74d521,
+    0x1d9f9a495d5b44e4, 0xbe95c7198e9d43f2, 0x98881e4255870550, 0x8d50c26279fc6b5a,
+    0x545476331d6442a6, 0x363af3862c3eb97e, 0x18ebf548964b8687, 0xd5573a5ba60fc7ec,
+    0xbb6a62306e41587e, 0x95be0b15295c4550, 0x8edb4b34c7ab20a4, 0x4c7b65957600d719,
+    0xab3bf7830eef7a0a,
+};
+
+// how often flipping one input bit flips each output bit, the worst of all of them. should be 0.5 everywhere
+static double WorstAvalanche(usize len, u32 samples, Math::SplitMix64& rng) {
+    static u32 flips[64 * 8 * 64];
+    std::fill_n(flips, len * 8 * 64, 0);
+    byte key[64];
+    for (u32 s = 0; s < samples; ++s) {
+        for (usize i = 0; i < len; ++i) key[i] = (byte)rng.Next64();
+        const u64 seed = rng.Next64();
+        const u64 h = Rapid(key, len, seed);
+        for (usize bit = 0; bit < len * 8; ++bit) {
+            key[bit / 8] ^= (byte)(1 << bit % 8);
+            u64 diff = h ^ Rapid(key, len, seed);
+            key[bit / 8] ^= (byte)(1 << bit % 8);
+            for (usize out = 0; out < 64; ++out, diff >>= 1) flips[bit * 64 + out] += diff & 1;
+        }
+    }
+    double worst = 0;
+    for (const u32 f : Spans::Slice(flips, len * 8 * 64)) worst = std::max(worst, std::abs((double)f / samples - 0.5));
+    return worst;
+}
+
+// collisions in the full hash, and in each 32 bit half of it, which is all a table ever looks at
+struct Collisions { usize full, low, high; };
+
+static Collisions CountCollisions(Vec<u64>& hashes) {
+    Collisions c {};
+    const auto count = [&] (auto&& key) {
+        Vec<u64> keys = Vec<u64>::WithCap(hashes.Length());
+        for (const u64 h : hashes) keys.Push(key(h));
+        std::sort(keys.Data(), keys.Data() + keys.Length());
+        usize n = 0;
+        for (usize i = 1; i < keys.Length(); ++i) n += keys[i] == keys[i - 1];
+        return n;
+    };
+    c.full = count([] (u64 h) { return h; });
+    c.low  = count([] (u64 h) { return h & 0xFFFFFFFF; });
+    c.high = count([] (u64 h) { return h >> 32; });
+    return c;
+}
+
+int main() {
+    byte counting[300];
+    for (usize i = 0; i < std::size(counting); ++i) counting[i] = (byte)i;
+
+    for (usize len = 0; len <= 64; ++len) {
+        const u64 h = Rapid(counting, len, Reference::RAPID_SEED);
+        if (!QCheck$(h == KNOWN_ANSWERS[len]))
+            std::fprintf(stderr, "  length %zu: 0x%016llx, expected 0x%016llx\n", len, (unsigned long long)h, (unsigned long long)KNOWN_ANSWERS[len]);
+    }
+
+    // past 64 too, where upstream unrolls its loop and Hash.cpp doesnt, with any seed and any bytes
+    Math::SplitMix64 rng { 0x4A54 };
+    byte key[300];
+    for (u32 i = 0; i < 20000; ++i) {
+        const usize len = i % std::size(key);
+        for (usize j = 0; j < len; ++j) key[j] = (byte)rng.Next64();
+        const u64 seed = i % 3 ? rng.Next64() : 0;
+        QCheck$(Rapid(key, len, seed) == Reference::rapidhash_withSeed(key, len, seed));
+    }
+
+    // 20000 samples put 6 standard deviations at about 0.02
+    for (const usize len : { 1, 2, 3, 4, 7, 8, 12, 16, 17, 24, 32, 33, 48, 49, 64 }) {
+        const double worst = WorstAvalanche(len, 20000, rng);
+        if (!QCheck$(worst < 0.025))
+            std::fprintf(stderr, "  length %zu: an output bit flips with bias %.4f\n", len, worst);
+    }
+
+    {
+        // every key of 0, 1 and 2 bytes, then every 3 byte key over a 64 letter alphabet
+        Vec<u64> hashes;
+        for (usize len = 0; len <= 2; ++len)
+            for (u32 k = 0; k < 1u << len * 8; ++k) {
+                const byte bytes[2] = { (byte)k, (byte)(k >> 8) };
+                hashes.Push(Rapid(bytes, len, 0));
+            }
+        static constexpr char ALPHABET[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_.";
+        for (u32 k = 0; k < 64 * 64 * 64; ++k) {
+            const byte bytes[3] = { (byte)ALPHABET[k % 64], (byte)ALPHABET[k / 64 % 64], (byte)ALPHABET[k / 4096] };
+            hashes.Push(Rapid(bytes, 3, 0));
+        }
+
+        // about 8.5 expected in each half for 327937 keys, so 30 would be way off
+        const Collisions c = CountCollisions(hashes);
+        QCheck$(c.full == 0);
+        if (!QCheck$(c.low < 30 && c.high < 30))
+            std::fprintf(stderr, "  %zu keys: %zu collisions in the low 32 bits, %zu in the high\n", hashes.Length(), c.low, c.high);
+    }
+    {
+        // keys that differ in only one or two bits, the sparse keys from smhasher
+        Vec<u64> hashes;
+        for (const usize len : { 8, 16, 32, 64 }) {
+            byte sparse[64] {};
+            hashes.Push(Rapid(sparse, len, 0));
+            for (usize a = 0; a < len * 8; ++a) {
+                sparse[a / 8] ^= (byte)(1 << a % 8);
+                hashes.Push(Rapid(sparse, len, 0));
+                for (usize b = a + 1; b < len * 8; ++b) {
+                    sparse[b / 8] ^= (byte)(1 << b % 8);
+                    hashes.Push(Rapid(sparse, len, 0));
+                    sparse[b / 8] ^= (byte)(1 << b % 8);
+                }
+                sparse[a / 8] ^= (byte)(1 << a % 8);
+            }
+        }
+        const Collisions c = CountCollisions(hashes);
+        QCheck$(c.full == 0);
+        if (!QCheck$(c.low < 30 && c.high < 30))
+            std::fprintf(stderr, "  %zu sparse keys: %zu collisions in the low 32 bits, %zu in the high\n", hashes.Length(), c.low, c.high);
+    }
+
+    // the seed changes everything, the empty key included
+    QCheck$(Rapid(counting, 0, 0) != Rapid(counting, 0, 1));
+    QCheck$(Rapid(counting, 5, 0) != Rapid(counting, 5, 1));
+#ifndef Q_HASH_BYTES_MURMUR
+    QCheck$((u64)Hashing::HashBytes(Spans::Slice(counting, 40)) == Reference::rapidhash_withSeed(counting, 40, 0));
+#endif
+
+    return Test::Finish("HashTests");
+}
@@ -0,0 +1,317 @@
+#include "Test.h"
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+#include "ModelLoading/LevelLoader.h"
+#include "Utils/CStr.h"
+#include "Utils/Text/Json.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using Text::JsonIndexer, Text::JsonParser, Text::JsonValue;
+
+static constexpr JsonIndexer::Level LEVELS[] = { JsonIndexer::SCALAR, JsonIndexer::SSE2, JsonIndexer::AVX2 };
+
+// what stage 1 should find, one byte at a time. backslashes escape the next byte anywhere,
+// the same as the block kernels, but only an escaped quote is treated any differently
+static bool ReferenceIndex(Str json, Vec<u32>& out) {
+    bool inString = false, escaped = false, prevScalar = false;
+    for (u32 i = 0; i < json.Length(); ++i) {
+        const char c = json[i];
+        const bool quote = c == '"' && !escaped;
+        escaped = c == '\\' && !escaped;
+        if (quote) inString = !inString;
+        const bool op = c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+        const bool space = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        const bool scalar = !(op || space || c == '"' || inString);
+        if ((op && !inString) || (quote && inString) || (scalar && !prevScalar)) out.Push(i);
+        prevScalar = scalar;
+    }
+    return !inString;
+}
+
+// a parse result in a form that can be compared across levels
+struct Outcome {
+    bool ok = false;
+    String dump;
+    Str error;
+    usize errorOffset = 0;
+
+    bool operator==(const Outcome& o) const { return ok == o.ok && dump == o.dump && error == o.error && errorOffset == o.errorOffset; }
+};
+
+static void Dump(JsonValue v, String& out) {
+    switch (v.GetType()) {
+        case JsonValue::NUL:    out += "null"; break;
+        case JsonValue::BOOL:   out += *v.AsBool() ? "true" : "false"; break;
+        case JsonValue::INT:    Text::FormatTo(Text::StringWriter::WriteTo(out), "i{}"_fmt, *v.AsInt()); break;
+        case JsonValue::FLOAT:  Text::FormatTo(Text::StringWriter::WriteTo(out), "d{}"_fmt, std::bit_cast<u64>(*v.AsFloat())); break;
+        case JsonValue::STRING: out += '"'; out += *v.AsStr(); out += '"'; break;
+        case JsonValue::ARRAY:
+            Text::FormatTo(Text::StringWriter::WriteTo(out), "[{}:"_fmt, v.Length());
+            for (const JsonValue e : v.Elements()) { Dump(e, out); out += ','; }
+            out += ']';
+            break;
+        case JsonValue::OBJECT:
+            Text::FormatTo(Text::StringWriter::WriteTo(out), "{{{}:"_fmt, v.Length());
+            for (const Text::JsonMember m : v.Members()) { out += m.key; out += '='; Dump(m.value, out); out += ','; }
+            out += '}';
+            break;
+    }
+}
+
+static Outcome ParseAt(JsonIndexer::Level level, Str json) {
+    JsonIndexer::UseLevel(level);
+    JsonParser parser;
+    Outcome o;
+    const Option<Text::JsonDocument> doc = parser.Parse(json);
+    o.ok = doc.HasValue();
+    if (doc) Dump(doc->Root(), o.dump);
+    o.error = parser.Error();
+    o.errorOffset = parser.ErrorOffset();
+    return o;
+}
+
+// parses json with every kernel this cpu has, checks they all agree and returns what they got
+static Outcome ParseAll(Str json) {
+    const Outcome scalar = ParseAt(JsonIndexer::SCALAR, json);
+    for (const JsonIndexer::Level level : LEVELS) {
+        if (level == JsonIndexer::SCALAR || level > JsonIndexer::BestLevel()) continue;
+        const Outcome simd = ParseAt(level, json);
+        if (!QCheck$(simd == scalar))
+            std::fprintf(stderr, "  %s disagrees with scalar on: %.*s\n", JsonIndexer::LevelName(level).Data(), (int)json.Length(), json.Data());
+    }
+    JsonIndexer::UseLevel(JsonIndexer::BestLevel());
+    return scalar;
+}
+
+static Option<String> ParseStr(Str json) {
+    JsonParser parser;
+    const Outcome o = ParseAll(json);
+    if (!o.ok) return nullptr;
+    const Option<Text::JsonDocument> doc = parser.Parse(json);
+    return String { *doc->Root().AsStr() };
+}
+
+static Option<JsonValue> ParseNumber(Str json, Text::JsonDocument& doc) {
+    if (!ParseAll(json).ok) return nullptr;
+    JsonParser parser;
+    doc = *parser.Parse(json);
+    return doc.Root();
+}
+
+static void TestIndexerAgainstReference() {
+    // random soup of everything the classifier cares about, so escapes and strings land on every block offset
+    static constexpr char ALPHABET[] = "\"\\\\\\{}[]:, \n\t\ra1-e.";
+    Math::SplitMix64 rng { 0x15011 };
+    for (u32 round = 0; round < 20000; ++round) {
+        String json;
+        for (u64 n = rng.Next64() % 400; n --> 0; ) json += ALPHABET[rng.Next64() % (sizeof(ALPHABET) - 1)];
+
+        Vec<u32> expected;
+        const bool expectedClosed = ReferenceIndex(json, expected);
+        for (const JsonIndexer::Level level : LEVELS) {
+            if (level > JsonIndexer::BestLevel()) continue;
+            JsonIndexer::UseLevel(level);
+            Vec<u32> got;
+            const bool closed = JsonIndexer::Index(json, got);
+            if (!QCheck$(closed == expectedClosed && got.AsSpan() == expected.AsSpan())) {
+                std::fprintf(stderr, "  %s, round %u\n", JsonIndexer::LevelName(level).Data(), round);
+                JsonIndexer::UseLevel(JsonIndexer::BestLevel());
+                return;
+            }
+        }
+    }
+    JsonIndexer::UseLevel(JsonIndexer::BestLevel());
+}
+
+static void TestEscapesAcrossBlocks() {
+    // a run of n backslashes at every offset around the first block boundary. an odd run escapes the quote after it,
+    // an even one leaves it to close the string
+    for (u32 pad = 40; pad < 72; ++pad)
+        for (u32 n = 0; n < 10; ++n) {
+            String json = "[\"", expected;
+            for (u32 i = 0; i < pad; ++i) { json += 'a'; expected += 'a'; }
+            for (u32 i = 0; i < n; ++i) json += '\\';
+            for (u32 i = 0; i < n / 2; ++i) expected += '\\';
+            if (n % 2) { json += '"'; expected += '"'; }
+            json += "\", 1]";
+
+            const Outcome o = ParseAll(json);
+            String dump = "[2:\"";
+            dump += expected;
+            dump += "\",i1,]";
+            QCheck$(o.ok && o.dump == dump);
+        }
+
+    // a run long enough to cover whole blocks, then an escaped quote
+    String json = "\"", expected;
+    for (u32 i = 0; i < 301; ++i) json += '\\';
+    json += "\"\"";
+    for (u32 i = 0; i < 150; ++i) expected += '\\';
+    expected += '"';
+    QCheck$(ParseStr(json) == expected);
+
+    QCheck$(ParseStr(R"("tab\there \"quoted\" back\\slash \/ \b\f\n\r")") == Str { "tab\there \"quoted\" back\\slash / \b\f\n\r" });
+    QCheck$(!ParseStr(R"("bad \x escape")"));
+    QCheck$(!ParseStr(R"("ends in a backslash\")"));
+}
+
+static void TestUnicodeEscapes() {
+    QCheck$(ParseStr(R"("\u0041\u00e9\u20AC")") == Str { "A\xC3\xA9\xE2\x82\xAC" });
+    // a surrogate pair becomes one 4 byte character
+    QCheck$(ParseStr(R"("\ud83d\ude00")") == Str { "\xF0\x9F\x98\x80" });
+    QCheck$(ParseStr(R"("\uD800\uDC00\uDBFF\uDFFF")") == Str { "\xF0\x90\x80\x80\xF4\x8F\xBF\xBF" });
+    // and one split across the first block boundary
+    String json = "\"";
+    for (u32 i = 0; i < 60; ++i) json += ' ';
+    json += R"(\ud83d\ude00")";
+    const Option<String> split = ParseStr(json);
+    QCheck$(split && split->Length() == 64 && split->Substr(60) == Str { "\xF0\x9F\x98\x80" });
+
+    for (const Str bad : { R"("\ud83d")", R"("\ude00")", R"("\ud83dx")", R"("\ud83dA")", R"("\ud83d\n")",
+                           R"("\u12g4")", R"("\u12")", R"("\u")" })
+        QCheck$(!ParseStr(bad));
+}
+
+static void TestNumbers() {
+    Text::JsonDocument doc;
+    const auto asInt = [&] (Str json) { return ParseNumber(json, doc).AndThen([] (JsonValue v) { return v.AsInt(); }); };
+    QCheck$(asInt("0") == 0 && asInt("-0") == 0 && asInt("42") == 42 && asInt("-17") == -17);
+    QCheck$(asInt("9223372036854775807") == i64s::MAX);
+    QCheck$(asInt("-9223372036854775808") == i64s::MIN);
+
+    // past what an i64 holds they turn into doubles, as do fractions and exponents
+    for (const char* number : { "9223372036854775808", "-9223372036854775809", "12345678901234567890123",
+                                "0.1", "-0.0", "1e2", "1E+2", "2.5e-3", "1.7976931348623157e308", "2.2250738585072014e-308",
+                                "4.9406564584124654e-324", "2.4703282292062328e-324", "0.30000000000000004",
+                                "1e400", "1e-400", "9007199254740993.0", "123456789012345678901234567890e-10" }) {
+        const Option<JsonValue> v = ParseNumber(Str::Slice(number, std::strlen(number)), doc);
+        const f64 expected = std::strtod(number, nullptr);
+        if (!QCheck$(v && v->GetType() == JsonValue::FLOAT && std::bit_cast<u64>(*v->AsFloat()) == std::bit_cast<u64>(expected)))
+            std::fprintf(stderr, "  number: %s\n", number);
+    }
+
+    for (const Str bad : { "01", "-", "-01", "1.", ".5", "1e", "1e+", "+1", "--1", "0x10", "1.5.2", "1e5.5",
+                           "Infinity", "NaN", "- 1", "1 2" })
+        if (!QCheck$(!ParseNumber(bad, doc)))
+            std::fprintf(stderr, "  should fail: %.*s\n", (int)bad.Length(), bad.Data());
+}
+
+static void TestNesting() {
+    const auto nested = [] (u32 depth, Str open, Str inner, Str close) {
+        String json;
+        for (u32 i = 0; i < depth; ++i) json += open;
+        json += inner;
+        for (u32 i = 0; i < depth; ++i) json += close;
+        return json;
+    };
+
+    // the root counts as the first level
+    const String deepest = nested(JsonParser::MAX_DEPTH, "[", "", "]");
+    QCheck$(ParseAll(deepest).ok);
+    const Outcome tooDeep = ParseAll(nested(JsonParser::MAX_DEPTH + 1, "[", "", "]"));
+    QCheck$(!tooDeep.ok && tooDeep.error == "json is nested too deep");
+
+    // objects and arrays both count, so this is twice as deep as it looks
+    QCheck$(!ParseAll(nested(JsonParser::MAX_DEPTH / 2 + 1, "{\"k\":[", "7", "]}")).ok);
+    const String halfObjects = nested(JsonParser::MAX_DEPTH / 2, "{\"k\":[", "7", "]}");
+    JsonParser parser;
+    const Option<Text::JsonDocument> doc = parser.Parse(halfObjects);
+    Option<JsonValue> v = doc->Root();
+    for (u32 i = 0; i < JsonParser::MAX_DEPTH / 2 && v; ++i)
+        v = v->Get("k").AndThen([] (JsonValue a) { return a.At(0); });
+    QCheck$(v && v->AsInt() == 7);
+}
+
+static void TestMalformed() {
+    for (const Str bad : { "", " ", "{", "}", "[", "]", "[1,]", "[1 2]", "[,1]", "{\"a\" 1}", "{\"a\":}", "{1:2}",
+                           "{\"a\":1,}", "{\"a\":1 \"b\":2}", "\"abc", "[\"abc]", "tru", "nul", "truee", "[true false]",
+                           "[1]]", "[1] [2]", "{\"a\"}", "[\"a\":1]", "\"\\\"", "[1}", "{\"a\":1]", "@", "[\"a\" \"b\"]" }) {
+        const Outcome o = ParseAll(bad);
+        if (!QCheck$(!o.ok && !o.error.IsEmpty()))
+            std::fprintf(stderr, "  should fail: %.*s\n", (int)bad.Length(), bad.Data());
+    }
+
+    // a byte order mark and whitespace around the root are fine
+    const Outcome bom = ParseAll("\xEF\xBB\xBF \n{ \"a\" : [ 1 , 2.5 , \"x\" , true , false , null ] }\r\n");
+    QCheck$(bom.ok && bom.dump == Str { "{1:a=[6:i1,d4612811918334230528,\"x\",true,false,null,],}" });
+}
+
+// json -> LevelData -> .qlevel -> LevelData, and a stale cache is ignored
+static void TestLevelRoundTrip() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string path = (dir / "QuasiJsonTests.level.json").string();
+    const CStr cpath = CStr::FromUnchecked(Str::Slice(path.data(), path.size()));
+    const String cachePath = Graphics::LevelCache::CachePathOf(Str::Slice(path.data(), path.size()));
+    std::filesystem::remove(path);
+    std::filesystem::remove(std::string { cachePath.Data(), cachePath.Length() });
+
+    String json = "\xEF\xBB\xBF{ \"LevelName\": \"caf\\u00e9 \\\"one\\\"\", \"Description\": \"line\\nbreak\", \"Tiles\": [";
+    Math::SplitMix64 rng { 0x1E7E1 };
+    for (u32 i = 0; i < 5000; ++i) {
+        const int x = (int)(rng.Next64() % 2001) - 1000, y = (int)(rng.Next64() % 21) - 10, z = (int)(rng.Next64() % 2001) - 1000;
+        Text::FormatTo(Text::StringWriter::WriteTo(json), "{}{{ \"Type\": {}, \"Position\": [{}, {}, {}] }}"_fmt, i ? Str { "," } : Str {}, i % 7, x, y, z);
+    }
+    json += "] }";
+    const auto writeJson = [&] {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        std::fwrite(json.Data(), 1, json.Length(), f);
+        std::fclose(f);
+    };
+    writeJson();
+
+    Graphics::LevelLoader fromJson;
+    fromJson.UseCache(false);
+    QCheck$(fromJson.Load(json));
+    const Graphics::LevelData& level = fromJson.GetLevel();
+    QCheck$(level.name == Str { "caf\xC3\xA9 \"one\"" } && level.description == Str { "line\nbreak" } && level.tiles.Length() == 5000);
+
+    // the first LoadFile parses the json and writes the cache
+    Graphics::LevelLoader first;
+    first.LoadFile(cpath);
+    const Option<Text::FileInfo> source = Text::GetFileInfo(cpath);
+    const Graphics::LevelCache cache = Graphics::LevelCache::Open(CStr::FromUnchecked(cachePath), *source);
+    if (!QCheck$(!cache.IsNull())) return;
+
+    QCheck$(cache.Name() == level.name && cache.Description() == level.description);
+    QCheck$(cache.BoundMin() == level.boundMin && cache.BoundMax() == level.boundMax);
+    const auto sameTiles = [&] (Span<const Graphics::LevelTile> tiles) {
+        return tiles.EqualsBy(level.tiles, [] (const Graphics::LevelTile& a, const Graphics::LevelTile& b) {
+            return a.position == b.position && a.type == b.type;
+        });
+    };
+    QCheck$(sameTiles(cache.Tiles()));
+
+    // the second one reads it back
+    Graphics::LevelLoader second;
+    second.LoadFile(cpath);
+    QCheck$(second.GetLevel().name == level.name && second.GetLevel().boundMin == level.boundMin &&
+            second.GetLevel().boundMax == level.boundMax && sameTiles(second.GetLevel().tiles));
+
+    // once the json changes the cache doesnt match it anymore
+    json += "\n";
+    writeJson();
+    QCheck$(Graphics::LevelCache::Open(CStr::FromUnchecked(cachePath), *Text::GetFileInfo(cpath)).IsNull());
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(std::string { cachePath.Data(), cachePath.Length() });
+}
+
+int main() {
+    // kernels the cpu doesnt have are skipped
+    std::printf("checking json kernels up to %s\n", JsonIndexer::LevelName(JsonIndexer::BestLevel()).Data());
+
+    TestIndexerAgainstReference();
+    TestEscapesAcrossBlocks();
+    TestUnicodeEscapes();
+    TestNumbers();
+    TestNesting();
+    TestMalformed();
+    TestLevelRoundTrip();
+
+    return Test::Finish("JsonTests");
+}
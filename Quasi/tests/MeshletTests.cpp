@@ -0,0 +1,189 @@
+#include "Test.h"
+
+#include <cmath>
+
+#include "CameraController3D.h"
+#include "Meshlets.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+static constexpr u32 PATCH_VERTICES = 81;
+
+// an 8x8 grid of unit quads spanned by u and v, facing u x v, with its corner at origin. by default on the z = 0 plane, facing +z
+static void AddPatch(Vec<Math::fv3>& positions, Vec<TriIndices>& indices, const Math::fv3& origin,
+                     const Math::fv3& u = { 1, 0, 0 }, const Math::fv3& v = { 0, 1, 0 }) {
+    static constexpr u32 N = 8;
+    const u32 base = (u32)positions.Length();
+    for (u32 y = 0; y <= N; ++y)
+        for (u32 x = 0; x <= N; ++x)
+            positions.Push(origin + u * (f32)x + v * (f32)y);
+    for (u32 y = 0; y < N; ++y)
+        for (u32 x = 0; x < N; ++x) {
+            const u32 v00 = base + y * (N + 1) + x, v10 = v00 + 1, v01 = v00 + N + 1, v11 = v01 + 1;
+            indices.Push({ v00, v10, v11 });
+            indices.Push({ v00, v11, v01 });
+        }
+}
+
+// an axis aligned box, as the 6 inward facing planes
+static Meshlets::Frustum BoxFrustum(const Math::fv3& min, const Math::fv3& max) {
+    return { {
+        Math::fv4 { 1, 0, 0, -min.x }, Math::fv4 { -1, 0, 0, max.x },
+        Math::fv4 { 0, 1, 0, -min.y }, Math::fv4 { 0, -1, 0, max.y },
+        Math::fv4 { 0, 0, 1, -min.z }, Math::fv4 { 0, 0, -1, max.z },
+    } };
+}
+
+// a ring of patches around the origin, all facing in. patch k is straight ahead at yaw 2pi k / RING_COUNT
+static constexpr u32 RING_COUNT = 8;
+static constexpr f32 RING_RADIUS = 30;
+
+struct Ring {
+    Vec<Math::fv3> positions;
+    Vec<TriIndices> indices;
+    Math::fv3 normals[RING_COUNT];
+
+    Ring() {
+        for (u32 k = 0; k < RING_COUNT; ++k) {
+            const f32 a = Math::TAU * (f32)k / RING_COUNT;
+            // the camera looks down -z at yaw 0, and turns towards -x
+            const Math::fv3 center = Math::fv3 { -std::sin(a), 0, -std::cos(a) } * RING_RADIUS,
+                            u = { std::cos(a), 0, -std::sin(a) }, v = { 0, 1, 0 };
+            normals[k] = u.Cross(v);
+            AddPatch(positions, indices, center - u * 4 - v * 4, u, v);
+        }
+    }
+};
+
+// the patches that have to show up: some vertex is inside the camera's clip volume, and the patch faces the camera.
+// and the ones that cant: entirely behind the camera, or the camera is well behind the patch's plane.
+// anything else sits where a bounding sphere may or may not reach, and is left alone
+struct Expected { u32 mustShow = 0, mustHide = 0; };
+
+static Expected Reference(const Ring& ring, const CameraController3D& camera, float aspect) {
+    const Math::Matrix3D viewProj = camera.GetProjMat(aspect) * camera.GetViewMat();
+    Expected e;
+    for (u32 k = 0; k < RING_COUNT; ++k) {
+        bool anyInside = false, allBehind = true;
+        for (u32 i = 0; i < PATCH_VERTICES; ++i) {
+            const Math::fv3& p = ring.positions[k * PATCH_VERTICES + i];
+            const Math::fv4 clip = viewProj * Math::fv4 { p.x, p.y, p.z, 1 };
+            anyInside |= std::abs(clip.x) < clip.w && std::abs(clip.y) < clip.w && std::abs(clip.z) < clip.w;
+            // further behind the camera than a patch is wide
+            allBehind &= clip.w < -12;
+        }
+        const float side = ring.normals[k].Dot(camera.position - ring.positions[k * PATCH_VERTICES]);
+        if (anyInside && side > 0) e.mustShow |= 1 << k;
+        if (allBehind || side < -12) e.mustHide |= 1 << k;
+    }
+    return e;
+}
+
+// culls the ring from wherever the camera is, and checks the surviving patches and triangles against the reference
+static bool CheckView(const Ring& ring, const Meshlets::MeshletSet& set, const CameraController3D& camera, float aspect,
+                      Option<u32> exactly = nullptr) {
+    Vec<TriIndices> out;
+    const Meshlets::CullStats stats = Meshlets::Cull(set, Meshlets::Frustum::FromCamera(camera, aspect), camera.position, out);
+
+    u32 shown = 0;
+    bool original = true;
+    for (const TriIndices& t : out) {
+        const u32 k = t.i / PATCH_VERTICES;
+        shown |= 1 << k;
+        // every triangle comes out whole, as it was in the mesh
+        original &= t.j / PATCH_VERTICES == k && t.k / PATCH_VERTICES == k &&
+                    ring.indices.AsSpan().FindIf([&] (const TriIndices& x) { return x.i == t.i && x.j == t.j && x.k == t.k; }).HasValue();
+    }
+    const Expected e = Reference(ring, camera, aspect);
+    const bool ok = original && stats.visibleTriangles == out.Length() &&
+                    stats.visibleMeshlets + stats.frustumCulled + stats.backfaceCulled == set.meshlets.Length() &&
+                    (shown & e.mustShow) == e.mustShow && (shown & e.mustHide) == 0 &&
+                    (exactly.IsNull() || shown == exactly.Unwrap());
+    if (!ok)
+        std::fprintf(stderr, "  at (%g, %g, %g) yaw %g pitch %g: shown %x, must show %x, must hide %x\n",
+                     camera.position.x, camera.position.y, camera.position.z, camera.yaw, camera.pitch, shown, e.mustShow, e.mustHide);
+    return ok;
+}
+
+int main() {
+    Vec<Math::fv3> positions;
+    Vec<TriIndices> indices;
+    // two patches far apart, 128 triangles each. at 64 triangles a meshlet, neither shares a meshlet
+    AddPatch(positions, indices, { 0, 0, 0 });
+    AddPatch(positions, indices, { 100, 0, 0 });
+
+    const Meshlets::MeshletSet set = Meshlets::Build(indices, positions, 64, 64);
+    QCheck$(set.TriangleCount() == 256);
+    QCheck$(set.meshlets.Length() == 4);
+    for (const Meshlets::Meshlet& m : set.meshlets) {
+        QCheck$(m.vertexCount <= 64 && m.triangleCount <= 64);
+        // every triangle of a flat patch faces the same way
+        QCheck$(m.coneCutoff < 0.01f);
+    }
+
+    Vec<TriIndices> out;
+    const Math::fv3 front = { 4, 4, 10 }, behind = { 4, 4, -10 };
+
+    // everything in view
+    Meshlets::CullStats stats = Meshlets::Cull(set, BoxFrustum({ -10, -10, -10 }, { 110, 10, 10 }), front, out);
+    QCheck$(stats.visibleTriangles == 256 && out.Length() == 256);
+    QCheck$(stats.visibleMeshlets == 4 && stats.frustumCulled == 0 && stats.backfaceCulled == 0);
+
+    // only the first patch in view
+    stats = Meshlets::Cull(set, BoxFrustum({ -10, -10, -10 }, { 20, 10, 10 }), front, out);
+    QCheck$(stats.visibleTriangles == 128 && out.Length() == 128);
+    QCheck$(stats.frustumCulled == 2);
+    for (const TriIndices& t : out) QCheck$(t.i < 81 && t.j < 81 && t.k < 81);
+
+    // nothing in view
+    stats = Meshlets::Cull(set, BoxFrustum({ 200, 200, 200 }, { 210, 210, 210 }), front, out);
+    QCheck$(stats.visibleTriangles == 0 && out.IsEmpty() && stats.frustumCulled == 4);
+
+    // seen from behind, both patches face away
+    stats = Meshlets::Cull(set, BoxFrustum({ -10, -10, -10 }, { 110, 10, 10 }), behind, out);
+    QCheck$(stats.visibleTriangles == 0 && stats.backfaceCulled == 4);
+    stats = Meshlets::Cull(set, BoxFrustum({ -10, -10, -10 }, { 20, 10, 10 }), behind, out);
+    QCheck$(stats.visibleTriangles == 0 && stats.backfaceCulled == 2);
+    // unless backface culling is off
+    stats = Meshlets::Cull(set, BoxFrustum({ -10, -10, -10 }, { 20, 10, 10 }), behind, out, false);
+    QCheck$(stats.visibleTriangles == 128 && stats.backfaceCulled == 0);
+
+    // the identity matrix is the [-1, 1] clip cube
+    const Meshlets::Frustum clip = Meshlets::Frustum::FromMatrix(Math::Matrix3D::Identity());
+    QCheck$(clip.IntersectsSphere({ 0, 0, 0 }, 0.1f));
+    QCheck$(clip.IntersectsSphere({ 1.5f, 0, 0 }, 0.6f));
+    QCheck$(!clip.IntersectsSphere({ 1.5f, 0, 0 }, 0.4f));
+    QCheck$(!clip.IntersectsSphere({ 0, 0, -3 }, 1));
+
+    {
+        const Ring ring;
+        // half a patch per meshlet, so no meshlet spans two patches and the reference can go patch by patch
+        const Meshlets::MeshletSet set = Meshlets::Build(ring.indices, ring.positions, 64, 64);
+        QCheck$(set.meshlets.Length() == 2 * RING_COUNT);
+        CameraController3D camera;
+        camera.position = { 0, 0, 0 };
+
+        // turning in place: a 45 degree fov sees exactly the patch its facing, the neighbours are 45 degrees off
+        for (u32 k = 0; k < RING_COUNT; ++k) {
+            camera.yaw = Math::TAU * (f32)k / RING_COUNT;
+            QCheck$(CheckView(ring, set, camera, 1, 1u << k));
+        }
+        // and a wide window sees a bit more, in between two patches
+        for (u32 step = 0; step < 64; ++step) {
+            camera.yaw = Math::TAU * (f32)step / 64;
+            QCheck$(CheckView(ring, set, camera, 16.0f / 9));
+        }
+
+        // a scripted fly through: across the ring and out the other side, bobbing and looking around on the way
+        for (u32 step = 0; step <= 120; ++step) {
+            const f32 t = (f32)step / 120;
+            camera.position = { std::lerp(-45.0f, 45.0f, t), 6 * std::sin(t * Math::TAU), std::lerp(20.0f, -20.0f, t) };
+            camera.yaw   = -Math::HALF_PI + std::sin(t * 3 * Math::TAU);
+            camera.pitch = 0.4f * std::cos(t * 2 * Math::TAU);
+            QCheck$(CheckView(ring, set, camera, 16.0f / 9));
+        }
+    }
+
+    return Test::Finish("MeshletTests");
+}
@@ -0,0 +1,141 @@
+#include "Test.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "Utils/Text.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+template <class F>
+static String FormatWith(F f, Str spec) {
+    String s;
+    Text::FormatObjectTo(Text::StringWriter::WriteTo(s), f, spec);
+    return s;
+}
+
+// printf zero pads the exponent and writes its +, this repo doesnt
+static String FromPrintf(const char* fmt, int precision, f64 f) {
+    char buf[512];
+    std::snprintf(buf, sizeof(buf), fmt, precision, f);
+    String s;
+    for (const char* c = buf; *c; ++c) {
+        if (*c != 'e') { s += *c; continue; }
+        s += 'e';
+        if (*++c == '-') s += '-';
+        else s += '+';
+        ++c;
+        while (*c == '0' && c[1]) ++c;
+        s += Str::Slice(c, std::strlen(c));
+        break;
+    }
+    return s;
+}
+
+static bool Matches(const String& s, Str expected) {
+    if (s == expected) return true;
+    std::fprintf(stderr, "  got \"%.*s\", expected \"%.*s\"\n",
+        (int)s.Length(), s.Data(), (int)expected.Length(), expected.Data());
+    return false;
+}
+
+static f64 RandomDouble(Math::SplitMix64& rng) {
+    // any finite bit pattern, so subnormals and huge exponents show up as often as ordinary values
+    for (;;) {
+        const f64 f = f64s::FromBits(rng.Next64());
+        if (f64s::IsFinite(f)) return f;
+    }
+}
+
+// formats every finite f32 in [begin, end) the shortest way and reads it back, returns how many didnt come back the same
+static u64 RoundTripRange(u64 begin, u64 end, std::atomic<u64>& firstBad) {
+    u64 bad = 0;
+    char buffer[64];
+    for (u64 bits = begin; bits < end; ++bits) {
+        const f32 f = f32s::FromBits((u32)bits);
+        if (!f32s::IsFinite(f)) continue;
+        Span<char> rest = Span<char>::Slice(buffer, sizeof(buffer));
+        Text::FormatObjectTo(Text::StringWriter::WriteToBuffer(rest), f, Str::Empty());
+        const Str s = Str::Slice(buffer, sizeof(buffer) - rest.Length());
+        f32 back;
+        const OptionUsize read = Text::Parser<f32>::ParseUntil(s, back, {});
+        if (read && *read == s.Length() && f32s::BitsOf(back) == (u32)bits) continue;
+        if (!bad++) {
+            u64 none = u64s::MAX;
+            firstBad.compare_exchange_strong(none, bits);
+        }
+    }
+    return bad;
+}
+
+static bool AllFloatsRoundTrip() {
+    const u32 threads = std::max(1u, std::thread::hardware_concurrency());
+    const u64 total = 1ull << 32, chunk = total / threads + 1;
+    std::atomic<u64> bad = 0, firstBad = u64s::MAX;
+    Vec<std::thread> workers;
+    for (u32 t = 0; t < threads; ++t)
+        workers.Push(std::thread { [&, t] {
+            bad += RoundTripRange(t * chunk, std::min(total, (t + 1) * chunk), firstBad);
+        } });
+    for (std::thread& w : workers) w.join();
+
+    if (bad) {
+        const f32 f = f32s::FromBits((u32)firstBad.load());
+        const String s = FormatWith(f, "");
+        std::fprintf(stderr, "  %llu f32s didnt round trip, the first was %.9g, written \"%.*s\"\n",
+                     (unsigned long long)bad.load(), f, (int)s.Length(), s.Data());
+    }
+    return bad == 0;
+}
+
+int main() {
+    // the precision rounds the exact binary value, not the shortest digits
+    QCheck$(Matches(FormatWith(0.015,  ".2f"), "0.01"));
+    QCheck$(Matches(FormatWith(2.675,  ".2f"), "2.67"));
+    QCheck$(Matches(FormatWith(2.675,  ".3g"), "2.67"));
+    QCheck$(Matches(FormatWith(5e-324, ".3g"), "4.94e-324"));
+    QCheck$(Matches(FormatWith(0.5,    ".0f"), "0"));
+    QCheck$(Matches(FormatWith(1.5,    ".0f"), "2"));
+    QCheck$(Matches(FormatWith(9.995,  ".2f"), "9.99"));
+    QCheck$(Matches(FormatWith(9.9999, ".3e"), "1.000e+1"));
+    QCheck$(Matches(FormatWith(0.0,    ".2e"), "0.00e+0"));
+    QCheck$(Matches(FormatWith(-0.0,   ".1f"), "-0.0"));
+    QCheck$(Matches(FormatWith(0.125,  ".1%"), "12.5%"));
+    QCheck$(Matches(FormatWith(1e22,   ".0f"), "10000000000000000000000"));
+    QCheck$(Matches(FormatWith(0.1f,   ".10f"), "0.1000000015"));
+    QCheck$(Matches(FormatWith(0.1,    ""), "0.1"));
+
+    Math::SplitMix64 rng { 0x5EED };
+    // the shortest form has to read back to the same bits
+    for (u32 i = 0; i < 200000; ++i) {
+        const f64 f = RandomDouble(rng);
+        const String s = FormatWith(f, "");
+        const Option<f64> back = Text::Parse<f64>(s);
+        if (!QCheck$(back && f64s::BitsOf(*back) == f64s::BitsOf(f)))
+            std::fprintf(stderr, "  %.17g wrote \"%.*s\"\n", f, (int)s.Length(), s.Data());
+    }
+    // every f32 there is, split over all the cores
+    QCheck$(AllFloatsRoundTrip());
+
+    // with a precision, every digit has to agree with printf
+    static constexpr u32 PRECISIONS[] = { 0, 1, 2, 3, 6, 9, 17, 30 };
+    char spec[8];
+    for (u32 i = 0; i < 20000 && !Test::failures; ++i) {
+        const f64 f = RandomDouble(rng);
+        const u32 p = PRECISIONS[i % std::size(PRECISIONS)];
+        for (const char mode : { 'e', 'g' }) {
+            std::snprintf(spec, sizeof(spec), ".%u%c", p, mode);
+            const char* cfmt = mode == 'e' ? "%.*e" : "%.*g";
+            QCheck$(Matches(FormatWith(f, Str::Slice(spec, std::strlen(spec))), FromPrintf(cfmt, (int)p, f)));
+        }
+        // fixed only where printf doesnt write hundreds of digits
+        if (std::abs(f) < 1e30) {
+            std::snprintf(spec, sizeof(spec), ".%uf", p);
+            QCheck$(Matches(FormatWith(f, Str::Slice(spec, std::strlen(spec))), FromPrintf("%.*f", (int)p, f)));
+        }
+    }
+
+    return Test::Finish("NumFormatTests");
+}
@@ -0,0 +1,250 @@
+#include "Test.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "Utils/CStr.h"
+#include "Utils/Text.h"
+#include "Utils/Text/Num.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+template <class F> static F StrToF(const char* s, char** end) {
+    if constexpr (sizeof(F) == 4) return std::strtof(s, end);
+    else return std::strtod(s, end);
+}
+
+// whether ParseUntil has to go past eisel-lemire for this string: more than 19 significant digits,
+// and the ones that were cut off change the rounding. the same digit split as the parser
+template <class F>
+static bool TakesLongDecimal(Str s) {
+    usize i = s.Length() && (s[0] == '-' || s[0] == '+');
+    u64 w = 0;
+    i64 q = 0;
+    u32 taken = 0;
+    bool truncated = false, fraction = false;
+    for (; i < s.Length() && (Chr::IsDigit(s[i]) || (s[i] == '.' && !fraction)); ++i) {
+        if (s[i] == '.') { fraction = true; continue; }
+        if (!taken && s[i] == '0') { q -= fraction; continue; }
+        if (taken < 19) { w = w * 10 + (u64)(s[i] - '0'); ++taken; q -= fraction; }
+        else { q += !fraction; truncated |= s[i] != '0'; }
+    }
+    if (!truncated) return false;
+    if (i < s.Length() && (s[i] | 0x20) == 'e') q += std::strtol(&s[i + 1], nullptr, 10);
+    using Conv = Text::NumberConversion::FloatConv<F>;
+    return Conv::EiselLemire(w, q) != Conv::EiselLemire(w + 1, q);
+}
+
+struct Counts { u64 checked = 0, wrong = 0, longDecimal = 0; };
+
+template <class F>
+static bool SameFloat(F a, F b) {
+    return NumInfo<F>::BitsOf(a) == NumInfo<F>::BitsOf(b) || (std::isnan(a) && std::isnan(b));
+}
+
+// parses s with ParseUntil and strtod/strtof, which have to agree on the value and on how much was read
+template <class F>
+static void Compare(const char* s, Counts& counts) {
+    const Str str = Str::Slice(s, std::strlen(s));
+    char* stdEnd;
+    const F expected = StrToF<F>(s, &stdEnd);
+    const usize expectedLen = (usize)(stdEnd - s);
+    F got {};
+    const OptionUsize len = Text::Parser<F>::ParseUntil(str, got, {});
+
+    ++counts.checked;
+    counts.longDecimal += TakesLongDecimal<F>(str);
+    if (len ? *len == expectedLen && SameFloat(got, expected) : expectedLen == 0) return;
+    if (counts.wrong++ < 8)
+        std::fprintf(stderr, "  f%zu \"%.80s\": got %.17g (%zu chars), strtod %.17g (%zu chars)\n",
+                     sizeof(F) * 8, s, (f64)got, len.UnwrapOr(0), (f64)expected, expectedLen);
+}
+
+template <class F>
+static void Compare(String& s, Counts& counts) {
+    Compare<F>(s.IntoCStr().Data(), counts);
+    s.TruncNullTerm();
+}
+
+// exact decimal digits of m * 2^k, written as an integer and a power of ten. limbs are base 1e9, least significant first
+static String ExactDecimal(u64 m, i32 k) {
+    Vec<u32> limbs;
+    for (; m; m /= 1'000'000'000) limbs.Push((u32)(m % 1'000'000'000));
+    const auto mul = [&] (u32 by) {
+        u64 carry = 0;
+        for (u32& l : limbs) {
+            carry += (u64)l * by;
+            l = (u32)(carry % 1'000'000'000);
+            carry /= 1'000'000'000;
+        }
+        if (carry) limbs.Push((u32)carry);
+    };
+    // m * 2^-k is m * 5^k / 10^k
+    for (i32 n = std::abs(k); n > 0; n -= 13) {
+        const u32 step = (u32)std::min(n, 13);
+        u32 pow = 1;
+        for (u32 i = 0; i < step; ++i) pow *= k < 0 ? 5 : 2;
+        mul(pow);
+    }
+
+    String s;
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%u", limbs.Last());
+    s += Str::Slice(buf, std::strlen(buf));
+    for (usize i = limbs.Length() - 1; i-- > 0;) {
+        std::snprintf(buf, sizeof(buf), "%09u", limbs[i]);
+        s += Str::Slice(buf, 9);
+    }
+    std::snprintf(buf, sizeof(buf), "e%d", std::min(k, 0));
+    s += Str::Slice(buf, std::strlen(buf));
+    return s;
+}
+
+// the exact point halfway between f and the next float up, and a hair above and below it.
+// these decide rounding with digits way past the 19th, so they go through FromLongDecimal
+template <class F>
+static void CompareMidpoints(F f, Counts& counts) {
+    using Info = NumInfo<F>;
+    const u64 bits = Info::BitsOf(f), exp = bits >> Info::MANTISSA_BITS, mantissa = bits & Info::MANTISSA_MASK;
+    const i32 bias = (1 << (Info::EXPONENT_BITS - 1)) - 1 + (i32)Info::MANTISSA_BITS;
+    const u64 m = exp ? mantissa | 1ULL << Info::MANTISSA_BITS : mantissa;
+    const i32 k = exp ? (i32)exp - bias : 1 - bias;
+
+    // (2m + 1) * 2^(k - 1)
+    String mid = ExactDecimal(2 * m + 1, k - 1);
+    Compare<F>(mid, counts);
+
+    const usize e = mid.AsStr().Find('e').Unwrap();
+    const i64 pow10 = std::strtoll(&mid[e + 1], nullptr, 10);
+    String above = mid.AsStr().First(e);
+    char tail[32];
+    std::snprintf(tail, sizeof(tail), "1e%lld", (long long)(pow10 - 1));
+    above += Str::Slice(tail, std::strlen(tail));
+    Compare<F>(above, counts);
+
+    // subtract one in the last place, then put some 9s after it
+    String below = mid.AsStr().First(e);
+    usize i = below.Length();
+    while (i-- > 0 && below[i] == '0') below[i] = '9';
+    --below[i];
+    std::snprintf(tail, sizeof(tail), "999e%lld", (long long)(pow10 - 3));
+    below += Str::Slice(tail, std::strlen(tail));
+    Compare<F>(below, counts);
+}
+
+template <class F>
+static F RandomFinite(Math::SplitMix64& rng) {
+    using Info = NumInfo<F>;
+    for (;;) {
+        const F f = Info::FromBits((typename Info::EquivalentInt)rng.Next64());
+        if (Info::IsFinite(f)) return f;
+    }
+}
+
+// a random decimal string: optional sign, up to 40 digits on each side of the point, leading and trailing zeros,
+// and an exponent anywhere from well under the smallest subnormal to well over the largest float
+static void RandomDecimal(Math::SplitMix64& rng, char* out, usize maxDigits) {
+    char* p = out;
+    if (rng.Next64() % 3 == 0) *p++ = rng.Next64() % 2 ? '-' : '+';
+    const auto digits = [&] (usize n) {
+        const u32 zeros = rng.Next64() % 4 == 0 ? (u32)(rng.Next64() % 8) : 0;
+        for (usize i = 0; i < n; ++i) *p++ = i < zeros ? '0' : (char)('0' + rng.Next64() % 10);
+    };
+    digits(rng.Next64() % (maxDigits + 1));
+    if (rng.Next64() % 4) {
+        *p++ = '.';
+        digits(rng.Next64() % (maxDigits + 1));
+    }
+    if (rng.Next64() % 4) p += std::snprintf(p, 16, "e%d", (int)(rng.Next64() % 801) - 400);
+    *p = '\0';
+}
+
+template <class F>
+static bool MatchesStrtod(const char* name, u32 n) {
+    Math::SplitMix64 rng { 0xDEC1 + sizeof(F) };
+    Counts counts;
+    char buf[2048];
+
+    static constexpr const char* EDGES[] = {
+        "0", "-0", "+0", "0.0", "0e0", "00000000000000000000000000000000000000001.5", ".5", "5.", ".", "-.", "+", "", "-",
+        "1e", "1e+", "1e-", "1E5", "1e+05", "1.5e5x", "1.5.5", "1..5", "e5", "1e99999999999999999999", "1e-99999999999999999999",
+        "inf", "-inf", "INF", "Infinity", "-infinity", "infin", "nan", "NaN", "-nan", "in", "na",
+        "0.1", "0.2", "0.3", "9007199254740993", "9007199254740993.0", "9007199254740992.99999999999999999999999",
+        "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324", "2.2250738585072011e-308",
+        "2.2250738585072014e-308", "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308",
+        "179769313486231580793728971405301e276", "1.4012984643e-45", "7.006492321624085e-46", "7.006492321624086e-46",
+        "1.17549435e-38", "3.4028234663852886e38", "3.4028235677973366e38", "3.4028235677973367e38",
+        "0.000000000000000000000000000000000000001e39", "123456789012345678901234567890", "1e23", "8.589973e9",
+        "7.038531e-26", "2.2250738585072012e-308", "0.500000000000000166533453693773481063544750213623046875",
+    };
+    for (const char* s : EDGES) Compare<F>(s, counts);
+
+    for (u32 i = 0; i < n; ++i) {
+        // what printf writes for any float at every precision
+        const F f = RandomFinite<F>(rng);
+        std::snprintf(buf, sizeof(buf), rng.Next64() % 2 ? "%.*e" : "%.*g", (int)(i % 25), (f64)f);
+        Compare<F>(buf, counts);
+
+        RandomDecimal(rng, buf, 40);
+        Compare<F>(buf, counts);
+        // past 19 digits, so the tail is cut off
+        if (i % 8 == 0) {
+            RandomDecimal(rng, buf, 800);
+            Compare<F>(buf, counts);
+        }
+        if (i % 4 == 0) CompareMidpoints<F>(std::abs(f), counts);
+    }
+
+    std::fprintf(stderr, "  %s: %llu strings, %llu through FromLongDecimal, %llu wrong\n", name,
+                 (unsigned long long)counts.checked, (unsigned long long)counts.longDecimal, (unsigned long long)counts.wrong);
+    // the fallback has to actually be exercised, not just reachable
+    return counts.wrong == 0 && counts.longDecimal > n / 16;
+}
+
+// a whitespace separated list has to read the same as strtod on each number, and stop at the first thing that isnt one
+template <class F>
+static bool ParseManyMatches(u32 count) {
+    Math::SplitMix64 rng { 0x3A11 + sizeof(F) };
+    String text;
+    Vec<F> expected;
+    char buf[64];
+    static constexpr char SPACES[] = { ' ', '\t', '\n', '\r' };
+    for (u32 i = 0; i < count; ++i) {
+        std::snprintf(buf, sizeof(buf), "%.*g", (int)(1 + i % 17), (f64)RandomFinite<F>(rng));
+        expected.Push(StrToF<F>(buf, nullptr));
+        for (u32 s = 0, n = 1 + (u32)(rng.Next64() % 3); s < n; ++s) text += SPACES[rng.Next64() % 4];
+        text += Str::Slice(buf, std::strlen(buf));
+    }
+    text += " 1.5,2 3";
+
+    Vec<F> out = Vec<F>::WithSize(count + 8);
+    Str rest = text;
+    // in pieces, so the text has to be left right after the last number each time
+    usize read = Text::Parser<F>::ParseMany(rest, Span<F>::Slice(out.Data(), count / 3));
+    read += Text::Parser<F>::ParseMany(rest, Span<F>::Slice(out.Data() + read, out.Length() - read));
+    bool same = read == count;
+    for (usize i = 0; i < std::min<usize>(read, count); ++i) same &= SameFloat(out[i], expected[i]);
+    return QCheck$(same) & QCheck$(rest == " 1.5,2 3");
+}
+
+int main() {
+    QCheck$(MatchesStrtod<f64>("f64", 200'000));
+    QCheck$(MatchesStrtod<f32>("f32", 200'000));
+    ParseManyMatches<f64>(20'000);
+    ParseManyMatches<f32>(20'000);
+
+    {
+        // a list that fills out exactly, and one that runs out of numbers first
+        f64 out[3];
+        Str full = "1 2 3 4";
+        QCheck$(Text::Parser<f64>::ParseMany(full, out) == 3 && out[2] == 3 && full == " 4");
+        Str partial = "  -1e3\t\n.5 ";
+        QCheck$(Text::Parser<f64>::ParseMany(partial, out) == 2 && out[0] == -1000 && out[1] == 0.5 && partial == " ");
+        Str nothing = "x 1";
+        QCheck$(Text::Parser<f64>::ParseMany(nothing, out) == 0 && nothing == "x 1");
+    }
+
+    return Test::Finish("NumParseTests");
+}
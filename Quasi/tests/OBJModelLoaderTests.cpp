@@ -0,0 +1,176 @@
+#include "Test.h"
+
+#include "ModelLoading/OBJModelLoader.h"
+#include "Utils/Algorithm.h"
+#include "Utils/Comparison.h"
+#include "Utils/Text.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+struct Triple { int v, t, n; };
+
+// a generated obj, with the v/t/n triple of every face corner kept on the side
+struct GeneratedOBJ {
+    String source;
+    Vec<Vec<Triple>> objectCorners;
+    int size;
+
+    // what the sort based path built for a triple, missing parts are zero
+    OBJVertex VertexOf(const Triple& t) const {
+        const int x = (t.v - 1) % size, y = (t.v - 1) / size;
+        const int tx = (t.t - 1) % size, ty = (t.t - 1) / size;
+        const int n = t.n - 1;
+        return {
+            { (f32)x / 8, (f32)y / 8, (f32)((x * 7 + y * 3) % 16) / 4 },
+            t.t == -1 ? Math::fv2 {} : Math::fv2 { (f32)(tx + 1) / 256, (f32)(ty + 1) / 256 },
+            t.n == -1 ? Math::fv3 {} : Math::fv3 { n == 0 ? 1.0f : 0.0f, n == 1 ? 1.0f : 0.0f, n >= 2 ? 1.0f : -1.0f }
+        };
+    }
+};
+
+// a grid of quads split into objects. some faces leave out the texture or normal,
+// and neighbouring quads disagree on normals, so positions are shared between distinct triples
+static GeneratedOBJ Generate(int size, int objects) {
+    GeneratedOBJ obj { .size = size };
+    String& s = obj.source;
+    // the first object comes before any geometry, like exporters write it. Load only sees geometry inside objects
+    s += "o part0\n";
+    obj.objectCorners.Push({});
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x) {
+            Text::FormatTo(Text::StringWriter::WriteTo(s), "v {} {} {}\n"_fmt, (f32)x / 8, (f32)y / 8, (f32)((x * 7 + y * 3) % 16) / 4);
+            Text::FormatTo(Text::StringWriter::WriteTo(s), "vt {} {}\n"_fmt, (f32)(x + 1) / 256, (f32)(y + 1) / 256);
+        }
+    for (int n = 0; n < 4; ++n)
+        Text::FormatTo(Text::StringWriter::WriteTo(s), "vn {} {} {}\n"_fmt, n == 0 ? 1 : 0, n == 1 ? 1 : 0, n >= 2 ? 1 : -1);
+
+    const int rowsPerObject = (size - 1 + objects - 1) / objects;
+    for (int y = 0; y < size - 1; ++y) {
+        if (y % rowsPerObject == 0 && y != 0) {
+            Text::FormatTo(Text::StringWriter::WriteTo(s), "o part{}\n"_fmt, y / rowsPerObject);
+            obj.objectCorners.Push({});
+        }
+        Vec<Triple>& corners = obj.objectCorners.Last();
+        for (int x = 0; x < size - 1; ++x) {
+            const int quad[4] = { y * size + x + 1, y * size + x + 2, (y + 1) * size + x + 2, (y + 1) * size + x + 1 };
+            const int normal = (x + y) % 4 + 1;
+            const int kind = (x * 5 + y) % 7;
+            static constexpr int TRIANGLES[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+            for (const auto& tri : TRIANGLES) {
+                s += "f";
+                for (const int c : tri) {
+                    const int v = quad[c];
+                    // mostly v/t/n, with the odd v//n, v/t and bare v
+                    const Triple t = kind == 0 ? Triple { v, -1, normal } :
+                                     kind == 1 ? Triple { v, v, -1 } :
+                                     kind == 2 ? Triple { v, -1, -1 } : Triple { v, v, normal };
+                    if      (t.t == -1 && t.n == -1) Text::FormatTo(Text::StringWriter::WriteTo(s), " {}"_fmt, t.v);
+                    else if (t.t == -1)              Text::FormatTo(Text::StringWriter::WriteTo(s), " {}//{}"_fmt, t.v, t.n);
+                    else if (t.n == -1)              Text::FormatTo(Text::StringWriter::WriteTo(s), " {}/{}"_fmt, t.v, t.t);
+                    else                             Text::FormatTo(Text::StringWriter::WriteTo(s), " {}/{}/{}"_fmt, t.v, t.t, t.n);
+                    corners.Push(t);
+                }
+                s += "\n";
+            }
+        }
+    }
+    return obj;
+}
+
+// the dedup ResolveObjectIndices used to do: sort every triple, drop duplicates, binary search each corner back
+static Vec<TriIndices> SortedIndices(Span<const Triple> corners, usize& uniqueCount) {
+    struct Cmp3 {
+        Comparison operator()(const Triple& a, const Triple& b) const {
+            return a.v != b.v ? Cmp::Between(a.v, b.v) : a.t != b.t ? Cmp::Between(a.t, b.t) : Cmp::Between(a.n, b.n);
+        }
+    };
+    Vec<Triple> unique = corners.CollectToVec();
+    unique.SortBy(Cmp3 {});
+    unique.RemoveDupIf([] (const Triple& a, const Triple& b) { return a.v == b.v && a.t == b.t && a.n == b.n; });
+    uniqueCount = unique.Length();
+
+    Vec<TriIndices> indices;
+    for (usize i = 0; i < corners.Length(); i += 3) {
+        u32 tri[3];
+        for (u32 c = 0; c < 3; ++c)
+            tri[c] = (u32)unique.BinarySearchWith([&] (const Triple& x) { return Cmp3 {}(x, corners[i + c]); }).Get<1>();
+        indices.Push({ tri[0], tri[1], tri[2] });
+    }
+    return indices;
+}
+
+static bool SameVertex(const OBJVertex& a, const OBJVertex& b) {
+    return a.Position == b.Position && a.TextureCoordinate == b.TextureCoordinate && a.Normal == b.Normal;
+}
+
+// the loaded mesh has to name the same vertices as the sort based path, in the same triangles,
+// with only the numbering allowed to differ. the numbering is first use order
+static void CheckAgainstSorted(const OBJModel& model, const GeneratedOBJ& obj) {
+    if (!QCheck$(model.objects.Length() == obj.objectCorners.Length())) return;
+
+    for (usize o = 0; o < model.objects.Length(); ++o) {
+        const Mesh<OBJVertex>& mesh = model.objects[o].mesh;
+        const Span<const Triple> corners = obj.objectCorners[o];
+        usize uniqueCount = 0;
+        const Vec<TriIndices> sorted = SortedIndices(corners, uniqueCount);
+        QCheck$(mesh.vertices.Length() == uniqueCount);
+        if (!QCheck$(mesh.indices.Length() == sorted.Length())) continue;
+
+        // hash index -> sorted index has to be one to one, which makes the vertex sets equal too
+        static constexpr u32 NONE = ~0u;
+        Vec<u32> toSorted;
+        toSorted.Resize(mesh.vertices.Length(), NONE);
+        Vec<bool> sortedSeen;
+        sortedSeen.Resize(uniqueCount, false);
+        bool oneToOne = true, sameData = true, firstUse = true;
+        u32 nextNew = 0;
+        for (usize i = 0; i < sorted.Length(); ++i) {
+            const u32 ours[3] = { mesh.indices[i].i, mesh.indices[i].j, mesh.indices[i].k };
+            const u32 theirs[3] = { sorted[i].i, sorted[i].j, sorted[i].k };
+            for (u32 c = 0; c < 3; ++c) {
+                const Triple& t = corners[i * 3 + c];
+                if (ours[c] > nextNew) firstUse = false;
+                if (ours[c] == nextNew) ++nextNew;
+
+                if (ours[c] >= mesh.vertices.Length()) { oneToOne = sameData = false; continue; }
+                sameData &= SameVertex(mesh.vertices[ours[c]], obj.VertexOf(t));
+
+                if (toSorted[ours[c]] != NONE) {
+                    oneToOne &= toSorted[ours[c]] == theirs[c];
+                } else {
+                    oneToOne &= !sortedSeen[theirs[c]];
+                    sortedSeen[theirs[c]] = true;
+                    toSorted[ours[c]] = theirs[c];
+                }
+            }
+        }
+        QCheck$(oneToOne);
+        QCheck$(firstUse && nextNew == mesh.vertices.Length());
+        QCheck$(sameData);
+    }
+}
+
+int main() {
+    {
+        // small enough to stay in one chunk
+        const GeneratedOBJ obj = Generate(24, 3);
+        OBJModelLoader loader;
+        loader.Load(obj.source);
+        CheckAgainstSorted(loader.GetModel(), obj);
+
+        OBJModelLoader chunked;
+        chunked.LoadParallel(obj.source, 1);
+        CheckAgainstSorted(chunked.GetModel(), obj);
+    }
+    {
+        // a few MB, so the parallel loader splits it and objects cross chunk boundaries
+        const GeneratedOBJ obj = Generate(320, 5);
+        QCheck$(obj.source.Length() > 3 * OBJModelLoader::MIN_CHUNK_SIZE);
+        OBJModelLoader loader;
+        loader.LoadParallel(obj.source, 4);
+        CheckAgainstSorted(loader.GetModel(), obj);
+    }
+
+    return Test::Finish("OBJModelLoaderTests");
+}
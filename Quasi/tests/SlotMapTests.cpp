@@ -0,0 +1,72 @@
+#include "Test.h"
+
+#include "Utils/SlotMap.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+int main() {
+    {
+        SlotMap<int> map;
+        QCheck$(!map.Contains(SlotKey {}) && !map.Get(SlotKey {}));
+
+        const SlotKey a = map.Insert(10), b = map.Insert(20), c = map.Insert(30);
+        QCheck$(map.Length() == 3 && map[a] == 10 && map[b] == 20 && map[c] == 30);
+
+        // removing from the middle moves the last value into the hole, its key still finds it
+        QCheck$(map.Remove(b));
+        QCheck$(!map.Contains(b) && !map.Get(b) && !map.Remove(b));
+        QCheck$(map.Length() == 2 && map[a] == 10 && map[c] == 30);
+        QCheck$(map.Values()[1] == 30 && map.KeyAt(1) == c);
+
+        // the freed slot comes back for the next value, with a new generation
+        const SlotKey d = map.Insert(40);
+        QCheck$(d.index == b.index && d.generation != b.generation);
+        QCheck$(!map.Contains(b) && map[d] == 40);
+        QCheck$(!map.Take(b) && map.Take(d) == 40);
+        QCheck$(!map.Contains(d));
+
+        // reused over and over, every old key to the slot stays stale
+        SlotKey keys[8];
+        for (SlotKey& k : keys) {
+            k = map.Insert(50);
+            map.Remove(k);
+        }
+        for (const SlotKey k : keys) QCheck$(k.index == b.index && !map.Contains(k));
+
+        map.Clear();
+        QCheck$(map.IsEmpty() && !map.Contains(a) && !map.Contains(c));
+        const SlotKey e = map.Insert(60);
+        QCheck$(map.Length() == 1 && map[e] == 60 && e != a && e != c);
+    }
+
+    {
+        // random inserts and removes against a plain list of what should be alive
+        struct Live { SlotKey key; u64 value; };
+        SlotMap<u64> map;
+        Vec<Live> live;
+        Vec<SlotKey> dead;
+        Math::SplitMix64 rng { 0x5107 };
+        for (u32 i = 0; i < 100000; ++i) {
+            if (live.IsEmpty() || rng.Next64() % 5 < 3) {
+                const u64 v = rng.Next64();
+                live.Push({ map.Insert(v), v });
+            } else {
+                const usize at = rng.Next64() % live.Length();
+                const Live gone = live[at];
+                live[at] = live.Last();
+                live.Pop();
+                QCheck$(map.Take(gone.key) == gone.value);
+                dead.Push(gone.key);
+            }
+        }
+        QCheck$(map.Length() == live.Length());
+        for (const Live& l : live) QCheck$(map.Contains(l.key) && map[l.key] == l.value);
+        usize staleFound = 0;
+        for (const SlotKey k : dead) staleFound += map.Contains(k);
+        QCheck$(staleFound == 0);
+        for (usize i = 0; i < map.Length(); ++i) QCheck$(map[map.KeyAt(i)] == map.Values()[i]);
+    }
+
+    return Test::Finish("SlotMapTests");
+}
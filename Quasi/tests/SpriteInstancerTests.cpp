@@ -0,0 +1,83 @@
+#include "Test.h"
+
+#include <algorithm>
+
+#include "SpriteInstancer.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+// the push index goes in Position.x, so the sorted buffer says where every sprite came from
+static SpriteInstance Tagged(u32 index) {
+    SpriteInstance s {};
+    s.Position = { (f32)index, 0 };
+    return s;
+}
+
+static bool OrderIs(Span<const SpriteInstance> sorted, std::initializer_list<u32> expected) {
+    if (sorted.Length() != expected.size()) return false;
+    usize i = 0;
+    for (const u32 e : expected)
+        if (sorted[i++].Position.x != (f32)e) return false;
+    return true;
+}
+
+int main() {
+    {
+        // same layer and depth keep the order they were pushed in
+        SpriteInstanceBuffer buffer;
+        for (u32 i = 0; i < 5; ++i) buffer.Push(Tagged(i), 1.0f, 2);
+        QCheck$(OrderIs(buffer.Sort(), { 0, 1, 2, 3, 4 }));
+    }
+    {
+        // -0 is the same depth as 0, so it ties instead of sorting before or after it
+        SpriteInstanceBuffer buffer;
+        buffer.Push(Tagged(0), 0.0f);
+        buffer.Push(Tagged(1), -0.0f);
+        buffer.Push(Tagged(2), 0.0f);
+        buffer.Push(Tagged(3), -0.0f);
+        QCheck$(OrderIs(buffer.Sort(), { 0, 1, 2, 3 }));
+        QCheck$(SpriteInstanceBuffer::SortKey(0.0f, 0) == SpriteInstanceBuffer::SortKey(-0.0f, 0));
+    }
+    {
+        // layers come first, then deepest first within a layer, negatives included
+        SpriteInstanceBuffer buffer;
+        buffer.Push(Tagged(0), -3.0f, 1);
+        buffer.Push(Tagged(1), 100.0f, 1);
+        buffer.Push(Tagged(2), -5.0f, 0);
+        buffer.Push(Tagged(3), 0.5f, 0);
+        buffer.Push(Tagged(4), 7.0f, 255);
+        buffer.Push(Tagged(5), -0.5f, 0);
+        QCheck$(OrderIs(buffer.Sort(), { 3, 5, 2, 1, 0, 4 }));
+        // the recorded buffer stays in push order
+        QCheck$(OrderIs(buffer.Recorded(), { 0, 1, 2, 3, 4, 5 }));
+    }
+    {
+        // enough sprites for the radix passes, with lots of ties. checked against a stable sort of the same keys
+        static constexpr u32 N = 1000;
+        static constexpr f32 DEPTHS[] = { -2.0f, -0.0f, 0.0f, 0.25f, 3.0f, -1e30f, 1e30f };
+        SpriteInstanceBuffer buffer;
+        Vec<u32> expected;
+        Vec<u64> keys;
+        u32 state = 12345;
+        for (u32 i = 0; i < N; ++i) {
+            state = state * 1664525 + 1013904223;
+            const f32 depth = DEPTHS[(state >> 8) % std::size(DEPTHS)];
+            const u8 layer = (u8)((state >> 20) % 3);
+            buffer.Push(Tagged(i), depth, layer);
+            expected.Push(i);
+            keys.Push(SpriteInstanceBuffer::SortKey(depth, layer));
+        }
+        std::stable_sort(expected.Data(), expected.Data() + N, [&] (u32 a, u32 b) { return keys[a] < keys[b]; });
+
+        const Span<const SpriteInstance> sorted = buffer.Sort();
+        bool matches = sorted.Length() == N;
+        for (u32 i = 0; matches && i < N; ++i) matches = sorted[i].Position.x == (f32)expected[i];
+        QCheck$(matches);
+
+        buffer.Clear();
+        QCheck$(buffer.IsEmpty() && buffer.Sort().IsEmpty());
+    }
+
+    return Test::Finish("SpriteInstancerTests");
+}
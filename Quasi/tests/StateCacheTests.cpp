@@ -0,0 +1,114 @@
+#include "Test.h"
+#include "GLStub.h"
+
+#include "../../PostEffect.h"
+#include "GraphicsDevice.h"
+#include "SpriteInstancer.h"
+#include "GLs/Render.h"
+#include "GLs/VertexArray.h"
+#include "GUI/Canvas.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+// the gl functions that the state cache stands in front of
+static usize StateCalls() {
+    static constexpr Str NAMES[] = {
+        "BindFramebuffer", "Viewport", "ClearColor", "Enable", "Disable", "BlendFunc",
+        "ActiveTexture", "BindTexture", "BindVertexArray", "BindBuffer", "UseProgram",
+    };
+    usize n = 0;
+    for (const Str name : NAMES) n += Test::GLStub::Calls(name);
+    return n;
+}
+
+// the state LimboApp's frame goes through, made from the real objects on a headless device
+struct Scene {
+    GraphicsDevice device { nullptr, { 640, 480 } };
+    Canvas canvas { device };
+    SpriteInstancer keys;
+    PostEffect intensify { { 640, 480 }, ShaderProgram::NewCompute("compute") };
+    Texture2D atlas = Texture2D::New(nullptr, { 64, 64 });
+
+    Scene() { keys.CreateRender(device); }
+
+    void PushKeys(float z) {
+        for (u32 i = 0; i < 4; ++i)
+            keys.Push(SpriteInstance::FromWidth({ atlas, { 0, 0.5f } }, { 80.0f + 160 * (f32)i, 240 }, 120), z);
+    }
+
+    // one LimboApp::Run: back keys, an overlay on the canvas, front keys, then the intensify pass to the screen
+    void Frame() {
+        intensify.SetToRenderTarget();
+        device.Begin();
+        canvas.BeginFrame();
+        canvas.DrawRect({ { 32, 48 }, { 608, 432 } });
+
+        PushKeys(2);
+        canvas.ForceDrawCurrentBatch();
+        keys.Draw(atlas);
+
+        canvas.DrawSTextureW({ atlas, { 0.5f, 1 } }, { 320, 240 }, 200);
+        PushKeys(0.5f);
+        canvas.ForceDrawCurrentBatch();
+        keys.Draw(atlas);
+
+        canvas.EndFrame();
+        intensify.shader.Bind();
+        intensify.ApplyEffect();
+        device.End();
+    }
+};
+
+static bool FrameIs(Scene& s, u32 issued, u32 skipped) {
+    Render::ResetStateCacheStats();
+    Test::GLStub::Reset();
+    s.Frame();
+    const Render::StateCacheStats& stats = Render::GetStateCacheStats();
+    if (stats.issued != issued || stats.skipped != skipped || StateCalls() != issued ||
+        Test::GLStub::Calls("DrawElements") != 3 || Test::GLStub::Calls("DrawElementsInstanced") != 2) {
+        std::fprintf(stderr, "  issued %u, skipped %u, %zu state calls reached gl\n", stats.issued, stats.skipped, StateCalls());
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    Scene scene;
+
+    // 40 state changes asked for every frame, the canvas and the instancer take turns with their vertex arrays and shaders.
+    // from nothing known, only what the frame asks for twice is skipped, like the blit's read target and rebinds for uploads
+    Render::InvalidateState();
+    QCheck$(FrameIs(scene, 29, 11));
+    // back to back, the viewport, the texture and its slot, the canvas's vertex array and its buffers are still bound from the last frame
+    QCheck$(FrameIs(scene, 22, 18));
+    // imgui runs in between in the app, which invalidates everything
+    Render::InvalidateState();
+    QCheck$(FrameIs(scene, 29, 11));
+
+    {
+        // a new vertex array drops the index buffer binding, the same index buffer has to be bound again
+        const VertexArray first = VertexArray::New(), second = VertexArray::New();
+        const IndexBuffer ibo = IndexBuffer::New(6);
+        Render::InvalidateState();
+        Render::ResetStateCacheStats();
+        Render::BindVertexArray(first.rendererID);
+        Render::BindIndexBuffer(ibo.rendererID);
+        Render::BindVertexArray(second.rendererID);
+        Render::BindIndexBuffer(ibo.rendererID);
+        QCheck$(Render::GetStateCacheStats().issued == 4);
+    }
+    {
+        // a deleted object's id can come back for a new object, which isnt bound yet
+        Render::ResetStateCacheStats();
+        Test::GLStub::Reset();
+        Render::BindVertexBuffer(77);
+        Render::BindVertexBuffer(77);
+        Render::ForgetBuffer(77);
+        Render::BindVertexBuffer(77);
+        QCheck$(Render::GetStateCacheStats().issued == 2 && Render::GetStateCacheStats().skipped == 1);
+        QCheck$(Test::GLStub::Calls("BindBuffer") == 2);
+    }
+
+    return Test::Finish("StateCacheTests");
+}
@@ -0,0 +1,198 @@
+#include "Test.h"
+
+#include <unordered_map>
+
+#include "Utils/HashMap.h"
+#include "Utils/String.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+
+// only 8 different hashes, so every key shares its probe sequence and its 7 bit tag with an eighth of the others
+struct CollidingHasher {
+    Hashing::Hash operator()(u64 x) const { return Hashing::AsHash(x % 8); }
+};
+
+// same entries as the reference, found through lookups, iteration and the copy's operator== alike
+template <class Table>
+static bool SameEntries(const Table& table, const std::unordered_map<u64, u64>& reference) {
+    if (table.Count() != reference.size()) return false;
+    usize iterated = 0;
+    for (const auto& [k, v] : table) {
+        const auto it = reference.find(k);
+        if (it == reference.end() || it->second != v) return false;
+        ++iterated;
+    }
+    if (iterated != reference.size()) return false;
+    for (const auto& [k, v] : reference)
+        if (table.Get(k).Map([&] (const u64& x) { return x != v; }).UnwrapOr(true)) return false;
+    const Table copy = table;
+    return copy == table;
+}
+
+// random operations over a small key range, so keys keep coming back after they were removed and leave tombstones behind
+template <class Hasher>
+static bool Fuzz(u32 ops, u64 keyRange, u64 seed) {
+    Math::SplitMix64 rng { seed };
+    SwissTable<u64, u64, Hasher> table;
+    std::unordered_map<u64, u64> reference;
+    bool ok = true;
+
+    for (u32 op = 0; op < ops && ok; ++op) {
+        const u64 k = rng.Next64() % keyRange, v = rng.Next64();
+        const auto found = reference.find(k);
+        const bool present = found != reference.end();
+        switch (rng.Next64() % 16) {
+            case 0: case 1: case 2:
+                table.Insert(k, v);
+                reference[k] = v;
+                break;
+            case 3:
+                ok &= table.TryInsert(k, v).HasValue() != present;
+                reference.emplace(k, v);
+                break;
+            case 4: {
+                const Option<u64> old = table.Replace(k, v);
+                ok &= present ? old.HasValue() && *old == found->second : !old.HasValue();
+                reference[k] = v;
+                break;
+            }
+            case 5:
+                ok &= table.GetOrInsert(k, v) == (present ? found->second : v);
+                reference.emplace(k, v);
+                break;
+            case 6: case 7: case 8:
+                ok &= table.Remove(k) == present;
+                reference.erase(k);
+                break;
+            case 9: {
+                const Option<u64> taken = table.Take(k);
+                ok &= present ? taken.HasValue() && *taken == found->second : !taken.HasValue();
+                reference.erase(k);
+                break;
+            }
+            case 10: case 11: case 12:
+                ok &= table.Contains(k) == present;
+                ok &= present ? table.Get(k).HasValue() && *table.Get(k) == found->second : !table.Get(k).HasValue();
+                break;
+            case 13:
+                // every so often, the things that rebuild or move the whole table
+                switch (rng.Next64() % 64) {
+                    case 0: table.Rehash(0); break;
+                    case 1: table.Reserve(table.Count() + rng.Next64() % 512); break;
+                    case 2: table.Compact(); break;
+                    case 3: { SwissTable<u64, u64, Hasher> moved = std::move(table); table = std::move(moved); break; }
+                    case 4: { const SwissTable<u64, u64, Hasher> copy = table; table = copy; break; }
+                    case 5: if (rng.Next64() % 8 == 0) { table.Clear(); reference.clear(); } break;
+                    case 6: {
+                        const u64 parity = rng.Next64() % 2;
+                        table.KeepEntries([&] (const KeyValuePair<u64, u64>& kv) { return kv.value % 2 == parity; });
+                        std::erase_if(reference, [&] (const auto& kv) { return kv.second % 2 != parity; });
+                        break;
+                    }
+                    default: break;
+                }
+                break;
+            default:
+                // the value in place, through operator[]
+                table[k] += 1;
+                reference[k] += 1;
+                break;
+        }
+        ok &= table.Count() == reference.size();
+        if (op % 4096 == 0) ok &= SameEntries(table, reference);
+    }
+    ok &= SameEntries(table, reference);
+    return ok;
+}
+
+int main() {
+    // 400k operations each: mostly present keys, a table that grows and shrinks, and one where every probe collides
+    QCheck$(Fuzz<Hashing::DefaultHasher>(400'000, 1 << 12, 0x5315));
+    QCheck$(Fuzz<Hashing::DefaultHasher>(400'000, 1 << 17, 0x5316));
+    QCheck$(Fuzz<CollidingHasher>(400'000, 1 << 10, 0x5317));
+
+    {
+        // a sliding window of keys: every insert follows a remove, so the table fills up with tombstones.
+        // at most half full, running out of room rehashes at the same size instead of growing
+        SwissMap<u64, u64> table;
+        table.Reserve(800);
+        const usize mask = table.GetMask();
+        for (u64 k = 0; k < 400; ++k) table.Insert(k, k);
+        bool found = true, sameSize = true;
+        for (u64 k = 400; k < 200'400; ++k) {
+            table.Remove(k - 400);
+            table.Insert(k, k);
+            sameSize &= table.GetMask() == mask;
+            if (k % 997 == 0) found &= table.Get(k - 399).HasValue() && !table.Contains(k - 400);
+        }
+        QCheck$(table.Count() == 400);
+        QCheck$(sameSize);
+        QCheck$(found);
+        bool all = true;
+        for (u64 k = 200'000; k < 200'400; ++k) all &= table.Get(k).HasValue() && *table.Get(k) == k;
+        QCheck$(all);
+    }
+    {
+        // grown just big enough for its keys and so more than half full: the churn doubles it once, then it stays
+        SwissMap<u64, u64> table;
+        for (u64 k = 0; k < 400; ++k) table.Insert(k, k);
+        const usize mask = table.GetMask();
+        usize doublings = 0;
+        for (u64 k = 400; k < 200'400; ++k) {
+            const usize before = table.GetMask();
+            table.Remove(k - 400);
+            table.Insert(k, k);
+            doublings += table.GetMask() != before;
+        }
+        QCheck$(doublings == 1 && table.GetMask() == mask * 2 + 1);
+        QCheck$(table.Count() == 400);
+    }
+    {
+        // tombstones from colliding keys, then a same size rehash that has to keep every one of them findable
+        SwissTable<u64, u64, CollidingHasher> table;
+        for (u64 k = 0; k < 100; ++k) table.Insert(k, k);
+        for (u64 k = 0; k < 100; k += 2) table.Remove(k);
+        const usize mask = table.GetMask();
+        table.Rehash(table.Count());
+        QCheck$(table.GetMask() <= mask);
+        bool ok = table.Count() == 50;
+        for (u64 k = 0; k < 100; ++k) ok &= table.Contains(k) == (k % 2 == 1);
+        QCheck$(ok);
+    }
+    {
+        // String keys found with a Str, including a Str cut out of the middle of something else
+        SwissMap<String, u32> table;
+        Math::SplitMix64 rng { 0x57A };
+        Vec<String> keys;
+        for (u32 i = 0; i < 5000; ++i) {
+            String key;
+            for (u32 n = 1 + (u32)(rng.Next64() % 40); n; --n) key += (char)('a' + rng.Next64() % 26);
+            key += (char)('0' + i % 10);
+            if (table.TryInsert(key.Clone(), i)) keys.Push(std::move(key));
+        }
+        bool ok = true;
+        for (usize i = 0; i < keys.Length(); ++i) {
+            String padded = "<<";
+            padded += keys[i].AsStr();
+            padded += ">>";
+            const Str view = padded.AsStr().Substr(2, keys[i].Length());
+            ok &= table.Contains(view) && *table.Get(view) == table.Get(keys[i].AsStr()).Map([] (const u32& x) { return x; }).UnwrapOr(~0u);
+            // a character more on either side is a different key
+            ok &= !table.Contains(padded.AsStr().Substr(1, keys[i].Length() + 1)) && !table.Contains(padded.AsStr().Substr(2, keys[i].Length() + 1));
+        }
+        QCheck$(ok);
+
+        // removing and taking by Str too
+        usize removed = 0;
+        for (usize i = 0; i < keys.Length(); i += 3) removed += table.Remove(keys[i].AsStr());
+        for (usize i = 1; i < keys.Length(); i += 3) removed += table.Take(keys[i].AsStr()).HasValue();
+        QCheck$(removed == (keys.Length() + 2) / 3 + (keys.Length() + 1) / 3);
+        QCheck$(table.Count() == keys.Length() - removed);
+        bool rest = true;
+        for (usize i = 0; i < keys.Length(); ++i) rest &= table.Contains(keys[i].AsStr()) == (i % 3 == 2);
+        QCheck$(rest);
+    }
+
+    return Test::Finish("SwissTableTests");
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdio>
+
+// a tiny harness for the headless tests: a failed check prints where it was and the test exits nonzero
+namespace Quasi::Test {
+    inline int failures = 0;
+
+    inline bool Check(bool passed, const char* expr, const char* file, int line) {
+        if (!passed) {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+            ++failures;
+        }
+        return passed;
+    }
+
+    inline int Finish(const char* name) {
+        if (failures) std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures);
+        else std::printf("%s: passed\n", name);
+        return failures != 0;
+    }
+}
+
+#define Q_TEST_CHECK(...) Quasi::Test::Check((bool)(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+#define QCheck$(...) Q_TEST_CHECK(__VA_ARGS__)
@@ -0,0 +1,106 @@
+#include "Test.h"
+
+#include "TileMap.h"
+#include "Utils/Math/Random.h"
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+// every chunk's quads, read back into tiles: each non-empty tile has to be in exactly one quad,
+// empty tiles in none, and a quad can only cover tiles of its own type
+static bool CheckCoverage(const TileMap& map) {
+    const Math::uv2 size = map.Size();
+    Vec<u32> covered;
+    covered.Resize(size.x * size.y, 0);
+    bool wellFormed = true, singleType = true, insideChunk = true;
+
+    for (u32 cy = 0; cy < map.ChunkCount().y; ++cy)
+        for (u32 cx = 0; cx < map.ChunkCount().x; ++cx) {
+            const Mesh<TileVertex>& mesh = map.ChunkAt(cx, cy).mesh;
+            if (mesh.vertices.Length() % 4 || mesh.indices.Length() != mesh.vertices.Length() / 2) { wellFormed = false; continue; }
+            const Math::fRect2D bounds = map.ChunkBounds(cx, cy);
+
+            for (usize q = 0; q < mesh.vertices.Length(); q += 4) {
+                const TileVertex* v = &mesh.vertices[q];
+                const u32 type = v[0].Type;
+                const Math::fv2 w = v[2].TileCoord;
+                wellFormed &= type != TileMap::EMPTY && v[1].Type == type && v[2].Type == type && v[3].Type == type;
+                wellFormed &= v[0].TileCoord == Math::fv2 { 0, 0 } && v[1].TileCoord == Math::fv2 { w.x, 0 } && v[3].TileCoord == Math::fv2 { 0, w.y };
+                insideChunk &= v[0].Position.x >= bounds.min.x && v[0].Position.y >= bounds.min.y &&
+                               v[2].Position.x <= bounds.max.x && v[2].Position.y <= bounds.max.y;
+
+                const Math::iv2 min = (Math::iv2)(v[0].Position / map.TileSize()) - map.Offset(),
+                                max = (Math::iv2)(v[2].Position / map.TileSize()) - map.Offset();
+                wellFormed &= max - min == (Math::iv2)w;
+                for (int y = min.y; y < max.y; ++y)
+                    for (int x = min.x; x < max.x; ++x) {
+                        if (x < 0 || y < 0 || x >= (int)size.x || y >= (int)size.y) { insideChunk = false; continue; }
+                        ++covered[y * size.x + x];
+                        singleType &= map.Get(x, y) == type;
+                    }
+            }
+        }
+
+    bool exactlyOnce = true;
+    for (u32 y = 0; y < size.y; ++y)
+        for (u32 x = 0; x < size.x; ++x)
+            exactlyOnce &= covered[y * size.x + x] == (map.Get(x, y) != TileMap::EMPTY ? 1u : 0u);
+
+    return QCheck$(wellFormed) & QCheck$(insideChunk) & QCheck$(singleType) & QCheck$(exactlyOnce);
+}
+
+static Math::fRect2D Everything(const TileMap& map) {
+    return { (Math::fv2)map.Offset() * map.TileSize(), (Math::fv2)(map.Offset() + (Math::iv2)map.Size()) * map.TileSize() };
+}
+
+int main() {
+    Math::SplitMix64 rng { 0x711E };
+    {
+        // random rectangles of a few types over a map that doesnt end on a chunk boundary, at an offset
+        TileMap map { { 150, 97 }, 0.5f, { -40, 13 } };
+        for (u32 i = 0; i < 300; ++i) {
+            const u32 x = rng.Next64() % 150, y = rng.Next64() % 97;
+            map.Fill({ { x, y }, { x + 1 + (u32)(rng.Next64() % 24), y + 1 + (u32)(rng.Next64() % 24) } }, (u32)(rng.Next64() % 5));
+        }
+        map.Update(Everything(map));
+        QCheck$(map.GetStats().rebuiltChunks == map.ChunkCount().x * map.ChunkCount().y);
+        CheckCoverage(map);
+
+        // single tile edits only rebuild their chunk, and stay covered
+        for (u32 i = 0; i < 200; ++i) map.Set(rng.Next64() % 150, rng.Next64() % 97, (u32)(rng.Next64() % 5));
+        map.Update(Everything(map));
+        CheckCoverage(map);
+    }
+    {
+        // noise and checkerboards, the worst case for merging, where nothing can merge at all
+        TileMap noise { { 64, 64 } };
+        for (u32 y = 0; y < 64; ++y)
+            for (u32 x = 0; x < 64; ++x) noise.Set(x, y, y < 32 ? (u32)(rng.Next64() % 3) : 1 + (x + y) % 2);
+        noise.Update(Everything(noise));
+        CheckCoverage(noise);
+        const TileMap::Chunk& checkerboard = noise.ChunkAt(0, 1);
+        QCheck$(checkerboard.mesh.indices.Length() == 2 * TileMap::CHUNK_SIZE * TileMap::CHUNK_SIZE);
+
+        // and a solid chunk is a single quad
+        TileMap solid { { 64, 64 } };
+        solid.Fill({ { 0, 0 }, { 64, 64 } }, 3);
+        solid.Update(Everything(solid));
+        CheckCoverage(solid);
+        QCheck$(solid.GetStats().triangles == 2 * 4);
+    }
+    {
+        // viewports far outside what a u32 can hold still just clamp to the map
+        TileMap map { { 100, 100 } };
+        map.Fill({ { 0, 0 }, { 100, 100 } }, 1);
+        map.Update(Math::fRect2D { { -1e30f, -1e30f }, { 1e30f, 1e30f } });
+        QCheck$(map.GetStats().visibleChunks == 16);
+        map.Update(Math::fRect2D { { 40, 40 }, { 1e20f, 50 } });
+        QCheck$(map.GetStats().visibleChunks == 3);
+        map.Update(Math::fRect2D { { 1e20f, 0 }, { 2e20f, 10 } });
+        QCheck$(map.GetStats().visibleChunks == 0);
+        map.Update(Math::fRect2D { { Math::NaN, 0 }, { Math::NaN, 10 } });
+        QCheck$(map.GetStats().visibleChunks == 0);
+    }
+
+    return Test::Finish("TileMapTests");
+}